@@ -186,7 +186,7 @@ private:
     otb::Wrapper::ElevationParametersHandler::SetupDEMHandlerFromElevationParameters(this, "elev");
 
     // Reproject geometries
-    auto inputImg            = this->GetParameterImage("in");
+    const auto* inputImg     = this->GetParameterImage("in");
     auto imageProjectionRef  = inputImg->GetProjectionRef();
     const auto & imageMetadata       = inputImg->GetImageMetadata();
     auto vectorProjectionRef = vectors->GetLayer(GetParameterInt("layer")).GetProjectionRef();
@@ -350,7 +350,7 @@ private:
     otb::ogr::DataSource::Pointer vectors = otb::ogr::DataSource::New(this->GetParameterString("vec"));
 
     // Reproject geometries
-    auto inputImg            = this->GetParameterImage("in");
+    const auto* inputImg     = this->GetParameterImage("in");
     auto imageProjectionRef  = inputImg->GetProjectionRef();
     const auto & imageMetadata       = inputImg->GetImageMetadata();
     auto vectorProjectionRef = vectors->GetLayer(GetParameterInt("layer")).GetProjectionRef();
@@ -328,8 +328,8 @@ private:
   {
     OGRMultiLineString mls;
 
-    FloatVectorImageType::Pointer image1 = this->GetParameterImage("in1");
-    FloatVectorImageType::Pointer image2 = this->GetParameterImage("in2");
+    FloatVectorImageType::ConstPointer image1 = this->GetParameterImage("in1");
+    FloatVectorImageType::ConstPointer image2 = this->GetParameterImage("in2");
 
     // Setting up RS Transform
     RSTransformType::Pointer rsTransform = RSTransformType::New();
@@ -156,8 +156,9 @@ private:
      * We need to reproject in WGS84 if the input image is in sensor model geometry
      */
 
-    std::string      projRef = GetParameterImage("in")->GetProjectionRef();
-    const auto & imageMetadata       = GetParameterImage("in")->GetImageMetadata();
+    const FloatVectorImageType* inImage       = GetParameterImage("in");
+    std::string                 projRef       = inImage->GetProjectionRef();
+    const auto &                imageMetadata = inImage->GetImageMetadata();
     
     VectorDataType::Pointer vd = lsd->GetFilter()->GetOutputVectorData();
 
@@ -577,7 +577,7 @@ private:
       }
       else
       {
-        RGBIndex = supportImage->GetImageMetadata().GetDefaultDisplay();
+        RGBIndex = static_cast<const FloatVectorImageType*>(supportImage.GetPointer())->GetImageMetadata().GetDefaultDisplay();
       }
 
       otbAppLogINFO(" RGB index are " << RGBIndex[0] << " " << RGBIndex[1] << " " << RGBIndex[2] << std::endl);
@@ -202,7 +202,8 @@ private:
       if (nbBand > 1)
       {
         // get band index : Red/Green/Blue, in depending on the sensor
-        auto const& display = GetParameterImage("in")->GetImageMetadata().GetDefaultDisplay();
+        const FloatVectorImageType* inImage = GetParameterImage("in");
+        auto const&                 display = inImage->GetImageMetadata().GetDefaultDisplay();
         SetDefaultParameterInt("channels.rgb.red", display[0] + 1);
         SetDefaultParameterInt("channels.rgb.green", display[1] + 1);
         SetDefaultParameterInt("channels.rgb.blue", display[2] + 1);
@@ -426,7 +426,7 @@ private:
     else // if( GetParameterString( "mode.extent.unit" ) == "lonlat" )
     {
       RSTransformType::Pointer rsTransform = RSTransformType::New();
-      ImageType*               inImage     = GetParameterImage("in");
+      const ImageType*         inImage     = GetParameterImage("in");
       rsTransform->SetOutputImageMetadata(&(inImage->GetImageMetadata()));
       rsTransform->SetOutputProjectionRef(inImage->GetProjectionRef());
       rsTransform->InstantiateTransform();
@@ -543,7 +543,7 @@ private:
       else // if ( GetParameterString( "mode.radius.unitc" ) == "lon/lat" )
       {
         RSTransformType::Pointer rsTransform = RSTransformType::New();
-        ImageType*               inImage     = GetParameterImage("in");
+        const ImageType*         inImage     = GetParameterImage("in");
         rsTransform->SetOutputImageMetadata(&(inImage->GetImageMetadata()));
         rsTransform->SetOutputProjectionRef(inImage->GetProjectionRef());
         rsTransform->InstantiateTransform();
@@ -568,7 +568,7 @@ private:
     else // if ( GetParameterString( "mode.radius.unitr" ) == "phy" )
     {
       // reference is physical space
-      ImageType* inImage = GetParameterImage("in");
+      const ImageType* inImage = GetParameterImage("in");
       itk::Point<float, 2> centerp, radiusp;
       radiusp.Fill(GetParameterFloat("mode.radius.r"));
       if (GetParameterString("mode.radius.unitc") == "pxl")
@@ -724,7 +724,7 @@ private:
         }
         RSTransformType::Pointer rsTransform = RSTransformType::New();
         rsTransform->SetInputProjectionRef(inputProjectionRef);
-        rsTransform->SetOutputImageMetadata(&(inImage->GetImageMetadata()));
+        rsTransform->SetOutputImageMetadata(&(static_cast<const ImageType*>(inImage)->GetImageMetadata()));
         rsTransform->SetOutputProjectionRef(inImage->GetProjectionRef());
         rsTransform->InstantiateTransform();
         itk::Point<float, 2> ulp_in, urp_in, llp_in, lrp_in;
@@ -768,9 +768,9 @@ private:
 
 
         RSTransformType::Pointer rsTransform = RSTransformType::New();
-        rsTransform->SetInputImageMetadata(&(referencePtr->GetImageMetadata()));
+        rsTransform->SetInputImageMetadata(&(static_cast<const FloatVectorImageType*>(referencePtr.GetPointer())->GetImageMetadata()));
         rsTransform->SetInputProjectionRef(referencePtr->GetProjectionRef());
-        rsTransform->SetOutputImageMetadata(&(inImage->GetImageMetadata()));
+        rsTransform->SetOutputImageMetadata(&(static_cast<const ImageType*>(inImage)->GetImageMetadata()));
         rsTransform->SetOutputProjectionRef(inImage->GetProjectionRef());
         rsTransform->InstantiateTransform();
 
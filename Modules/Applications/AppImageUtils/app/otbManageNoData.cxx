@@ -131,7 +131,7 @@ private:
 
   void DoExecute() override
   {
-    FloatVectorImageType::Pointer inputPtr = this->GetParameterImage("in");
+    FloatVectorImageType::ConstPointer inputPtr = this->GetParameterImage("in");
 
     if (GetParameterString("mode") == "buildmask")
     {
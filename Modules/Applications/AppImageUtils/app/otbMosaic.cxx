@@ -48,6 +48,9 @@
 // danielson distance image
 #include "itkDanielssonDistanceMapImageFilter.h"
 
+// exact distance image
+#include "otbStreamingEuclideanDistanceMapImageFilter.h"
+
 // Interpolators
 #include "itkLinearInterpolateImageFunction.h"
 #include "otbBCOInterpolateImageFunction.h"
@@ -94,6 +97,12 @@ enum
   Harmonisation_Method_rgb
 };
 
+enum
+{
+  DistanceMap_Method_danielsson,
+  DistanceMap_Method_exact
+};
+
 namespace Wrapper
 {
 
@@ -138,6 +147,9 @@ public:
   /* Distance map image writer typedef */
   typedef otb::ImageFileReader<DoubleImageType> DistanceMapImageReaderType;
 
+  /* Exact distance map typedef */
+  typedef otb::StreamingEuclideanDistanceMapImageFilter<UInt8MaskImageType, DoubleImageType> ExactDistanceMapFilterType;
+
   /* Vector data filters typedefs */
   typedef otb::VectorDataIntoImageProjectionFilter<VectorDataType, FloatVectorImageType> VectorDataReprojFilterType;
   typedef otb::VectorDataToLabelImageFilter<VectorDataType, LabelImageType>              RasterizerType;
@@ -367,6 +379,18 @@ private:
                             "or in order to speed up the process");
     SetDefaultParameterFloat("distancemap.sr", 10);
 
+    AddParameter(ParameterType_Choice, "distancemap.method", "Distance maps computation method");
+    SetParameterDescription("distancemap.method", "Set the algorithm used to compute the distance maps");
+    AddChoice("distancemap.method.danielsson", "Danielsson");
+    SetParameterDescription("distancemap.method.danielsson",
+                            "Approximate distance maps computed in memory on sub-sampled masks (see distancemap.sr), "
+                            "written to temporary files");
+    AddChoice("distancemap.method.exact", "Exact");
+    SetParameterDescription("distancemap.method.exact",
+                            "Exact Euclidean distance maps at full resolution. Each mask is streamed once to encode its "
+                            "columns, then the distance maps are computed on the fly by the mosaic pipeline, without "
+                            "temporary files. distancemap.sr is not used.");
+
     // no-data value
     AddParameter(ParameterType_Float, "nodata", "no-data value");
     SetParameterDescription("nodata",
@@ -391,6 +415,23 @@ private:
    * Write a binary mask to disk from a vector data
    */
   void RasterizeBinaryMask(VectorDataType* vd, FloatVectorImageType* reference, string outputFileName, double spacingRatio, bool invert = false)
+  {
+    std::vector<itk::ProcessObject::Pointer> registry;
+
+    // Write file
+    UInt8MaskWriterType::Pointer writer = UInt8MaskWriterType::New();
+    writer->SetInput(CreateRasterizedBinaryMask(vd, reference, spacingRatio, invert, registry));
+    writer->SetFileName(outputFileName);
+    AddProcess(writer, "Writing binary mask (from vector data) " + outputFileName);
+    writer->Update();
+  }
+
+  /*
+   * Create a binary mask from a vector data, and update the registry of
+   * the filters producing it
+   */
+  UInt8MaskImageType* CreateRasterizedBinaryMask(VectorDataType* vd, FloatVectorImageType* reference, double spacingRatio, bool invert,
+                                                 std::vector<itk::ProcessObject::Pointer>& registry)
   {
 
     // Reproject VectorData
@@ -440,12 +481,10 @@ private:
     labelThreshold->SetLowerThreshold(1);
     labelThreshold->SetUpperThreshold(itk::NumericTraits<LabelImageType::InternalPixelType>::max());
 
-    // Write file
-    UInt8MaskWriterType::Pointer writer = UInt8MaskWriterType::New();
-    writer->SetInput(labelThreshold->GetOutput());
-    writer->SetFileName(outputFileName);
-    AddProcess(writer, "Writing binary mask (from vector data) " + outputFileName);
-    writer->Update();
+    registry.push_back(vdReproj.GetPointer());
+    registry.push_back(rasterizer.GetPointer());
+    registry.push_back(labelThreshold.GetPointer());
+    return labelThreshold->GetOutput();
   }
 
   /*
@@ -503,32 +542,21 @@ private:
    */
   void WriteBinaryMask(FloatVectorImageType* referenceImage, string outputFileName, double spacingRatio = 1.0)
   {
-    // Vector image to amplitude image
-    VectorImageToAmplitudeFilterType::Pointer ampFilter = VectorImageToAmplitudeFilterType::New();
-
-    ampFilter->SetInput(referenceImage);
-
-    // Threshold image
-    ImageThresholdFilterType::Pointer thresholdFilter = ImageThresholdFilterType::New();
-    thresholdFilter->SetInput(ampFilter->GetOutput());
-    thresholdFilter->SetOutsideValue(itk::NumericTraits<UInt8MaskImageType::InternalPixelType>::Zero);
-    thresholdFilter->SetInsideValue(itk::NumericTraits<UInt8MaskImageType::InternalPixelType>::max());
-    thresholdFilter->SetLowerThreshold(GetParameterFloat("nodata"));
-    thresholdFilter->SetUpperThreshold(GetParameterFloat("nodata"));
-    thresholdFilter->UpdateOutputInformation();
+    std::vector<itk::ProcessObject::Pointer> registry;
+    UInt8MaskImageType*                      mask = CreateBinaryMask(referenceImage, registry);
 
     // Resample image
     UInt8ResampleImageFilterType::Pointer resampler = UInt8ResampleImageFilterType::New();
-    resampler->SetInput(thresholdFilter->GetOutput());
-    LabelImageType::SizeType outputSize = thresholdFilter->GetOutput()->GetLargestPossibleRegion().GetSize();
+    resampler->SetInput(mask);
+    LabelImageType::SizeType outputSize = mask->GetLargestPossibleRegion().GetSize();
     outputSize[0]                       = outputSize[0] / spacingRatio + 1;
     outputSize[1]                       = outputSize[1] / spacingRatio + 1;
     resampler->SetOutputSize(outputSize);
-    LabelImageType::SpacingType outputSpacing = thresholdFilter->GetOutput()->GetSignedSpacing();
+    LabelImageType::SpacingType outputSpacing = mask->GetSignedSpacing();
     outputSpacing[0] *= spacingRatio;
     outputSpacing[1] *= spacingRatio;
     resampler->SetOutputSpacing(outputSpacing);
-    resampler->SetOutputOrigin(thresholdFilter->GetOutput()->GetOrigin());
+    resampler->SetOutputOrigin(mask->GetOrigin());
 
     // Write image
     UInt8MaskWriterType::Pointer writer = UInt8MaskWriterType::New();
@@ -538,6 +566,31 @@ private:
     writer->Update();
   }
 
+  /*
+   * Create a binary mask from the no-data pixels of an input image, and
+   * update the registry of the filters producing it
+   */
+  UInt8MaskImageType* CreateBinaryMask(FloatVectorImageType* referenceImage, std::vector<itk::ProcessObject::Pointer>& registry)
+  {
+    // Vector image to amplitude image
+    VectorImageToAmplitudeFilterType::Pointer ampFilter = VectorImageToAmplitudeFilterType::New();
+
+    ampFilter->SetInput(referenceImage);
+
+    // Threshold image
+    ImageThresholdFilterType::Pointer thresholdFilter = ImageThresholdFilterType::New();
+    thresholdFilter->SetInput(ampFilter->GetOutput());
+    thresholdFilter->SetOutsideValue(itk::NumericTraits<UInt8MaskImageType::InternalPixelType>::Zero);
+    thresholdFilter->SetInsideValue(itk::NumericTraits<UInt8MaskImageType::InternalPixelType>::max());
+    thresholdFilter->SetLowerThreshold(GetParameterFloat("nodata"));
+    thresholdFilter->SetUpperThreshold(GetParameterFloat("nodata"));
+    thresholdFilter->UpdateOutputInformation();
+
+    registry.push_back(ampFilter.GetPointer());
+    registry.push_back(thresholdFilter.GetPointer());
+    return thresholdFilter->GetOutput();
+  }
+
   /*
    * Write the distance image of the input image #id
    */
@@ -581,6 +634,36 @@ private:
     return outputFileName;
   }
 
+  /*
+   * Create the exact distance map of the input image #id. The binary mask
+   * is streamed once, then the distance map is computed on the fly.
+   */
+  DoubleImageType* CreateExactDistanceMap(unsigned int id)
+  {
+    FloatVectorImageType* image = GetParameterImageList("il")->GetNthElement(id);
+    UInt8MaskImageType*   mask;
+    if (GetParameterByKey("vdcut")->HasValue())
+    {
+      mask = CreateRasterizedBinaryMask(GetParameterVectorDataList("vdcut")->GetNthElement(id), image, 1.0, false, m_DistanceMapMaskFilters);
+    }
+    else // use images boundaries
+    {
+      mask = CreateBinaryMask(image, m_DistanceMapMaskFilters);
+    }
+
+    ExactDistanceMapFilterType::Pointer distanceMapFilter = ExactDistanceMapFilterType::New();
+    distanceMapFilter->SetInput(mask);
+    distanceMapFilter->GetColumnRunsFilter()->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    AddProcess(distanceMapFilter->GetColumnRunsFilter()->GetStreamer(), "Encoding binary mask of image " + std::to_string(id));
+    distanceMapFilter->UpdateOutputInformation();
+    m_ExactDistanceMapFilter.push_back(distanceMapFilter);
+
+    // Prepare image for new data
+    image->PrepareForNewData();
+
+    return distanceMapFilter->GetOutput();
+  }
+
   /*
    * Set the correction model to the mosaic filter
    */
@@ -750,7 +833,8 @@ private:
   {
     filter->UpdateOutputInformation();
     typename TMosaicFilterType::OutputImageSpacingType spacing       = filter->GetOutputSpacing();
-    const float                                        multiplicator = GetParameterFloat("distancemap.sr");
+    const float                                        multiplicator =
+        (GetParameterInt("distancemap.method") == DistanceMap_Method_exact) ? 1.0 : GetParameterFloat("distancemap.sr");
     const float                                        abs_spc_x     = multiplicator * vnl_math_abs(spacing[0]);
     const float                                        abs_spc_y     = multiplicator * vnl_math_abs(spacing[1]);
     const float                                        maxSpacing    = vnl_math_max(abs_spc_x, abs_spc_y);
@@ -859,8 +943,17 @@ private:
     otbAppLogINFO("Computing distance maps");
 
     m_DistanceMapImageReader.clear();
+    m_ExactDistanceMapFilter.clear();
+    m_DistanceMapMaskFilters.clear();
+    m_DistanceMaps.clear();
     for (unsigned int i = 0; i < GetParameterImageList("il")->Size(); i++)
     {
+      if (GetParameterInt("distancemap.method") == DistanceMap_Method_exact)
+      {
+        m_DistanceMaps.push_back(CreateExactDistanceMap(i));
+        continue;
+      }
+
       const string outputFileName = GenerateFileName("tmp_distance_image", i);
       if (GetParameterByKey("vdcut")->HasValue())
       {
@@ -875,6 +968,7 @@ private:
 
       // Instantiate a reader
       DistanceMapImageReaderType::Pointer reader = CreateReader<DistanceMapImageReaderType>(outputFileName, m_DistanceMapImageReader);
+      m_DistanceMaps.push_back(reader->GetOutput());
     }
   }
 
@@ -947,7 +1041,7 @@ private:
       m_LargeFeatherMosaicFilter = LargeFeatherMosaicFilterType::New();
       for (unsigned int i = 0; i < m_SourcesForCompositing->Size(); i++)
       {
-        m_LargeFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), m_DistanceMapImageReader[i]->GetOutput());
+        m_LargeFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), m_DistanceMaps[i]);
       }
       ComputeDistanceOffset<LargeFeatherMosaicFilterType>(m_LargeFeatherMosaicFilter);
       mosaicFilter = static_cast<MosaicFilterType*>(m_LargeFeatherMosaicFilter);
@@ -963,7 +1057,7 @@ private:
       m_SlimFeatherMosaicFilter = SlimFeatherMosaicFilterType::New();
       for (unsigned int i = 0; i < m_SourcesForCompositing->Size(); i++)
       {
-        m_SlimFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), m_DistanceMapImageReader[i]->GetOutput());
+        m_SlimFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), m_DistanceMaps[i]);
       }
       ComputeDistanceOffset<SlimFeatherMosaicFilterType>(m_SlimFeatherMosaicFilter);
 
@@ -1087,6 +1181,13 @@ private:
   // Distance images reader
   vector<DistanceMapImageReaderType::Pointer> m_DistanceMapImageReader;
 
+  // Exact distance images, and filters producing their binary masks
+  vector<ExactDistanceMapFilterType::Pointer> m_ExactDistanceMapFilter;
+  vector<itk::ProcessObject::Pointer>         m_DistanceMapMaskFilters;
+
+  // Distance images used for feathering
+  vector<DoubleImageType::Pointer> m_DistanceMaps;
+
   // Parameters
   string         m_TempFilesPrefix; // Temp. directory
   vector<string> m_TemporaryFiles;  // Temp. filenames for distance images, masks, etc.
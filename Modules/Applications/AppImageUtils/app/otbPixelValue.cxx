@@ -136,8 +136,8 @@ private:
 
   std::string CreateBoundaryBox(const std::string& mode)
   {
-    FloatVectorImageType::Pointer   inImage = GetParameterImage("in");
-    FloatVectorImageType::IndexType min, max;
+    FloatVectorImageType::ConstPointer inImage = GetParameterImage("in");
+    FloatVectorImageType::IndexType    min, max;
     min.Fill(0);
     max[0] = inImage->GetLargestPossibleRegion().GetSize()[0] - 1;
     max[1] = inImage->GetLargestPossibleRegion().GetSize()[1] - 1;
@@ -202,9 +202,9 @@ private:
 
   void DoExecute() override
   {
-    std::string                     mode    = GetParameterString("mode");
-    FloatVectorImageType::Pointer   inImage = GetParameterImage("in");
-    FloatVectorImageType::IndexType id;
+    std::string                        mode    = GetParameterString("mode");
+    FloatVectorImageType::ConstPointer inImage = GetParameterImage("in");
+    FloatVectorImageType::IndexType    id;
     id.Fill(0);
     bool isPixelIn(false);
     if (mode == "index")
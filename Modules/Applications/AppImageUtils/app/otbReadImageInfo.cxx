@@ -263,7 +263,7 @@ private:
   void DoExecute() override
   {
     std::ostringstream            ossOutput;
-    FloatVectorImageType::Pointer inImage = GetParameterImage("in");
+    FloatVectorImageType::ConstPointer inImage = GetParameterImage("in");
 
     ossOutput << std::endl << "Image general information:" << std::endl;
 
@@ -396,7 +396,7 @@ private:
         ossOutput << std::endl << "File: " << m_inImageName << std::endl;
 
         // Check if valid metadata information are available to compute ImageToRadiance and RadianceToReflectance
-        FloatVectorImageType::Pointer          inImage                 = GetParameterFloatVectorImage("in");
+        FloatVectorImageType::ConstPointer     inImage                 = GetParameterFloatVectorImage("in");
         
         const auto & metadata = inImage->GetImageMetadata();
 
@@ -614,7 +614,7 @@ private:
     m_paramAcqui  = AcquiCorrectionParametersType::New();
     m_paramAtmo   = AtmoCorrectionParametersType::New();
 
-    FloatVectorImageType::Pointer inImage = GetParameterFloatVectorImage("in");
+    FloatVectorImageType::ConstPointer inImage = GetParameterFloatVectorImage("in");
 
     const auto & metadata = inImage->GetImageMetadata();
     auto hasOpticalSensorMetadata = HasOpticalSensorMetadata(metadata);
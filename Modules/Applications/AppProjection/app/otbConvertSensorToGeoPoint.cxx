@@ -107,7 +107,7 @@ private:
   void DoExecute() override
   {
     // Get input Image
-    FloatVectorImageType::Pointer inImage = GetParameterImage("in");
+    FloatVectorImageType::ConstPointer inImage = GetParameterImage("in");
 
     // Instantiate a ForwardSensor Model
     ModelType::Pointer model = ModelType::New();
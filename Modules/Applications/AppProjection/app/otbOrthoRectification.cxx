@@ -23,6 +23,7 @@
 
 #include "otbImageToGenericRSOutputParameters.h"
 #include "otbGenericRSResampleImageFilter.h"
+#include "otbFunctorImageFilter.h"
 
 #include "itkLinearInterpolateImageFunction.h"
 #include "otbBCOInterpolateImageFunction.h"
@@ -61,6 +62,41 @@ const float DefaultGridSpacingMeter = 4.0;
 namespace Wrapper
 {
 
+/** Conversions between the deformation grid and the vector image
+ * written or read by the application */
+template <class TDisplacement>
+struct GridToVectorImage
+{
+  itk::VariableLengthVector<double> operator()(const TDisplacement& displacement) const
+  {
+    itk::VariableLengthVector<double> out(TDisplacement::Dimension);
+    for (unsigned int i = 0; i < TDisplacement::Dimension; ++i)
+    {
+      out[i] = displacement[i];
+    }
+    return out;
+  }
+
+  size_t OutputSize(const std::array<size_t, 1>&) const
+  {
+    return TDisplacement::Dimension;
+  }
+};
+
+template <class TDisplacement>
+struct VectorImageToGrid
+{
+  TDisplacement operator()(const itk::VariableLengthVector<double>& in) const
+  {
+    TDisplacement displacement;
+    for (unsigned int i = 0; i < TDisplacement::Dimension; ++i)
+    {
+      displacement[i] = in[i];
+    }
+    return displacement;
+  }
+};
+
 class OrthoRectification : public Application
 {
 public:
@@ -78,6 +114,11 @@ public:
   /** Generic Remote Sensor Resampler */
   typedef otb::GenericRSResampleImageFilter<FloatVectorImageType, FloatVectorImageType> ResampleFilterType;
 
+  /** Deformation grid import/export */
+  typedef ResampleFilterType::DisplacementFieldType::PixelType    DisplacementType;
+  typedef FunctorImageFilter<GridToVectorImage<DisplacementType>> GridExportFilterType;
+  typedef FunctorImageFilter<VectorImageToGrid<DisplacementType>> GridImportFilterType;
+
   /** Interpolators typedefs*/
   typedef itk::LinearInterpolateImageFunction<FloatVectorImageType, double>          LinearInterpolationType;
   typedef itk::NearestNeighborInterpolateImageFunction<FloatVectorImageType, double> NearestNeighborInterpolationType;
@@ -242,6 +283,27 @@ private:
                             "but increasing this parameter will reduce processing time.");
     MandatoryOff("opt.gridspacing");
 
+    // Deformation grid reuse
+    AddParameter(ParameterType_Bool, "opt.gridcache", "Cache the resampling grid");
+    SetParameterDescription("opt.gridcache",
+                            "Compute each node of the deformation grid once for the whole output, "
+                            "instead of once per streaming tile (nodes on tile borders are otherwise computed several times). "
+                            "The whole deformation grid is kept in memory.");
+
+    AddParameter(ParameterType_OutputImage, "opt.gridout", "Output resampling grid");
+    SetParameterDescription("opt.gridout",
+                            "Write the deformation grid, so that it can be reused with opt.gridin to ortho-rectify "
+                            "other bands or pixel types of the same scene with the same output parameters. "
+                            "Each pixel holds the displacement from output to input coordinates.");
+    SetDefaultOutputPixelType("opt.gridout", ImagePixelType_double);
+    MandatoryOff("opt.gridout");
+
+    AddParameter(ParameterType_InputImage, "opt.gridin", "Input resampling grid");
+    SetParameterDescription("opt.gridin",
+                            "Use a deformation grid written by a previous run (opt.gridout) instead of computing it. "
+                            "The grid must have been computed for the same scene, map projection and output parameters.");
+    MandatoryOff("opt.gridin");
+
     // Doc example parameter settings
     SetDocExampleParameterValue("io.in", "QB_TOULOUSE_MUL_Extract_500_500.tif");
     SetDocExampleParameterValue("io.out", "QB_Toulouse_ortho.tif");
@@ -557,7 +619,7 @@ private:
   void DoExecute() override
   {
     // Get the input image
-    FloatVectorImageType* inImage = GetParameterImage("io.in");
+    const FloatVectorImageType* inImage = GetParameterImage("io.in");
 
     // Resampler Instantiation
     m_ResampleFilter = ResampleFilterType::New();
@@ -684,12 +746,46 @@ private:
       m_ResampleFilter->SetDisplacementFieldSpacing(gridSpacing);
     }
 
+    if (GetParameterInt("opt.gridcache"))
+    {
+      otbAppLogINFO("Caching the deformation grid");
+      m_ResampleFilter->DisplacementFieldCachingOn();
+    }
+
+    // Reuse a deformation grid computed by a previous run
+    if (HasValue("opt.gridin"))
+    {
+      DoubleVectorImageType* grid = GetParameterDoubleVectorImage("opt.gridin");
+      if (grid->GetNumberOfComponentsPerPixel() != DisplacementType::Dimension)
+      {
+        otbAppLogFATAL("The input deformation grid must have " << static_cast<unsigned int>(DisplacementType::Dimension) << " bands, got "
+                                                                << grid->GetNumberOfComponentsPerPixel());
+      }
+      otbAppLogINFO("Using the deformation grid " << GetParameterString("opt.gridin"));
+
+      m_GridImportFilter = NewFunctorFilter(VectorImageToGrid<DisplacementType>{});
+      m_GridImportFilter->SetInputs(grid);
+      m_ResampleFilter->SetDisplacementField(m_GridImportFilter->GetOutput());
+    }
+
+    // Export the deformation grid, whose parameters are known once the
+    // output information is up to date
+    if (HasValue("opt.gridout"))
+    {
+      m_ResampleFilter->UpdateOutputInformation();
+      m_GridExportFilter = NewFunctorFilter(GridToVectorImage<DisplacementType>{});
+      m_GridExportFilter->SetInputs(m_ResampleFilter->GetDisplacementField());
+      SetParameterOutputImage("opt.gridout", m_GridExportFilter->GetOutput());
+    }
+
     // Output Image
     SetParameterOutputImage("io.out", m_ResampleFilter->GetOutput());
   }
 
-  ResampleFilterType::Pointer m_ResampleFilter;
-  std::string                 m_OutputProjectionRef;
+  ResampleFilterType::Pointer   m_ResampleFilter;
+  GridImportFilterType::Pointer m_GridImportFilter;
+  GridExportFilterType::Pointer m_GridExportFilter;
+  std::string                   m_OutputProjectionRef;
 };
 
 } // namespace Wrapper
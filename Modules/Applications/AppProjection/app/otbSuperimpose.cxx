@@ -155,12 +155,15 @@ private:
 
   void DoUpdateParameters() override
   {
-    if (!HasUserValue("mode") && HasValue("inr") && HasValue("inm") &&
-        otb::PleiadesPToXSAffineTransformCalculator::CanCompute(GetParameterImage("inr")->GetImageMetadata(), 
-                                                                GetParameterImage("inm")->GetImageMetadata()))
+    if (!HasUserValue("mode") && HasValue("inr") && HasValue("inm"))
     {
-      otbAppLogWARNING("Forcing PHR mode with PHR data. You need to add \"-mode default\" to force the default mode with PHR images.");
-      SetParameterString("mode", "phr");
+      const FloatVectorImageType* refImage    = GetParameterImage("inr");
+      const FloatVectorImageType* movingImage = GetParameterImage("inm");
+      if (otb::PleiadesPToXSAffineTransformCalculator::CanCompute(refImage->GetImageMetadata(), movingImage->GetImageMetadata()))
+      {
+        otbAppLogWARNING("Forcing PHR mode with PHR data. You need to add \"-mode default\" to force the default mode with PHR images.");
+        SetParameterString("mode", "phr");
+      }
     }
   }
 
@@ -168,8 +171,8 @@ private:
   void DoExecute() override
   {
     // Get the inputs
-    FloatVectorImageType* refImage    = GetParameterImage("inr");
-    FloatVectorImageType* movingImage = GetParameterImage("inm");
+    const FloatVectorImageType* refImage    = GetParameterImage("inr");
+    const FloatVectorImageType* movingImage = GetParameterImage("inm");
 
     // Resample filter
     m_Resampler = ResamplerType::New();
@@ -275,8 +278,7 @@ private:
       otbAppLogINFO("Using the PHR mode");
 
       otb::PleiadesPToXSAffineTransformCalculator::TransformType::OffsetType offset =
-          otb::PleiadesPToXSAffineTransformCalculator::ComputeOffset(GetParameterImage("inr")->GetImageMetadata(), 
-                                                                     GetParameterImage("inm")->GetImageMetadata());
+          otb::PleiadesPToXSAffineTransformCalculator::ComputeOffset(refImage->GetImageMetadata(), movingImage->GetImageMetadata());
 
       m_BasicResampler->SetInput(movingImage);
       origin += offset;
@@ -133,14 +133,14 @@ private:
 
     if (HasValue("in.kwl"))
     {
-      FloatVectorImageType::Pointer inImage = GetParameterFloatVectorImage("in.kwl");
+      FloatVectorImageType::ConstPointer inImage = GetParameterFloatVectorImage("in.kwl");
       m_GeometriesProjFilter->SetInputImageMetadata(&(inImage->GetImageMetadata()));
       // otbAppLogINFO(<<"kwl."<<std::endl);
     }
 
     if (GetParameterInt("out.proj") == 0)
     {
-      FloatVectorImageType::Pointer outImage = GetParameterFloatVectorImage("out.proj.image.in");
+      FloatVectorImageType::ConstPointer outImage = GetParameterFloatVectorImage("out.proj.image.in");
 
       if (outImage)
       {
@@ -31,6 +31,7 @@ otb_module(OTBAppProjection
     OTBApplicationEngine
     OTBMathParser
     OTBCommon
+    OTBFunctor
     OTBInterpolation
     OTBGDAL
     OTBITK
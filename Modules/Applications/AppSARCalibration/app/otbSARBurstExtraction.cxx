@@ -113,7 +113,7 @@ private:
   void DoExecute() override
   {
     // Get the input complex image
-    FloatVectorImageType* in = GetParameterImage("in");
+    const FloatVectorImageType* in = GetParameterImage("in");
 
     // Get the Burst index
     int burst_index = GetParameterInt("burstindex"); // If -1 or > nb_Bursts => all bursts will be extracted
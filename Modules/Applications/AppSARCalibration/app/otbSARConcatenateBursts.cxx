@@ -113,6 +113,7 @@ private:
     // Get the input complex image
     FloatVectorImageType* in = GetParameterImage("insar");
     in->UpdateOutputInformation();
+    const otb::ImageMetadata& inImd = static_cast<const FloatVectorImageType*>(in)->GetImageMetadata();
 
     std::vector<std::pair<unsigned long, unsigned long>> lines;
     std::vector<std::pair<unsigned long, unsigned long>> samples;
@@ -121,7 +122,7 @@ private:
     unsigned int nbBursts = 1;
     try
     {
-      nbBursts = boost::any_cast<const otb::SARParam&>(in->GetImageMetadata()[otb::MDGeom::SAR]).burstRecords.size();
+      nbBursts = boost::any_cast<const otb::SARParam&>(inImd[otb::MDGeom::SAR]).burstRecords.size();
     }
     catch (...)
     {
@@ -137,12 +138,12 @@ private:
   }*/
 
     // Coniguration for fusion filter
-    fusionFilter->SetSLCImageMetadata(in->GetImageMetadata());
+    fusionFilter->SetSLCImageMetadata(inImd);
     // Get Invalid pixel Key (from Image 0)
     FloatVectorImageType::Pointer Im0 = inList->GetNthElement(0);
     Im0->UpdateOutputInformation();
 
-    auto const & imd = Im0->GetImageMetadata();
+    auto const & imd = static_cast<const FloatVectorImageType*>(Im0.GetPointer())->GetImageMetadata();
     const bool inputWithInvalidPixels = imd.Has("invalid_pixels") && imd["invalid_pixels"] == "yes";
 
     fusionFilter->getDeburstLinesAndSamples(lines, samples, burst_index, inputWithInvalidPixels);
@@ -154,8 +155,8 @@ private:
       vectIm->UpdateOutputInformation();
 
       // Check invalid Pixel Key
-      const bool inputWithInvalidPixels_loop = vectIm->GetImageMetadata().Has("invalid_pixels") &&
-                                               vectIm->GetImageMetadata()["support_data.invalid_pixels"] == "yes";
+      auto const & vectImd                   = static_cast<const FloatVectorImageType*>(vectIm.GetPointer())->GetImageMetadata();
+      const bool   inputWithInvalidPixels_loop = vectImd.Has("invalid_pixels") && vectImd["support_data.invalid_pixels"] == "yes";
 
       if (inputWithInvalidPixels_loop != inputWithInvalidPixels)
       {
@@ -136,7 +136,7 @@ private:
 
   void DoExecute() override
   {
-    InputVectorImageType::Pointer inputImage = GetParameterImage("in");
+    InputVectorImageType::ConstPointer inputImage = GetParameterImage("in");
 
     m_Connected = SegmentationFilterType::FilterType::New();
     m_Connected->GetFilter()->SetInput(inputImage);
@@ -294,6 +294,11 @@ private:
     SetParameterDescription("mode.vector.stitch", "Scan polygons on each side of tiles and stitch polygons which connect by more than one pixel.");
     SetParameterInt("mode.vector.stitch", 1);
 
+    AddParameter(ParameterType_Bool, "mode.vector.borderstitch", "Stitch polygons from border pixels");
+    SetParameterDescription("mode.vector.borderstitch",
+                            "Measure the border shared by the polygons on each side of the tiles from the pixels they cover, instead of testing the "
+                            "intersections of every pair of polygons. The polygons are stitched the same way. This is much faster on large images.");
+
     AddParameter(ParameterType_Int, "mode.vector.minsize", "Minimum object size");
     SetParameterDescription("mode.vector.minsize",
                             "Objects whose size is below the minimum object size (area in pixels) will be ignored during vectorization.");
@@ -467,7 +472,8 @@ private:
 
     std::vector<bool>        noDataFlags;
     std::vector<double>      noDataValues;
-    const auto & imd = GetParameterFloatVectorImage("in")->GetImageMetadata();
+    const FloatVectorImageType* inImage = GetParameterFloatVectorImage("in");
+    const auto & imd = inImage->GetImageMetadata();
     bool                     ret  = otb::ReadNoDataFlags(imd, noDataFlags, noDataValues);
 
     if (ret)
@@ -669,6 +675,7 @@ private:
         fusionFilter->SetInput(GetParameterFloatVectorImage("in"));
         fusionFilter->SetOGRLayer(layer);
         fusionFilter->SetStreamSize(streamSize);
+        fusionFilter->SetBorderLabelStitching(GetParameterInt("mode.vector.borderstitch"));
 
         AddProcess(fusionFilter, "Stitching polygons");
         fusionFilter->GenerateData();
@@ -270,6 +270,13 @@ private:
     SetDefaultParameterInt("bm.radius", 3);
     SetMinimumParameterIntValue("bm.radius", 1);
 
+    AddParameter(ParameterType_Bool, "bm.boxfilter", "Box-filtered metric");
+    SetParameterDescription("bm.boxfilter",
+                            "Compute the SSD and NCC metrics with box filters, so that the "
+                            "computation time does not depend on the radius. Results may differ "
+                            "from the default computation by floating-point rounding. This option "
+                            "has no effect on the other metrics.");
+
     AddParameter(ParameterType_Int, "bm.minhd", "Minimum horizontal disparity");
     SetParameterDescription("bm.minhd", "Minimum horizontal disparity to explore (can be negative)");
 
@@ -628,6 +635,7 @@ private:
       m_SSDBlockMatcher->SetRightInput(rightImage);
       m_SSDBlockMatcher->SetRadius(radius);
       m_SSDBlockMatcher->SetStep(step);
+      m_SSDBlockMatcher->SetBoxFiltering(GetParameterInt("bm.boxfilter"));
       m_SSDBlockMatcher->SetGridIndex(gridIndex);
       m_SSDBlockMatcher->SetMinimumHorizontalDisparity(minhdisp);
       m_SSDBlockMatcher->SetMaximumHorizontalDisparity(maxhdisp);
@@ -698,6 +706,7 @@ private:
       m_NCCBlockMatcher->SetRightInput(rightImage);
       m_NCCBlockMatcher->SetRadius(radius);
       m_NCCBlockMatcher->SetStep(step);
+      m_NCCBlockMatcher->SetBoxFiltering(GetParameterInt("bm.boxfilter"));
       m_NCCBlockMatcher->SetGridIndex(gridIndex);
       m_NCCBlockMatcher->SetMinimumHorizontalDisparity(minhdisp);
       m_NCCBlockMatcher->SetMaximumHorizontalDisparity(maxhdisp);
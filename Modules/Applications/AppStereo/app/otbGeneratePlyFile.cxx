@@ -165,7 +165,7 @@ private:
     }
 
     rsTransform->SetOutputProjectionRef(colorPtr->GetProjectionRef());
-    rsTransform->SetOutputImageMetadata(&(colorPtr->GetImageMetadata()));
+    rsTransform->SetOutputImageMetadata(&(static_cast<const FloatVectorImageType*>(colorPtr.GetPointer())->GetImageMetadata()));
     rsTransform->InstantiateTransform();
     toMap->InstantiateTransform();
 
@@ -465,6 +465,13 @@ private:
     SetMinimumParameterIntValue("bm.radius", 1);
     MandatoryOff("bm.radius");
 
+    AddParameter(ParameterType_Bool, "bm.boxfilter", "Box-filtered metric");
+    SetParameterDescription("bm.boxfilter",
+                            "Compute the SSD and NCC metrics with box filters, so that the "
+                            "computation time does not depend on the radius. Results may differ "
+                            "from the default computation by floating-point rounding. This option "
+                            "has no effect on the other metrics.");
+
     AddParameter(ParameterType_Float, "bm.minhoffset", "Minimum altitude offset (in meters)");
     SetParameterDescription("bm.minhoffset",
                             "Minimum altitude below the "
@@ -576,6 +583,7 @@ private:
     blockMatcherFilter->SetLeftMaskInput(leftMask);
     blockMatcherFilter->SetRightMaskInput(rightMask);
     blockMatcherFilter->SetRadius(this->GetParameterInt("bm.radius"));
+    blockMatcherFilter->SetBoxFiltering(this->GetParameterInt("bm.boxfilter"));
     blockMatcherFilter->SetMinimumHorizontalDisparity(minDisp);
     blockMatcherFilter->SetMaximumHorizontalDisparity(maxDisp);
     blockMatcherFilter->SetMinimumVerticalDisparity(0);
@@ -595,6 +603,7 @@ private:
       invBlockMatcherFilter->SetLeftMaskInput(rightMask);
       invBlockMatcherFilter->SetRightMaskInput(leftMask);
       invBlockMatcherFilter->SetRadius(this->GetParameterInt("bm.radius"));
+      invBlockMatcherFilter->SetBoxFiltering(this->GetParameterInt("bm.boxfilter"));
       invBlockMatcherFilter->SetMinimumHorizontalDisparity(-maxDisp);
       invBlockMatcherFilter->SetMaximumHorizontalDisparity(-minDisp);
       invBlockMatcherFilter->SetMinimumVerticalDisparity(0);
@@ -1138,11 +1147,11 @@ private:
       }
 
       // transform disparity into 3D map
-      m_MultiDisparityTo3DFilterList[i]->SetReferenceImageMetadata(&(inleft->GetImageMetadata()));
+      m_MultiDisparityTo3DFilterList[i]->SetReferenceImageMetadata(&(static_cast<const FloatImageType*>(inleft.GetPointer())->GetImageMetadata()));
       m_MultiDisparityTo3DFilterList[i]->SetNumberOfMovingImages(1);
       m_MultiDisparityTo3DFilterList[i]->SetHorizontalDisparityMapInput(0, hDispOutput2);
       m_MultiDisparityTo3DFilterList[i]->SetVerticalDisparityMapInput(0, vDispOutput2);
-      m_MultiDisparityTo3DFilterList[i]->SetMovingImageMetadata(0, &(inright->GetImageMetadata()));
+      m_MultiDisparityTo3DFilterList[i]->SetMovingImageMetadata(0, &(static_cast<const FloatImageType*>(inright.GetPointer())->GetImageMetadata()));
       m_MultiDisparityTo3DFilterList[i]->SetDisparityMaskInput(0, translatedMaskImage);
       m_MultiDisparityTo3DFilterList[i]->UpdateOutputInformation();
 
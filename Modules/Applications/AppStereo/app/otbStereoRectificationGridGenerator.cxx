@@ -303,7 +303,8 @@ private:
       m_DEMToImageGenerator->SetOutputSize(size);
       m_DEMToImageGenerator->SetOutputSpacing(spacing);
       m_DEMToImageGenerator->SetOutputProjectionRef(GetParameterImage("io.inleft")->GetProjectionRef());
-      m_DEMToImageGenerator->SetOutputImageMetadata(&(GetParameterImage("io.inleft")->GetImageMetadata()));
+      const FloatVectorImageType* inLeft = GetParameterImage("io.inleft");
+      m_DEMToImageGenerator->SetOutputImageMetadata(&(inLeft->GetImageMetadata()));
       m_DEMToImageGenerator->AboveEllipsoidOn();
 
       m_StatisticsFilter->SetInput(m_DEMToImageGenerator->GetOutput());
@@ -162,6 +162,13 @@ private:
     SetParameterDescription("parameters.nbbin", "Histogram number of bin");
     SetDefaultParameterInt("parameters.nbbin", 8);
 
+    AddParameter(ParameterType_Bool, "parameters.sliding", "Sliding window co-occurrence");
+    SetParameterDescription("parameters.sliding",
+                            "Update the co-occurrence list incrementally between neighbouring "
+                            "pixels instead of rebuilding it for each window. This is faster for "
+                            "large radii, but results may differ from the default mode by "
+                            "floating-point rounding. Not used by the higher order texture set.");
+
     AddParameter(ParameterType_Choice, "texture", "Texture Set Selection");
     SetParameterDescription("texture", "Choice of The Texture Set");
 
@@ -281,6 +288,7 @@ private:
       m_HarTexFilter->SetNumberOfBinsPerAxis(GetParameterInt("parameters.nbbin"));
       m_HarTexFilter->SetSubsampleFactor(stepping);
       m_HarTexFilter->SetSubsampleOffset(stepOffset);
+      m_HarTexFilter->SetSlidingWindow(GetParameterInt("parameters.sliding"));
       m_HarTexFilter->UpdateOutputInformation();
       m_HarImageList->PushBack(m_HarTexFilter->GetEnergyOutput());
       m_HarImageList->PushBack(m_HarTexFilter->GetEntropyOutput());
@@ -304,6 +312,7 @@ private:
       m_AdvTexFilter->SetNumberOfBinsPerAxis(GetParameterInt("parameters.nbbin"));
       m_AdvTexFilter->SetSubsampleFactor(stepping);
       m_AdvTexFilter->SetSubsampleOffset(stepOffset);
+      m_AdvTexFilter->SetSlidingWindow(GetParameterInt("parameters.sliding"));
       m_AdvImageList->PushBack(m_AdvTexFilter->GetMeanOutput());
       m_AdvImageList->PushBack(m_AdvTexFilter->GetVarianceOutput());
       m_AdvImageList->PushBack(m_AdvTexFilter->GetDissimilarityOutput());
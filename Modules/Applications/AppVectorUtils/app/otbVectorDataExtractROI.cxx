@@ -115,7 +115,7 @@ private:
   {
     // Get the inputs
     VectorDataType*       vd      = GetParameterVectorData("io.vd");
-    FloatVectorImageType* inImage = GetParameterImage("io.in");
+    const FloatVectorImageType* inImage = GetParameterImage("io.in");
 
     // Extracting the VectorData
     m_VdExtract = VectorDataExtractROIType::New();
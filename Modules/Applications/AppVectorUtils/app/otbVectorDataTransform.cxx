@@ -139,7 +139,7 @@ private:
   void DoExecute() override
   {
     // Get the support image
-    FloatVectorImageType* inImage = GetParameterImage("in");
+    const FloatVectorImageType* inImage = GetParameterImage("in");
 
     // Get the VectorData to apply the transform on
     VectorDataType* vd = GetParameterVectorData("vd");
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbAsynchronousTaskQueue_h
+#define otbAsynchronousTaskQueue_h
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "OTBCommonExport.h"
+
+namespace otb
+{
+
+/** \class AsynchronousTaskQueue
+ * \brief Bounded FIFO of tasks executed by a single background thread.
+ *
+ * Tasks are executed in the order they were pushed, one at a time, by a
+ * worker thread owned by the queue. At most MaxPendingTasks tasks (queued
+ * or running) are held at once: Push() blocks until a slot is available,
+ * which bounds the memory held by the tasks.
+ *
+ * If a task throws, the exception is stored, the remaining tasks are
+ * discarded and the exception is rethrown by the next call to Push() or
+ * Wait().
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT AsynchronousTaskQueue final
+{
+public:
+  /** Standard class typedefs. */
+  typedef AsynchronousTaskQueue Self;
+
+  typedef std::function<void()> TaskType;
+
+  /** Constructs a queue and starts its worker thread. A maxPendingTasks
+   * value of 0 is treated as 1. */
+  explicit AsynchronousTaskQueue(std::size_t maxPendingTasks = 1);
+
+  /** Executes the remaining tasks, then stops the worker thread. Errors
+   * not yet reported are discarded. */
+  ~AsynchronousTaskQueue();
+
+  AsynchronousTaskQueue(const Self&) = delete;
+  Self& operator=(const Self&) = delete;
+
+  /** Queue a task, blocking while MaxPendingTasks tasks are pending.
+   * Rethrows the error of a previously failed task, if any. */
+  void Push(TaskType task);
+
+  /** Block until a task can be pushed without waiting. Lets the caller
+   * allocate the resources of its next task only once they can be queued.
+   * Rethrows the error of a previously failed task, if any. */
+  void WaitForSlot();
+
+  /** Block until all pushed tasks are done. Rethrows the error of a
+   * failed task, if any. */
+  void Wait();
+
+  /** Get the maximum number of tasks queued or running at once */
+  std::size_t GetMaxPendingTasks() const;
+
+  /** Get the number of tasks queued or running */
+  std::size_t GetNumberOfPendingTasks() const;
+
+private:
+  void Run();
+
+  void RethrowError();
+
+  mutable std::mutex      m_Mutex;
+  std::condition_variable m_TaskAvailable;
+  std::condition_variable m_TaskDone;
+  std::deque<TaskType>    m_Tasks;
+  std::size_t             m_MaxPendingTasks;
+  std::size_t             m_NumberOfPendingTasks;
+  std::exception_ptr      m_Error;
+  bool                    m_Stop;
+  std::thread             m_Worker;
+};
+
+} // namespace otb
+
+#endif
@@ -112,6 +112,29 @@ public:
    */
   static int InitOpenMPThreads();
 
+  /**
+   * ThreadAffinity tells whether the workers of the OTB thread pool
+   * are pinned to CPUs, one NUMA node after the other.
+   *
+   * If environment variable OTB_THREAD_AFFINITY is set to ON, TRUE or
+   * 1, returns true. Else returns false.
+   */
+  static bool GetThreadAffinity();
+
+  /**
+   * Size the thread pools of ITK, OTB, OpenMP and GDAL from the ITK
+   * global default number of threads N:
+   * - ITK filters run on the N persistent threads of the ITK thread
+   *   pool instead of spawning threads for each piece,
+   * - the OTB ThreadPool is started with N workers,
+   * - OpenMP is set up with N threads, as with InitOpenMPThreads(),
+   * - a GDAL_NUM_THREADS value of ALL_CPUS is replaced by N.
+   * The pools are distinct, so up to 3N threads (ITK pool, OTB pool
+   * and OpenMP) can exist at the same time; only the threads of the
+   * pools actually used are busy. Returns N.
+   */
+  static int InitThreads();
+
 private:
   ConfigurationManager()                            = delete;
   ~ConfigurationManager()                           = delete;
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMemoryMappedFile_h
+#define otbMemoryMappedFile_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "OTBCommonExport.h"
+
+namespace otb
+{
+
+/** \class MemoryMappedFile
+ * \brief Private, copy-on-write memory mapping of a part of a file.
+ *
+ * The bytes [offset, offset + length) of the file are mapped in memory
+ * when the object is constructed, and unmapped when it is destroyed.
+ * The offset does not need to be aligned on a page boundary.
+ *
+ * Pages are loaded by the operating system on first access, which
+ * avoids any intermediate copy. The mapping is private: the mapped
+ * memory can be modified, but the modified pages are copied and the
+ * file is never altered.
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT MemoryMappedFile final
+{
+public:
+  /** Standard class typedefs. */
+  typedef MemoryMappedFile Self;
+
+  /** Map a part of a file. Throws an itk::ExceptionObject if the file
+   * cannot be opened or mapped. */
+  MemoryMappedFile(const std::string& fileName, std::uint64_t offset, std::size_t length);
+
+  /** Unmap the file */
+  ~MemoryMappedFile();
+
+  MemoryMappedFile(const Self&) = delete;
+  Self& operator=(const Self&) = delete;
+
+  /** Get the address of the byte at the requested offset */
+  char* GetData() const
+  {
+    return m_Data;
+  }
+
+  /** Get the number of bytes mapped from the requested offset */
+  std::size_t GetLength() const
+  {
+    return m_Length;
+  }
+
+private:
+  void*       m_Address;
+  std::size_t m_MappedLength;
+  char*       m_Data;
+  std::size_t m_Length;
+#if defined(_WIN32)
+  void* m_Mapping;
+#endif
+};
+
+} // namespace otb
+
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbThreadPool_h
+#define otbThreadPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "OTBCommonExport.h"
+
+namespace otb
+{
+
+/** \class ThreadPool
+ * \brief Persistent pool of worker threads with work-stealing queues.
+ *
+ * Each worker owns a queue of tasks. A worker runs the tasks of its own
+ * queue in LIFO order, which keeps recently produced data in its
+ * caches, and steals the oldest tasks of the other queues when its own
+ * queue is empty. Tasks submitted from outside the pool are spread over
+ * the queues in a round-robin fashion.
+ *
+ * ParallelFor() splits a range of indices in chunks run by the workers.
+ * The calling thread takes part in the computation and runs pending
+ * tasks while it waits, so that ParallelFor() can be nested, or called
+ * from a worker, without deadlock.
+ *
+ * When the workers are pinned, they are bound to the CPUs available to
+ * the process, filling one NUMA node after the other, so that
+ * neighbouring chunks tend to run on the same node (Linux only, ignored
+ * elsewhere).
+ *
+ * The instance shared by OTB is returned by GetInstance(). Its number of
+ * workers and pinning are read from the ConfigurationManager when it is
+ * first used.
+ *
+ * \sa ConfigurationManager::InitThreads()
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT ThreadPool final
+{
+public:
+  /** Standard class typedefs. */
+  typedef ThreadPool Self;
+
+  typedef std::function<void(std::size_t, std::size_t)> RangeFunctionType;
+
+  /** Constructs a pool and starts its workers. A numberOfThreads value
+   * of 0 is treated as the number of hardware threads. */
+  explicit ThreadPool(std::size_t numberOfThreads = 0, bool pinWorkers = false);
+
+  /** Executes the remaining tasks, then stops the workers. */
+  ~ThreadPool();
+
+  ThreadPool(const Self&) = delete;
+  Self& operator=(const Self&) = delete;
+
+  /** Get the pool shared by OTB */
+  static ThreadPool& GetInstance();
+
+  /** Run function(chunkBegin, chunkEnd) over the chunks of at most
+   * grainSize indices of [begin, end[, and block until all the chunks
+   * are done. A grainSize of 0 gives about four chunks per thread. If a
+   * chunk throws, the chunks not yet started are skipped and the first
+   * exception is rethrown. */
+  void ParallelFor(std::size_t begin, std::size_t end, const RangeFunctionType& function, std::size_t grainSize = 0);
+
+  /** Get the number of workers */
+  std::size_t GetNumberOfThreads() const;
+
+  /** Get whether the workers are pinned to CPUs */
+  bool GetPinWorkers() const;
+
+private:
+  typedef std::function<void()> TaskType;
+
+  /** Queue of tasks of a worker */
+  struct TaskQueue
+  {
+    std::mutex           Mutex;
+    std::deque<TaskType> Tasks;
+  };
+
+  /** Push a task in the queue of the calling worker, or in the next
+   * queue when called from outside the pool */
+  void Submit(TaskType task);
+
+  /** Pop a task from the queue of the worker, or steal one from the
+   * other queues. workerId is the number of workers for threads outside
+   * the pool. */
+  bool TryPop(std::size_t workerId, TaskType& task);
+
+  /** Run one pending task, if any, from the calling thread */
+  bool RunPendingTask();
+
+  void Run(std::size_t workerId);
+
+  void PinWorker(std::size_t workerId);
+
+  std::vector<std::unique_ptr<TaskQueue>> m_Queues;
+  std::vector<std::thread>                m_Workers;
+  std::vector<int>                        m_Cpus;
+  bool                                    m_PinWorkers;
+  std::atomic<std::size_t>                m_NextQueue;
+  std::atomic<std::size_t>                m_NumberOfPendingTasks;
+  std::mutex                              m_SleepMutex;
+  std::condition_variable                 m_TaskAvailable;
+  bool                                    m_Stop;
+};
+
+} // namespace otb
+
+#endif
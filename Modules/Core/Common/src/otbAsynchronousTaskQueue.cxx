@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include "otbAsynchronousTaskQueue.h"
+
+namespace otb
+{
+
+AsynchronousTaskQueue::AsynchronousTaskQueue(std::size_t maxPendingTasks)
+  : m_MaxPendingTasks(std::max<std::size_t>(maxPendingTasks, 1)), m_NumberOfPendingTasks(0), m_Error(), m_Stop(false)
+{
+  // Start the worker once all members are initialized
+  m_Worker = std::thread(&Self::Run, this);
+}
+
+AsynchronousTaskQueue::~AsynchronousTaskQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_TaskAvailable.notify_all();
+  m_Worker.join();
+}
+
+void AsynchronousTaskQueue::Push(TaskType task)
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_TaskDone.wait(lock, [this] { return m_Error || m_NumberOfPendingTasks < m_MaxPendingTasks; });
+  this->RethrowError();
+
+  m_Tasks.push_back(std::move(task));
+  ++m_NumberOfPendingTasks;
+  lock.unlock();
+  m_TaskAvailable.notify_one();
+}
+
+void AsynchronousTaskQueue::WaitForSlot()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_TaskDone.wait(lock, [this] { return m_Error || m_NumberOfPendingTasks < m_MaxPendingTasks; });
+  this->RethrowError();
+}
+
+void AsynchronousTaskQueue::Wait()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_TaskDone.wait(lock, [this] { return m_NumberOfPendingTasks == 0; });
+  this->RethrowError();
+}
+
+std::size_t AsynchronousTaskQueue::GetMaxPendingTasks() const
+{
+  return m_MaxPendingTasks;
+}
+
+std::size_t AsynchronousTaskQueue::GetNumberOfPendingTasks() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfPendingTasks;
+}
+
+void AsynchronousTaskQueue::RethrowError()
+{
+  // Must be called with m_Mutex held. The error is reported only once.
+  if (m_Error)
+  {
+    std::exception_ptr error = m_Error;
+    m_Error                  = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void AsynchronousTaskQueue::Run()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  while (true)
+  {
+    m_TaskAvailable.wait(lock, [this] { return m_Stop || !m_Tasks.empty(); });
+    if (m_Tasks.empty())
+    {
+      // m_Stop is set and there is nothing left to do
+      return;
+    }
+
+    TaskType task = std::move(m_Tasks.front());
+    m_Tasks.pop_front();
+    lock.unlock();
+
+    std::exception_ptr error;
+    try
+    {
+      task();
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    // Release the resources held by the task before freeing its slot
+    task = nullptr;
+
+    lock.lock();
+    --m_NumberOfPendingTasks;
+    if (error)
+    {
+      m_Error = error;
+      // Following tasks may depend on the failed one: drop them
+      m_NumberOfPendingTasks -= m_Tasks.size();
+      m_Tasks.clear();
+    }
+    m_TaskDone.notify_all();
+  }
+}
+
+} // namespace otb
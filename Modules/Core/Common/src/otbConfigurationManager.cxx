@@ -22,14 +22,18 @@
 
 #include "otbMacro.h"
 #include "otbLogger.h"
+#include "otbThreadPool.h"
 
 #include "itkMultiThreader.h"
 #include "itksys/SystemTools.hxx"
 
+#include "cpl_conv.h"
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+#include <cctype>
 #include <cstdlib>
 #include <algorithm>
 #include <string>
@@ -114,4 +118,32 @@ int ConfigurationManager::InitOpenMPThreads()
 #endif
   return ret;
 }
+
+bool ConfigurationManager::GetThreadAffinity()
+{
+  std::string svalue;
+  itksys::SystemTools::GetEnv("OTB_THREAD_AFFINITY", svalue);
+  std::transform(svalue.begin(), svalue.end(), svalue.begin(), ::toupper);
+  return svalue == "ON" || svalue == "TRUE" || svalue == "1";
+}
+
+int ConfigurationManager::InitThreads()
+{
+  const int nbThreads = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+
+  itk::MultiThreader::SetGlobalDefaultUseThreadPool(true);
+
+  ThreadPool& pool = ThreadPool::GetInstance();
+  otbLogMacro(Debug, << "OTB thread pool started with " << pool.GetNumberOfThreads() << " workers" << (pool.GetPinWorkers() ? " pinned to CPUs" : ""));
+
+  InitOpenMPThreads();
+
+  const char* gdalThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+  if (gdalThreads != nullptr && std::string(gdalThreads) == "ALL_CPUS")
+  {
+    CPLSetConfigOption("GDAL_NUM_THREADS", std::to_string(nbThreads).c_str());
+  }
+
+  return nbThreads;
+}
 }
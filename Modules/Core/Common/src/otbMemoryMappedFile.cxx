@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMemoryMappedFile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+
+#include "itkMacro.h"
+
+namespace otb
+{
+
+MemoryMappedFile::MemoryMappedFile(const std::string& fileName, std::uint64_t offset, std::size_t length)
+  : m_Address(nullptr), m_MappedLength(0), m_Data(nullptr), m_Length(length)
+{
+  if (length == 0)
+  {
+    itkGenericExceptionMacro(<< "Cannot map an empty part of file " << fileName);
+  }
+
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const std::uint64_t alignedOffset = offset - offset % info.dwAllocationGranularity;
+
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    itkGenericExceptionMacro(<< "Cannot open file " << fileName << " for memory mapping");
+  }
+  m_Mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (m_Mapping == nullptr)
+  {
+    itkGenericExceptionMacro(<< "Cannot map file " << fileName);
+  }
+
+  m_MappedLength = static_cast<std::size_t>(offset - alignedOffset) + length;
+  const DWORD offsetHigh = static_cast<DWORD>(alignedOffset >> 32);
+  const DWORD offsetLow  = static_cast<DWORD>(alignedOffset & 0xFFFFFFFF);
+  m_Address              = MapViewOfFile(m_Mapping, FILE_MAP_COPY, offsetHigh, offsetLow, m_MappedLength);
+  if (m_Address == nullptr)
+  {
+    CloseHandle(m_Mapping);
+    itkGenericExceptionMacro(<< "Cannot map " << length << " bytes at offset " << offset << " of file " << fileName);
+  }
+#else
+  const std::uint64_t pageSize      = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+  const std::uint64_t alignedOffset = offset - offset % pageSize;
+
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    itkGenericExceptionMacro(<< "Cannot open file " << fileName << " for memory mapping: " << std::strerror(errno));
+  }
+
+  m_MappedLength = static_cast<std::size_t>(offset - alignedOffset) + length;
+  void* address  = mmap(nullptr, m_MappedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(alignedOffset));
+  // The mapping keeps its own reference on the file
+  close(fd);
+  if (address == MAP_FAILED)
+  {
+    itkGenericExceptionMacro(<< "Cannot map " << length << " bytes at offset " << offset << " of file " << fileName << ": " << std::strerror(errno));
+  }
+  m_Address = address;
+#endif
+
+  m_Data = static_cast<char*>(m_Address) + (offset - alignedOffset);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#if defined(_WIN32)
+  UnmapViewOfFile(m_Address);
+  CloseHandle(m_Mapping);
+#else
+  munmap(m_Address, m_MappedLength);
+#endif
+}
+
+} // namespace otb
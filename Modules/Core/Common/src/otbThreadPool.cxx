@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbThreadPool.h"
+
+#include "otbConfigurationManager.h"
+#include "itkMultiThreader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace otb
+{
+
+namespace
+{
+// Pool and queue of the worker running on the current thread, if any
+thread_local const ThreadPool* currentPool   = nullptr;
+thread_local std::size_t       currentWorker = 0;
+
+#ifdef __linux__
+// Parse a Linux CPU list, such as "0-3,8-11"
+std::vector<int> ParseCpuList(const std::string& cpuList)
+{
+  std::vector<int>   cpus;
+  std::istringstream stream(cpuList);
+  std::string        range;
+  while (std::getline(stream, range, ','))
+  {
+    const std::size_t dash = range.find('-');
+    try
+    {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; ++cpu)
+      {
+        cpus.push_back(cpu);
+      }
+    }
+    catch (std::exception&)
+    {
+      // Ignore malformed ranges
+    }
+  }
+  return cpus;
+}
+
+// CPUs available to the process, sorted by NUMA node
+std::vector<int> GetCpusByNode()
+{
+  std::vector<int> cpus;
+  cpu_set_t        cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+  {
+    return cpus;
+  }
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &cpuSet))
+    {
+      cpus.push_back(cpu);
+    }
+  }
+
+  std::map<int, int> nodeOfCpu;
+  for (int node = 0; node < 1024; ++node)
+  {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string   cpuList;
+    if (file && std::getline(file, cpuList))
+    {
+      for (int cpu : ParseCpuList(cpuList))
+      {
+        nodeOfCpu[cpu] = node;
+      }
+    }
+  }
+  std::stable_sort(cpus.begin(), cpus.end(), [&nodeOfCpu](int a, int b) { return nodeOfCpu[a] < nodeOfCpu[b]; });
+  return cpus;
+}
+#endif
+}
+
+ThreadPool::ThreadPool(std::size_t numberOfThreads, bool pinWorkers)
+  : m_PinWorkers(pinWorkers), m_NextQueue(0), m_NumberOfPendingTasks(0), m_Stop(false)
+{
+  if (numberOfThreads == 0)
+  {
+    numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+#ifdef __linux__
+  if (m_PinWorkers)
+  {
+    m_Cpus = GetCpusByNode();
+  }
+#endif
+
+  for (std::size_t i = 0; i < numberOfThreads; ++i)
+  {
+    m_Queues.emplace_back(new TaskQueue);
+  }
+  for (std::size_t i = 0; i < numberOfThreads; ++i)
+  {
+    m_Workers.emplace_back(&Self::Run, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_SleepMutex);
+    m_Stop = true;
+  }
+  m_TaskAvailable.notify_all();
+  for (auto& worker : m_Workers)
+  {
+    worker.join();
+  }
+}
+
+ThreadPool& ThreadPool::GetInstance()
+{
+  // Never destroyed: joining the workers during the static
+  // destructions may deadlock on some platforms
+  static ThreadPool* instance = new ThreadPool(itk::MultiThreader::GetGlobalDefaultNumberOfThreads(), ConfigurationManager::GetThreadAffinity());
+  return *instance;
+}
+
+void ThreadPool::ParallelFor(std::size_t begin, std::size_t end, const RangeFunctionType& function, std::size_t grainSize)
+{
+  if (end <= begin)
+  {
+    return;
+  }
+
+  const std::size_t count = end - begin;
+  if (grainSize == 0)
+  {
+    grainSize = std::max<std::size_t>(1, count / (4 * m_Workers.size()));
+  }
+  const std::size_t numberOfChunks = (count + grainSize - 1) / grainSize;
+  if (numberOfChunks == 1)
+  {
+    function(begin, end);
+    return;
+  }
+
+  std::mutex              mutex;
+  std::condition_variable done;
+  std::size_t             remaining = numberOfChunks;
+  std::exception_ptr      error;
+  std::atomic<bool>       failed(false);
+
+  auto runChunk = [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+    if (!failed)
+    {
+      try
+      {
+        function(chunkBegin, chunkEnd);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+        {
+          error = std::current_exception();
+        }
+        failed = true;
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--remaining == 0)
+    {
+      done.notify_all();
+    }
+  };
+
+  for (std::size_t chunk = 1; chunk < numberOfChunks; ++chunk)
+  {
+    const std::size_t chunkBegin = begin + chunk * grainSize;
+    const std::size_t chunkEnd   = std::min(end, chunkBegin + grainSize);
+    Submit([&runChunk, chunkBegin, chunkEnd] { runChunk(chunkBegin, chunkEnd); });
+  }
+  runChunk(begin, begin + grainSize);
+
+  // Help the workers until all the chunks are done
+  while (true)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (remaining == 0)
+      {
+        break;
+      }
+    }
+    if (!RunPendingTask())
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      done.wait_for(lock, std::chrono::milliseconds(1), [&remaining] { return remaining == 0; });
+    }
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+std::size_t ThreadPool::GetNumberOfThreads() const
+{
+  return m_Workers.size();
+}
+
+bool ThreadPool::GetPinWorkers() const
+{
+  return m_PinWorkers;
+}
+
+void ThreadPool::Submit(TaskType task)
+{
+  const std::size_t queue = currentPool == this ? currentWorker : m_NextQueue++ % m_Queues.size();
+
+  {
+    std::lock_guard<std::mutex> lock(m_SleepMutex);
+    ++m_NumberOfPendingTasks;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_Queues[queue]->Mutex);
+    m_Queues[queue]->Tasks.push_back(std::move(task));
+  }
+  m_TaskAvailable.notify_one();
+}
+
+bool ThreadPool::TryPop(std::size_t workerId, TaskType& task)
+{
+  const std::size_t numberOfQueues = m_Queues.size();
+
+  // Most recent task of the own queue first
+  if (workerId < numberOfQueues)
+  {
+    TaskQueue&                  queue = *m_Queues[workerId];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (!queue.Tasks.empty())
+    {
+      task = std::move(queue.Tasks.back());
+      queue.Tasks.pop_back();
+      --m_NumberOfPendingTasks;
+      return true;
+    }
+  }
+
+  // Then steal the oldest task of another queue
+  for (std::size_t i = 1; i <= numberOfQueues; ++i)
+  {
+    const std::size_t victim = (workerId + i) % numberOfQueues;
+    if (victim == workerId)
+    {
+      continue;
+    }
+    TaskQueue&                  queue = *m_Queues[victim];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (!queue.Tasks.empty())
+    {
+      task = std::move(queue.Tasks.front());
+      queue.Tasks.pop_front();
+      --m_NumberOfPendingTasks;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::RunPendingTask()
+{
+  TaskType task;
+  if (TryPop(currentPool == this ? currentWorker : m_Queues.size(), task))
+  {
+    task();
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::Run(std::size_t workerId)
+{
+  currentPool   = this;
+  currentWorker = workerId;
+
+  if (m_PinWorkers)
+  {
+    PinWorker(workerId);
+  }
+
+  TaskType task;
+  while (true)
+  {
+    if (TryPop(workerId, task))
+    {
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_SleepMutex);
+    m_TaskAvailable.wait(lock, [this] { return m_Stop || m_NumberOfPendingTasks > 0; });
+    if (m_Stop && m_NumberOfPendingTasks == 0)
+    {
+      return;
+    }
+  }
+}
+
+void ThreadPool::PinWorker(std::size_t workerId)
+{
+#ifdef __linux__
+  if (m_Cpus.empty())
+  {
+    return;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(m_Cpus[workerId % m_Cpus.size()], &cpuSet);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+  (void)workerId;
+#endif
+}
+
+} // namespace otb
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "itkMacro.h"
+
+#include "otbAsynchronousTaskQueue.h"
+
+using namespace std::chrono_literals;
+
+int otbAsynchronousTaskQueueTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // Tasks are run in order, and never more than the bound at once
+  {
+    otb::AsynchronousTaskQueue queue(2);
+    std::vector<int>           order;
+    std::atomic<std::size_t>   maxPending(0);
+
+    for (int i = 0; i < 10; ++i)
+    {
+      queue.Push([&order, i] {
+        std::this_thread::sleep_for(5ms);
+        order.push_back(i);
+      });
+      maxPending = std::max<std::size_t>(maxPending, queue.GetNumberOfPendingTasks());
+    }
+    queue.Wait();
+
+    if (queue.GetNumberOfPendingTasks() != 0 || maxPending > 2)
+    {
+      std::cerr << "Wrong number of pending tasks: max was " << maxPending << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+      if (order[i] != i)
+      {
+        std::cerr << "Task " << i << " was executed out of order" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // A slot is free once WaitForSlot() returns
+  {
+    otb::AsynchronousTaskQueue queue(1);
+
+    queue.Push([] { std::this_thread::sleep_for(20ms); });
+    queue.WaitForSlot();
+    if (queue.GetNumberOfPendingTasks() != 0)
+    {
+      std::cerr << "WaitForSlot() returned while the queue was full" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The error of a task is reported once, and following tasks are dropped
+  {
+    otb::AsynchronousTaskQueue queue(1);
+    bool                       executed = false;
+
+    queue.Push([] { throw std::runtime_error("task failure"); });
+    try
+    {
+      queue.Push([&executed] { executed = true; });
+      queue.Wait();
+      std::cerr << "The task error was not reported" << std::endl;
+      return EXIT_FAILURE;
+    }
+    catch (std::runtime_error&)
+    {
+    }
+    queue.Wait();
+    if (executed)
+    {
+      std::cerr << "A task was run after a failure" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Remaining tasks are completed on destruction
+  {
+    std::atomic<int> count(0);
+    {
+      otb::AsynchronousTaskQueue queue(4);
+      for (int i = 0; i < 4; ++i)
+      {
+        queue.Push([&count] {
+          std::this_thread::sleep_for(5ms);
+          ++count;
+        });
+      }
+    }
+    if (count != 4)
+    {
+      std::cerr << "Only " << count << " tasks out of 4 were run" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -28,6 +28,9 @@ void RegisterTests()
   REGISTER_TEST(otbRectangle);
   REGISTER_TEST(otbSystemTest);
   REGISTER_TEST(otbStopwatchTest);
+  REGISTER_TEST(otbAsynchronousTaskQueueTest);
+  REGISTER_TEST(otbThreadPoolTest);
+  REGISTER_TEST(otbThreadPoolBenchmark);
   REGISTER_TEST(otbParseHdfSubsetName);
   REGISTER_TEST(otbParseHdfFileName);
   REGISTER_TEST(otbImageRegionSquareTileSplitter);
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "itkMultiThreader.h"
+
+#include "otbThreadPool.h"
+
+namespace
+{
+// Work done on each pixel of a strip
+inline float ProcessPixel(float value)
+{
+  return std::sqrt(value * value + 1.f) * 0.5f + std::sin(value);
+}
+
+struct StripData
+{
+  const float*      Input;
+  float*            Output;
+  std::size_t       Size;
+  itk::ThreadIdType NumberOfThreads;
+};
+
+ITK_THREAD_RETURN_TYPE StripCallback(void* arg)
+{
+  auto*             info  = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+  const StripData*  strip = static_cast<StripData*>(info->UserData);
+  const std::size_t begin = strip->Size * info->ThreadID / info->NumberOfThreads;
+  const std::size_t end   = strip->Size * (info->ThreadID + 1) / info->NumberOfThreads;
+  for (std::size_t i = begin; i < end; ++i)
+  {
+    strip->Output[i] = ProcessPixel(strip->Input[i]);
+  }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+// Process the strips one after the other with an ITK multithreader,
+// spawning threads or using the ITK thread pool
+double RunMultiThreader(const std::vector<float>& input, std::vector<float>& output, std::size_t stripSize, bool useThreadPool)
+{
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetUseThreadPool(useThreadPool);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t offset = 0; offset < input.size(); offset += stripSize)
+  {
+    StripData strip = {input.data() + offset, output.data() + offset, stripSize, threader->GetNumberOfThreads()};
+    threader->SetSingleMethod(StripCallback, &strip);
+    threader->SingleMethodExecute();
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Process the strips one after the other with the OTB thread pool
+double RunThreadPool(const std::vector<float>& input, std::vector<float>& output, std::size_t stripSize)
+{
+  otb::ThreadPool& pool = otb::ThreadPool::GetInstance();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t offset = 0; offset < input.size(); offset += stripSize)
+  {
+    pool.ParallelFor(offset, offset + stripSize, [&input, &output](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        output[i] = ProcessPixel(input[i]);
+      }
+    });
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+// Throughput of strips processed with the ITK multithreader, with and
+// without the ITK thread pool, and with the OTB thread pool. Run with
+// larger sizes to get meaningful figures.
+int otbThreadPoolBenchmark(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " numberOfStrips stripSize" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::size_t numberOfStrips = std::atoi(argv[1]);
+  const std::size_t stripSize      = std::atoi(argv[2]);
+
+  std::vector<float> input(numberOfStrips * stripSize);
+  for (std::size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = static_cast<float>(i % 1000) / 10.f;
+  }
+  std::vector<float> reference(input.size());
+  std::vector<float> output(input.size());
+
+  const double spawnTime = RunMultiThreader(input, reference, stripSize, false);
+  const double itkPoolTime = RunMultiThreader(input, output, stripSize, true);
+  if (output != reference)
+  {
+    std::cerr << "The ITK thread pool gives different results" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const double otbPoolTime = RunThreadPool(input, output, stripSize);
+  if (output != reference)
+  {
+    std::cerr << "The OTB thread pool gives different results" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const double megaPixels = input.size() / 1e6;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << numberOfStrips << " strips of " << stripSize << " pixels, " << otb::ThreadPool::GetInstance().GetNumberOfThreads() << " threads" << std::endl;
+  std::cout << "ITK multithreader, spawned threads: " << megaPixels / spawnTime << " Mpix/s" << std::endl;
+  std::cout << "ITK multithreader, ITK thread pool: " << megaPixels / itkPoolTime << " Mpix/s" << std::endl;
+  std::cout << "OTB thread pool:                    " << megaPixels / otbPoolTime << " Mpix/s" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "itkMacro.h"
+
+#include "otbThreadPool.h"
+
+int otbThreadPoolTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  otb::ThreadPool pool(4);
+
+  // Every index is processed exactly once, whatever the grain size
+  for (std::size_t grainSize : {0, 1, 7, 1000})
+  {
+    std::vector<std::atomic<int>> counts(1000);
+    for (auto& count : counts)
+    {
+      count = 0;
+    }
+    pool.ParallelFor(0, counts.size(), [&counts](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        ++counts[i];
+      }
+    }, grainSize);
+    for (std::size_t i = 0; i < counts.size(); ++i)
+    {
+      if (counts[i] != 1)
+      {
+        std::cerr << "Index " << i << " processed " << counts[i] << " times with a grain size of " << grainSize << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Nested loops do not deadlock, even with more chunks than workers
+  {
+    std::atomic<std::size_t> sum(0);
+    pool.ParallelFor(0, 16, [&pool, &sum](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        pool.ParallelFor(0, 100, [&sum](std::size_t innerBegin, std::size_t innerEnd) { sum += innerEnd - innerBegin; }, 1);
+      }
+    }, 1);
+    if (sum != 1600)
+    {
+      std::cerr << "Nested loops processed " << sum << " indices instead of 1600" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The error of a chunk is rethrown to the caller
+  try
+  {
+    pool.ParallelFor(0, 100, [](std::size_t begin, std::size_t) {
+      if (begin == 50)
+      {
+        throw std::runtime_error("chunk failure");
+      }
+    }, 1);
+    std::cerr << "The chunk error was not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (std::runtime_error&)
+  {
+  }
+
+  // The pool can still be used after an error, and pinned workers run
+  // on a single CPU
+  {
+    otb::ThreadPool          pinnedPool(2, true);
+    std::atomic<std::size_t> count(0);
+    std::atomic<int>         unpinnedChunks(0);
+    const std::thread::id    callerId = std::this_thread::get_id();
+    pinnedPool.ParallelFor(10, 20,
+                           [&count, &unpinnedChunks, callerId](std::size_t begin, std::size_t end) {
+                             count += end - begin;
+#ifdef __linux__
+                             if (std::this_thread::get_id() != callerId)
+                             {
+                               cpu_set_t cpuSet;
+                               CPU_ZERO(&cpuSet);
+                               if (pthread_getaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0 || CPU_COUNT(&cpuSet) != 1)
+                               {
+                                 ++unpinnedChunks;
+                               }
+                             }
+#else
+                             (void)unpinnedChunks;
+                             (void)callerId;
+#endif
+                           },
+                           1);
+    if (unpinnedChunks != 0)
+    {
+      std::cerr << unpinnedChunks << " chunks ran on a worker that is not pinned to a single CPU" << std::endl;
+      return EXIT_FAILURE;
+    }
+    pool.ParallelFor(10, 20, [&count](std::size_t begin, std::size_t end) { count += end - begin; });
+    if (count != 20)
+    {
+      std::cerr << "Processed " << count << " indices instead of 20" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
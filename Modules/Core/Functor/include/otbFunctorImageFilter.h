@@ -24,6 +24,9 @@
 #include "otbVariadicNamedInputsImageFilter.h"
 #include "otbImage.h"
 #include "otbVectorImage.h"
+#include "otbSpan.h"
+#include "otbFusableImageFilterInterface.h"
+#include "itkProgressReporter.h"
 #include "itkRGBPixel.h"
 #include "itkRGBAPixel.h"
 #include "itkFixedArray.h"
@@ -59,6 +62,25 @@ struct IsNeighborhood<const itk::ConstNeighborhoodIterator<VectorImage<T>>&> : s
 {
 };
 
+/**
+ * \struct IsSpan
+ * \brief Struct testing if T is a Span
+ *
+ * Provides:
+ * - ValueType type set to false_type or true_type
+ * - value set to true or false
+ */
+template <class T>
+struct IsSpan : std::false_type
+{
+};
+
+/// Partial specialisation for Span<T>
+template <class T>
+struct IsSpan<Span<T>> : std::true_type
+{
+};
+
 /**
  * \struct IsSuitableType
  * \brief Helper struct to check if a type can be used as pixel type.
@@ -107,6 +129,7 @@ struct IsSuitableType<itk::RGBAPixel<T>> : IsSuitableType<T>::type
  * T                                                -> PixelType = T
  * const ConstNeighborhoodIterator<Image::T>&       -> PixelType = T
  * const ConstNeighborhoodIterator<VectorImage::T>& -> PixelType = itk::VariableLengthVector<T>
+ * Span<const T>                                    -> PixelType = itk::VariableLengthVector<T>
  */
 template <class T>
 struct PixelTypeDeduction
@@ -131,6 +154,14 @@ struct PixelTypeDeduction<itk::ConstNeighborhoodIterator<VectorImage<T>>>
   using PixelType = itk::VariableLengthVector<T>;
 };
 
+/// Partial specialisation for Span<const T>, a view on a VectorImage pixel
+template <class T>
+struct PixelTypeDeduction<Span<const T>>
+{
+  static_assert(IsSuitableType<T>::value, "T can not be used as a template parameter for Image or VectorImage classes.");
+  using PixelType = itk::VariableLengthVector<T>;
+};
+
 /**
  * \struct ImageTypeDeduction
  * \brief Helper struct to derive ImageType from template parameter
@@ -183,6 +214,10 @@ struct RetrieveOperator
  * - the operator() prototype
  * - InputHasNeighborhood a tuple of N false_type or true_type to denote
  * - if Ith arg of operator() expects a neighborhood.
+ * - InputIsSpan a tuple of N false_type or true_type to denote
+ * - if Ith arg of operator() expects a Span on the pixel.
+ * - OutputIsSpan true_type if the operator() writes its output in a
+ * - Span on the output pixel, false_type otherwise.
  */
 template <typename T, typename TNameMap>
 struct FunctorFilterSuperclassHelper : public FunctorFilterSuperclassHelper<typename RetrieveOperator<T>::Type, TNameMap>
@@ -209,6 +244,9 @@ struct FunctorFilterSuperclassHelperImpl
 
   // InputHasNeighborhood is derived from IsNeighborhood
   using InputHasNeighborhood = std::tuple<typename IsNeighborhood<T>::type...>;
+
+  // InputIsSpan is derived from IsSpan
+  using InputIsSpan = std::tuple<typename IsSpan<RemoveCVRef<T>>::type...>;
 };
 } // End namespace functor_filter_details
 
@@ -219,6 +257,8 @@ struct FunctorFilterSuperclassHelper<R (*)(T...), TNameMap>
   using OutputImageType      = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::OutputImageType;
   using FilterType           = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::FilterType;
   using InputHasNeighborhood = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputHasNeighborhood;
+  using InputIsSpan          = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputIsSpan;
+  using OutputIsSpan         = std::false_type;
 };
 
 /// Partial specialisation for R(C::*)(T...) const
@@ -228,6 +268,8 @@ struct FunctorFilterSuperclassHelper<R (C::*)(T...) const, TNameMap>
   using OutputImageType      = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::OutputImageType;
   using FilterType           = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::FilterType;
   using InputHasNeighborhood = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputHasNeighborhood;
+  using InputIsSpan          = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputIsSpan;
+  using OutputIsSpan         = std::false_type;
 };
 
 /// Partial specialisation for R(C::*)(T...)
@@ -237,6 +279,8 @@ struct FunctorFilterSuperclassHelper<R (C::*)(T...), TNameMap>
   using OutputImageType      = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::OutputImageType;
   using FilterType           = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::FilterType;
   using InputHasNeighborhood = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputHasNeighborhood;
+  using InputIsSpan          = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputIsSpan;
+  using OutputIsSpan         = std::false_type;
 };
 
 /// Partial specialisation for void(*)(R &,T...)
@@ -246,6 +290,8 @@ struct FunctorFilterSuperclassHelper<void (*)(R&, T...), TNameMap>
   using OutputImageType      = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::OutputImageType;
   using FilterType           = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::FilterType;
   using InputHasNeighborhood = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputHasNeighborhood;
+  using InputIsSpan          = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputIsSpan;
+  using OutputIsSpan         = std::false_type;
 };
 
 /// Partial specialisation for void(C::*)(R&,T...) const
@@ -255,6 +301,8 @@ struct FunctorFilterSuperclassHelper<void (C::*)(R&, T...) const, TNameMap>
   using OutputImageType      = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::OutputImageType;
   using FilterType           = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::FilterType;
   using InputHasNeighborhood = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputHasNeighborhood;
+  using InputIsSpan          = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputIsSpan;
+  using OutputIsSpan         = std::false_type;
 };
 
 /// Partial specialisation for void(C::*)(R&,T...)
@@ -264,6 +312,44 @@ struct FunctorFilterSuperclassHelper<void (C::*)(R&, T...), TNameMap>
   using OutputImageType      = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::OutputImageType;
   using FilterType           = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::FilterType;
   using InputHasNeighborhood = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputHasNeighborhood;
+  using InputIsSpan          = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputIsSpan;
+  using OutputIsSpan         = std::false_type;
+};
+
+/// Partial specialisation for void(*)(Span<R>,T...)
+template <typename R, typename... T, typename TNameMap>
+struct FunctorFilterSuperclassHelper<void (*)(Span<R>, T...), TNameMap>
+{
+  using Impl                 = functor_filter_details::FunctorFilterSuperclassHelperImpl<itk::VariableLengthVector<R>, TNameMap, T...>;
+  using OutputImageType      = typename Impl::OutputImageType;
+  using FilterType           = typename Impl::FilterType;
+  using InputHasNeighborhood = typename Impl::InputHasNeighborhood;
+  using InputIsSpan          = typename Impl::InputIsSpan;
+  using OutputIsSpan         = std::true_type;
+};
+
+/// Partial specialisation for void(C::*)(Span<R>,T...) const
+template <typename C, typename R, typename... T, typename TNameMap>
+struct FunctorFilterSuperclassHelper<void (C::*)(Span<R>, T...) const, TNameMap>
+{
+  using Impl                 = functor_filter_details::FunctorFilterSuperclassHelperImpl<itk::VariableLengthVector<R>, TNameMap, T...>;
+  using OutputImageType      = typename Impl::OutputImageType;
+  using FilterType           = typename Impl::FilterType;
+  using InputHasNeighborhood = typename Impl::InputHasNeighborhood;
+  using InputIsSpan          = typename Impl::InputIsSpan;
+  using OutputIsSpan         = std::true_type;
+};
+
+/// Partial specialisation for void(C::*)(Span<R>,T...)
+template <typename C, typename R, typename... T, typename TNameMap>
+struct FunctorFilterSuperclassHelper<void (C::*)(Span<R>, T...), TNameMap>
+{
+  using Impl                 = functor_filter_details::FunctorFilterSuperclassHelperImpl<itk::VariableLengthVector<R>, TNameMap, T...>;
+  using OutputImageType      = typename Impl::OutputImageType;
+  using FilterType           = typename Impl::FilterType;
+  using InputHasNeighborhood = typename Impl::InputHasNeighborhood;
+  using InputIsSpan          = typename Impl::InputIsSpan;
+  using OutputIsSpan         = std::true_type;
 };
 
 
@@ -274,9 +360,9 @@ struct FunctorFilterSuperclassHelper<void (C::*)(R&, T...), TNameMap>
  * - Accepts any number of arguments of T,
  * (const) itk::VariableLengthVector<T> (&),const
  * itk::ConstNeighborhoodIterator<VectorImage<T>> &, (const)
- * itk::ConstNeighborhoodIterator<Image<T>> & with T a scalar type
+ * itk::ConstNeighborhoodIterator<Image<T>> &, Span<const T> with T a scalar type
  * - returns T or itk::VariableLengthVector<T>, with T a scalar type
- * or returns void and has first parameter as output (i.e. T& or itk::VariableLengthVector<T>&)
+ * or returns void and has first parameter as output (i.e. T&, itk::VariableLengthVector<T>& or Span<T>)
  *
  * The returned filter is ready to use. Inputs can be set through the
  * SetInputs() method (see VariadicInputsImageFilter class for
@@ -304,12 +390,23 @@ auto NewFunctorFilter(Functor f, itk::Size<2> radius = {{0, 0}});
  * - Accepts any number of arguments of T,
  * (const) itk::VariableLengthVector<T> (&),const
  * itk::ConstNeighborhoodIterator<Image<T>> &, const
- * itk::ConstNeighborhoodIterator<VectorImage<T>> & with T a scalar type
+ * itk::ConstNeighborhoodIterator<VectorImage<T>> &, Span<const T> with T a scalar type
  * - returns T or itk::VariableLengthVector<T>, with T a scalar type
- * or returns void and has first parameter as output (i.e. T& or itk::VariableLengthVector<T>&)
+ * or returns void and has first parameter as output (i.e. T&, itk::VariableLengthVector<T>& or Span<T>)
  *
  * All image types will be deduced from the TFunction operator().
  *
+ * Span<const T> arguments and Span<T> outputs are views on the pixels of
+ * VectorImage<T> buffers: they avoid building an itk::VariableLengthVector
+ * for each input pixel, and copying the output pixel into the output
+ * image. As with itk::VariableLengthVector outputs, the number of
+ * output bands is given by the OutputSize() method of the functor.
+ *
+ * Filters with a single input and no neighborhood are fusable (see
+ * FusableImageFilterInterface): a chain of such filters can be
+ * executed tile by tile by the FusedTileExecutor, without buffering
+ * the intermediate images.
+ *
  * \sa VariadicInputsImageFilter
  * \sa NewFunctorFilter
  *
@@ -318,7 +415,7 @@ auto NewFunctorFilter(Functor f, itk::Size<2> radius = {{0, 0}});
  * \ingroup OTBFunctor
  */
 template <class TFunction, class TNameMap = void>
-class ITK_EXPORT FunctorImageFilter : public FunctorFilterSuperclassHelper<TFunction, TNameMap>::FilterType
+class ITK_EXPORT FunctorImageFilter : public FunctorFilterSuperclassHelper<TFunction, TNameMap>::FilterType, public FusableImageFilterInterface
 {
 
 public:
@@ -337,11 +434,20 @@ public:
   // A tuple of bool of the same size as the number of arguments in
   // the functor
   using InputHasNeighborhood = typename SuperclassHelper::InputHasNeighborhood;
+  using InputIsSpan          = typename SuperclassHelper::InputIsSpan;
+  using OutputIsSpan         = typename SuperclassHelper::OutputIsSpan;
   using InputTypesTupleType  = typename Superclass::InputTypesTupleType;
   template <size_t I>
   using InputImageType = typename Superclass::template InputImageType<I>;
   using Superclass::NumberOfInputs;
 
+  // Types of the fused execution
+  using FusedImageType  = FusableImageFilterInterface::ImageBaseType;
+  using FusedRegionType = FusableImageFilterInterface::RegionType;
+
+  // Only the filters with a single input and no neighborhood can be fused
+  static constexpr bool IsFusableType = NumberOfInputs == 1 && !std::is_same<InputHasNeighborhood, std::tuple<std::true_type>>::value;
+
   /** Run-time type information (and related methods). */
   itkTypeMacro(FunctorImageFilter, VariadicInputsImageFilter);
 
@@ -394,6 +500,15 @@ public:
     return m_Functor;
   }
 
+  /** FusableImageFilterInterface implementation */
+  bool IsFusable() const override;
+
+  FusedImageType* GetFusedInput() override;
+
+  FusedImageType::Pointer CreateFusedOutput() const override;
+
+  void GenerateFusedRegion(const FusedImageType* input, FusedImageType* output, const FusedRegionType& region) override;
+
 protected:
   /// Constructor of functor filter, will copy the functor
   FunctorImageFilter(const FunctorType& f, itk::Size<2> radius) : m_Functor(f), m_Radius(radius){};
@@ -408,6 +523,23 @@ private:
   /** Overload of ThreadedGenerateData  */
   void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
+  /** Process a region of an output image from a tuple of input
+   * images, setting each output pixel with the output iterator. The
+   * progress is reported to the given reporter, if any. */
+  template <class... TInputs>
+  void GenerateOutputPixels(OutputImageType* output, std::tuple<TInputs...> inputs, const OutputImageRegionType& region, itk::ProgressReporter* progress,
+                            std::false_type);
+
+  /** Process a region of an output image from a tuple of input
+   * images, the functor writing in place in Span on the output pixels */
+  template <class... TInputs>
+  void GenerateOutputPixels(OutputImageType* output, std::tuple<TInputs...> inputs, const OutputImageRegionType& region, itk::ProgressReporter* progress,
+                            std::true_type);
+
+  /** Fused processing of a region, dispatched on IsFusableType */
+  void GenerateFusedRegion(const FusedImageType* input, FusedImageType* output, const FusedRegionType& region, std::true_type);
+  void GenerateFusedRegion(const FusedImageType* input, FusedImageType* output, const FusedRegionType& region, std::false_type);
+
   /**
    * Pad the input requested region by radius
    */
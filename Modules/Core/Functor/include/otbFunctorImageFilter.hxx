@@ -95,13 +95,57 @@ auto GetNumberOfComponentsPerInput(std::tuple<T...>& t)
   return GetNumberOfComponentsPerInputImpl(t, std::make_index_sequence<sizeof...(T)>{});
 }
 
-template <typename N>
+/**
+ * Iterator over the pixels of a region of a VectorImage, providing
+ * Span views on the pixels in the image buffer. TImage may be const.
+ */
+template <class TImage>
+class PixelSpanIterator
+{
+public:
+  using InternalPixelType = typename std::remove_const<TImage>::type::InternalPixelType;
+  using ValueType         = typename std::conditional<std::is_const<TImage>::value, const InternalPixelType, InternalPixelType>::type;
+
+  PixelSpanIterator(TImage* img, const itk::ImageRegion<2>& region)
+    : m_NumberOfComponents(img->GetNumberOfComponentsPerPixel()),
+      m_LineStride(img->GetBufferedRegion().GetSize(0) * m_NumberOfComponents),
+      m_LineLength(region.GetSize(0) * m_NumberOfComponents),
+      m_LineBegin(img->GetBufferPointer() + img->ComputeOffset(region.GetIndex()) * m_NumberOfComponents),
+      m_Position(m_LineBegin)
+  {
+  }
+
+  Span<ValueType> Get() const
+  {
+    return Span<ValueType>(m_Position, m_NumberOfComponents);
+  }
+
+  PixelSpanIterator& operator++()
+  {
+    m_Position += m_NumberOfComponents;
+    if (m_Position == m_LineBegin + m_LineLength)
+    {
+      m_LineBegin += m_LineStride;
+      m_Position = m_LineBegin;
+    }
+    return *this;
+  }
+
+private:
+  std::size_t m_NumberOfComponents;
+  std::size_t m_LineStride;
+  std::size_t m_LineLength;
+  ValueType*  m_LineBegin;
+  ValueType*  m_Position;
+};
+
+template <typename N, typename S>
 struct MakeIterator
 {
 };
 
 template <>
-struct MakeIterator<std::false_type>
+struct MakeIterator<std::false_type, std::false_type>
 {
   template <class T>
   static auto Make(const T* img, const itk::ImageRegion<2>& region, const itk::Size<2>&)
@@ -112,7 +156,7 @@ struct MakeIterator<std::false_type>
 };
 
 template <>
-struct MakeIterator<std::true_type>
+struct MakeIterator<std::true_type, std::false_type>
 {
   template <class T>
   static auto Make(const T* img, const itk::ImageRegion<2>& region, const itk::Size<2>& radius)
@@ -122,18 +166,30 @@ struct MakeIterator<std::true_type>
   }
 };
 
+template <>
+struct MakeIterator<std::false_type, std::true_type>
+{
+  template <class T>
+  static auto Make(const T* img, const itk::ImageRegion<2>& region, const itk::Size<2>&)
+  {
+    PixelSpanIterator<const T> it(img, region);
+    return it;
+  }
+};
+
 // Will be easier to write in c++17 with std::apply and fold expressions
-template <class TNeigh, class Tuple, size_t... Is>
-auto MakeIteratorsImpl(const Tuple& t, const itk::ImageRegion<2>& region, const itk::Size<2>& radius, std::index_sequence<Is...>, TNeigh)
+template <class TNeigh, class TSpan, class Tuple, size_t... Is>
+auto MakeIteratorsImpl(const Tuple& t, const itk::ImageRegion<2>& region, const itk::Size<2>& radius, std::index_sequence<Is...>, TNeigh, TSpan)
 {
-  return std::make_tuple(MakeIterator<typename std::tuple_element<Is, TNeigh>::type>::Make(std::get<Is>(t), region, radius)...);
+  return std::make_tuple(
+      MakeIterator<typename std::tuple_element<Is, TNeigh>::type, typename std::tuple_element<Is, TSpan>::type>::Make(std::get<Is>(t), region, radius)...);
 }
 
 // Will be easier to write in c++17 with std::apply and fold expressions
-template <class TNeigh, typename... T>
-auto MakeIterators(std::tuple<T...>&& t, const itk::ImageRegion<2>& region, const itk::Size<2>& radius, TNeigh n)
+template <class TNeigh, class TSpan, typename... T>
+auto MakeIterators(std::tuple<T...>&& t, const itk::ImageRegion<2>& region, const itk::Size<2>& radius, TNeigh n, TSpan s)
 {
-  return MakeIteratorsImpl(t, region, radius, std::make_index_sequence<sizeof...(T)>{}, n);
+  return MakeIteratorsImpl(t, region, radius, std::make_index_sequence<sizeof...(T)>{}, n, s);
 }
 
 // Variadic call of operator from iterator tuple
@@ -161,6 +217,15 @@ struct GetProxy<itk::ConstNeighborhoodIterator<T>>
   }
 };
 
+template <typename T>
+struct GetProxy<PixelSpanIterator<T>>
+{
+  static decltype(auto) Get(const PixelSpanIterator<T>& t)
+  {
+    return t.Get();
+  }
+};
+
 /// Proxy for operator (dispatch between void operator()(Out &
 /// out,...) and Out operator()(...)
 template <class Oper>
@@ -228,6 +293,36 @@ struct OperProxy<void (C::*)(Out&, In...) const>
   }
 };
 
+template <class Out, class... In>
+struct OperProxy<void (*)(Span<Out>, In...)>
+{
+  template <class Oper>
+  static void Compute(Oper& oper, Span<Out> out, const In&... in)
+  {
+    oper(out, in...);
+  }
+};
+
+template <class C, class Out, class... In>
+struct OperProxy<void (C::*)(Span<Out>, In...)>
+{
+  template <class Oper>
+  static void Compute(Oper& oper, Span<Out> out, const In&... in)
+  {
+    oper(out, in...);
+  }
+};
+
+template <class C, class Out, class... In>
+struct OperProxy<void (C::*)(Span<Out>, In...) const>
+{
+  template <class Oper>
+  static void Compute(Oper& oper, Span<Out> out, const In&... in)
+  {
+    oper(out, in...);
+  }
+};
+
 
 // Will be easier to write in c++17 with std::apply and fold expressions
 template <class Tuple, class Out, class Oper, size_t... Is>
@@ -329,15 +424,24 @@ void FunctorImageFilter<TFunction, TNameMap>::ThreadedGenerateData(const OutputI
   const auto            numberOfLinesToProcess = outputRegionForThread.GetNumberOfPixels() / regionSize[0];
   itk::ProgressReporter p(this, threadId, numberOfLinesToProcess);
 
+  // Dispatch depending on how the functor writes its output
+  this->GenerateOutputPixels(this->GetOutput(), this->GetInputs(), outputRegionForThread, &p, OutputIsSpan{});
+}
+
+template <class TFunction, class TNameMap>
+template <class... TInputs>
+void FunctorImageFilter<TFunction, TNameMap>::GenerateOutputPixels(OutputImageType* output, std::tuple<TInputs...> inputs, const OutputImageRegionType& region,
+                                                                   itk::ProgressReporter* progress, std::false_type)
+{
   // Build output iterator
-  itk::ImageScanlineIterator<OutputImageType> outIt(this->GetOutput(), outputRegionForThread);
+  itk::ImageScanlineIterator<OutputImageType> outIt(output, region);
 
   // This will build a tuple of iterators to be used
-  auto inputIterators = functor_filter_details::MakeIterators(this->GetInputs(), outputRegionForThread, m_Radius, InputHasNeighborhood{});
+  auto inputIterators = functor_filter_details::MakeIterators(std::move(inputs), region, m_Radius, InputHasNeighborhood{}, InputIsSpan{});
 
   // Build a default value
   typename OutputImageType::PixelType outputValueHolder;
-  itk::NumericTraits<typename OutputImageType::PixelType>::SetLength(outputValueHolder, this->GetOutput()->GetNumberOfComponentsPerPixel());
+  itk::NumericTraits<typename OutputImageType::PixelType>::SetLength(outputValueHolder, output->GetNumberOfComponentsPerPixel());
 
   while (!outIt.IsAtEnd())
   {
@@ -350,8 +454,97 @@ void FunctorImageFilter<TFunction, TNameMap>::ThreadedGenerateData(const OutputI
       outIt.Set(outputValueHolder);
     }
     outIt.NextLine();
-    p.CompletedPixel(); // may throw
+    if (progress)
+    {
+      progress->CompletedPixel(); // may throw
+    }
+  }
+}
+
+template <class TFunction, class TNameMap>
+template <class... TInputs>
+void FunctorImageFilter<TFunction, TNameMap>::GenerateOutputPixels(OutputImageType* output, std::tuple<TInputs...> inputs, const OutputImageRegionType& region,
+                                                                   itk::ProgressReporter* progress, std::true_type)
+{
+  const auto& regionSize             = region.GetSize();
+  const auto  numberOfLinesToProcess = region.GetNumberOfPixels() / regionSize[0];
+
+  // Build output iterator, providing views on the output pixels
+  functor_filter_details::PixelSpanIterator<OutputImageType> outIt(output, region);
+
+  // This will build a tuple of iterators to be used
+  auto inputIterators = functor_filter_details::MakeIterators(std::move(inputs), region, m_Radius, InputHasNeighborhood{}, InputIsSpan{});
+
+  for (itk::SizeValueType line = 0; line < numberOfLinesToProcess; ++line)
+  {
+    // MoveIterartors will ++ all iterators in the tuple
+    for (itk::SizeValueType x = 0; x < regionSize[0]; ++x, ++outIt, functor_filter_details::MoveIterators(inputIterators))
+    {
+      // This will call the operator with inputIterators Get() results,
+      // the operator writing directly in the output buffer
+      auto outputValue = outIt.Get();
+      functor_filter_details::CallOperator(outputValue, m_Functor, inputIterators);
+    }
+    if (progress)
+    {
+      progress->CompletedPixel(); // may throw
+    }
+  }
+}
+
+template <class TFunction, class TNameMap>
+bool FunctorImageFilter<TFunction, TNameMap>::IsFusable() const
+{
+  return IsFusableType;
+}
+
+template <class TFunction, class TNameMap>
+auto FunctorImageFilter<TFunction, TNameMap>::GetFusedInput() -> FusedImageType*
+{
+  return dynamic_cast<FusedImageType*>(this->itk::ProcessObject::GetInput(0));
+}
+
+template <class TFunction, class TNameMap>
+auto FunctorImageFilter<TFunction, TNameMap>::CreateFusedOutput() const -> FusedImageType::Pointer
+{
+  typename OutputImageType::Pointer fusedOutput = OutputImageType::New();
+  fusedOutput->CopyInformation(this->GetOutput());
+  fusedOutput->SetNumberOfComponentsPerPixel(this->GetOutput()->GetNumberOfComponentsPerPixel());
+  return FusedImageType::Pointer(fusedOutput.GetPointer());
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::GenerateFusedRegion(const FusedImageType* input, FusedImageType* output, const FusedRegionType& region)
+{
+  this->GenerateFusedRegion(input, output, region, std::integral_constant<bool, IsFusableType>{});
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::GenerateFusedRegion(const FusedImageType* input, FusedImageType* output, const FusedRegionType& region,
+                                                                  std::true_type)
+{
+  using FusedInputImageType = InputImageType<0>;
+
+  const FusedInputImageType* typedInput  = dynamic_cast<const FusedInputImageType*>(input);
+  OutputImageType*           typedOutput = dynamic_cast<OutputImageType*>(output);
+  if (typedInput == nullptr || typedOutput == nullptr)
+  {
+    itkExceptionMacro(<< "Fused images do not match the input and output types of the filter");
   }
+
+  if (region.GetSize(0) == 0)
+  {
+    return;
+  }
+
+  // No progress is reported for fused regions
+  this->GenerateOutputPixels(typedOutput, std::make_tuple(typedInput), region, nullptr, OutputIsSpan{});
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::GenerateFusedRegion(const FusedImageType*, FusedImageType*, const FusedRegionType&, std::false_type)
+{
+  itkExceptionMacro(<< "Only filters with a single input and no neighborhood can be fused");
 }
 
 } // end namespace otb
@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include "otbFunctorImageFilter.h"
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using namespace otb;
+
+// static tests
+static_assert(IsSpan<Span<const double>>::value, "");
+static_assert(!IsSpan<itk::VariableLengthVector<double>>::value, "");
+static_assert(std::is_same<PixelTypeDeduction<Span<const double>>::PixelType, itk::VariableLengthVector<double>>::value, "");
+
+namespace
+{
+using VectorImageType = VectorImage<float>;
+using ImageType       = Image<float>;
+
+// Same operations written against itk::VariableLengthVector and Span
+
+// Gain and offset applied to each band
+struct AffineVector
+{
+  itk::VariableLengthVector<float> operator()(const itk::VariableLengthVector<float>& in) const
+  {
+    itk::VariableLengthVector<float> out(in.Size());
+    for (unsigned int band = 0; band < in.Size(); ++band)
+    {
+      out[band] = 2.f * in[band] + 1.f;
+    }
+    return out;
+  }
+
+  size_t OutputSize(const std::array<size_t, 1>& nbBands) const
+  {
+    return nbBands[0];
+  }
+};
+
+struct AffineSpan
+{
+  void operator()(Span<float> out, Span<const float> in) const
+  {
+    for (size_t band = 0; band < in.size(); ++band)
+    {
+      out[band] = 2.f * in[band] + 1.f;
+    }
+  }
+
+  size_t OutputSize(const std::array<size_t, 1>& nbBands) const
+  {
+    return nbBands[0];
+  }
+};
+
+// Sum of the bands of two images, weighted by a scalar image
+struct WeightedSumVector
+{
+  float operator()(const itk::VariableLengthVector<float>& a, const itk::VariableLengthVector<float>& b, float w) const
+  {
+    float sum = 0;
+    for (unsigned int band = 0; band < a.Size(); ++band)
+    {
+      sum += a[band] + w * b[band];
+    }
+    return sum;
+  }
+};
+
+struct WeightedSumSpan
+{
+  float operator()(Span<const float> a, Span<const float> b, float w) const
+  {
+    float sum = 0;
+    for (size_t band = 0; band < a.size(); ++band)
+    {
+      sum += a[band] + w * b[band];
+    }
+    return sum;
+  }
+};
+
+VectorImageType::Pointer CreateVectorImage(const VectorImageType::RegionType& region, unsigned int nbBands, float seed)
+{
+  auto image = VectorImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(nbBands);
+  image->Allocate();
+
+  float* buffer = image->GetBufferPointer();
+  for (size_t i = 0; i < region.GetNumberOfPixels() * nbBands; ++i)
+  {
+    buffer[i] = static_cast<float>((i * 7919 + static_cast<size_t>(seed)) % 1000) / 10.f;
+  }
+  return image;
+}
+
+template <class TImage>
+bool CompareImages(const TImage* expected, const TImage* result)
+{
+  const auto& region = expected->GetRequestedRegion();
+  if (region != result->GetRequestedRegion() || expected->GetNumberOfComponentsPerPixel() != result->GetNumberOfComponentsPerPixel())
+  {
+    std::cerr << "Output regions or number of bands differ" << std::endl;
+    return false;
+  }
+
+  itk::ImageRegionConstIteratorWithIndex<TImage> itExpected(expected, region);
+  itk::ImageRegionConstIteratorWithIndex<TImage> itResult(result, region);
+  for (; !itExpected.IsAtEnd(); ++itExpected, ++itResult)
+  {
+    if (itExpected.Get() != itResult.Get())
+    {
+      std::cerr << "Outputs differ at " << itExpected.GetIndex() << ": " << itResult.Get() << " instead of " << itExpected.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Update the filter on a sub-region of its output, so that the input and
+// output buffers have different line lengths
+template <class TFilter>
+void UpdateOnSubRegion(TFilter* filter, const VectorImageType::RegionType& subRegion)
+{
+  filter->UpdateOutputInformation();
+  filter->GetOutput()->SetRequestedRegion(subRegion);
+  filter->Update();
+}
+
+template <class TFilter, class... TInputs>
+double Time(TFilter* filter, unsigned int nbIterations, TInputs*... inputs)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < nbIterations; ++i)
+  {
+    filter->SetInputs(inputs...);
+    filter->Modified();
+    filter->Update();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}
+
+int otbFunctorImageFilterSpan(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  VectorImageType::RegionType region;
+  region.SetIndex(0, 3);
+  region.SetIndex(1, -2);
+  region.SetSize(0, 37);
+  region.SetSize(1, 21);
+
+  VectorImageType::RegionType subRegion;
+  subRegion.SetIndex(0, 10);
+  subRegion.SetIndex(1, 1);
+  subRegion.SetSize(0, 13);
+  subRegion.SetSize(1, 11);
+
+  auto a = CreateVectorImage(region, 5, 0);
+  auto b = CreateVectorImage(region, 5, 17);
+
+  auto w = ImageType::New();
+  w->SetRegions(region);
+  w->Allocate();
+  w->FillBuffer(0.5f);
+
+  bool ok = true;
+
+  // Span input and Span output
+  auto affineVector = NewFunctorFilter(AffineVector{});
+  auto affineSpan   = NewFunctorFilter(AffineSpan{});
+  affineVector->SetInputs(a);
+  affineSpan->SetInputs(a);
+  static_assert(std::is_same<decltype(affineSpan)::ObjectType::OutputImageType, VectorImageType>::value, "");
+
+  affineVector->Update();
+  affineSpan->Update();
+  ok = ok && CompareImages(affineVector->GetOutput(), affineSpan->GetOutput());
+
+  affineVector->Modified();
+  affineSpan->Modified();
+  UpdateOnSubRegion(affineVector.GetPointer(), subRegion);
+  UpdateOnSubRegion(affineSpan.GetPointer(), subRegion);
+  ok = ok && CompareImages(affineVector->GetOutput(), affineSpan->GetOutput());
+
+  // Span output given by a lambda, with the number of bands set at creation
+  auto lambdaSpan = NewFunctorFilter(
+      [](Span<float> out, Span<const float> in) {
+        for (size_t band = 0; band < in.size(); ++band)
+        {
+          out[band] = 2.f * in[band] + 1.f;
+        }
+      },
+      5);
+  lambdaSpan->SetInputs(a);
+  lambdaSpan->Update();
+  affineVector->Modified();
+  affineVector->GetOutput()->SetRequestedRegionToLargestPossibleRegion();
+  affineVector->Update();
+  ok = ok && CompareImages(affineVector->GetOutput(), lambdaSpan->GetOutput());
+
+  // Span inputs mixed with a scalar input
+  auto sumVector = NewFunctorFilter(WeightedSumVector{});
+  auto sumSpan   = NewFunctorFilter(WeightedSumSpan{});
+  sumVector->SetInputs(a, b, w);
+  sumSpan->SetInputs(a, b, w);
+
+  UpdateOnSubRegion(sumVector.GetPointer(), subRegion);
+  UpdateOnSubRegion(sumSpan.GetPointer(), subRegion);
+  ok = ok && CompareImages(sumVector->GetOutput(), sumSpan->GetOutput());
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int otbFunctorImageFilterSpanBenchmark(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::cerr << "Usage: " << argv[0] << " sizex sizey nbIterations" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  VectorImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, atoi(argv[1]));
+  region.SetSize(1, atoi(argv[2]));
+  const unsigned int nbIterations = atoi(argv[3]);
+  const double       nbMPixels    = region.GetNumberOfPixels() * nbIterations * 1e-6;
+
+  std::cout << std::setw(8) << "bands" << std::setw(16) << "functor" << std::setw(16) << "vector (MP/s)" << std::setw(16) << "span (MP/s)"
+            << std::setw(10) << "speedup" << std::endl;
+
+  bool ok = true;
+  for (unsigned int nbBands : {4, 13, 200})
+  {
+    auto a = CreateVectorImage(region, nbBands, 0);
+    auto b = CreateVectorImage(region, nbBands, 17);
+    auto w = ImageType::New();
+    w->SetRegions(region);
+    w->Allocate();
+    w->FillBuffer(0.5f);
+
+    auto affineVector = NewFunctorFilter(AffineVector{});
+    auto affineSpan   = NewFunctorFilter(AffineSpan{});
+    auto sumVector    = NewFunctorFilter(WeightedSumVector{});
+    auto sumSpan      = NewFunctorFilter(WeightedSumSpan{});
+
+    const double affineVectorTime = Time(affineVector.GetPointer(), nbIterations, a.GetPointer());
+    const double affineSpanTime   = Time(affineSpan.GetPointer(), nbIterations, a.GetPointer());
+    const double sumVectorTime    = Time(sumVector.GetPointer(), nbIterations, a.GetPointer(), b.GetPointer(), w.GetPointer());
+    const double sumSpanTime      = Time(sumSpan.GetPointer(), nbIterations, a.GetPointer(), b.GetPointer(), w.GetPointer());
+
+    std::cout << std::setw(8) << nbBands << std::setw(16) << "affine" << std::setw(16) << nbMPixels / affineVectorTime << std::setw(16)
+              << nbMPixels / affineSpanTime << std::setw(10) << affineVectorTime / affineSpanTime << std::endl;
+    std::cout << std::setw(8) << nbBands << std::setw(16) << "weighted sum" << std::setw(16) << nbMPixels / sumVectorTime << std::setw(16)
+              << nbMPixels / sumSpanTime << std::setw(10) << sumVectorTime / sumSpanTime << std::endl;
+
+    ok = ok && CompareImages(affineVector->GetOutput(), affineSpan->GetOutput());
+    ok = ok && CompareImages(sumVector->GetOutput(), sumSpan->GetOutput());
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
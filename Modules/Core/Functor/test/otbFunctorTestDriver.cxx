@@ -23,4 +23,6 @@
 void RegisterTests()
 {
   REGISTER_TEST(otbFunctorImageFilter);
+  REGISTER_TEST(otbFunctorImageFilterSpan);
+  REGISTER_TEST(otbFunctorImageFilterSpanBenchmark);
 }
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFusableImageFilterInterface_h
+#define otbFusableImageFilterInterface_h
+
+#include "itkImageBase.h"
+
+#include "OTBImageBaseExport.h"
+
+namespace otb
+{
+
+/** \class FusableImageFilterInterface
+ *  \brief Interface of the filters whose execution can be fused with
+ *  their neighbours in a pipeline
+ *
+ *  A fusable filter computes each output pixel from the pixel at the
+ *  same index of a single input image. Such filters can be chained
+ *  without buffering their whole output: FusedTileExecutor pulls small
+ *  tiles through a chain of fusable filters, each thread keeping the
+ *  intermediate tiles in its own scratch images.
+ *
+ *  The methods of this interface bypass the pipeline: they neither
+ *  update the input nor allocate the output of the filter.
+ *
+ * \sa FusedTileExecutor
+ *
+ * \ingroup OTBImageBase
+ */
+class OTBImageBase_EXPORT FusableImageFilterInterface
+{
+public:
+  typedef itk::ImageBase<2>         ImageBaseType;
+  typedef ImageBaseType::RegionType RegionType;
+
+  virtual ~FusableImageFilterInterface();
+
+  /** Whether the current configuration of the filter can be fused */
+  virtual bool IsFusable() const = 0;
+
+  /** Get the input image the output pixels are computed from */
+  virtual ImageBaseType* GetFusedInput() = 0;
+
+  /** Create an empty image of the output type, with the information of
+   * the output. Its buffer is allocated by the caller. */
+  virtual ImageBaseType::Pointer CreateFusedOutput() const = 0;
+
+  /** Compute a region of the output pixels from the input pixels. Both
+   * images must already buffer the region. This method is called
+   * concurrently from several threads on disjoint regions. */
+  virtual void GenerateFusedRegion(const ImageBaseType* input, ImageBaseType* output, const RegionType& region) = 0;
+};
+
+} // end namespace otb
+
+#endif
@@ -28,6 +28,18 @@
 namespace otb
 {
 
+/** \class ImageCommons
+ *
+ * \brief Metadata part common to otb::Image and otb::VectorImage
+ *
+ * Each image owns its ImageMetadata, which is copied when it is
+ * propagated along a pipeline (e.g. by CopyInformation()). The metadata
+ * of an image is updated in place, so that the pointers on it (e.g. held
+ * by a GenericRSTransform) remain valid for the life of the image and
+ * see the metadata of the last update of its pipeline.
+ *
+ * \ingroup OTBImageBase
+ */
 class OTBImageBase_EXPORT ImageCommons
 {
 public:
@@ -68,6 +80,7 @@ public:
   /** Returns true if a sensor geometric model is present */
   bool HasSensorGeometry() const;
 
+private:
   /** Image metadata */
   ImageMetadata m_Imd;
 };
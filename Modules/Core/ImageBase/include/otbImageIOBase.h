@@ -23,11 +23,13 @@
 #define otbImageIOBase_h
 
 #include "otbImageMetadata.h"
+#include "otbMemoryMappedFile.h"
 #include "itkLightProcessObject.h"
 #include "itkIndent.h"
 #include "itkImageIORegion.h"
 #include "vnl/vnl_vector.h"
 
+#include <memory>
 #include <string>
 #include <typeinfo>
 #include <vector>
@@ -340,6 +342,20 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   virtual void Read(void* buffer) = 0;
 
+  /** Determine if the pixels of the current IORegion can be mapped in
+   * memory directly from the file, see MapRead(). Default is false. */
+  virtual bool CanMapRead()
+  {
+    return false;
+  }
+
+  /** Map the pixels of the current IORegion in memory. The data of the
+   * returned mapping starts at the first pixel of the region, and the
+   * pixels of each line are laid out as in the buffer filled by Read().
+   * Consecutive lines are lineStride bytes apart. This method can be
+   * invoked only if CanMapRead() returns true. */
+  virtual std::shared_ptr<MemoryMappedFile> MapRead(std::size_t& lineStride);
+
 
   /*-------- This part of the interfaces deals with writing data ----- */
 
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMemoryMappedImageContainer_h
+#define otbMemoryMappedImageContainer_h
+
+#include <memory>
+
+#include "otbMemoryMappedFile.h"
+
+namespace otb
+{
+
+/** \class MemoryMappedImageContainer
+ * \brief Pixel container importing the pixels of a memory mapped file.
+ *
+ * The container keeps a reference on the MemoryMappedFile, so that the
+ * file remains mapped as long as the container is used by an image.
+ * TPixelContainer is the pixel container type of the image, which is
+ * an itk::ImportImageContainer.
+ *
+ * \sa MemoryMappedFile
+ *
+ * \ingroup OTBImageBase
+ */
+template <class TPixelContainer>
+class ITK_EXPORT MemoryMappedImageContainer : public TPixelContainer
+{
+public:
+  /** Standard class typedefs. */
+  typedef MemoryMappedImageContainer    Self;
+  typedef TPixelContainer               Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  typedef typename Superclass::Element           Element;
+  typedef typename Superclass::ElementIdentifier ElementIdentifier;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MemoryMappedImageContainer, ImportImageContainer);
+
+  /** Import the size elements found at the beginning of the mapped data */
+  void SetMapping(const std::shared_ptr<MemoryMappedFile>& mapping, ElementIdentifier size)
+  {
+    m_Mapping = mapping;
+    this->SetImportPointer(reinterpret_cast<Element*>(mapping->GetData()), size, false);
+  }
+
+protected:
+  MemoryMappedImageContainer()
+  {
+  }
+  ~MemoryMappedImageContainer() override
+  {
+  }
+
+private:
+  MemoryMappedImageContainer(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  std::shared_ptr<MemoryMappedFile> m_Mapping;
+};
+
+} // end namespace otb
+
+#endif
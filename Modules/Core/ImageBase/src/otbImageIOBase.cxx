@@ -1192,6 +1192,11 @@ std::vector<double> ImageIOBase::GetDefaultDirection(unsigned int k) const
   return axis;
 }
 
+std::shared_ptr<MemoryMappedFile> ImageIOBase::MapRead(std::size_t& itkNotUsed(lineStride))
+{
+  itkExceptionMacro(<< "Memory mapped reading is not supported by " << this->GetNameOfClass());
+}
+
 void ImageIOBase::DoMapBuffer(void* buffer, size_t numberOfPixels, std::vector<unsigned int>& bandList)
 {
   m_BandList = bandList;
@@ -39,6 +39,8 @@ void RegisterTests()
   REGISTER_TEST(otbComplexToIntensityFilterTest);
   REGISTER_TEST(otbMultiToMonoChannelExtractROI);
   REGISTER_TEST(otbImageTest);
+  REGISTER_TEST(otbImageMetadataPropagationTest);
+  REGISTER_TEST(otbImageMetadataPropagationUpdateTest);
   REGISTER_TEST(otbImageFunctionAdaptor);
   REGISTER_TEST(otbMetaImageFunction);
 }
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "itkCastImageFilter.h"
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbStopwatch.h"
+
+/** Propagate the metadata of an image along a chain of filters, check
+ * that each output gets its own copy, and report the time spent in
+ * UpdateOutputInformation() */
+int otbImageMetadataPropagationTest(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " input nbFilters" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  typedef otb::Image<std::complex<float>, 2>         ImageType;
+  typedef otb::ImageFileReader<ImageType>            ReaderType;
+  typedef itk::CastImageFilter<ImageType, ImageType> FilterType;
+
+  const unsigned int nbFilters = std::atoi(argv[2]);
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  reader->UpdateOutputInformation();
+
+  std::vector<FilterType::Pointer> chain;
+  const ImageType*                 previous = reader->GetOutput();
+  for (unsigned int i = 0; i < nbFilters; ++i)
+  {
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(previous);
+    previous = filter->GetOutput();
+    chain.push_back(filter);
+  }
+
+  otb::Stopwatch chrono = otb::Stopwatch::StartNew();
+  chain.back()->UpdateOutputInformation();
+  chrono.Stop();
+
+  const ImageType*          input = reader->GetOutput();
+  const otb::ImageMetadata& imd   = input->GetImageMetadata();
+  std::cout << "Metadata size: " << imd.GetSize() << " keys" << std::endl;
+  std::cout << "UpdateOutputInformation() on " << nbFilters << " filters: " << chrono.GetElapsedMilliseconds() << " ms" << std::endl;
+
+  // Every output has a copy of the metadata of the reader
+  for (unsigned int i = 0; i < nbFilters; ++i)
+  {
+    const ImageType* output = chain[i]->GetOutput();
+    if (&output->GetImageMetadata() == &imd || output->GetImageMetadata().GetSize() != imd.GetSize() ||
+        output->GetGCPCount() != input->GetGCPCount())
+    {
+      std::cerr << "The metadata of filter " << i << " is not a copy of the input metadata" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Modifying an output leaves the input and the other outputs untouched
+  const std::string name = "otbImageMetadataPropagationTest";
+  chain.front()->GetOutput()->GetImageMetadata().Add(otb::MDStr::SensorID, name);
+  const ImageType* first = chain.front()->GetOutput();
+  const ImageType* last  = chain.back()->GetOutput();
+  if (!first->GetImageMetadata().Has(otb::MDStr::SensorID) || first->GetImageMetadata()[otb::MDStr::SensorID] != name)
+  {
+    std::cerr << "The metadata of the output was not modified" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (imd.Has(otb::MDStr::SensorID) && imd[otb::MDStr::SensorID] == name)
+  {
+    std::cerr << "The modification of an output changed the input metadata" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (nbFilters > 1 && last->GetImageMetadata().Has(otb::MDStr::SensorID) && last->GetImageMetadata()[otb::MDStr::SensorID] == name)
+  {
+    std::cerr << "The modification of an output changed the other outputs" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** Hold a pointer on the metadata of the output of a pipeline, the way
+ * a GenericRSTransform does, and check that it stays valid and follows
+ * the updates of the pipeline when the input changes */
+int otbImageMetadataPropagationUpdateTest(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " input1 input2" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  typedef otb::Image<float, 2>                       ImageType;
+  typedef otb::ImageFileReader<ImageType>            ReaderType;
+  typedef itk::CastImageFilter<ImageType, ImageType> FilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  FilterType::Pointer first  = FilterType::New();
+  first->SetInput(reader->GetOutput());
+  FilterType::Pointer second = FilterType::New();
+  second->SetInput(first->GetOutput());
+
+  const ImageType*          input  = reader->GetOutput();
+  const ImageType*          output = second->GetOutput();
+  const otb::ImageMetadata* imd    = nullptr;
+
+  // Alternate between the inputs, so that the metadata changes at each
+  // update
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    reader->SetFileName(argv[1 + i % 2]);
+    second->UpdateOutputInformation();
+
+    if (imd == nullptr)
+    {
+      imd = &output->GetImageMetadata();
+    }
+    if (&output->GetImageMetadata() != imd)
+    {
+      std::cerr << "The metadata of the output was reallocated by update " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+    const otb::ImageMetadata& inputImd = input->GetImageMetadata();
+    if (imd->GetProjectionWKT() != inputImd.GetProjectionWKT() || imd->StringKeys != inputImd.StringKeys || imd->NumericKeys != inputImd.NumericKeys)
+    {
+      std::cerr << "The held metadata does not match the input " << argv[1 + i % 2] << " after update " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
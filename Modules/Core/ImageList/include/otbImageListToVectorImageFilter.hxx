@@ -51,7 +51,8 @@ void ImageListToVectorImageFilter<TImageList, TVectorImage>::GenerateOutputInfor
       
       while (inputListIt != inputPtr->End())
       {
-        const auto & imd = inputListIt.Get()->GetImageMetadata();
+        const InputImageType* inputImage = inputListIt.Get();
+        const auto &          imd        = inputImage->GetImageMetadata();
         if (imd.Bands.size())
         {
           bandsImd.push_back(imd.Bands[0]);
@@ -30,6 +30,7 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <cstddef>
 #include <string>
 
 namespace otb
@@ -73,6 +74,17 @@ public:
     return 1.0;
   }
 
+  /** Compute the values of count consecutive pixels of the line y,
+   * starting at column x. Sub-classes can override it to share the
+   * computations depending on the line only. */
+  virtual void GetValues(const IndexValueType x, const IndexValueType y, std::size_t count, double* values) const
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      values[i] = this->GetValue(x + static_cast<IndexValueType>(i), y);
+    }
+  }
+
   void SetType(short t)
   {
     m_Type = t;
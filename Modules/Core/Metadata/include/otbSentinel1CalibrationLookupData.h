@@ -80,6 +80,8 @@ public:
 
   double GetValue(const IndexValueType x, const IndexValueType y) const override;
 
+  void GetValues(const IndexValueType x, const IndexValueType y, std::size_t count, double* values) const override;
+
   int GetVectorIndex(int y) const;
 
   int GetPixelIndex(int x, const Sentinel1CalibrationStruct& calVec) const;
@@ -85,6 +85,9 @@ public:
   /** Compute noise contribution for a given pixel */
   double GetValue(const IndexValueType x, const IndexValueType y) const override;
 
+  /** Compute noise contribution for consecutive pixels of a line */
+  void GetValues(const IndexValueType x, const IndexValueType y, std::size_t count, double* values) const override;
+
 protected:
   Sentinel1ThermalNoiseLookupData() : m_FirstLineTime(0.), m_LastLineTime(0.) {m_FirstLineTime = 1.;};
   ~Sentinel1ThermalNoiseLookupData() = default;
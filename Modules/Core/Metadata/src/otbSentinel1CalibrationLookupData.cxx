@@ -159,6 +159,32 @@ double Sentinel1CalibrationLookupData::GetValue(const IndexValueType x, const In
   return lutVal;
 }
 
+void Sentinel1CalibrationLookupData::GetValues(const IndexValueType x, const IndexValueType y, std::size_t nbValues, double* values) const
+{
+  const int calVecIdx = GetVectorIndex(y);
+  assert(calVecIdx >= 0 && calVecIdx < count - 1);
+  const Sentinel1CalibrationStruct& vec0   = calibrationVectorList[calVecIdx];
+  const Sentinel1CalibrationStruct& vec1   = calibrationVectorList[calVecIdx + 1];
+  const double                      azTime = firstLineTime + y * lineTimeInterval;
+  const double                      muY    = (azTime - vec0.timeMJD) / vec1.deltaMJD;
+
+  // Walk along the calibration vector instead of searching the pixel
+  // index of each column: this gives the same index as GetPixelIndex()
+  const int lastPixelIdx = static_cast<int>(vec0.pixels.size()) - 2;
+  int       pixelIdx     = GetPixelIndex(x, vec0);
+  for (std::size_t i = 0; i < nbValues; ++i)
+  {
+    const IndexValueType curX = x + static_cast<IndexValueType>(i);
+    while (pixelIdx < lastPixelIdx && vec0.pixels[pixelIdx + 1] <= curX)
+    {
+      ++pixelIdx;
+    }
+    const double muX = (curX - vec0.pixels[pixelIdx]) / vec0.deltaPixels[pixelIdx + 1];
+    values[i] =
+        (1 - muY) * ((1 - muX) * vec0.vect[pixelIdx] + muX * vec0.vect[pixelIdx + 1]) + muY * ((1 - muX) * vec1.vect[pixelIdx] + muX * vec1.vect[pixelIdx + 1]);
+  }
+}
+
 int Sentinel1CalibrationLookupData::GetVectorIndex(int y) const
 {
   for (int i = 1; i < count; i++)
@@ -20,6 +20,8 @@
 
 #include "otbSentinel1ThermalNoiseLookupData.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
@@ -47,6 +49,46 @@ double Sentinel1ThermalNoiseLookupData::GetValue(const IndexValueType x, const I
   return GetRangeNoise(x,y) * GetAzimuthNoise(x,y);
 }
 
+void Sentinel1ThermalNoiseLookupData::GetValues(const IndexValueType x, const IndexValueType y, std::size_t count, double* values) const
+{
+  // Range noise along the line, computed as in GetRangeNoise()
+  if (m_RangeCount)
+  {
+    const auto vecIdx = GetRangeVectorIndex(y);
+    assert(vecIdx >= 0 && vecIdx < m_RangeCount - 1);
+
+    const auto& vec0 = m_RangeNoiseVectorList[vecIdx];
+    const auto& vec1 = m_RangeNoiseVectorList[vecIdx + 1];
+
+    const auto azTime = m_FirstLineTime + y * m_LineTimeInterval;
+    const auto muY = (azTime - vec0.timeMJD) / vec1.deltaMJD;
+
+    // Walk along the noise vector to get the same index as GetPixelIndex()
+    const int lastPixelIdx = static_cast<int>(vec0.pixels.size()) - 2;
+    int pixelIdx = GetPixelIndex(x, vec0.pixels);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const IndexValueType curX = x + static_cast<IndexValueType>(i);
+      while (pixelIdx < lastPixelIdx && vec0.pixels[pixelIdx + 1] <= curX)
+      {
+        ++pixelIdx;
+      }
+      const double muX = (curX - vec0.pixels[pixelIdx]) / vec0.deltaPixels[pixelIdx + 1];
+      values[i] =
+          (1 - muY) * ((1 - muX) * vec0.vect[pixelIdx] + muX * vec0.vect[pixelIdx + 1]) + muY * ((1 - muX) * vec1.vect[pixelIdx] + muX * vec1.vect[pixelIdx + 1]);
+    }
+  }
+  else
+  {
+    std::fill(values, values + count, 1.);
+  }
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    values[i] *= GetAzimuthNoise(x + static_cast<IndexValueType>(i), y);
+  }
+}
+
 double Sentinel1ThermalNoiseLookupData::GetRangeNoise(const IndexValueType x, const IndexValueType y) const
 {
   if (m_RangeCount)
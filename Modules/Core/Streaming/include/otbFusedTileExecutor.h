@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFusedTileExecutor_h
+#define otbFusedTileExecutor_h
+
+#include "itkObject.h"
+#include "itkMultiThreader.h"
+#include "otbFusableImageFilterInterface.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include "OTBStreamingExport.h"
+
+namespace otb
+{
+
+/** \class FusedTileExecutor
+ *  \brief Generate a region of an image by pulling small tiles through
+ *  the chain of fusable filters producing it
+ *
+ *  In a regular pipeline update, each filter buffers the whole
+ *  requested region and synchronizes its threads before the next
+ *  filter starts. When the image is produced by a linear chain of
+ *  fusable filters (see FusableImageFilterInterface), this executor
+ *  instead:
+ *  - updates the input of the first fusable filter of the chain through
+ *  the pipeline, for the requested region,
+ *  - splits the region into tiles of about TileSize pixels,
+ *  - lets each thread pull tiles through the whole chain, the
+ *  intermediate tiles being computed in scratch images owned by the
+ *  thread and reused from one tile to the next.
+ *
+ *  Only the requested image and the input of the chain are buffered
+ *  over the whole region, and the intermediate pixels stay in the
+ *  cache of the thread computing them. The output pixels are the same
+ *  as the ones of the regular update.
+ *
+ *  The filters of the chain are not executed through the pipeline: they
+ *  report no progress, and their outputs other than the requested image
+ *  are left untouched, so that another consumer of them still updates
+ *  them normally.
+ *
+ *  This executor is used by the ImageFileWriter and the
+ *  StreamingImageVirtualWriter when their FusedTileExecution flag is on.
+ *
+ * \sa FusableImageFilterInterface
+ *
+ * \ingroup OTBStreaming
+ */
+class OTBStreaming_EXPORT FusedTileExecutor : public itk::Object
+{
+public:
+  /** Standard class typedefs */
+  typedef FusedTileExecutor             Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Useful typedefs */
+  typedef FusableImageFilterInterface::ImageBaseType ImageBaseType;
+  typedef FusableImageFilterInterface::RegionType    RegionType;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(FusedTileExecutor, itk::Object);
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Set/Get the number of pixels of the tiles pulled through the
+   * chain (default is 16384) */
+  itkSetMacro(TileSize, unsigned int);
+  itkGetConstMacro(TileSize, unsigned int);
+
+  /** Set/Get the minimum number of fusable filters for a chain to be
+   * fused (default is 2) */
+  itkSetMacro(MinimumNumberOfFusedFilters, unsigned int);
+  itkGetConstMacro(MinimumNumberOfFusedFilters, unsigned int);
+
+  /** Set/Get the number of threads (default is the global default
+   * number of threads of ITK) */
+  itkSetMacro(NumberOfThreads, itk::ThreadIdType);
+  itkGetConstMacro(NumberOfThreads, itk::ThreadIdType);
+
+  /** Get the number of filters fused by the last call to GenerateRegion() */
+  itkGetConstMacro(NumberOfFusedFilters, unsigned int);
+
+  /** Generate a region of the image. The image must hold its output
+   * information. Return false, without updating anything, when the
+   * image is not produced by a chain of enough fusable filters: the
+   * caller is then expected to update the image through the pipeline. */
+  bool GenerateRegion(ImageBaseType* image, const RegionType& region);
+
+protected:
+  FusedTileExecutor();
+  ~FusedTileExecutor() override = default;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  FusedTileExecutor(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Callback of the threads */
+  static ITK_THREAD_RETURN_TYPE ThreaderCallback(void* arg);
+
+  /** Pull tiles through the chain until there is none left */
+  void ProcessTiles();
+
+  unsigned int      m_TileSize;
+  unsigned int      m_MinimumNumberOfFusedFilters;
+  itk::ThreadIdType m_NumberOfThreads;
+  unsigned int      m_NumberOfFusedFilters;
+
+  /** State of the region being generated */
+  std::vector<FusableImageFilterInterface*> m_Chain;
+  ImageBaseType*                            m_Head;
+  ImageBaseType*                            m_Output;
+  std::vector<RegionType>                   m_Tiles;
+  std::atomic<std::size_t>                  m_NextTile;
+  std::exception_ptr                        m_Exception;
+  std::mutex                                m_ExceptionMutex;
+};
+
+} // end namespace otb
+
+#endif
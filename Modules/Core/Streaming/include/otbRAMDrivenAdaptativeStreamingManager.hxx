@@ -47,7 +47,7 @@ void RAMDrivenAdaptativeStreamingManager<TImage>::PrepareStreaming(itk::DataObje
 
   typename otb::ImageRegionAdaptativeSplitter<itkGetStaticConstMacro(ImageDimension)>::SizeType tileHint;
 
-  auto inputImage = dynamic_cast<TImage*>(input);
+  auto inputImage = dynamic_cast<const TImage*>(input);
 
   tileHint[0] = 0;
   tileHint[1] = 0;
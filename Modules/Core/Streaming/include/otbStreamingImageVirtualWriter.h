@@ -25,6 +25,7 @@
 #include "itkImageToImageFilter.h"
 #include "otbStreamingManager.h"
 #include "itkFastMutexLock.h"
+#include "otbFusedTileExecutor.h"
 
 namespace otb
 {
@@ -50,6 +51,11 @@ namespace otb
  *  It is used in the PersistentFilterStreamingDecorator helper class to propose an easy
  *  way to stream an image through a persistent filter.
  *
+ *  When FusedTileExecution is on, each piece of the input is produced by a
+ *  FusedTileExecutor if the input comes from a chain of fusable filters
+ *  (see FusableImageFilterInterface), and by the regular pipeline update
+ *  otherwise.
+ *
  * \sa PersistentImageFilter
  * \sa PersistentStatisticsImageFilter
  * \sa PersistentImageStreamingDecorator.
@@ -138,6 +144,15 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /** Set the fused execution of the fusable filters of the input
+   *  pipeline On or Off (default is Off) */
+  itkSetMacro(FusedTileExecution, bool);
+  itkGetConstReferenceMacro(FusedTileExecution, bool);
+  itkBooleanMacro(FusedTileExecution);
+
+  /** Executor of the fused filters, to tune the tile size */
+  itkGetObjectMacro(FusedTileExecutor, FusedTileExecutor);
+
   /** Override Update() from ProcessObject
    *  This filter does not produce an output */
   void Update() override;
@@ -189,6 +204,9 @@ private:
 
   StreamingManagerPointerType m_StreamingManager;
 
+  bool                       m_FusedTileExecution;
+  FusedTileExecutor::Pointer m_FusedTileExecutor;
+
   bool          m_IsObserving;
   unsigned long m_ObserverID;
 
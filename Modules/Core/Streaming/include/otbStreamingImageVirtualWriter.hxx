@@ -39,7 +39,13 @@ namespace otb
 
 template <class TInputImage>
 StreamingImageVirtualWriter<TInputImage>::StreamingImageVirtualWriter()
-  : m_NumberOfDivisions(0), m_CurrentDivision(0), m_DivisionProgress(0.0), m_IsObserving(true), m_ObserverID(0)
+  : m_NumberOfDivisions(0),
+    m_CurrentDivision(0),
+    m_DivisionProgress(0.0),
+    m_FusedTileExecution(false),
+    m_FusedTileExecutor(FusedTileExecutor::New()),
+    m_IsObserving(true),
+    m_ObserverID(0)
 {
   // By default, we use tiled streaming, with automatic tile size
   // We don't set any parameter, so the memory size is retrieved from the OTB configuration options
@@ -55,6 +61,7 @@ template <class TInputImage>
 void StreamingImageVirtualWriter<TInputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "FusedTileExecution: " << (m_FusedTileExecution ? "On" : "Off") << "\n";
 }
 
 template <class TInputImage>
@@ -221,8 +228,15 @@ void StreamingImageVirtualWriter<TInputImage>::GenerateData(void)
     // inputPtr->SetRequestedRegion(streamRegion);
     // inputPtr->Update();
     inputPtr->SetRequestedRegion(streamRegion);
-    inputPtr->PropagateRequestedRegion();
-    inputPtr->UpdateOutputData();
+
+    // Fall back on the regular pipeline update when the input is not
+    // produced by a chain of fusable filters
+    itk::ImageBase<2>* fusedImage = m_FusedTileExecution ? dynamic_cast<itk::ImageBase<2>*>(inputPtr.GetPointer()) : nullptr;
+    if (fusedImage == nullptr || !m_FusedTileExecutor->GenerateRegion(fusedImage, streamRegion))
+    {
+      inputPtr->PropagateRequestedRegion();
+      inputPtr->UpdateOutputData();
+    }
   }
 
   /**
@@ -94,6 +94,12 @@ public:
   itkSetMacro(DefaultRAM, MemoryPrintType);
   itkGetMacro(DefaultRAM, MemoryPrintType);
 
+  /** Number of copies of each split held outside of the pipeline, for
+   *  instance by a writer still writing a previous split. They are added
+   *  to the pipeline memory print when estimating the number of divisions. */
+  itkSetMacro(NumberOfPendingBuffers, unsigned int);
+  itkGetMacro(NumberOfPendingBuffers, unsigned int);
+
 protected:
   StreamingManager();
   ~StreamingManager() override;
@@ -121,6 +127,9 @@ private:
 
   /** Default available RAM in MB */
   MemoryPrintType m_DefaultRAM;
+
+  /** Number of split copies held outside of the pipeline */
+  unsigned int m_NumberOfPendingBuffers;
 };
 
 } // End namespace otb
@@ -24,12 +24,13 @@
 #include "otbStreamingManager.h"
 #include "otbConfigurationManager.h"
 #include "itkExtractImageFilter.h"
+#include <type_traits>
 
 namespace otb
 {
 
 template <class TImage>
-StreamingManager<TImage>::StreamingManager() : m_ComputedNumberOfSplits(0), m_DefaultRAM(0)
+StreamingManager<TImage>::StreamingManager() : m_ComputedNumberOfSplits(0), m_DefaultRAM(0), m_NumberOfPendingBuffers(0)
 {
 }
 
@@ -133,6 +134,14 @@ unsigned int StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::Dat
 
       pipelineMemoryPrint -= extractContrib;
     }
+
+    // Add the split copies held outside of the pipeline. Scalar and fixed-size pixels
+    // (e.g. RGB) are stored whole, only VectorImage stores one InternalPixelType per band.
+    const std::size_t pixelSize = std::is_same<typename ImageType::PixelType, PixelType>::value
+                                      ? sizeof(typename ImageType::PixelType)
+                                      : inputImage->GetNumberOfComponentsPerPixel() * sizeof(PixelType);
+
+    pipelineMemoryPrint += static_cast<MemoryPrintType>(m_NumberOfPendingBuffers) * region.GetNumberOfPixels() * pixelSize;
   }
   else
   {
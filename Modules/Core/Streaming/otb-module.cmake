@@ -33,6 +33,7 @@ ENABLE_SHARED
     OTBImageList
 
   TEST_DEPENDS
+    OTBFunctor
     OTBImageIO
     OTBStatistics
     OTBTestKernel
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbFusedTileExecutor.h"
+
+#include "otbMacro.h"
+#include "itkProcessObject.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+FusedTileExecutor::FusedTileExecutor()
+  : m_TileSize(16384),
+    m_MinimumNumberOfFusedFilters(2),
+    m_NumberOfThreads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads()),
+    m_NumberOfFusedFilters(0),
+    m_Head(nullptr),
+    m_Output(nullptr),
+    m_NextTile(0)
+{
+}
+
+void FusedTileExecutor::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Tile size:                          " << m_TileSize << std::endl;
+  os << indent << "Minimum number of fused filters:    " << m_MinimumNumberOfFusedFilters << std::endl;
+  os << indent << "Number of threads:                  " << m_NumberOfThreads << std::endl;
+  os << indent << "Number of fused filters:            " << m_NumberOfFusedFilters << std::endl;
+}
+
+bool FusedTileExecutor::GenerateRegion(ImageBaseType* image, const RegionType& region)
+{
+  m_NumberOfFusedFilters = 0;
+
+  // Walk up the pipeline while the sources are fusable filters
+  std::vector<FusableImageFilterInterface*> chain;
+  ImageBaseType*                            head = image;
+  while (true)
+  {
+    FusableImageFilterInterface* filter = dynamic_cast<FusableImageFilterInterface*>(head->GetSource().GetPointer());
+    if (filter == nullptr || !filter->IsFusable())
+    {
+      break;
+    }
+    ImageBaseType* input = filter->GetFusedInput();
+    if (input == nullptr || !input->GetLargestPossibleRegion().IsInside(region))
+    {
+      break;
+    }
+    chain.push_back(filter);
+    head = input;
+  }
+
+  if (chain.empty() || chain.size() < m_MinimumNumberOfFusedFilters)
+  {
+    return false;
+  }
+
+  // The chain is processed from the input to the requested image
+  std::reverse(chain.begin(), chain.end());
+
+  // Update the input of the chain through the regular pipeline
+  head->SetRequestedRegion(region);
+  head->PropagateRequestedRegion();
+  head->UpdateOutputData();
+
+  if (!head->GetBufferedRegion().IsInside(region))
+  {
+    itkExceptionMacro(<< "The input of the fused filters does not buffer the requested region " << region);
+  }
+
+  image->SetRequestedRegion(region);
+  image->SetBufferedRegion(region);
+  image->Allocate();
+
+  // Split the region in tiles of whole lines, or of parts of a line
+  // when a line is larger than a tile
+  const itk::SizeValueType tileWidth = std::min<itk::SizeValueType>(region.GetSize(0), std::max(1u, m_TileSize));
+  const itk::SizeValueType tileLines = std::max<itk::SizeValueType>(1, m_TileSize / tileWidth);
+
+  m_Tiles.clear();
+  for (itk::SizeValueType y = 0; y < region.GetSize(1); y += tileLines)
+  {
+    for (itk::SizeValueType x = 0; x < region.GetSize(0); x += tileWidth)
+    {
+      RegionType tile;
+      tile.SetIndex(0, region.GetIndex(0) + x);
+      tile.SetIndex(1, region.GetIndex(1) + y);
+      tile.SetSize(0, std::min(tileWidth, region.GetSize(0) - x));
+      tile.SetSize(1, std::min(tileLines, region.GetSize(1) - y));
+      m_Tiles.push_back(tile);
+    }
+  }
+
+  otbMsgDevMacro(<< "Fusing " << chain.size() << " filters over " << m_Tiles.size() << " tiles of " << region);
+
+  m_Chain     = chain;
+  m_Head      = head;
+  m_Output    = image;
+  m_NextTile  = 0;
+  m_Exception = nullptr;
+
+  if (!m_Tiles.empty())
+  {
+    itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+    threader->SetNumberOfThreads(std::min<std::size_t>(std::max<itk::ThreadIdType>(1, m_NumberOfThreads), m_Tiles.size()));
+    threader->SetSingleMethod(&Self::ThreaderCallback, this);
+    threader->SingleMethodExecute();
+  }
+
+  m_Chain.clear();
+  m_Head   = nullptr;
+  m_Output = nullptr;
+
+  if (m_Exception)
+  {
+    std::exception_ptr exception = m_Exception;
+    m_Exception                  = nullptr;
+    std::rethrow_exception(exception);
+  }
+
+  m_NumberOfFusedFilters = chain.size();
+  return true;
+}
+
+ITK_THREAD_RETURN_TYPE FusedTileExecutor::ThreaderCallback(void* arg)
+{
+  Self* self = static_cast<Self*>(static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg)->UserData);
+
+  self->ProcessTiles();
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+void FusedTileExecutor::ProcessTiles()
+{
+  try
+  {
+    // Scratch images of the intermediate filters, reused for all the
+    // tiles of this thread
+    std::vector<ImageBaseType::Pointer> scratches;
+    for (std::size_t i = 0; i + 1 < m_Chain.size(); ++i)
+    {
+      scratches.push_back(m_Chain[i]->CreateFusedOutput());
+    }
+
+    for (std::size_t tileIndex = m_NextTile++; tileIndex < m_Tiles.size(); tileIndex = m_NextTile++)
+    {
+      const RegionType& tile = m_Tiles[tileIndex];
+
+      const ImageBaseType* input = m_Head;
+      for (std::size_t i = 0; i < m_Chain.size(); ++i)
+      {
+        ImageBaseType* output = m_Output;
+        if (i < scratches.size())
+        {
+          // Allocate() only grows the buffer when the tile is larger
+          output = scratches[i];
+          output->SetBufferedRegion(tile);
+          output->Allocate();
+        }
+        m_Chain[i]->GenerateFusedRegion(input, output, tile);
+        input = output;
+      }
+    }
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(m_ExceptionMutex);
+    if (!m_Exception)
+    {
+      m_Exception = std::current_exception();
+    }
+    // Stop the other threads
+    m_NextTile = m_Tiles.size();
+  }
+}
+
+} // end namespace otb
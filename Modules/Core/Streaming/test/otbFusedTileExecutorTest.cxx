@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include "otbFusedTileExecutor.h"
+#include "otbFunctorImageFilter.h"
+#include "otbImage.h"
+#include "otbStreamingImageVirtualWriter.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionConstIterator.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <type_traits>
+
+int otbFusedTileExecutorTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  using InputImageType = otb::Image<float>;
+  using RegionType     = InputImageType::RegionType;
+
+  RegionType largestRegion;
+  largestRegion.SetSize(0, 100);
+  largestRegion.SetSize(1, 37);
+
+  auto input = InputImageType::New();
+  input->SetRegions(largestRegion);
+  input->Allocate();
+  float* buffer = input->GetBufferPointer();
+  for (size_t i = 0; i < largestRegion.GetNumberOfPixels(); ++i)
+  {
+    buffer[i] = static_cast<float>((i * 7919) % 1000) / 10.f;
+  }
+
+  // A chain of three fusable filters, with scalar and vector outputs
+  auto affine = [](float x) { return 2.f * x + 1.f; };
+  auto square = [](float x) { return static_cast<double>(x) * x; };
+  auto split  = [](double x) {
+    itk::VariableLengthVector<double> out(2);
+    out[0] = x / 3.;
+    out[1] = x - 5.;
+    return out;
+  };
+
+  // Reference from the regular pipeline
+  auto affineFilter = otb::NewFunctorFilter(affine);
+  auto squareFilter = otb::NewFunctorFilter(square);
+  auto splitFilter  = otb::NewFunctorFilter(split, 2);
+  affineFilter->SetInput(input);
+  squareFilter->SetInput(affineFilter->GetOutput());
+  splitFilter->SetInput(squareFilter->GetOutput());
+  splitFilter->Update();
+
+  // Fused execution of the same chain, on a sub-region
+  auto fusedAffineFilter = otb::NewFunctorFilter(affine);
+  auto fusedSquareFilter = otb::NewFunctorFilter(square);
+  auto fusedSplitFilter  = otb::NewFunctorFilter(split, 2);
+  fusedAffineFilter->SetInput(input);
+  fusedSquareFilter->SetInput(fusedAffineFilter->GetOutput());
+  fusedSplitFilter->SetInput(fusedSquareFilter->GetOutput());
+  fusedSplitFilter->UpdateOutputInformation();
+
+  RegionType region;
+  region.SetIndex(0, 3);
+  region.SetIndex(1, 5);
+  region.SetSize(0, 90);
+  region.SetSize(1, 30);
+
+  auto executor = otb::FusedTileExecutor::New();
+  executor->SetMinimumNumberOfFusedFilters(4);
+  if (executor->GenerateRegion(fusedSplitFilter->GetOutput(), region))
+  {
+    std::cerr << "A chain shorter than the minimum number of filters was fused" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tiles are smaller than a line, so that lines are split
+  executor->SetMinimumNumberOfFusedFilters(2);
+  executor->SetTileSize(64);
+  executor->SetNumberOfThreads(3);
+  if (!executor->GenerateRegion(fusedSplitFilter->GetOutput(), region) || executor->GetNumberOfFusedFilters() != 3)
+  {
+    std::cerr << "The chain was not fused: " << executor->GetNumberOfFusedFilters() << " fused filters" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using OutputImageType = std::remove_pointer<decltype(splitFilter->GetOutput())>::type;
+  itk::ImageRegionConstIterator<OutputImageType> refIt(splitFilter->GetOutput(), region);
+  itk::ImageRegionConstIterator<OutputImageType> fusedIt(fusedSplitFilter->GetOutput(), region);
+  for (; !refIt.IsAtEnd(); ++refIt, ++fusedIt)
+  {
+    if (refIt.Get() != fusedIt.Get())
+    {
+      std::cerr << "Fused output " << fusedIt.Get() << " differs from " << refIt.Get() << " at " << refIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Streaming the chain through a virtual writer, which fuses each piece
+  auto streamedAffineFilter = otb::NewFunctorFilter(affine);
+  auto streamedSquareFilter = otb::NewFunctorFilter(square);
+  auto streamedSplitFilter  = otb::NewFunctorFilter(split, 2);
+  streamedAffineFilter->SetInput(input);
+  streamedSquareFilter->SetInput(streamedAffineFilter->GetOutput());
+  streamedSplitFilter->SetInput(streamedSquareFilter->GetOutput());
+
+  auto virtualWriter = otb::StreamingImageVirtualWriter<OutputImageType>::New();
+  virtualWriter->SetInput(streamedSplitFilter->GetOutput());
+  virtualWriter->SetNumberOfDivisionsStrippedStreaming(4);
+  virtualWriter->FusedTileExecutionOn();
+  virtualWriter->GetFusedTileExecutor()->SetMinimumNumberOfFusedFilters(2);
+  virtualWriter->Update();
+
+  if (virtualWriter->GetFusedTileExecutor()->GetNumberOfFusedFilters() != 3)
+  {
+    std::cerr << "The virtual writer did not fuse the chain: " << virtualWriter->GetFusedTileExecutor()->GetNumberOfFusedFilters() << " fused filters"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The last piece is left in the output of the chain
+  const RegionType lastPiece = streamedSplitFilter->GetOutput()->GetBufferedRegion();
+  itk::ImageRegionConstIterator<OutputImageType> lastRefIt(splitFilter->GetOutput(), lastPiece);
+  itk::ImageRegionConstIterator<OutputImageType> streamedIt(streamedSplitFilter->GetOutput(), lastPiece);
+  for (; !lastRefIt.IsAtEnd(); ++lastRefIt, ++streamedIt)
+  {
+    if (lastRefIt.Get() != streamedIt.Get())
+    {
+      std::cerr << "Streamed output " << streamedIt.Get() << " differs from " << lastRefIt.Get() << " at " << lastRefIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -114,6 +114,10 @@ public:
   /**  Method to transform a point. */
   SecondTransformOutputPointType TransformPoint(const FirstTransformInputPointType&) const override;
 
+  /**  Method to transform a batch of points: the whole batch goes through
+   *  the first transform, then through the second one. */
+  void TransformPoints(Span<const FirstTransformInputPointType> in, Span<SecondTransformOutputPointType> out) const override;
+
   /**  Method to transform a vector. */
   //  virtual OutputVectorType TransformVector(const InputVectorType &) const;
 
@@ -25,6 +25,7 @@
 
 #include "otbGenericMapProjection.h"
 #include "itkIdentityTransform.h"
+#include <vector>
 
 namespace otb
 {
@@ -55,6 +56,15 @@ CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensi
   return outputPoint;
 }
 
+template <class TFirstTransform, class TSecondTransform, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(
+    Span<const FirstTransformInputPointType> in, Span<SecondTransformOutputPointType> out) const
+{
+  std::vector<FirstTransformOutputPointType> geoPoints(in.size());
+  otb::TransformPoints(*m_FirstTransform, in, geoPoints);
+  otb::TransformPoints(*m_SecondTransform, geoPoints, out);
+}
+
 /*template<class TFirstTransform, class TSecondTransform, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
   typename CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>::OutputVectorType
   CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>
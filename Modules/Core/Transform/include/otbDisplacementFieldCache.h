@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDisplacementFieldCache_h
+#define otbDisplacementFieldCache_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace otb
+{
+
+/** \class DisplacementFieldCache
+ * \brief Thread-safe cache of a displacement field, computed lazily by blocks.
+ *
+ * The cached field covers the largest possible region of a reference
+ * image and is divided into blocks of BlockSize nodes. A block is computed
+ * the first time a region intersecting it is fetched, and is then kept in
+ * memory. Streaming tiles, which share the nodes of their borders and the
+ * margin required by the interpolation, thus only copy values computed
+ * once for the whole field.
+ *
+ * Blocks are dropped when the geometry of the reference image or the key
+ * given to Initialize() change. The key only identifies the field for the
+ * filter owning the cache (TransformToDisplacementFieldSource uses its
+ * modification time), so a cache must not be shared between filters.
+ *
+ * \sa TransformToDisplacementFieldSource
+ *
+ * \ingroup OTBTransform
+ */
+template <class TImage>
+class ITK_EXPORT DisplacementFieldCache : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef DisplacementFieldCache        Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(DisplacementFieldCache, itk::Object);
+
+  typedef TImage                         ImageType;
+  typedef typename ImageType::Pointer    ImagePointerType;
+  typedef typename ImageType::RegionType RegionType;
+  typedef typename ImageType::SizeType   SizeType;
+  typedef typename ImageType::IndexType  IndexType;
+
+  /** Function computing the field over a region of the given image */
+  typedef std::function<void(ImageType*, const RegionType&)> ComputeFunctionType;
+
+  /** Function called with the number of pixels copied from each block */
+  typedef std::function<void(itk::SizeValueType)> ProgressFunctionType;
+
+  /** Set the size of the blocks, in nodes of the field. Drops the
+   * computed blocks. */
+  void SetBlockSize(const SizeType& blockSize);
+  itkGetConstReferenceMacro(BlockSize, SizeType);
+
+  /** Prepare the cache for the field of the reference image. Computed
+   * blocks are dropped if its geometry or the key differ from the ones
+   * of the previous call. Not thread-safe. */
+  void Initialize(const ImageType* reference, itk::ModifiedTimeType key);
+
+  /** Copy the field over the region into the image, computing the
+   * missing blocks with the compute function first. The region must be
+   * inside the largest possible region of the reference. Thread-safe:
+   * each block is computed only once, even when fetched concurrently.
+   * The optional progress function is called after each block copy. */
+  void Fetch(ImageType* image, const RegionType& region, const ComputeFunctionType& compute, const ProgressFunctionType& progress = nullptr);
+
+  /** Drop all the computed blocks */
+  void Clear();
+
+  /** Get the number of blocks computed since the cache was last
+   * invalidated */
+  unsigned long GetNumberOfComputedBlocks() const
+  {
+    return m_NumberOfComputedBlocks;
+  }
+
+protected:
+  DisplacementFieldCache();
+  ~DisplacementFieldCache() override = default;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  DisplacementFieldCache(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  struct Block
+  {
+    std::mutex       Mutex;
+    ImagePointerType Field;
+  };
+
+  /** Region of the field covered by a block */
+  RegionType GetBlockRegion(const IndexType& blockIndex) const;
+
+  SizeType                            m_BlockSize;
+  SizeType                            m_NumberOfBlocks;
+  ImagePointerType                    m_Geometry;
+  itk::ModifiedTimeType               m_Key;
+  std::vector<std::unique_ptr<Block>> m_Blocks;
+  std::atomic<unsigned long>          m_NumberOfComputedBlocks;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbDisplacementFieldCache.hxx"
+#endif
+
+#endif
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDisplacementFieldCache_hxx
+#define otbDisplacementFieldCache_hxx
+
+#include "otbDisplacementFieldCache.h"
+#include "itkImageAlgorithm.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TImage>
+DisplacementFieldCache<TImage>::DisplacementFieldCache() : m_Key(0), m_NumberOfComputedBlocks(0)
+{
+  m_BlockSize.Fill(64);
+  m_NumberOfBlocks.Fill(0);
+}
+
+template <class TImage>
+void DisplacementFieldCache<TImage>::SetBlockSize(const SizeType& blockSize)
+{
+  for (unsigned int dim = 0; dim < ImageType::ImageDimension; ++dim)
+  {
+    if (blockSize[dim] == 0)
+    {
+      itkExceptionMacro(<< "Block size must not be null, got " << blockSize);
+    }
+  }
+
+  if (blockSize != m_BlockSize)
+  {
+    m_BlockSize = blockSize;
+    this->Clear();
+    this->Modified();
+  }
+}
+
+template <class TImage>
+void DisplacementFieldCache<TImage>::Initialize(const ImageType* reference, itk::ModifiedTimeType key)
+{
+  const bool sameField = m_Geometry && key == m_Key && m_Geometry->GetLargestPossibleRegion() == reference->GetLargestPossibleRegion() &&
+                         m_Geometry->GetOrigin() == reference->GetOrigin() && m_Geometry->GetSpacing() == reference->GetSpacing() &&
+                         m_Geometry->GetDirection() == reference->GetDirection();
+  if (sameField)
+  {
+    return;
+  }
+
+  this->Clear();
+
+  m_Key      = key;
+  m_Geometry = ImageType::New();
+  m_Geometry->CopyInformation(reference);
+
+  const SizeType& size = reference->GetLargestPossibleRegion().GetSize();
+  for (unsigned int dim = 0; dim < ImageType::ImageDimension; ++dim)
+  {
+    m_NumberOfBlocks[dim] = (size[dim] + m_BlockSize[dim] - 1) / m_BlockSize[dim];
+  }
+
+  RegionType blocks;
+  blocks.SetSize(m_NumberOfBlocks);
+  m_Blocks.resize(blocks.GetNumberOfPixels());
+  for (auto& block : m_Blocks)
+  {
+    block.reset(new Block);
+  }
+}
+
+template <class TImage>
+void DisplacementFieldCache<TImage>::Fetch(ImageType* image, const RegionType& region, const ComputeFunctionType& compute,
+                                           const ProgressFunctionType& progress)
+{
+  if (!m_Geometry)
+  {
+    itkExceptionMacro(<< "The cache must be initialized before fetching the field");
+  }
+
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  const RegionType& largest = m_Geometry->GetLargestPossibleRegion();
+  if (!largest.IsInside(region))
+  {
+    itkExceptionMacro(<< "Region " << region << " is outside of the cached field " << largest);
+  }
+
+  // Range of blocks intersecting the region
+  IndexType firstBlock;
+  SizeType  blockRange;
+  for (unsigned int dim = 0; dim < ImageType::ImageDimension; ++dim)
+  {
+    const auto first = (region.GetIndex(dim) - largest.GetIndex(dim)) / m_BlockSize[dim];
+    const auto last  = (region.GetIndex(dim) + region.GetSize(dim) - 1 - largest.GetIndex(dim)) / m_BlockSize[dim];
+    firstBlock[dim]  = first;
+    blockRange[dim]  = last - first + 1;
+  }
+
+  RegionType blocks(firstBlock, blockRange);
+  for (itk::SizeValueType n = 0; n < blocks.GetNumberOfPixels(); ++n)
+  {
+    IndexType          blockIndex;
+    itk::SizeValueType blockId = 0;
+    itk::SizeValueType stride  = 1;
+    itk::SizeValueType offset  = n;
+    for (unsigned int dim = 0; dim < ImageType::ImageDimension; ++dim)
+    {
+      blockIndex[dim] = firstBlock[dim] + offset % blockRange[dim];
+      offset /= blockRange[dim];
+      blockId += blockIndex[dim] * stride;
+      stride *= m_NumberOfBlocks[dim];
+    }
+
+    const RegionType blockRegion = this->GetBlockRegion(blockIndex);
+    Block&           block       = *m_Blocks[blockId];
+    ImagePointerType field;
+    {
+      std::lock_guard<std::mutex> lock(block.Mutex);
+      if (!block.Field)
+      {
+        ImagePointerType newField = ImageType::New();
+        newField->CopyInformation(m_Geometry);
+        newField->SetBufferedRegion(blockRegion);
+        newField->SetRequestedRegion(blockRegion);
+        newField->Allocate();
+        compute(newField, blockRegion);
+
+        block.Field = newField;
+        ++m_NumberOfComputedBlocks;
+      }
+      field = block.Field;
+    }
+
+    RegionType copyRegion = blockRegion;
+    copyRegion.Crop(region);
+    itk::ImageAlgorithm::Copy(field.GetPointer(), image, copyRegion, copyRegion);
+
+    if (progress)
+    {
+      progress(copyRegion.GetNumberOfPixels());
+    }
+  }
+}
+
+template <class TImage>
+void DisplacementFieldCache<TImage>::Clear()
+{
+  m_Blocks.clear();
+  m_Geometry = nullptr;
+  m_NumberOfBlocks.Fill(0);
+  m_NumberOfComputedBlocks = 0;
+}
+
+template <class TImage>
+typename DisplacementFieldCache<TImage>::RegionType DisplacementFieldCache<TImage>::GetBlockRegion(const IndexType& blockIndex) const
+{
+  const RegionType& largest = m_Geometry->GetLargestPossibleRegion();
+
+  RegionType blockRegion;
+  for (unsigned int dim = 0; dim < ImageType::ImageDimension; ++dim)
+  {
+    const itk::SizeValueType start = blockIndex[dim] * m_BlockSize[dim];
+    blockRegion.SetIndex(dim, largest.GetIndex(dim) + start);
+    blockRegion.SetSize(dim, std::min(m_BlockSize[dim], largest.GetSize(dim) - start));
+  }
+  return blockRegion;
+}
+
+template <class TImage>
+void DisplacementFieldCache<TImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "BlockSize: " << m_BlockSize << std::endl;
+  os << indent << "NumberOfBlocks: " << m_NumberOfBlocks << std::endl;
+  os << indent << "NumberOfComputedBlocks: " << m_NumberOfComputedBlocks.load() << std::endl;
+}
+
+} // end namespace otb
+
+#endif
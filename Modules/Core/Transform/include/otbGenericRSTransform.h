@@ -159,6 +159,8 @@ public:
 
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  void TransformPoints(Span<const InputPointType> in, Span<OutputPointType> out) const override;
+
   virtual void InstantiateTransform();
 
   // Get inverse methods
@@ -31,6 +31,8 @@
 #include "ogr_spatialref.h"
 #include "otbSensorTransformFactory.h"
 
+#include <vector>
+
 namespace otb
 {
 
@@ -238,6 +240,33 @@ GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformP
   return outputPoint;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(Span<const InputPointType> in, Span<OutputPointType> out) const
+{
+  assert(in.size() == out.size());
+  std::vector<typename TransformType::InputPointType>  inputPoints(in.size());
+  std::vector<typename TransformType::OutputPointType> outputPoints(in.size());
+
+  // Apply input origin/spacing
+  for (std::size_t i = 0; i < in.size(); ++i)
+  {
+    inputPoints[i]    = in[i];
+    inputPoints[i][0] = in[i][0] * m_InputSpacing[0] + m_InputOrigin[0];
+    inputPoints[i][1] = in[i][1] * m_InputSpacing[1] + m_InputOrigin[1];
+  }
+
+  // Transform the whole batch at once
+  this->GetTransform()->TransformPoints(inputPoints, outputPoints);
+
+  // Apply output origin/spacing
+  for (std::size_t i = 0; i < in.size(); ++i)
+  {
+    out[i]    = outputPoints[i];
+    out[i][0] = (outputPoints[i][0] - m_OutputOrigin[0]) / m_OutputSpacing[0];
+    out[i][1] = (outputPoints[i][1] - m_OutputOrigin[1]) / m_OutputSpacing[1];
+  }
+}
+
 template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
 bool GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>::GetInverse(Self* inverseTransform) const
 {
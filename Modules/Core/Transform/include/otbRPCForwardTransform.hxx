@@ -23,6 +23,9 @@
 
 #include "otbRPCForwardTransform.h"
 
+#include <stdexcept>
+#include <vector>
+
 namespace otb
 {
 template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
@@ -51,6 +54,38 @@ RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::Transform
   return pOut;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(Span<const InputPointType> in,
+                                                                                         Span<OutputPointType>      out) const
+{
+  assert(in.size() == out.size());
+  if (in.empty())
+    return;
+
+  const std::size_t   nbPoints = in.size();
+  std::vector<double> x(nbPoints), y(nbPoints), z(nbPoints);
+  for (std::size_t i = 0; i < nbPoints; ++i)
+  {
+    x[i] = static_cast<double>(in[i][0]);
+    y[i] = static_cast<double>(in[i][1]);
+    if (NInputDimensions > 2)
+      z[i] = static_cast<double>(in[i][2]);
+    else
+      z[i] = 0.;
+  }
+
+  if (!this->m_Transformer->ForwardTransform(x.data(), y.data(), z.data(), static_cast<int>(nbPoints)))
+    throw std::runtime_error("GDALRPCTransform was not able to process the ForwardTransform.");
+
+  for (std::size_t i = 0; i < nbPoints; ++i)
+  {
+    out[i][0] = static_cast<TScalarType>(x[i]);
+    out[i][1] = static_cast<TScalarType>(y[i]);
+    if (NOutputDimensions > 2)
+      out[i][2] = static_cast<TScalarType>(z[i]);
+  }
+}
+
 /**
  * PrintSelf method
  */
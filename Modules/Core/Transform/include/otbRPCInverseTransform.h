@@ -62,6 +62,10 @@ public:
   /**  Method to transform a point. */
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  /**  Method to transform a batch of points, with a single call to the
+   *   RPC transformer. */
+  void TransformPoints(Span<const InputPointType> in, Span<OutputPointType> out) const override;
+
   RPCInverseTransform();
   ~RPCInverseTransform() = default;
 
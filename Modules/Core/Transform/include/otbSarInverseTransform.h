@@ -62,6 +62,10 @@ public:
   /**  Method to transform a point. */
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  /**  Method to transform a batch of points. When the input points have no
+   *   height, the DEM is sampled for the whole batch at once. */
+  void TransformPoints(Span<const InputPointType> in, Span<OutputPointType> out) const override;
+
   SarInverseTransform();
   ~SarInverseTransform() = default;
 
@@ -24,6 +24,8 @@
 #include "otbSarInverseTransform.h"
 #include "otbDEMHandler.h"
 
+#include <vector>
+
 namespace otb
 {
 template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
@@ -57,6 +59,49 @@ SarInverseTransform<TScalarType, NInputDimensions, NOutputDimensions>::Transform
   return pOut;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void SarInverseTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(Span<const InputPointType> in,
+                                                                                         Span<OutputPointType>      out) const
+{
+  assert(in.size() == out.size());
+  const std::size_t nbPoints = in.size();
+
+  std::vector<double> heights(nbPoints);
+  if (NInputDimensions > 2)
+  {
+    for (std::size_t i = 0; i < nbPoints; ++i)
+      heights[i] = static_cast<double>(in[i][2]);
+  }
+  else
+  {
+    std::vector<double> lon(nbPoints), lat(nbPoints);
+    for (std::size_t i = 0; i < nbPoints; ++i)
+    {
+      lon[i] = static_cast<double>(in[i][0]);
+      lat[i] = static_cast<double>(in[i][1]);
+    }
+    otb::DEMHandler::GetInstance().GetHeightAboveEllipsoid(lon.data(), lat.data(), heights.data(), nbPoints);
+  }
+
+  SarSensorModel::Point2DType sensorPoint;
+  SarSensorModel::Point3DType worldPoint;
+  for (std::size_t i = 0; i < nbPoints; ++i)
+  {
+    worldPoint[0] = static_cast<double>(in[i][0]);
+    worldPoint[1] = static_cast<double>(in[i][1]);
+    worldPoint[2] = heights[i];
+
+    this->m_Transformer->WorldToLineSample(worldPoint, sensorPoint);
+
+    // from centered to upper left corner pixel convention
+    out[i][0] = static_cast<TScalarType>(sensorPoint[0]) + 0.5;
+    out[i][1] = static_cast<TScalarType>(sensorPoint[1]) + 0.5;
+
+    if (NOutputDimensions > 2)
+      out[i][2] = static_cast<TScalarType>(worldPoint[2]);
+  }
+}
+
 /**
  * PrintSelf method
  */
@@ -23,6 +23,8 @@
 
 #include "itkTransform.h"
 #include "vnl/vnl_vector_fixed.h"
+#include "otbSpan.h"
+#include <cassert>
 
 
 namespace otb
@@ -106,6 +108,22 @@ public:
     return OutputPointType();
   }
 
+  /** Method to transform a batch of points.
+   *
+   * The default implementation calls TransformPoint() on each point.
+   * Transforms able to process several points at once (sensor models for
+   * instance) override it.
+   * \pre `in.size() == out.size()`
+   */
+  virtual void TransformPoints(Span<const InputPointType> in, Span<OutputPointType> out) const
+  {
+    assert(in.size() == out.size());
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+      out[i] = this->TransformPoint(in[i]);
+    }
+  }
+
   using Superclass::TransformVector;
   /**  Method to transform a vector. */
   OutputVectorType TransformVector(const InputVectorType&) const override
@@ -255,6 +273,29 @@ private:
   Transform(const Self&) = delete;
   void operator=(const Self&) = delete;
 };
+
+/** Transform a batch of points with any itk::Transform.
+ *
+ * otb::Transform instances process the whole batch through their
+ * TransformPoints() method, other transforms are applied point by point.
+ * \pre `in.size() == out.size()`
+ */
+template <class TTransform>
+void TransformPoints(const TTransform& transform, Span<const typename TTransform::InputPointType> in, Span<typename TTransform::OutputPointType> out)
+{
+  typedef Transform<typename TTransform::ScalarType, TTransform::InputSpaceDimension, TTransform::OutputSpaceDimension> BatchTransformType;
+
+  assert(in.size() == out.size());
+  if (auto batchTransform = dynamic_cast<const BatchTransformType*>(&transform))
+  {
+    batchTransform->TransformPoints(in, out);
+    return;
+  }
+  for (std::size_t i = 0; i < in.size(); ++i)
+  {
+    out[i] = transform.TransformPoint(in[i]);
+  }
+}
 } // end namespace otb
 
 #endif
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbTransformToDisplacementFieldSource_h
+#define otbTransformToDisplacementFieldSource_h
+
+#include "itkTransformToDisplacementFieldSource.h"
+#include "itkProgressReporter.h"
+#include "otbDisplacementFieldCache.h"
+
+namespace otb
+{
+
+/** \class TransformToDisplacementFieldSource
+ * \brief This class acts like the itk::TransformToDisplacementFieldSource,
+ * but it transforms the points of the field line by line.
+ *
+ * For non-linear transforms, the points of each line of the output region
+ * are transformed with a single call to otb::TransformPoints(). Sensor
+ * models such as RPC or SAR models process such a batch much faster than
+ * the same points one by one. Linear transforms keep the fast path of the
+ * superclass.
+ *
+ * With CachingOn(), the field is computed by blocks covering the largest
+ * possible region, and kept by a DisplacementFieldCache private to the
+ * source across updates: streaming several requested regions computes each
+ * node of the field only once. The cache is dropped when the source is
+ * modified. Blocks are always computed line by line, including for linear
+ * transforms.
+ *
+ * \sa itk::TransformToDisplacementFieldSource
+ * \sa otb::Transform::TransformPoints()
+ *
+ * \ingroup Threaded
+ *
+ * \ingroup OTBTransform
+ */
+template <class TOutputImage, class TTransformPrecisionType = double>
+class ITK_EXPORT TransformToDisplacementFieldSource : public itk::TransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>
+{
+public:
+  /** Standard class typedefs. */
+  typedef TransformToDisplacementFieldSource Self;
+  typedef itk::TransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(TransformToDisplacementFieldSource, itk::TransformToDisplacementFieldSource);
+
+  /** Superclass typedefs */
+  typedef typename Superclass::OutputImageType       OutputImageType;
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+  typedef typename Superclass::TransformType         TransformType;
+  typedef typename Superclass::PixelType             PixelType;
+  typedef typename Superclass::PixelValueType        PixelValueType;
+  typedef typename Superclass::IndexType             IndexType;
+
+  typedef DisplacementFieldCache<OutputImageType> CacheType;
+
+  /** Keep the computed field across updates. If off (default), the
+   * requested region is computed at each update. */
+  void SetCaching(bool caching);
+  bool GetCaching() const
+  {
+    return m_Cache.IsNotNull();
+  }
+  itkBooleanMacro(Caching);
+
+  /** Get the cache of the field, for instance to set its block size.
+   * Null when caching is off. */
+  itkGetModifiableObjectMacro(Cache, CacheType);
+
+protected:
+  TransformToDisplacementFieldSource() = default;
+  ~TransformToDisplacementFieldSource() override = default;
+
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  TransformToDisplacementFieldSource(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Compute the field over a region of the given image, line by line */
+  void ComputeDisplacementField(OutputImageType* field, const OutputImageRegionType& region, itk::ProgressReporter* progress) const;
+
+  typename CacheType::Pointer m_Cache;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbTransformToDisplacementFieldSource.hxx"
+#endif
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbTransformToDisplacementFieldSource_hxx
+#define otbTransformToDisplacementFieldSource_hxx
+
+#include "otbTransformToDisplacementFieldSource.h"
+#include "otbTransform.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
+
+#include <vector>
+
+namespace otb
+{
+
+template <class TOutputImage, class TTransformPrecisionType>
+void TransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::SetCaching(bool caching)
+{
+  if (caching == this->GetCaching())
+  {
+    return;
+  }
+
+  m_Cache = caching ? CacheType::New() : nullptr;
+  this->Modified();
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void TransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::BeforeThreadedGenerateData()
+{
+  Superclass::BeforeThreadedGenerateData();
+
+  // The modification time covers the transform and the output parameters.
+  // It only identifies the field for this source, hence the private cache.
+  if (m_Cache)
+  {
+    m_Cache->Initialize(this->GetOutput(), this->GetMTime());
+  }
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void TransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                      itk::ThreadIdType            threadId)
+{
+  if (m_Cache)
+  {
+    // Progress follows the copies into the requested region, as blocks
+    // computed by this thread may also cover regions of other threads
+    itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+    m_Cache->Fetch(this->GetOutput(), outputRegionForThread,
+                   [this](OutputImageType* field, const OutputImageRegionType& region) { this->ComputeDisplacementField(field, region, nullptr); },
+                   [&progress](itk::SizeValueType nbPixels) {
+                     for (itk::SizeValueType i = 0; i < nbPixels; ++i)
+                     {
+                       progress.CompletedPixel();
+                     }
+                   });
+    return;
+  }
+
+  // Linear transforms are handled by the superclass fast path
+  if (this->GetTransform()->IsLinear())
+  {
+    Superclass::ThreadedGenerateData(outputRegionForThread, threadId);
+    return;
+  }
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+  this->ComputeDisplacementField(this->GetOutput(), outputRegionForThread, &progress);
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void TransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::ComputeDisplacementField(OutputImageType*             field,
+                                                                                                          const OutputImageRegionType& region,
+                                                                                                          itk::ProgressReporter*       progress) const
+{
+  const TransformType* transform = this->GetTransform();
+
+  typedef itk::ImageScanlineIterator<OutputImageType> OutputIteratorType;
+  OutputIteratorType outIt(field, region);
+
+  const std::size_t lineLength = region.GetSize()[0];
+  std::vector<typename TransformType::InputPointType>  outputPoints(lineLength);
+  std::vector<typename TransformType::OutputPointType> transformedPoints(lineLength);
+  PixelType deformation;
+
+  outIt.GoToBegin();
+  while (!outIt.IsAtEnd())
+  {
+    // Physical coordinates of the whole line
+    IndexType index = outIt.GetIndex();
+    for (std::size_t i = 0; i < lineLength; ++i, ++index[0])
+    {
+      field->TransformIndexToPhysicalPoint(index, outputPoints[i]);
+    }
+
+    // Transform the line at once
+    otb::TransformPoints(*transform, outputPoints, transformedPoints);
+
+    for (std::size_t i = 0; i < lineLength; ++i)
+    {
+      for (unsigned int d = 0; d < OutputImageType::ImageDimension; ++d)
+      {
+        deformation[d] = static_cast<PixelValueType>(transformedPoints[i][d] - outputPoints[i][d]);
+      }
+      outIt.Set(deformation);
+      ++outIt;
+      if (progress)
+      {
+        progress->CompletedPixel();
+      }
+    }
+    outIt.NextLine();
+  }
+}
+
+} // end namespace otb
+
+#endif
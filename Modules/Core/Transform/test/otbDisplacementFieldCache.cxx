@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbTransformToDisplacementFieldSource.h"
+#include "otbLogPolarTransform.h"
+#include "otbImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkVector.h"
+#include <cstdlib>
+#include <iostream>
+
+int otbDisplacementFieldCache(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef itk::Vector<double, 2> DisplacementType;
+  typedef otb::Image<DisplacementType> DisplacementFieldType;
+  typedef otb::TransformToDisplacementFieldSource<DisplacementFieldType> SourceType;
+  typedef SourceType::CacheType         CacheType;
+  typedef otb::LogPolarTransform<double> TransformType;
+
+  TransformType::Pointer        transform = TransformType::New();
+  TransformType::ParametersType params(4);
+  params[0] = 10.;
+  params[1] = -5.;
+  params[2] = 0.01;
+  params[3] = 0.5;
+  transform->SetParameters(params);
+
+  SourceType::SizeType size;
+  size[0] = 101;
+  size[1] = 57;
+  SourceType::IndexType index;
+  index[0] = 3;
+  index[1] = -2;
+  SourceType::SpacingType spacing;
+  spacing.Fill(1.5);
+  SourceType::OriginType origin;
+  origin[0] = -12.;
+  origin[1] = 4.;
+
+  auto configure = [&](SourceType* source) {
+    source->SetTransform(transform);
+    source->SetOutputSize(size);
+    source->SetOutputIndex(index);
+    source->SetOutputSpacing(spacing);
+    source->SetOutputOrigin(origin);
+  };
+
+  // Reference field, computed at once without cache
+  SourceType::Pointer reference = SourceType::New();
+  configure(reference);
+  reference->Update();
+
+  // Cached field, streamed through overlapping regions
+  SourceType::Pointer cached = SourceType::New();
+  configure(cached);
+  cached->CachingOn();
+  cached->UpdateOutputInformation();
+
+  CacheType*          cache = cached->GetModifiableCache();
+  CacheType::SizeType blockSize;
+  blockSize[0] = 16;
+  blockSize[1] = 7;
+  cache->SetBlockSize(blockSize);
+
+  const SourceType::OutputImageRegionType largest = cached->GetOutput()->GetLargestPossibleRegion();
+  const unsigned long nbBlocks = ((size[0] + blockSize[0] - 1) / blockSize[0]) * ((size[1] + blockSize[1] - 1) / blockSize[1]);
+
+  for (unsigned int tile = 0; tile < 6; ++tile)
+  {
+    // Tiles overlap by a few lines, as streamed resampling does
+    SourceType::OutputImageRegionType region = largest;
+    region.SetIndex(1, largest.GetIndex(1) + tile * 10 - 2);
+    region.SetSize(1, 14);
+    region.Crop(largest);
+
+    cached->GetOutput()->SetRequestedRegion(region);
+    cached->Update();
+
+    itk::ImageRegionConstIteratorWithIndex<DisplacementFieldType> itRef(reference->GetOutput(), region);
+    itk::ImageRegionConstIteratorWithIndex<DisplacementFieldType> itCached(cached->GetOutput(), region);
+    for (; !itRef.IsAtEnd(); ++itRef, ++itCached)
+    {
+      if (itRef.Get() != itCached.Get())
+      {
+        std::cerr << "Cached field differs at " << itRef.GetIndex() << ": " << itCached.Get() << " instead of " << itRef.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Each block was computed once
+  if (cache->GetNumberOfComputedBlocks() != nbBlocks)
+  {
+    std::cerr << cache->GetNumberOfComputedBlocks() << " blocks computed instead of " << nbBlocks << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Changing the transform invalidates the cache
+  params[2] = 0.02;
+  transform->SetParameters(params);
+  cached->GetOutput()->SetRequestedRegion(largest);
+  cached->Update();
+  reference->Update();
+
+  itk::ImageRegionConstIteratorWithIndex<DisplacementFieldType> itRef(reference->GetOutput(), largest);
+  itk::ImageRegionConstIteratorWithIndex<DisplacementFieldType> itCached(cached->GetOutput(), largest);
+  for (; !itRef.IsAtEnd(); ++itRef, ++itCached)
+  {
+    if (itRef.Get() != itCached.Get())
+    {
+      std::cerr << "The cache was not invalidated by the transform: field differs at " << itRef.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
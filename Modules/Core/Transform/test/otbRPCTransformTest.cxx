@@ -18,6 +18,8 @@
  * limitations under the License.
  */
 
+#include <functional>
+
 #include "itkPoint.h"
 #include "itkEuclideanDistanceMetric.h"
 #include "otbGeographicalDistance.h"
@@ -182,7 +184,34 @@ int otbRPCTransformTest(int argc, char* argv[])
        success = false;
      }
   }
-  
+
+  // The batch transforms must give the same results as the point by point ones
+  auto checkBatch = [&success](const char* name, const PointsContainerType& batch, const PointsContainerType& input,
+                               const std::function<PointType(const PointType&)>& transformPoint) {
+    for (std::size_t i = 0; i < input.size(); ++i)
+    {
+      const PointType expected = transformPoint(input[i]);
+      if (batch[i].EuclideanDistanceTo(expected) > 1e-9)
+      {
+        std::cerr << name << "->TransformPoints differs from TransformPoint for " << input[i] << ": " << batch[i] << " vs " << expected << std::endl;
+        success = false;
+      }
+    }
+  };
+
+  PointsContainerType batchPoints(pointsContainer.size());
+  ForwardTransform->TransformPoints(pointsContainer, batchPoints);
+  checkBatch("ForwardTransform", batchPoints, pointsContainer, [&](const PointType& p) { return ForwardTransform->TransformPoint(p); });
+  GenericRSTransform_img2wgs->TransformPoints(pointsContainer, batchPoints);
+  checkBatch("GenericRSTransform_img2wgs", batchPoints, pointsContainer, [&](const PointType& p) { return GenericRSTransform_img2wgs->TransformPoint(p); });
+
+  batchPoints.resize(geo3dPointsContainer.size());
+  InverseTransform->TransformPoints(geo3dPointsContainer, batchPoints);
+  checkBatch("InverseTransform", batchPoints, geo3dPointsContainer, [&](const PointType& p) { return InverseTransform->TransformPoint(p); });
+  GenericRSTransform_wgs2img->TransformPoints(geo3dPointsContainer, batchPoints);
+  checkBatch("GenericRSTransform_wgs2img", batchPoints, geo3dPointsContainer,
+             [&](const PointType& p) { return GenericRSTransform_wgs2img->TransformPoint(p); });
+
   if (success)
     return EXIT_SUCCESS;
   else
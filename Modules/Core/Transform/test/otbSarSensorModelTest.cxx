@@ -136,7 +136,7 @@ BOOST_AUTO_TEST_CASE(SARSensorModel_auto_validate_forward_transform)
     return;
   }
 
-  auto & imd = reader->GetOutput()->m_Imd;
+  auto & imd = reader->GetOutput()->GetImageMetadata();
   auto & GCPParam = imd.GetGCPParam();
 
   std::vector<otb::GCP> testGCPs;
@@ -116,8 +116,42 @@ public:
   /** Get the total frequency of Co-occurrence pairs. */
   itkGetMacro(Symmetry, bool);
 
+  /** Running sums over the co-occurrence pairs of the list, where c is the
+    * frequency of the pair [i, j] = [index[0], index[1]]. */
+  struct RunningSumsType
+  {
+    /** Sums of c.i, c.j, c.i^2 and c.i.j */
+    double SumI;
+    double SumJ;
+    double SumII;
+    double SumIJ;
+    /** Sums of c^2, (i - j).c^2 and c.log(c) */
+    double SumSquaredFrequencies;
+    double SumDifferenceSquaredFrequencies;
+    double SumFrequencyLogFrequencies;
+    /** Sums of c over j (resp. over i), indexed by i (resp. j) */
+    std::vector<FrequencyType> MarginalI;
+    std::vector<FrequencyType> MarginalJ;
+    /** Sums of c, indexed by i + j (resp. i - j + nbins - 1) */
+    std::vector<FrequencyType> SumHistogram;
+    std::vector<FrequencyType> DifferenceHistogram;
+  };
+
   /** Get std::vector containing non-zero co-occurrence pairs */
-  VectorType GetVector();
+  const VectorType& GetVector() const;
+
+  /** Set whether AddPixelPair() and RemovePixelPair() update the running
+    * sums. This lets a list updated incrementally (e.g. by a sliding
+    * window) give its texture features without iterating over all its
+    * pairs. false by default. */
+  void SetComputeRunningSums(bool compute);
+
+  /** Get the running sums. They are only up to date when
+    * SetComputeRunningSums(true) was called before adding pairs. */
+  const RunningSumsType& GetRunningSums() const
+  {
+    return m_RunningSums;
+  }
 
   /** Initialize the lowerbound and upper bound vecotor, Fill m_LookupArray with
     * -1 and set m_TotalFrequency to zero */
@@ -127,6 +161,16 @@ public:
   // m_InputImageMaximum. If so add to m_Vector via AddPairToVector method */
   void AddPixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue2);
 
+  /** Remove a pixel pair previously added with AddPixelPair(). The same
+    * bounds checks are applied, so that adding then removing a pair leaves
+    * the list unchanged. Co-occurrence pairs whose frequency drops to zero are
+    * removed from m_Vector. */
+  void RemovePixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue2);
+
+  /** Remove all the co-occurrence pairs, keeping the bins set by
+    * Initialize() */
+  void Clear();
+
   /* Get the frequency value from Vector with index =[j,i] */
   RelativeFrequencyType GetFrequency(IndexValueType i, IndexValueType j);
 
@@ -144,6 +188,22 @@ protected:
     * co-occurrence pair is added again with index values swapped */
   void AddPairToVector(IndexType index);
 
+  /** Update the running sums when the frequency of the co-occurrence pair
+    * with given index goes from frequency to frequency + 1 (add) or
+    * frequency - 1 */
+  void UpdateRunningSums(const IndexType& index, FrequencyType frequency, bool add);
+
+  /** Get c.log(c) from a table grown on demand */
+  double FrequencyLogFrequency(FrequencyType frequency);
+
+  /** Reset the running sums to zero */
+  void ResetRunningSums();
+
+  /** decrement the frequency of the co-occurrence pair with given index. The
+    * pair is removed from the vector when its frequency drops to zero: the
+    * last element of the vector takes its place to keep the vector compact. */
+  void RemovePairFromVector(IndexType index);
+
   void SetBinMin(const unsigned int dimension, const InstanceIdentifier nbin, PixelValueType min);
 
   void SetBinMax(const unsigned int dimension, const InstanceIdentifier nbin, PixelValueType max);
@@ -181,6 +241,15 @@ private:
 
   /** Input image maximum */
   PixelValueType m_InputImageMaximum;
+
+  /** boolean to update the running sums. false by default */
+  bool m_ComputeRunningSums;
+
+  /** Running sums over the co-occurrence pairs */
+  RunningSumsType m_RunningSums;
+
+  /** c.log(c) for the frequencies c seen so far */
+  std::vector<double> m_FrequencyLogFrequencies;
 };
 
 } // End namespace otb
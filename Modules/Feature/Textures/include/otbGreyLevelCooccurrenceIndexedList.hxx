@@ -23,12 +23,22 @@
 #define otbGreyLevelCooccurrenceIndexedList_hxx
 
 #include "otbGreyLevelCooccurrenceIndexedList.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
 
 namespace otb
 {
 template <class TPixel>
 GreyLevelCooccurrenceIndexedList<TPixel>::GreyLevelCooccurrenceIndexedList()
-  : m_Size(), m_Symmetry(true), m_TotalFrequency(0), m_ClipBinsAtEnds(true), m_InputImageMinimum(0), m_InputImageMaximum(255)
+  : m_Size(),
+    m_Symmetry(true),
+    m_TotalFrequency(0),
+    m_ClipBinsAtEnds(true),
+    m_InputImageMinimum(0),
+    m_InputImageMaximum(255),
+    m_ComputeRunningSums(false),
+    m_RunningSums()
 {
 }
 
@@ -49,6 +59,12 @@ void GreyLevelCooccurrenceIndexedList<TPixel>::Initialize(const unsigned int nbi
   m_LookupArray.Fill(-1);
   m_TotalFrequency = 0;
 
+  m_RunningSums.MarginalI.resize(nbins);
+  m_RunningSums.MarginalJ.resize(nbins);
+  m_RunningSums.SumHistogram.resize(nbins > 0 ? 2 * nbins - 1 : 0);
+  m_RunningSums.DifferenceHistogram.resize(nbins > 0 ? 2 * nbins - 1 : 0);
+  this->ResetRunningSums();
+
   // adjust the sizes of min max value containers
   unsigned int dim;
   m_Min.resize(PixelPairSize);
@@ -217,6 +233,123 @@ void GreyLevelCooccurrenceIndexedList<TPixel>::AddPixelPair(const PixelValueType
   }
 }
 
+template <class TPixel>
+void GreyLevelCooccurrenceIndexedList<TPixel>::RemovePixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue2)
+{
+  if (pixelvalue1 < m_InputImageMinimum || pixelvalue1 > m_InputImageMaximum)
+  {
+    return; // pixelvalue1 was not added to the co-occurrence list
+  }
+
+  if (pixelvalue2 < m_InputImageMinimum || pixelvalue2 > m_InputImageMaximum)
+  {
+    return; // pixelvalue2 was not added to the co-occurrence list
+  }
+
+  IndexType     index;
+  PixelPairType ppair(PixelPairSize);
+  ppair[0] = pixelvalue1;
+  ppair[1] = pixelvalue2;
+
+  this->GetIndex(ppair, index);
+  this->RemovePairFromVector(index);
+  if (m_Symmetry)
+  {
+    std::swap(index[0], index[1]);
+    this->RemovePairFromVector(index);
+  }
+}
+
+template <class TPixel>
+void GreyLevelCooccurrenceIndexedList<TPixel>::Clear()
+{
+  typename VectorType::const_iterator it;
+  for (it = m_Vector.begin(); it != m_Vector.end(); ++it)
+  {
+    m_LookupArray[(*it).first[1] * m_Size[0] + (*it).first[0]] = -1;
+  }
+  m_Vector.clear();
+  m_TotalFrequency = 0;
+  this->ResetRunningSums();
+}
+
+template <class TPixel>
+void GreyLevelCooccurrenceIndexedList<TPixel>::SetComputeRunningSums(bool compute)
+{
+  if (compute && !m_ComputeRunningSums)
+  {
+    // Take the pairs already in the list into account
+    this->ResetRunningSums();
+    for (const auto& pair : m_Vector)
+    {
+      for (FrequencyType frequency = 0; frequency < pair.second; ++frequency)
+      {
+        this->UpdateRunningSums(pair.first, frequency, true);
+      }
+    }
+  }
+  m_ComputeRunningSums = compute;
+}
+
+template <class TPixel>
+void GreyLevelCooccurrenceIndexedList<TPixel>::ResetRunningSums()
+{
+  m_RunningSums.SumI                            = 0.;
+  m_RunningSums.SumJ                            = 0.;
+  m_RunningSums.SumII                           = 0.;
+  m_RunningSums.SumIJ                           = 0.;
+  m_RunningSums.SumSquaredFrequencies           = 0.;
+  m_RunningSums.SumDifferenceSquaredFrequencies = 0.;
+  m_RunningSums.SumFrequencyLogFrequencies      = 0.;
+  std::fill(m_RunningSums.MarginalI.begin(), m_RunningSums.MarginalI.end(), 0);
+  std::fill(m_RunningSums.MarginalJ.begin(), m_RunningSums.MarginalJ.end(), 0);
+  std::fill(m_RunningSums.SumHistogram.begin(), m_RunningSums.SumHistogram.end(), 0);
+  std::fill(m_RunningSums.DifferenceHistogram.begin(), m_RunningSums.DifferenceHistogram.end(), 0);
+}
+
+template <class TPixel>
+double GreyLevelCooccurrenceIndexedList<TPixel>::FrequencyLogFrequency(FrequencyType frequency)
+{
+  while (m_FrequencyLogFrequencies.size() <= frequency)
+  {
+    const double c = static_cast<double>(m_FrequencyLogFrequencies.size());
+    m_FrequencyLogFrequencies.push_back(c > 0. ? c * std::log(c) : 0.);
+  }
+  return m_FrequencyLogFrequencies[frequency];
+}
+
+template <class TPixel>
+void GreyLevelCooccurrenceIndexedList<TPixel>::UpdateRunningSums(const IndexType& index, FrequencyType frequency, bool add)
+{
+  const double        i            = static_cast<double>(index[0]);
+  const double        j            = static_cast<double>(index[1]);
+  const double        sign         = add ? 1. : -1.;
+  const FrequencyType newFrequency = add ? frequency + 1 : frequency - 1;
+  const double        squaredDelta = static_cast<double>(newFrequency) * newFrequency - static_cast<double>(frequency) * frequency;
+
+  m_RunningSums.SumI += sign * i;
+  m_RunningSums.SumJ += sign * j;
+  m_RunningSums.SumII += sign * i * i;
+  m_RunningSums.SumIJ += sign * i * j;
+  m_RunningSums.SumSquaredFrequencies += squaredDelta;
+  m_RunningSums.SumDifferenceSquaredFrequencies += (i - j) * squaredDelta;
+  m_RunningSums.SumFrequencyLogFrequencies += this->FrequencyLogFrequency(newFrequency) - this->FrequencyLogFrequency(frequency);
+
+  FrequencyType* counts[] = {&m_RunningSums.MarginalI[index[0]], &m_RunningSums.MarginalJ[index[1]], &m_RunningSums.SumHistogram[index[0] + index[1]],
+                             &m_RunningSums.DifferenceHistogram[index[0] - index[1] + m_Size[0] - 1]};
+  for (FrequencyType* count : counts)
+  {
+    if (add)
+    {
+      ++(*count);
+    }
+    else
+    {
+      --(*count);
+    }
+  }
+}
+
 template <class TPixel>
 typename GreyLevelCooccurrenceIndexedList<TPixel>::RelativeFrequencyType GreyLevelCooccurrenceIndexedList<TPixel>::GetFrequency(IndexValueType i,
                                                                                                                                 IndexValueType j)
@@ -248,7 +381,7 @@ GreyLevelCooccurrenceIndexedList<TPixel>::GetFrequency(IndexValueType i, IndexVa
 }
 
 template <class TPixel>
-typename GreyLevelCooccurrenceIndexedList<TPixel>::VectorType GreyLevelCooccurrenceIndexedList<TPixel>::GetVector()
+const typename GreyLevelCooccurrenceIndexedList<TPixel>::VectorType& GreyLevelCooccurrenceIndexedList<TPixel>::GetVector() const
 {
   return m_Vector;
 }
@@ -259,6 +392,10 @@ void GreyLevelCooccurrenceIndexedList<TPixel>::AddPairToVector(IndexType index)
   InstanceIdentifier instanceId = 0;
   instanceId                    = index[1] * m_Size[0] + index[0];
   int vindex                    = m_LookupArray[instanceId];
+  if (m_ComputeRunningSums)
+  {
+    this->UpdateRunningSums(index, vindex < 0 ? 0 : m_Vector[vindex].second, true);
+  }
   if (vindex < 0)
   {
     m_LookupArray[instanceId] = m_Vector.size();
@@ -274,6 +411,33 @@ void GreyLevelCooccurrenceIndexedList<TPixel>::AddPairToVector(IndexType index)
   m_TotalFrequency = m_TotalFrequency + 1;
 }
 
+template <class TPixel>
+void GreyLevelCooccurrenceIndexedList<TPixel>::RemovePairFromVector(IndexType index)
+{
+  const InstanceIdentifier instanceId = index[1] * m_Size[0] + index[0];
+  const int                vindex     = m_LookupArray[instanceId];
+  if (vindex < 0)
+  {
+    return; // the pair is not in the list
+  }
+
+  if (m_ComputeRunningSums)
+  {
+    this->UpdateRunningSums(index, m_Vector[vindex].second, false);
+  }
+  if (--m_Vector[vindex].second == 0)
+  {
+    // Move the last pair in the empty slot
+    const IndexType          lastIndex = m_Vector.back().first;
+    const InstanceIdentifier lastId    = lastIndex[1] * m_Size[0] + lastIndex[0];
+    m_Vector[vindex]                   = m_Vector.back();
+    m_LookupArray[lastId]              = vindex;
+    m_Vector.pop_back();
+    m_LookupArray[instanceId] = -1;
+  }
+  m_TotalFrequency = m_TotalFrequency - 1;
+}
+
 template <class TPixel>
 void GreyLevelCooccurrenceIndexedList<TPixel>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGreyLevelCooccurrenceSlidingWindow_h
+#define otbGreyLevelCooccurrenceSlidingWindow_h
+
+#include "otbGreyLevelCooccurrenceIndexedList.h"
+
+namespace otb
+{
+
+/** \class GreyLevelCooccurrenceSlidingWindow
+ * \brief Maintains the co-occurrence list of a window sliding along the
+ * lines of an image.
+ *
+ * SetRegion() moves the window. When the new region spans the same lines
+ * as the previous one and overlaps it, only the pixel pairs whose center
+ * lies in the columns leaving (resp. entering) the window are removed from
+ * (resp. added to) the co-occurrence list. Moving a window of radius r by one
+ * column thus costs O(r) instead of O(r^2). Otherwise, the list is rebuilt
+ * from the whole region.
+ *
+ * As with itk::ConstNeighborhoodIterator, a pixel pair is only counted when
+ * the offset pixel lies inside the buffered region of the image.
+ *
+ * The co-occurrence list holds the same pairs as one filled from scratch
+ * over the region, but they may be stored in a different order. Its
+ * running sums are kept up to date, so that the texture features of the
+ * window can be computed without iterating over the list.
+ *
+ * \sa GreyLevelCooccurrenceIndexedList
+ *
+ * \ingroup OTBTextures
+ */
+template <class TInputImage>
+class ITK_EXPORT GreyLevelCooccurrenceSlidingWindow
+{
+public:
+  /** Standard typedefs */
+  typedef GreyLevelCooccurrenceSlidingWindow Self;
+
+  typedef TInputImage                           InputImageType;
+  typedef typename InputImageType::PixelType    InputPixelType;
+  typedef typename InputImageType::RegionType   RegionType;
+  typedef typename InputImageType::IndexType    IndexType;
+  typedef typename InputImageType::OffsetType   OffsetType;
+  typedef typename IndexType::IndexValueType    IndexValueType;
+
+  typedef GreyLevelCooccurrenceIndexedList<InputPixelType>     CooccurrenceIndexedListType;
+  typedef typename CooccurrenceIndexedListType::Pointer        CooccurrenceIndexedListPointerType;
+  typedef typename CooccurrenceIndexedListType::PixelValueType PixelValueType;
+
+  /** Constructor. The image buffered region must not change while the
+   * window is in use. */
+  GreyLevelCooccurrenceSlidingWindow(const InputImageType* image, const OffsetType& offset, unsigned int nbins, PixelValueType min, PixelValueType max);
+
+  GreyLevelCooccurrenceSlidingWindow(const Self&) = delete;
+  Self& operator=(const Self&) = delete;
+
+  /** Move the window to the given region, which must be inside the buffered
+   * region of the image */
+  void SetRegion(const RegionType& region);
+
+  /** Get the co-occurrence list of the current region */
+  CooccurrenceIndexedListType* GetCooccurrenceList() const
+  {
+    return m_CooccurrenceList;
+  }
+
+private:
+  /** Add (or remove) the pixel pairs centered in columns [first, last] of
+   * the current region */
+  void UpdateColumns(IndexValueType first, IndexValueType last, bool add);
+
+  const InputImageType*              m_Image;
+  RegionType                         m_BufferedRegion;
+  OffsetType                         m_Offset;
+  RegionType                         m_Region;
+  bool                               m_IsEmpty;
+  CooccurrenceIndexedListPointerType m_CooccurrenceList;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbGreyLevelCooccurrenceSlidingWindow.hxx"
+#endif
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGreyLevelCooccurrenceSlidingWindow_hxx
+#define otbGreyLevelCooccurrenceSlidingWindow_hxx
+
+#include "otbGreyLevelCooccurrenceSlidingWindow.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+namespace otb
+{
+
+template <class TInputImage>
+GreyLevelCooccurrenceSlidingWindow<TInputImage>::GreyLevelCooccurrenceSlidingWindow(const InputImageType* image, const OffsetType& offset,
+                                                                                    unsigned int nbins, PixelValueType min, PixelValueType max)
+  : m_Image(image),
+    m_BufferedRegion(image->GetBufferedRegion()),
+    m_Offset(offset),
+    m_Region(),
+    m_IsEmpty(true),
+    m_CooccurrenceList(CooccurrenceIndexedListType::New())
+{
+  m_CooccurrenceList->Initialize(nbins, min, max);
+  m_CooccurrenceList->SetComputeRunningSums(true);
+}
+
+template <class TInputImage>
+void GreyLevelCooccurrenceSlidingWindow<TInputImage>::SetRegion(const RegionType& region)
+{
+  // The incremental update is only possible along the lines
+  bool sameLines = !m_IsEmpty;
+  for (unsigned int dim = 1; dim < InputImageType::ImageDimension && sameLines; ++dim)
+  {
+    sameLines = region.GetIndex(dim) == m_Region.GetIndex(dim) && region.GetSize(dim) == m_Region.GetSize(dim);
+  }
+
+  const IndexValueType oldFirst = m_Region.GetIndex(0);
+  const IndexValueType oldLast  = oldFirst + static_cast<IndexValueType>(m_Region.GetSize(0)) - 1;
+  const IndexValueType newFirst = region.GetIndex(0);
+  const IndexValueType newLast  = newFirst + static_cast<IndexValueType>(region.GetSize(0)) - 1;
+
+  if (!sameLines || newFirst > oldLast || newLast < oldFirst)
+  {
+    // Rebuild the list from the whole region
+    m_CooccurrenceList->Clear();
+    m_Region  = region;
+    m_IsEmpty = region.GetNumberOfPixels() == 0;
+    if (!m_IsEmpty)
+    {
+      this->UpdateColumns(newFirst, newLast, true);
+    }
+    return;
+  }
+
+  // Remove the leaving columns, then add the entering ones
+  if (newFirst > oldFirst)
+  {
+    this->UpdateColumns(oldFirst, newFirst - 1, false);
+  }
+  if (newLast < oldLast)
+  {
+    this->UpdateColumns(newLast + 1, oldLast, false);
+  }
+  if (newFirst < oldFirst)
+  {
+    this->UpdateColumns(newFirst, oldFirst - 1, true);
+  }
+  if (newLast > oldLast)
+  {
+    this->UpdateColumns(oldLast + 1, newLast, true);
+  }
+  m_Region = region;
+}
+
+template <class TInputImage>
+void GreyLevelCooccurrenceSlidingWindow<TInputImage>::UpdateColumns(IndexValueType first, IndexValueType last, bool add)
+{
+  RegionType columns = m_Region;
+  columns.SetIndex(0, first);
+  columns.SetSize(0, last - first + 1);
+
+  itk::ImageRegionConstIteratorWithIndex<InputImageType> it(m_Image, columns);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const IndexType neighborIndex = it.GetIndex() + m_Offset;
+    if (!m_BufferedRegion.IsInside(neighborIndex))
+    {
+      continue; // don't put a pixel in the co-occurrence list if the value is
+                // out of bounds
+    }
+    if (add)
+    {
+      m_CooccurrenceList->AddPixelPair(it.Get(), m_Image->GetPixel(neighborIndex));
+    }
+    else
+    {
+      m_CooccurrenceList->RemovePixelPair(it.Get(), m_Image->GetPixel(neighborIndex));
+    }
+  }
+}
+
+} // End namespace otb
+
+#endif
@@ -135,11 +135,11 @@ HaralickTexturesImageFunction<TInputImage, TCoordRep>::EvaluateAtIndex(const Ind
   std::vector<double> marginalSums(m_NumberOfBinsPerAxis, 0);
 
   // get co-occurrence vector and totalfrequency
-  VectorType glcVector      = GLCIList->GetVector();
-  double     totalFrequency = static_cast<double>(GLCIList->GetTotalFrequency());
+  const VectorType& glcVector      = GLCIList->GetVector();
+  double            totalFrequency = static_cast<double>(GLCIList->GetTotalFrequency());
 
   // Normalize the co-occurrence indexed list and compute mean, marginalSum
-  typename VectorType::iterator it = glcVector.begin();
+  typename VectorType::const_iterator it = glcVector.begin();
   while (it != glcVector.end())
   {
     double                frequency = (*it).second / totalFrequency;
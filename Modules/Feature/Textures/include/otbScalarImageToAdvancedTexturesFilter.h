@@ -22,6 +22,7 @@
 #define otbScalarImageToAdvancedTexturesFilter_h
 
 #include "otbGreyLevelCooccurrenceIndexedList.h"
+#include "otbGreyLevelCooccurrenceSlidingWindow.h"
 #include "itkMacro.h"
 #include "itkImageToImageFilter.h"
 
@@ -92,6 +93,12 @@ namespace otb
  * Neighborhood size can be set using the SetRadius() method. Offset for co-occurence estimation
  * is set using the SetOffset() method.
  *
+ * When SlidingWindowOn() is set, the co-occurrence list is not rebuilt for
+ * each output pixel but updated as the window slides along the lines (see
+ * otb::GreyLevelCooccurrenceSlidingWindow). This is much faster for large
+ * radii. Textures are the same up to floating point rounding, since the
+ * co-occurrence pairs are summed in a different order.
+ *
  * \sa otb::ScalarImageToCooccurrenceIndexedList
  * \sa otb::ScalarImageToTexturesFiler
  * \sa otb::ScalarImageToHigherOrderTexturesFilter
@@ -135,6 +142,7 @@ public:
   typedef typename CooccurrenceIndexedListType::PixelValueType        PixelValueType;
   typedef typename CooccurrenceIndexedListType::RelativeFrequencyType RelativeFrequencyType;
   typedef typename CooccurrenceIndexedListType::VectorType            VectorType;
+  typedef typename CooccurrenceIndexedListType::RunningSumsType       RunningSumsType;
 
   typedef typename VectorType::iterator       VectorIteratorType;
   typedef typename VectorType::const_iterator VectorConstIteratorType;
@@ -180,6 +188,11 @@ public:
   /** Get the sub-sampling offset */
   itkGetMacro(SubsampleOffset, OffsetType);
 
+  /** Set/Get the sliding window mode (off by default) */
+  itkSetMacro(SlidingWindow, bool);
+  itkGetConstMacro(SlidingWindow, bool);
+  itkBooleanMacro(SlidingWindow);
+
   /** Get the mean output image */
   OutputImageType* GetMeanOutput();
 
@@ -254,6 +267,9 @@ private:
 
   /** Sub-sampling offset */
   OffsetType m_SubsampleOffset;
+
+  /** Update the co-occurrence list as the window slides */
+  bool m_SlidingWindow;
 };
 } // End namespace otb
 
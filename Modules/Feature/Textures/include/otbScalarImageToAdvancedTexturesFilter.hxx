@@ -28,6 +28,7 @@
 #include "itkProgressReporter.h"
 #include "itkNumericTraits.h"
 #include <algorithm>
+#include <memory>
 
 namespace otb
 {
@@ -40,7 +41,8 @@ ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>::ScalarImageToAdv
     m_InputImageMinimum(0),
     m_InputImageMaximum(255),
     m_SubsampleFactor(),
-    m_SubsampleOffset()
+    m_SubsampleOffset(),
+    m_SlidingWindow(false)
 {
   // There are 10 outputs corresponding to the 9 textures indices
   this->SetNumberOfRequiredOutputs(10);
@@ -333,6 +335,14 @@ void ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>::ThreadedGen
   // Set-up progress reporting
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
+  // Co-occurrence list updated incrementally along the lines
+  typedef GreyLevelCooccurrenceSlidingWindow<InputImageType> SlidingWindowType;
+  std::unique_ptr<SlidingWindowType>                         slidingWindow;
+  if (m_SlidingWindow)
+  {
+    slidingWindow.reset(new SlidingWindowType(inputPtr, m_Offset, m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum));
+  }
+
   // Iterate on outputs to compute textures
   while (!varianceIt.IsAtEnd() && !meanIt.IsAtEnd() && !dissimilarityIt.IsAtEnd() && !sumAverageIt.IsAtEnd() && !sumVarianceIt.IsAtEnd() &&
          !sumEntropytIt.IsAtEnd() && !differenceEntropyIt.IsAtEnd() && !differenceVarianceIt.IsAtEnd() && !ic1It.IsAtEnd() && !ic2It.IsAtEnd())
@@ -359,23 +369,32 @@ void ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>::ThreadedGen
     inputRegion.SetSize(inputSize);
     inputRegion.Crop(inputPtr->GetRequestedRegion());
 
-    CooccurrenceIndexedListPointerType GLCIList = CooccurrenceIndexedListType::New();
-    GLCIList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
-
-    typedef itk::ConstNeighborhoodIterator<InputImageType> NeighborhoodIteratorType;
-    NeighborhoodIteratorType                               neighborIt;
-    neighborIt = NeighborhoodIteratorType(m_NeighborhoodRadius, inputPtr, inputRegion);
-    for (neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt)
+    CooccurrenceIndexedListPointerType GLCIList;
+    if (slidingWindow)
     {
-      const InputPixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-      bool                 pixelInBounds;
-      const InputPixelType pixelIntensity = neighborIt.GetPixel(m_Offset, pixelInBounds);
-      if (!pixelInBounds)
+      slidingWindow->SetRegion(inputRegion);
+      GLCIList = slidingWindow->GetCooccurrenceList();
+    }
+    else
+    {
+      GLCIList = CooccurrenceIndexedListType::New();
+      GLCIList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
+
+      typedef itk::ConstNeighborhoodIterator<InputImageType> NeighborhoodIteratorType;
+      NeighborhoodIteratorType                               neighborIt;
+      neighborIt = NeighborhoodIteratorType(m_NeighborhoodRadius, inputPtr, inputRegion);
+      for (neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt)
       {
-        continue; // don't put a pixel in the co-occurrence list if the value is
-                  // out of bounds
+        const InputPixelType centerPixelIntensity = neighborIt.GetCenterPixel();
+        bool                 pixelInBounds;
+        const InputPixelType pixelIntensity = neighborIt.GetPixel(m_Offset, pixelInBounds);
+        if (!pixelInBounds)
+        {
+          continue; // don't put a pixel in the co-occurrence list if the value is
+                    // out of bounds
+        }
+        GLCIList->AddPixelPair(centerPixelIntensity, pixelIntensity);
       }
-      GLCIList->AddPixelPair(centerPixelIntensity, pixelIntensity);
     }
 
     PixelValueType m_Mean               = itk::NumericTraits<PixelValueType>::Zero;
@@ -411,49 +430,83 @@ void ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>::ThreadedGen
     double hxy1 = 0;
 
     // get co-occurrence vector and totalfrequency
-    VectorType glcVector      = GLCIList->GetVector();
-    double     totalFrequency = static_cast<double>(GLCIList->GetTotalFrequency());
-
-    VectorConstIteratorType constVectorIt;
-    // Normalize the GreyLevelCooccurrenceListType
-    // Compute Mean, Entropy (f12), hx, hy, pdxy
-    constVectorIt = glcVector.begin();
-    while (constVectorIt != glcVector.end())
+    const VectorType& glcVector      = GLCIList->GetVector();
+    double            totalFrequency = static_cast<double>(GLCIList->GetTotalFrequency());
+    const bool        useRunningSums = slidingWindow && totalFrequency > 0;
+
+    if (useRunningSums)
     {
-      CooccurrenceIndexType index     = (*constVectorIt).first;
-      double                frequency = (*constVectorIt).second / totalFrequency;
-      m_Mean += static_cast<double>(index[0]) * frequency;
-      Entropy -= (frequency > 0.0001) ? frequency * std::log(frequency) / log2 : 0.;
-      unsigned int i = index[1];
-      unsigned int j = index[0];
-      hx[j] += frequency;
-      hy[i] += frequency;
-
-      if (i + j > histSize - 1)
+      // The sums kept up to date by the sliding window give the histograms,
+      // the mean, the variance and the entropy without a pass over the list
+      const RunningSumsType& sums = GLCIList->GetRunningSums();
+      for (long unsigned int k = 0; k < histSize; ++k)
+      {
+        hx[k]   = sums.MarginalI[k] / totalFrequency;
+        hy[k]   = sums.MarginalJ[k] / totalFrequency;
+        pdxy[k] = sums.DifferenceHistogram[k + histSize - 1] / totalFrequency;
+      }
+      for (long unsigned int k = histSize; k < twiceHistSize - 1; ++k)
+      {
+        pdxy[k] = sums.SumHistogram[k] / totalFrequency;
+      }
+      m_Mean          = sums.SumI / totalFrequency;
+      m_Variance      = sums.SumII / totalFrequency - m_Mean * m_Mean;
+      m_Dissimilarity = sums.SumDifferenceSquaredFrequencies / (totalFrequency * totalFrequency);
+      if (totalFrequency * 0.0001 < 1.)
       {
-        pdxy[i + j] += frequency;
+        // All the frequencies are above the threshold
+        Entropy = (std::log(totalFrequency) - sums.SumFrequencyLogFrequencies / totalFrequency) / log2;
       }
-      if (i <= j)
+      else
       {
-        pdxy[j - i] += frequency;
+        for (const auto& pair : glcVector)
+        {
+          double frequency = pair.second / totalFrequency;
+          Entropy -= (frequency > 0.0001) ? frequency * std::log(frequency) / log2 : 0.;
+        }
+      }
+    }
+    else
+    {
+      // Normalize the GreyLevelCooccurrenceListType
+      // Compute Mean, Entropy (f12), hx, hy, pdxy
+      for (const auto& pair : glcVector)
+      {
+        CooccurrenceIndexType index     = pair.first;
+        double                frequency = pair.second / totalFrequency;
+        m_Mean += static_cast<double>(index[0]) * frequency;
+        Entropy -= (frequency > 0.0001) ? frequency * std::log(frequency) / log2 : 0.;
+        unsigned int i = index[1];
+        unsigned int j = index[0];
+        hx[j] += frequency;
+        hy[i] += frequency;
+
+        if (i + j > histSize - 1)
+        {
+          pdxy[i + j] += frequency;
+        }
+        if (i <= j)
+        {
+          pdxy[j - i] += frequency;
+        }
       }
-      ++constVectorIt;
     }
 
     // second pass over normalized co-occurrence list to find variance and pipj.
     // pipj is needed to calculate f11
-    constVectorIt = glcVector.begin();
-    while (constVectorIt != glcVector.end())
+    for (const auto& pair : glcVector)
     {
-      double                frequency = (*constVectorIt).second / totalFrequency;
-      CooccurrenceIndexType index     = (*constVectorIt).first;
+      double                frequency = pair.second / totalFrequency;
+      CooccurrenceIndexType index     = pair.first;
       unsigned int          i         = index[1];
       unsigned int          j         = index[0];
-      double                index0    = static_cast<double>(index[0]);
-      m_Variance += ((index0 - m_Mean) * (index0 - m_Mean)) * frequency;
+      if (!useRunningSums)
+      {
+        double index0 = static_cast<double>(index[0]);
+        m_Variance += ((index0 - m_Mean) * (index0 - m_Mean)) * frequency;
+      }
       double pipj = hx[j] * hy[i];
       hxy1 -= (pipj > 0.0001) ? frequency * std::log(pipj) : 0.;
-      ++constVectorIt;
     }
 
     // iterate histSize to compute sumEntropy
@@ -496,8 +549,11 @@ void ScalarImageToAdvancedTexturesFilter<TInputImage, TOutputImage>::ThreadedGen
       {
         double pipj = hx[j] * hy[i];
         hxy2 -= (pipj > 0.0001) ? pipj * std::log(pipj) : 0.;
-        double frequency = GLCIList->GetFrequency(i, j, glcVector) / totalFrequency;
-        m_Dissimilarity += (static_cast<double>(j) - static_cast<double>(i)) * (frequency * frequency);
+        if (!useRunningSums)
+        {
+          double frequency = GLCIList->GetFrequency(i, j, glcVector) / totalFrequency;
+          m_Dissimilarity += (static_cast<double>(j) - static_cast<double>(i)) * (frequency * frequency);
+        }
       }
     }
 
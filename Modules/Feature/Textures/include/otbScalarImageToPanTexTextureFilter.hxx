@@ -160,7 +160,7 @@ void ScalarImageToPanTexTextureFilter<TInputImage, TOutputImage>::ThreadedGenera
       }
 
       VectorConstIteratorType constVectorIt;
-      VectorType              glcVector      = GLCIList->GetVector();
+      const VectorType&       glcVector      = GLCIList->GetVector();
       double                  totalFrequency = static_cast<double>(GLCIList->GetTotalFrequency());
 
       // Compute inertia aka contrast
@@ -28,6 +28,7 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include "itkNumericTraits.h"
+#include <memory>
 #include <vector>
 #include <cmath>
 
@@ -42,7 +43,8 @@ ScalarImageToTexturesFilter<TInputImage, TOutputImage>::ScalarImageToTexturesFil
     m_InputImageMinimum(0),
     m_InputImageMaximum(255),
     m_SubsampleFactor(),
-    m_SubsampleOffset()
+    m_SubsampleOffset(),
+    m_SlidingWindow(false)
 {
   // There are 8 outputs corresponding to the 8 textures indices
   this->SetNumberOfRequiredOutputs(8);
@@ -299,6 +301,14 @@ void ScalarImageToTexturesFilter<TInputImage, TOutputImage>::ThreadedGenerateDat
   // Set-up progress reporting
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
+  // Co-occurrence list updated incrementally along the lines
+  typedef GreyLevelCooccurrenceSlidingWindow<InputImageType> SlidingWindowType;
+  std::unique_ptr<SlidingWindowType>                         slidingWindow;
+  if (m_SlidingWindow)
+  {
+    slidingWindow.reset(new SlidingWindowType(inputPtr, m_Offset, m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum));
+  }
+
   // Iterate on outputs to compute textures
   while (!energyIt.IsAtEnd() && !entropyIt.IsAtEnd() && !correlationIt.IsAtEnd() && !invDiffMomentIt.IsAtEnd() && !inertiaIt.IsAtEnd() &&
          !clusterShadeIt.IsAtEnd() && !clusterProminenceIt.IsAtEnd() && !haralickCorIt.IsAtEnd())
@@ -325,23 +335,32 @@ void ScalarImageToTexturesFilter<TInputImage, TOutputImage>::ThreadedGenerateDat
     inputRegion.SetSize(inputSize);
     inputRegion.Crop(inputPtr->GetRequestedRegion());
 
-    CooccurrenceIndexedListPointerType GLCIList = CooccurrenceIndexedListType::New();
-    GLCIList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
-
-    typedef itk::ConstNeighborhoodIterator<InputImageType> NeighborhoodIteratorType;
-    NeighborhoodIteratorType                               neighborIt;
-    neighborIt = NeighborhoodIteratorType(m_NeighborhoodRadius, inputPtr, inputRegion);
-    for (neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt)
+    CooccurrenceIndexedListPointerType GLCIList;
+    if (slidingWindow)
     {
-      const InputPixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-      bool                 pixelInBounds;
-      const InputPixelType pixelIntensity = neighborIt.GetPixel(m_Offset, pixelInBounds);
-      if (!pixelInBounds)
+      slidingWindow->SetRegion(inputRegion);
+      GLCIList = slidingWindow->GetCooccurrenceList();
+    }
+    else
+    {
+      GLCIList = CooccurrenceIndexedListType::New();
+      GLCIList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
+
+      typedef itk::ConstNeighborhoodIterator<InputImageType> NeighborhoodIteratorType;
+      NeighborhoodIteratorType                               neighborIt;
+      neighborIt = NeighborhoodIteratorType(m_NeighborhoodRadius, inputPtr, inputRegion);
+      for (neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt)
       {
-        continue; // don't put a pixel in the co-occurrence list if the value is
-                  // out of bounds
+        const InputPixelType centerPixelIntensity = neighborIt.GetCenterPixel();
+        bool                 pixelInBounds;
+        const InputPixelType pixelIntensity = neighborIt.GetPixel(m_Offset, pixelInBounds);
+        if (!pixelInBounds)
+        {
+          continue; // don't put a pixel in the co-occurrence list if the value is
+                    // out of bounds
+        }
+        GLCIList->AddPixelPair(centerPixelIntensity, pixelIntensity);
       }
-      GLCIList->AddPixelPair(centerPixelIntensity, pixelIntensity);
     }
 
     double pixelMean = 0.;
@@ -353,18 +372,110 @@ void ScalarImageToTexturesFilter<TInputImage, TOutputImage>::ThreadedGenerateDat
     std::vector<double> marginalSums(m_NumberOfBinsPerAxis, 0);
 
     // get co-occurrence vector and totalfrequency
-    VectorType glcVector      = GLCIList->GetVector();
-    double     totalFrequency = static_cast<double>(GLCIList->GetTotalFrequency());
+    const VectorType& glcVector      = GLCIList->GetVector();
+    double            totalFrequency = static_cast<double>(GLCIList->GetTotalFrequency());
 
-    // Normalize the co-occurrence indexed list and compute mean, marginalSum
-    typename VectorType::iterator it = glcVector.begin();
-    while (it != glcVector.end())
+    // Initialize texture variables;
+    PixelValueType energy                  = itk::NumericTraits<PixelValueType>::Zero;
+    PixelValueType entropy                 = itk::NumericTraits<PixelValueType>::Zero;
+    PixelValueType correlation             = itk::NumericTraits<PixelValueType>::Zero;
+    PixelValueType inverseDifferenceMoment = itk::NumericTraits<PixelValueType>::Zero;
+    PixelValueType inertia                 = itk::NumericTraits<PixelValueType>::Zero;
+    PixelValueType clusterShade            = itk::NumericTraits<PixelValueType>::Zero;
+    PixelValueType clusterProminence       = itk::NumericTraits<PixelValueType>::Zero;
+    PixelValueType haralickCorrelation     = itk::NumericTraits<PixelValueType>::Zero;
+
+    if (slidingWindow && totalFrequency > 0)
+    {
+      // The sums kept up to date by the sliding window give the textures
+      // in O(nbins) instead of a pass over the whole co-occurrence list
+      const RunningSumsType& sums  = GLCIList->GetRunningSums();
+      const int              nbins = static_cast<int>(m_NumberOfBinsPerAxis);
+
+      pixelMean = sums.SumI / totalFrequency;
+      for (int i = 0; i < nbins; ++i)
+      {
+        marginalSums[i] = sums.MarginalI[i] / totalFrequency;
+      }
+      pixelVariance = sums.SumII / totalFrequency - pixelMean * pixelMean;
+
+      double pixelVarianceSquared = pixelVariance * pixelVariance;
+      if (pixelVarianceSquared < GetPixelValueTolerance())
+      {
+        pixelVarianceSquared = 1.;
+      }
+
+      energy = sums.SumSquaredFrequencies / (totalFrequency * totalFrequency);
+      if (totalFrequency * GetPixelValueTolerance() < 1.)
+      {
+        // All the frequencies are above the tolerance
+        entropy = (std::log(totalFrequency) - sums.SumFrequencyLogFrequencies / totalFrequency) / log2;
+      }
+      else
+      {
+        for (const auto& pair : glcVector)
+        {
+          RelativeFrequencyType frequency = pair.second / totalFrequency;
+          entropy -= (frequency > GetPixelValueTolerance()) ? frequency * std::log(frequency) / log2 : 0;
+        }
+      }
+      correlation = (sums.SumIJ / totalFrequency - pixelMean * (sums.SumI + sums.SumJ) / totalFrequency + pixelMean * pixelMean) / pixelVarianceSquared;
+      for (int d = 0; d < 2 * nbins - 1; ++d)
+      {
+        const double difference = d - (nbins - 1);
+        const double frequency  = sums.DifferenceHistogram[d] / totalFrequency;
+        inverseDifferenceMoment += frequency / (1.0 + difference * difference);
+        inertia += difference * difference * frequency;
+
+        const double centeredSum  = d - 2 * pixelMean;
+        const double cube         = centeredSum * centeredSum * centeredSum;
+        const double sumFrequency = sums.SumHistogram[d] / totalFrequency;
+        clusterShade += cube * sumFrequency;
+        clusterProminence += cube * centeredSum * sumFrequency;
+      }
+      haralickCorrelation = sums.SumIJ / totalFrequency;
+    }
+    else
     {
-      double                frequency = (*it).second / totalFrequency;
-      CooccurrenceIndexType index     = (*it).first;
-      pixelMean += index[0] * frequency;
-      marginalSums[index[0]] += frequency;
-      ++it;
+      // Normalize the co-occurrence indexed list and compute mean, marginalSum
+      for (const auto& pair : glcVector)
+      {
+        double                frequency = pair.second / totalFrequency;
+        CooccurrenceIndexType index     = pair.first;
+        pixelMean += index[0] * frequency;
+        marginalSums[index[0]] += frequency;
+      }
+
+      for (const auto& pair : glcVector)
+      {
+        RelativeFrequencyType frequency = pair.second / totalFrequency;
+        CooccurrenceIndexType index     = pair.first;
+        pixelVariance += (index[0] - pixelMean) * (index[0] - pixelMean) * frequency;
+      }
+
+      double pixelVarianceSquared = pixelVariance * pixelVariance;
+      // Variance is only used in correlation. If variance is 0, then (index[0] - pixelMean) * (index[1] - pixelMean)
+      // should be zero as well. In this case, set the variance to 1. in order to
+      // avoid NaN correlation.
+      if (pixelVarianceSquared < GetPixelValueTolerance())
+      {
+        pixelVarianceSquared = 1.;
+      }
+
+      // Compute textures
+      for (const auto& pair : glcVector)
+      {
+        CooccurrenceIndexType index     = pair.first;
+        RelativeFrequencyType frequency = pair.second / totalFrequency;
+        energy += frequency * frequency;
+        entropy -= (frequency > GetPixelValueTolerance()) ? frequency * std::log(frequency) / log2 : 0;
+        correlation += ((index[0] - pixelMean) * (index[1] - pixelMean) * frequency) / pixelVarianceSquared;
+        inverseDifferenceMoment += frequency / (1.0 + (index[0] - index[1]) * (index[0] - index[1]));
+        inertia += (index[0] - index[1]) * (index[0] - index[1]) * frequency;
+        clusterShade += std::pow((index[0] - pixelMean) + (index[1] - pixelMean), 3) * frequency;
+        clusterProminence += std::pow((index[0] - pixelMean) + (index[1] - pixelMean), 4) * frequency;
+        haralickCorrelation += index[0] * index[1] * frequency;
+      }
     }
 
     /* Now get the mean and deviaton of the marginal sums.
@@ -393,52 +504,6 @@ void ScalarImageToTexturesFilter<TInputImage, TOutputImage>::ThreadedGenerateDat
     }
     marginalDevSquared = marginalDevSquared / m_NumberOfBinsPerAxis;
 
-    VectorConstIteratorType constVectorIt;
-    constVectorIt = glcVector.begin();
-    while (constVectorIt != glcVector.end())
-    {
-      RelativeFrequencyType frequency = (*constVectorIt).second / totalFrequency;
-      CooccurrenceIndexType index     = (*constVectorIt).first;
-      pixelVariance += (index[0] - pixelMean) * (index[0] - pixelMean) * frequency;
-      ++constVectorIt;
-    }
-
-    double pixelVarianceSquared = pixelVariance * pixelVariance;
-    // Variance is only used in correlation. If variance is 0, then (index[0] - pixelMean) * (index[1] - pixelMean)
-    // should be zero as well. In this case, set the variance to 1. in order to
-    // avoid NaN correlation.
-    if (pixelVarianceSquared < GetPixelValueTolerance())
-    {
-      pixelVarianceSquared = 1.;
-    }
-
-    // Initialize texture variables;
-    PixelValueType energy                  = itk::NumericTraits<PixelValueType>::Zero;
-    PixelValueType entropy                 = itk::NumericTraits<PixelValueType>::Zero;
-    PixelValueType correlation             = itk::NumericTraits<PixelValueType>::Zero;
-    PixelValueType inverseDifferenceMoment = itk::NumericTraits<PixelValueType>::Zero;
-    PixelValueType inertia                 = itk::NumericTraits<PixelValueType>::Zero;
-    PixelValueType clusterShade            = itk::NumericTraits<PixelValueType>::Zero;
-    PixelValueType clusterProminence       = itk::NumericTraits<PixelValueType>::Zero;
-    PixelValueType haralickCorrelation     = itk::NumericTraits<PixelValueType>::Zero;
-
-    // Compute textures
-    constVectorIt = glcVector.begin();
-    while (constVectorIt != glcVector.end())
-    {
-      CooccurrenceIndexType index     = (*constVectorIt).first;
-      RelativeFrequencyType frequency = (*constVectorIt).second / totalFrequency;
-      energy += frequency * frequency;
-      entropy -= (frequency > GetPixelValueTolerance()) ? frequency * std::log(frequency) / log2 : 0;
-      correlation += ((index[0] - pixelMean) * (index[1] - pixelMean) * frequency) / pixelVarianceSquared;
-      inverseDifferenceMoment += frequency / (1.0 + (index[0] - index[1]) * (index[0] - index[1]));
-      inertia += (index[0] - index[1]) * (index[0] - index[1]) * frequency;
-      clusterShade += std::pow((index[0] - pixelMean) + (index[1] - pixelMean), 3) * frequency;
-      clusterProminence += std::pow((index[0] - pixelMean) + (index[1] - pixelMean), 4) * frequency;
-      haralickCorrelation += index[0] * index[1] * frequency;
-      ++constVectorIt;
-    }
-
     haralickCorrelation = (fabs(marginalDevSquared) > 1E-8) ? (haralickCorrelation - marginalMean * marginalMean) / marginalDevSquared : 0;
 
     // Fill outputs
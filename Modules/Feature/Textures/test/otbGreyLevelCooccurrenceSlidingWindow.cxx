@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "itkMacro.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkConstNeighborhoodIterator.h"
+
+#include "otbImage.h"
+#include "otbGreyLevelCooccurrenceSlidingWindow.h"
+#include "otbScalarImageToTexturesFilter.h"
+#include "otbScalarImageToAdvancedTexturesFilter.h"
+
+namespace
+{
+const unsigned int Dimension = 2;
+typedef float      PixelType;
+typedef otb::Image<PixelType, Dimension> ImageType;
+
+const unsigned int NbBins = 8;
+
+ImageType::Pointer CreateRandomImage()
+{
+  ImageType::SizeType   size  = {{37, 23}};
+  ImageType::IndexType  index = {{3, -2}};
+  ImageType::RegionType region(index, size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  // Few distinct values, so that co-occurrence pairs often leave and enter
+  // the list
+  std::mt19937                       generator(42);
+  std::uniform_int_distribution<int> distribution(0, 300);
+  for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<PixelType>(distribution(generator) - 20));
+  }
+  return image;
+}
+
+// Check the sliding co-occurrence list against one filled from scratch on
+// every window of the image
+bool CheckSlidingWindow(const ImageType* image, const ImageType::OffsetType& offset, unsigned int radius)
+{
+  typedef otb::GreyLevelCooccurrenceSlidingWindow<ImageType> SlidingWindowType;
+  typedef SlidingWindowType::CooccurrenceIndexedListType     CooccurrenceIndexedListType;
+  typedef itk::ConstNeighborhoodIterator<ImageType>          NeighborhoodIteratorType;
+
+  SlidingWindowType                    slidingWindow(image, offset, NbBins, 0, 255);
+  CooccurrenceIndexedListType::Pointer reference = CooccurrenceIndexedListType::New();
+  reference->Initialize(NbBins, 0, 255);
+
+  const ImageType::RegionType& bufferedRegion = image->GetBufferedRegion();
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, bufferedRegion); !it.IsAtEnd(); ++it)
+  {
+    ImageType::RegionType window;
+    for (unsigned int dim = 0; dim < Dimension; ++dim)
+    {
+      window.SetIndex(dim, it.GetIndex()[dim] - radius);
+      window.SetSize(dim, 2 * radius + 1);
+    }
+    window.Crop(bufferedRegion);
+
+    slidingWindow.SetRegion(window);
+
+    reference->Clear();
+    NeighborhoodIteratorType::RadiusType offsetRadius;
+    offsetRadius.Fill(std::max(std::abs(offset[0]), std::abs(offset[1])));
+    NeighborhoodIteratorType neighIt(offsetRadius, image, window);
+    for (neighIt.GoToBegin(); !neighIt.IsAtEnd(); ++neighIt)
+    {
+      bool      inBounds;
+      PixelType pixel = neighIt.GetPixel(offset, inBounds);
+      if (inBounds)
+      {
+        reference->AddPixelPair(neighIt.GetCenterPixel(), pixel);
+      }
+    }
+
+    CooccurrenceIndexedListType* sliding = slidingWindow.GetCooccurrenceList();
+    if (sliding->GetTotalFrequency() != reference->GetTotalFrequency() || sliding->GetVector().size() != reference->GetVector().size())
+    {
+      std::cerr << "Wrong number of pairs at " << it.GetIndex() << ": " << sliding->GetTotalFrequency() << " instead of " << reference->GetTotalFrequency()
+                << std::endl;
+      return false;
+    }
+    for (unsigned int i = 0; i < NbBins; ++i)
+    {
+      for (unsigned int j = 0; j < NbBins; ++j)
+      {
+        if (sliding->GetFrequency(i, j) != reference->GetFrequency(i, j))
+        {
+          std::cerr << "Wrong frequency of pair [" << i << ", " << j << "] at " << it.GetIndex() << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Run the filter with and without the sliding window, and compare all its
+// outputs
+template <class TFilter>
+bool CheckTexturesFilter(ImageType* image, const ImageType::OffsetType& offset, unsigned int radius, unsigned int step)
+{
+  typename TFilter::SizeType sradius;
+  sradius.Fill(radius);
+  typename TFilter::SizeType factor;
+  factor.Fill(step);
+  typename TFilter::OffsetType subsampleOffset;
+  subsampleOffset.Fill((step - 1) / 2);
+
+  typename TFilter::Pointer filters[2];
+  for (unsigned int k = 0; k < 2; ++k)
+  {
+    filters[k] = TFilter::New();
+    filters[k]->SetInput(image);
+    filters[k]->SetRadius(sradius);
+    filters[k]->SetOffset(offset);
+    filters[k]->SetNumberOfBinsPerAxis(NbBins);
+    filters[k]->SetInputImageMinimum(0);
+    filters[k]->SetInputImageMaximum(255);
+    filters[k]->SetSubsampleFactor(factor);
+    filters[k]->SetSubsampleOffset(subsampleOffset);
+    filters[k]->SetSlidingWindow(k == 1);
+    filters[k]->Update();
+  }
+
+  for (unsigned int i = 0; i < filters[0]->GetNumberOfOutputs(); ++i)
+  {
+    itk::ImageRegionConstIteratorWithIndex<ImageType> it0(filters[0]->GetOutput(i), filters[0]->GetOutput(i)->GetBufferedRegion());
+    itk::ImageRegionConstIteratorWithIndex<ImageType> it1(filters[1]->GetOutput(i), filters[1]->GetOutput(i)->GetBufferedRegion());
+    for (; !it0.IsAtEnd() && !it1.IsAtEnd(); ++it0, ++it1)
+    {
+      const double expected = it0.Get();
+      const double value    = it1.Get();
+      if (std::abs(value - expected) > 1e-5 * std::max(1., std::abs(expected)))
+      {
+        std::cerr << filters[0]->GetNameOfClass() << ": output " << i << " differs at " << it0.GetIndex() << ": " << value << " instead of " << expected
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int otbGreyLevelCooccurrenceSlidingWindow(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::ScalarImageToTexturesFilter<ImageType, ImageType>         TexturesFilterType;
+  typedef otb::ScalarImageToAdvancedTexturesFilter<ImageType, ImageType> AdvancedTexturesFilterType;
+
+  ImageType::Pointer image = CreateRandomImage();
+
+  const int offsets[][Dimension] = {{1, 0}, {1, 1}, {-2, 1}, {0, -3}};
+
+  bool ok = true;
+  for (const auto& o : offsets)
+  {
+    ImageType::OffsetType offset;
+    offset[0] = o[0];
+    offset[1] = o[1];
+
+    ok = ok && CheckSlidingWindow(image, offset, 3);
+    ok = ok && CheckTexturesFilter<TexturesFilterType>(image, offset, 3, 1);
+    ok = ok && CheckTexturesFilter<TexturesFilterType>(image, offset, 2, 3);
+    ok = ok && CheckTexturesFilter<AdvancedTexturesFilterType>(image, offset, 3, 1);
+    ok = ok && CheckTexturesFilter<AdvancedTexturesFilterType>(image, offset, 2, 3);
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
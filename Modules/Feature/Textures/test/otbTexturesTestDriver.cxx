@@ -29,4 +29,5 @@ void RegisterTests()
   REGISTER_TEST(otbSFSTexturesImageFilterTest);
   REGISTER_TEST(otbScalarImageToAdvancedTexturesFilter);
   REGISTER_TEST(otbScalarImageToPanTexTextureFilter);
+  REGISTER_TEST(otbGreyLevelCooccurrenceSlidingWindow);
 }
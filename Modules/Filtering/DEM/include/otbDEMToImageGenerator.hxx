@@ -63,9 +63,9 @@ void DEMToImageGenerator<TDEMImage>::GenerateOutputInformation()
   output->SetOrigin(m_OutputOrigin);
 
   // Add the metadata set by the user to the output
-  output->m_Imd.Add(MDGeom::ProjectionProj, std::string(m_Transform->GetInputProjectionRef()));
+  output->GetImageMetadata().Add(MDGeom::ProjectionProj, std::string(m_Transform->GetInputProjectionRef()));
   if (m_Transform->GetInputImageMetadata() != nullptr)
-    output->m_Imd.Merge(*m_Transform->GetInputImageMetadata());
+    output->GetImageMetadata().Merge(*m_Transform->GetInputImageMetadata());
 }
 
 // InstantiateTransform method
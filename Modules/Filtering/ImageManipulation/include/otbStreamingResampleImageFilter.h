@@ -23,7 +23,7 @@
 
 #include "itkImageToImageFilter.h"
 #include "otbStreamingWarpImageFilter.h"
-#include "itkTransformToDisplacementFieldSource.h"
+#include "otbTransformToDisplacementFieldSource.h"
 #include "itkLinearInterpolateImageFunction.h"
 #include "otbImage.h"
 #include "itkVector.h"
@@ -47,6 +47,15 @@ namespace otb
  * the  interpolator (SetInterpolator()) and the origin (SetOrigin())
  * can be set using the method between brackets.
  *
+ * The displacement grid is computed line by line, each line of the grid
+ * going through a single otb::TransformPoints() call.
+ *
+ * With DisplacementFieldCachingOn(), the grid is computed lazily by blocks
+ * and kept by the grid source across streaming tiles, so that the nodes
+ * shared by adjacent tiles are computed once. The grid can also be
+ * retrieved with GetDisplacementField(), and a grid computed by a previous
+ * run set back with SetDisplacementField() to skip its computation.
+ *
  *
  *
  * \ingroup Projection
@@ -83,7 +92,7 @@ public:
   typedef StreamingWarpImageFilter<InputImageType, OutputImageType, DisplacementFieldType> WarpImageFilterType;
 
   /** Internal filters typedefs*/
-  typedef itk::TransformToDisplacementFieldSource<DisplacementFieldType, double> DisplacementFieldGeneratorType;
+  typedef otb::TransformToDisplacementFieldSource<DisplacementFieldType, double> DisplacementFieldGeneratorType;
   typedef typename DisplacementFieldGeneratorType::TransformType TransformType;
   typedef typename DisplacementFieldGeneratorType::SizeType      SizeType;
   typedef typename DisplacementFieldGeneratorType::SpacingType   SpacingType;
@@ -150,6 +159,31 @@ public:
   otbSetObjectMemberMacro(WarpFilter, EdgePaddingValue, typename OutputImageType::PixelType);
   otbGetObjectMemberMacro(WarpFilter, EdgePaddingValue, typename OutputImageType::PixelType);
 
+  /** Cache the displacement field across requested regions. Off by
+   * default: the whole field is eventually held in memory. */
+  void SetDisplacementFieldCaching(bool caching)
+  {
+    m_DisplacementFilter->SetCaching(caching);
+    this->Modified();
+  }
+  bool GetDisplacementFieldCaching() const
+  {
+    return m_DisplacementFilter->GetCaching();
+  }
+  itkBooleanMacro(DisplacementFieldCaching);
+
+  /** Warp the input with a precomputed displacement field instead of
+   * computing it from the transform. A null field restores the
+   * computation. */
+  void SetDisplacementField(const DisplacementFieldType* field);
+
+  /** Get the displacement field used to warp the input. Its parameters
+   * are set once the output information has been updated. */
+  DisplacementFieldType* GetDisplacementField()
+  {
+    return m_WarpFilter->GetDisplacementField();
+  }
+
   /** Import output parameters from a given image */
   void SetOutputParametersFromImage(const ImageBaseType* image);
 
@@ -141,6 +141,20 @@ void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecis
   this->Modified();
 }
 
+template <class TInputImage, class TOutputImage, class TInterpolatorPrecisionType>
+void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::SetDisplacementField(const DisplacementFieldType* field)
+{
+  if (field)
+  {
+    m_WarpFilter->SetDisplacementField(field);
+  }
+  else
+  {
+    m_WarpFilter->SetDisplacementField(m_DisplacementFilter->GetOutput());
+  }
+  this->Modified();
+}
+
 template <class TInputImage, class TOutputImage, class TInterpolatorPrecisionType>
 void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
@@ -149,6 +163,7 @@ void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecis
   os << indent << "OutputSpacing: " << this->GetOutputSpacing() << std::endl;
   os << indent << "OutputStartIndex: " << this->GetOutputStartIndex() << std::endl;
   os << indent << "OutputSize: " << this->GetOutputSize() << std::endl;
+  os << indent << "DisplacementFieldCaching: " << this->GetDisplacementFieldCaching() << std::endl;
 }
 }
 #endif
@@ -28,6 +28,7 @@
 #include "itkArray.h"
 
 #include "otbParser.h"
+#include "otbStopwatch.h"
 #include <string>
 
 namespace otb
@@ -70,6 +71,14 @@ namespace otb
  * This functionality assumes that all the band involved have the same
  * spacing and origin.
  *
+ * By default, the expression is evaluated on whole lines of pixels at
+ * once, using the bulk mode of muParser: the expression is compiled
+ * once per thread and its bytecode is run over a batch of pixels,
+ * which removes most of the per-pixel overhead of the parser. Results
+ * are identical to the pixel by pixel evaluation, which can still be
+ * selected with BulkEvaluationOff(). The throughput of each
+ * evaluation is reported in the debug log.
+ *
  *
  * \sa Parser
  *
@@ -126,6 +135,12 @@ public:
   /** Return a pointer on the nth filter input */
   ImageType* GetNthInput(DataObjectPointerArraySizeType idx);
 
+  /** Evaluate the expression on whole lines of pixels (default) or
+   * pixel by pixel */
+  itkSetMacro(BulkEvaluation, bool);
+  itkGetConstMacro(BulkEvaluation, bool);
+  itkBooleanMacro(BulkEvaluation);
+
 protected:
   BandMathImageFilter();
   ~BandMathImageFilter() override;
@@ -139,11 +154,22 @@ private:
   BandMathImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Evaluate the expression on a batch of lines */
+  void BulkThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId);
+
+  /** Cast a parser result to the output pixel type, counting the
+   * underflows and overflows of the thread */
+  PixelType CastResult(double value, itk::ThreadIdType threadId);
+
   std::string                      m_Expression;
   std::vector<ParserType::Pointer> m_VParser;
   std::vector<std::vector<double>> m_AImage;
+  std::vector<std::vector<double>> m_AResult;
   std::vector<std::string>         m_VVarName;
   unsigned int                     m_NbVar;
+  bool                             m_BulkEvaluation;
+  unsigned int                     m_BulkSize;
+  Stopwatch                        m_Stopwatch;
 
   SpacingType m_Spacing;
   OrigineType m_Origin;
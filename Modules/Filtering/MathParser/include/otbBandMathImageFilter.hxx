@@ -24,11 +24,13 @@
 #include "otbBandMathImageFilter.h"
 
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "otbMacro.h"
 
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -44,6 +46,8 @@ BandMathImageFilter<TImage>::BandMathImageFilter()
   this->SetNumberOfRequiredInputs(1);
   this->InPlaceOff();
 
+  m_BulkEvaluation = true;
+  m_BulkSize       = 1;
   m_UnderflowCount = 0;
   m_OverflowCount  = 0;
   m_ThreadUnderflow.SetSize(1);
@@ -62,6 +66,7 @@ void BandMathImageFilter<TImage>::PrintSelf(std::ostream& os, itk::Indent indent
   Superclass::PrintSelf(os, indent);
 
   os << indent << "Expression: " << m_Expression << std::endl;
+  os << indent << "BulkEvaluation: " << m_BulkEvaluation << std::endl;
   os << indent << "Computed values follow:" << std::endl;
   os << indent << "UnderflowCount: " << m_UnderflowCount << std::endl;
   os << indent << "OverflowCount: " << m_OverflowCount << std::endl;
@@ -141,6 +146,8 @@ void BandMathImageFilter<TImage>::BeforeThreadedGenerateData()
   unsigned int                                        inputSize[2];
   std::vector<std::string>                            tmpIdxVarNames;
 
+  m_Stopwatch.Restart();
+
   tmpIdxVarNames.resize(nbAccessIndex);
 
   tmpIdxVarNames.resize(nbAccessIndex);
@@ -176,6 +183,7 @@ void BandMathImageFilter<TImage>::BeforeThreadedGenerateData()
   m_ThreadOverflow.Fill(0);
   m_VParser.resize(nbThreads);
   m_AImage.resize(nbThreads);
+  m_AResult.resize(nbThreads);
   m_NbVar = nbInputImages + nbAccessIndex;
   m_VVarName.resize(m_NbVar);
 
@@ -184,20 +192,33 @@ void BandMathImageFilter<TImage>::BeforeThreadedGenerateData()
     *itParser = ParserType::New();
   }
 
+  // In bulk mode, each variable holds a batch of lines of the requested
+  // region, variables being stored one after the other. Batches hold at
+  // least MinimumBulkSize pixels so that the setup cost of each bulk
+  // evaluation stays negligible.
+  m_BulkSize = 1;
+  if (m_BulkEvaluation)
+  {
+    const unsigned int MinimumBulkSize = 4096;
+    const unsigned int lineLength      = std::max<unsigned int>(this->GetOutput()->GetRequestedRegion().GetSize(0), 1);
+    m_BulkSize                         = lineLength * std::max(MinimumBulkSize / lineLength, 1u);
+  }
+
   for (i = 0; i < nbThreads; ++i)
   {
-    m_AImage[i].resize(m_NbVar);
+    m_AImage[i].resize(m_NbVar * m_BulkSize);
+    m_AResult[i].resize(m_BulkSize);
     m_VParser[i]->SetExpr(m_Expression);
 
     for (j = 0; j < nbInputImages; ++j)
     {
-      m_VParser[i]->DefineVar(m_VVarName[j], &(m_AImage[i][j]));
+      m_VParser[i]->DefineVar(m_VVarName[j], &(m_AImage[i][j * m_BulkSize]));
     }
 
     for (j = nbInputImages; j < nbInputImages + nbAccessIndex; ++j)
     {
       m_VVarName[j] = tmpIdxVarNames[j - nbInputImages];
-      m_VParser[i]->DefineVar(m_VVarName[j], &(m_AImage[i][j]));
+      m_VParser[i]->DefineVar(m_VVarName[j], &(m_AImage[i][j * m_BulkSize]));
     }
   }
 }
@@ -225,11 +246,43 @@ void BandMathImageFilter<TImage>::AfterThreadedGenerateData()
                     << "And " << m_OverflowCount << " Overflow(s) " << std::endl
                     << "The Parsed Expression, The Inputs And The Output "
                     << "Type May Be Incompatible !");
+
+  m_Stopwatch.Stop();
+  const double nbPixels     = this->GetOutput()->GetRequestedRegion().GetNumberOfPixels();
+  const double milliseconds = std::max<double>(m_Stopwatch.GetElapsedMilliseconds(), 1.);
+  otbMsgDebugMacro(<< "Expression \"" << m_Expression << "\" evaluated on " << nbPixels << " pixels in " << m_Stopwatch.GetElapsedMilliseconds() << " ms ("
+                   << nbPixels / milliseconds * 1e-3 << " Mpixels/s, " << (m_BulkEvaluation ? "bulk" : "pixel by pixel") << " evaluation)");
+}
+
+template <typename TImage>
+typename BandMathImageFilter<TImage>::PixelType BandMathImageFilter<TImage>::CastResult(double value, itk::ThreadIdType threadId)
+{
+  // Case value is equal to -inf or inferior to the minimum value
+  // allowed by the pixelType cast
+  if (value < double(itk::NumericTraits<PixelType>::NonpositiveMin()))
+  {
+    m_ThreadUnderflow[threadId]++;
+    return itk::NumericTraits<PixelType>::NonpositiveMin();
+  }
+  // Case value is equal to inf or superior to the maximum value
+  // allowed by the pixelType cast
+  if (value > double(itk::NumericTraits<PixelType>::max()))
+  {
+    m_ThreadOverflow[threadId]++;
+    return itk::NumericTraits<PixelType>::max();
+  }
+  return static_cast<PixelType>(value);
 }
 
 template <typename TImage>
 void BandMathImageFilter<TImage>::ThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
 {
+  if (m_BulkEvaluation)
+  {
+    this->BulkThreadedGenerateData(outputRegionForThread, threadId);
+    return;
+  }
+
   double       value;
   unsigned int j;
   unsigned int nbInputImages = this->GetNumberOfInputs();
@@ -251,8 +304,6 @@ void BandMathImageFilter<TImage>::ThreadedGenerateData(const ImageRegionType& ou
 
   std::vector<double>&          threadImage      = m_AImage[threadId];
   ParserType::Pointer const&    threadParser     = m_VParser[threadId];
-  long&                         threadUnderflow  = m_ThreadUnderflow[threadId];
-  long&                         threadOverflow   = m_ThreadOverflow[threadId];
   ImageRegionConstIteratorType& firstImageRegion = Vit.front(); // alias for better perfs
   while (!firstImageRegion.IsAtEnd())
   {
@@ -282,24 +333,7 @@ void BandMathImageFilter<TImage>::ThreadedGenerateData(const ImageRegionType& ou
       itkExceptionMacro(<< err);
     }
 
-    // Case value is equal to -inf or inferior to the minimum value
-    // allowed by the pixelType cast
-    if (value < double(itk::NumericTraits<PixelType>::NonpositiveMin()))
-    {
-      ot.Set(itk::NumericTraits<PixelType>::NonpositiveMin());
-      threadUnderflow++;
-    }
-    // Case value is equal to inf or superior to the maximum value
-    // allowed by the pixelType cast
-    else if (value > double(itk::NumericTraits<PixelType>::max()))
-    {
-      ot.Set(itk::NumericTraits<PixelType>::max());
-      threadOverflow++;
-    }
-    else
-    {
-      ot.Set(static_cast<PixelType>(value));
-    }
+    ot.Set(this->CastResult(value, threadId));
 
     for (j = 0; j < nbInputImages; ++j)
     {
@@ -312,6 +346,99 @@ void BandMathImageFilter<TImage>::ThreadedGenerateData(const ImageRegionType& ou
   }
 }
 
+template <typename TImage>
+void BandMathImageFilter<TImage>::BulkThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  unsigned int       nbInputImages = this->GetNumberOfInputs();
+  const unsigned int lineLength    = outputRegionForThread.GetSize(0);
+
+  typedef itk::ImageScanlineConstIterator<TImage> ScanlineConstIteratorType;
+
+  if (outputRegionForThread.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  assert(nbInputImages);
+  assert(lineLength <= m_BulkSize);
+  std::vector<ScanlineConstIteratorType> Vit(nbInputImages);
+
+  for (unsigned int j = 0; j < nbInputImages; ++j)
+  {
+    Vit[j] = ScanlineConstIteratorType(this->GetNthInput(j), outputRegionForThread);
+  }
+
+  itk::ImageScanlineIterator<TImage> ot(this->GetOutput(), outputRegionForThread);
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  std::vector<double>&       threadImage  = m_AImage[threadId];
+  double*                    threadResult = m_AResult[threadId].data();
+  ParserType::Pointer const& threadParser = m_VParser[threadId];
+
+  // Lines are evaluated by batches of linesPerBatch
+  const unsigned int linesPerBatch = m_BulkSize / lineLength;
+  const unsigned int batchSize     = linesPerBatch * lineLength;
+
+  // Index variables follow the input variables
+  double* idxX    = &threadImage[nbInputImages * m_BulkSize];
+  double* idxY    = idxX + m_BulkSize;
+  double* idxPhyX = idxY + m_BulkSize;
+  double* idxPhyY = idxPhyX + m_BulkSize;
+
+  // Column indexes are the same for every batch
+  for (unsigned int k = 0; k < batchSize; ++k)
+  {
+    idxX[k]    = static_cast<double>(outputRegionForThread.GetIndex(0) + k % lineLength);
+    idxPhyX[k] = static_cast<double>(m_Origin[0]) + idxX[k] * static_cast<double>(m_Spacing[0]);
+  }
+
+  ScanlineConstIteratorType& firstImageRegion = Vit.front(); // alias for better perfs
+  while (!firstImageRegion.IsAtEnd())
+  {
+    // Gather a batch of lines
+    unsigned int nbLines = 0;
+    for (; nbLines < linesPerBatch && !firstImageRegion.IsAtEnd(); ++nbLines)
+    {
+      const unsigned int offset = nbLines * lineLength;
+      const double       y      = static_cast<double>(firstImageRegion.GetIndex()[1]);
+      std::fill(idxY + offset, idxY + offset + lineLength, y);
+      std::fill(idxPhyY + offset, idxPhyY + offset + lineLength, static_cast<double>(m_Origin[1]) + y * static_cast<double>(m_Spacing[1]));
+
+      for (unsigned int j = 0; j < nbInputImages; ++j)
+      {
+        double* var = &threadImage[j * m_BulkSize + offset];
+        for (; !Vit[j].IsAtEndOfLine(); ++Vit[j], ++var)
+        {
+          *var = static_cast<double>(Vit[j].Get());
+        }
+        Vit[j].NextLine();
+      }
+    }
+
+    try
+    {
+      threadParser->Eval(threadResult, nbLines * lineLength);
+    }
+    catch (itk::ExceptionObject& err)
+    {
+      itkExceptionMacro(<< err);
+    }
+
+    const double* result = threadResult;
+    for (unsigned int line = 0; line < nbLines; ++line)
+    {
+      for (; !ot.IsAtEndOfLine(); ++ot, ++result)
+      {
+        ot.Set(this->CastResult(*result, threadId));
+        progress.CompletedPixel();
+      }
+      ot.NextLine();
+    }
+  }
+}
+
 } // end namespace otb
 
 #endif
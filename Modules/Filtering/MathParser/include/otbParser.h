@@ -69,6 +69,11 @@ public:
   /** Trigger the parsing */
   ValueType Eval();
 
+  /** Evaluate the expression nbResults times at once (bulk mode).
+   * Each variable must point to an array of nbResults values: the
+   * i-th result is computed from the i-th value of each variable. */
+  void Eval(ValueType* results, int nbResults);
+
   /** Define a variable */
   void DefineVar(const std::string& sName, ValueType* fVar);
 
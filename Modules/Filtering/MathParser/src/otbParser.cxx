@@ -96,6 +96,19 @@ public:
     return result;
   }
 
+  /** Trigger the parsing in bulk mode */
+  void Eval(ValueType* results, int nbResults)
+  {
+    try
+    {
+      m_MuParser.Eval(results, nbResults);
+    }
+    catch (ExceptionType& e)
+    {
+      ExceptionHandler(e);
+    }
+  }
+
 
   /** Define a variable */
   void DefineVar(const std::string& sName, ValueType* fVar)
@@ -253,6 +266,11 @@ Parser::ValueType Parser::Eval()
   return m_InternalParser->Eval();
 }
 
+void Parser::Eval(Parser::ValueType* results, int nbResults)
+{
+  m_InternalParser->Eval(results, nbResults);
+}
+
 void Parser::DefineVar(const std::string& sName, Parser::ValueType* fVar)
 {
   m_InternalParser->DefineVar(sName, fVar);
@@ -22,11 +22,15 @@
 #include "itkMacro.h"
 #include <iostream>
 #include <complex> //only for the isnan() test line 148
+#include <chrono>
+#include <string>
+#include <vector>
 
 #include "otbMath.h"
 #include "otbImage.h"
 #include "otbBandMathImageFilter.h"
 #include "otbImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 
 
 int otbBandMathImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
@@ -272,3 +276,104 @@ int otbBandMathImageFilterWithIdx(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbBandMathImageFilterBulk(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef double PixelType;
+  typedef otb::Image<PixelType, 2> ImageType;
+  typedef otb::BandMathImageFilter<ImageType> FilterType;
+
+  ImageType::RegionType region;
+  region.SetIndex(0, 5);
+  region.SetIndex(1, -3);
+  region.SetSize(0, 301);
+  region.SetSize(1, 67);
+
+  ImageType::PointType origin;
+  origin[0] = -25;
+  origin[1] = 12;
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = -0.25;
+
+  std::vector<ImageType::Pointer> images;
+  for (unsigned int b = 0; b < 3; ++b)
+  {
+    ImageType::Pointer image = ImageType::New();
+    image->SetRegions(region);
+    image->SetOrigin(origin);
+    image->SetSignedSpacing(spacing);
+    image->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<ImageType> it(image, region);
+    for (unsigned int i = 0; !it.IsAtEnd(); ++it, ++i)
+    {
+      it.Set(static_cast<PixelType>((i * (7919 + 13 * b)) % 1000) / 10.);
+    }
+    images.push_back(image);
+  }
+
+  // Streamed requested region, with lines shorter than the image ones
+  ImageType::RegionType subRegion;
+  subRegion.SetIndex(0, 40);
+  subRegion.SetIndex(1, 2);
+  subRegion.SetSize(0, 123);
+  subRegion.SetSize(1, 45);
+
+  std::vector<std::string> expressions = {"ndvi(b1, b2)", "b1 / (b2 + 1)", "sqrt(b1 * b1 + b2 * b2 + b3 * b3)", "idxPhyX * b3 + idxY - idxX * idxPhyY",
+#ifdef OTB_MUPARSER_HAS_CXX_LOGICAL_OPERATORS
+                                          "(b1 > 50) ? b2 : b3"
+#else
+                                          "if(b1 > 50, b2, b3)"
+#endif
+  };
+
+  for (const auto& expression : expressions)
+  {
+    for (const auto& requestedRegion : {region, subRegion})
+    {
+      FilterType::Pointer pixelFilter = FilterType::New();
+      FilterType::Pointer bulkFilter  = FilterType::New();
+      for (unsigned int b = 0; b < images.size(); ++b)
+      {
+        pixelFilter->SetNthInput(b, images[b]);
+        bulkFilter->SetNthInput(b, images[b]);
+      }
+      pixelFilter->SetExpression(expression);
+      bulkFilter->SetExpression(expression);
+      pixelFilter->BulkEvaluationOff();
+      bulkFilter->BulkEvaluationOn();
+
+      pixelFilter->UpdateOutputInformation();
+      bulkFilter->UpdateOutputInformation();
+      pixelFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+      bulkFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+
+      auto start = std::chrono::steady_clock::now();
+      pixelFilter->Update();
+      std::chrono::duration<double> pixelTime = std::chrono::steady_clock::now() - start;
+      start                                   = std::chrono::steady_clock::now();
+      bulkFilter->Update();
+      std::chrono::duration<double> bulkTime = std::chrono::steady_clock::now() - start;
+
+      const double nbMPixels = requestedRegion.GetNumberOfPixels() * 1e-6;
+      std::cout << expression << " on " << requestedRegion.GetSize() << ": " << nbMPixels / pixelTime.count() << " Mpixels/s pixel by pixel, "
+                << nbMPixels / bulkTime.count() << " Mpixels/s in bulk mode" << std::endl;
+
+      itk::ImageRegionConstIteratorWithIndex<ImageType> itPixel(pixelFilter->GetOutput(), requestedRegion);
+      itk::ImageRegionConstIteratorWithIndex<ImageType> itBulk(bulkFilter->GetOutput(), requestedRegion);
+      for (; !itPixel.IsAtEnd(); ++itPixel, ++itBulk)
+      {
+        // Both modes run the same bytecode: results must be identical
+        if (itPixel.Get() != itBulk.Get() && !(vnl_math_isnan(itPixel.Get()) && vnl_math_isnan(itBulk.Get())))
+        {
+          std::cout << "Bulk evaluation of " << expression << " differs at " << itPixel.GetIndex() << ": " << itBulk.Get() << " instead of "
+                    << itPixel.Get() << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
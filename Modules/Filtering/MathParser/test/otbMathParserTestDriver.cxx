@@ -27,4 +27,5 @@ void RegisterTests()
   REGISTER_TEST(otbImageListToSingleImageFilter);
   REGISTER_TEST(otbBandMathImageFilter);
   REGISTER_TEST(otbBandMathImageFilterWithIdx);
+  REGISTER_TEST(otbBandMathImageFilterBulk);
 }
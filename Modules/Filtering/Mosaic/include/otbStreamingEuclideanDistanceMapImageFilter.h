@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingEuclideanDistanceMapImageFilter_h
+#define otbStreamingEuclideanDistanceMapImageFilter_h
+
+#include <utility>
+#include <vector>
+#include "itkImageSource.h"
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+
+namespace otb
+{
+
+/** \class PersistentColumnRunsImageFilter
+ * \brief Encode the non-zero pixels of a binary image as runs of rows, column by column.
+ *
+ * For each column of the largest possible region, the filter gathers the
+ * intervals of consecutive rows holding non-zero pixels. Runs split between
+ * two streamed regions, or between two threads, are merged in Synthetize().
+ * The encoding is compact for the masks used in mosaicking (no-data borders,
+ * cutlines), which only have a few transitions per column.
+ *
+ * Run indices are expressed relative to the largest possible region index.
+ *
+ * \sa PersistentImageFilter
+ * \sa StreamingEuclideanDistanceMapImageFilter
+ *
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBMosaic
+ */
+template <class TInputImage>
+class ITK_EXPORT PersistentColumnRunsImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentColumnRunsImageFilter                 Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>                         Pointer;
+  typedef itk::SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentColumnRunsImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                        ImageType;
+  typedef typename TInputImage::Pointer      InputImagePointer;
+  typedef typename TInputImage::RegionType   RegionType;
+  typedef typename TInputImage::IndexType    IndexType;
+  typedef typename IndexType::IndexValueType IndexValueType;
+  typedef typename TInputImage::PixelType    PixelType;
+
+  /** First and last rows (inclusive) of a run of non-zero pixels */
+  typedef std::pair<IndexValueType, IndexValueType> RunType;
+  typedef std::vector<RunType>                      RunListType;
+  typedef std::vector<RunListType>                  ColumnRunsType;
+
+  /** Return the sorted and merged runs of each column */
+  const ColumnRunsType& GetColumnRuns() const
+  {
+    return m_ColumnRuns;
+  }
+
+  /** Return the number of runs found in the whole image */
+  itkGetConstMacro(NumberOfRuns, unsigned long);
+
+  /** Pass the input through unmodified. Do this by Grafting in the
+   *  AllocateOutputs method.
+   */
+  void AllocateOutputs() override;
+  void GenerateOutputInformation() override;
+  void Synthetize(void) override;
+  void Reset(void) override;
+
+protected:
+  PersistentColumnRunsImageFilter();
+  ~PersistentColumnRunsImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Multi-thread version GenerateData. */
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  PersistentColumnRunsImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Column and run, as collected by one thread */
+  typedef std::pair<IndexValueType, RunType> ThreadRunType;
+
+  std::vector<std::vector<ThreadRunType>> m_ThreadRuns;
+  ColumnRunsType                          m_ColumnRuns;
+  unsigned long                           m_NumberOfRuns;
+}; // end of class PersistentColumnRunsImageFilter
+
+
+/** \class StreamingEuclideanDistanceMapImageFilter
+ * \brief Exact, streamed and multi-threaded Euclidean distance map of a binary mask.
+ *
+ * The output pixel value is the distance from the pixel center to the
+ * center of the closest non-zero pixel of the mask, like the
+ * itk::DanielssonDistanceMapImageFilter with InputIsBinary on. Pixels
+ * outside of the mask extent are considered non-zero, so that the
+ * distance never exceeds the distance to the image border plus one pixel.
+ * Distances are expressed in physical units when UseImageSpacing is on
+ * (default).
+ *
+ * The computation follows the separable scheme of Meijster et al. and
+ * Felzenszwalb and Huttenlocher. The column pass is replaced by a run
+ * length encoding of the mask, computed once by streaming the mask through
+ * a PersistentColumnRunsImageFilter when the output information is
+ * generated. The vertical distance of any pixel is then a binary search in
+ * the runs of its column. The row pass computes the lower envelope of
+ * parabolas, restricted to the columns which can hold the closest feature
+ * of the requested pixels. Hence any output region can be produced without
+ * reading the mask again, which makes the filter fully streamable and
+ * suited as a distance image input of StreamingLargeFeatherMosaicFilter
+ * or StreamingFeatherMosaicFilter.
+ *
+ * The mask is not a pipeline input of this filter: it is only streamed
+ * when the filter output information is updated after a call to SetInput().
+ *
+ * \sa PersistentColumnRunsImageFilter
+ *
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBMosaic
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT StreamingEuclideanDistanceMapImageFilter : public itk::ImageSource<TOutputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingEuclideanDistanceMapImageFilter Self;
+  typedef itk::ImageSource<TOutputImage>           Superclass;
+  typedef itk::SmartPointer<Self>                  Pointer;
+  typedef itk::SmartPointer<const Self>            ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(StreamingEuclideanDistanceMapImageFilter, ImageSource);
+
+  /** Image related typedefs. */
+  typedef TInputImage                           InputImageType;
+  typedef typename InputImageType::ConstPointer InputImageConstPointer;
+  typedef TOutputImage                          OutputImageType;
+  typedef typename OutputImageType::RegionType  OutputImageRegionType;
+  typedef typename OutputImageType::PixelType   OutputImagePixelType;
+  typedef typename OutputImageType::SpacingType OutputImageSpacingType;
+
+  /** Column pass typedefs */
+  typedef PersistentColumnRunsImageFilter<InputImageType>          ColumnRunsFilterType;
+  typedef PersistentFilterStreamingDecorator<ColumnRunsFilterType> StreamingColumnRunsFilterType;
+  typedef typename ColumnRunsFilterType::IndexValueType            IndexValueType;
+  typedef typename ColumnRunsFilterType::RunListType               RunListType;
+  typedef typename ColumnRunsFilterType::ColumnRunsType            ColumnRunsType;
+
+  /** Set/Get the binary mask (non-zero pixels are the features) */
+  void SetInput(const InputImageType* input);
+  const InputImageType* GetInput() const;
+
+  /** Access to the column pass, e.g. to set the streaming parameters */
+  itkGetObjectMacro(ColumnRunsFilter, StreamingColumnRunsFilterType);
+
+  /** Express the distances in physical units (default) or in pixels */
+  itkSetMacro(UseImageSpacing, bool);
+  itkGetConstMacro(UseImageSpacing, bool);
+  itkBooleanMacro(UseImageSpacing);
+
+protected:
+  StreamingEuclideanDistanceMapImageFilter();
+  ~StreamingEuclideanDistanceMapImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Copy the mask information, and stream the mask to encode its columns */
+  void GenerateOutputInformation() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  StreamingEuclideanDistanceMapImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Number of rows between a row and the closest run of a column,
+   * or the image border */
+  static IndexValueType VerticalDistance(const RunListType& runs, IndexValueType row, IndexValueType nbRows);
+
+  typename StreamingColumnRunsFilterType::Pointer m_ColumnRunsFilter;
+  bool                                            m_UseImageSpacing;
+}; // end of class StreamingEuclideanDistanceMapImageFilter
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingEuclideanDistanceMapImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,350 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingEuclideanDistanceMapImageFilter_hxx
+#define otbStreamingEuclideanDistanceMapImageFilter_hxx
+
+#include "otbStreamingEuclideanDistanceMapImageFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include "itkImageScanlineIterator.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkProgressReporter.h"
+#include "otbMacro.h"
+
+namespace otb
+{
+
+template <class TInputImage>
+PersistentColumnRunsImageFilter<TInputImage>::PersistentColumnRunsImageFilter() : m_NumberOfRuns(0)
+{
+  this->Reset();
+}
+
+template <class TInputImage>
+void PersistentColumnRunsImageFilter<TInputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentColumnRunsImageFilter<TInputImage>::AllocateOutputs()
+{
+  // The output image of this filter is not intended to be used, so the
+  // input is not grafted to prevent streaming the whole image at once
+}
+
+template <class TInputImage>
+void PersistentColumnRunsImageFilter<TInputImage>::Reset()
+{
+  m_ThreadRuns.clear();
+  m_ThreadRuns.resize(this->GetNumberOfThreads());
+  m_ColumnRuns.clear();
+  m_NumberOfRuns = 0;
+}
+
+template <class TInputImage>
+void PersistentColumnRunsImageFilter<TInputImage>::Synthetize()
+{
+  m_ColumnRuns.assign(this->GetInput()->GetLargestPossibleRegion().GetSize(0), RunListType());
+  for (auto& threadRuns : m_ThreadRuns)
+  {
+    for (const auto& columnRun : threadRuns)
+    {
+      m_ColumnRuns[columnRun.first].push_back(columnRun.second);
+    }
+    std::vector<ThreadRunType>().swap(threadRuns);
+  }
+
+  // Merge the runs split across streamed regions and threads
+  m_NumberOfRuns = 0;
+  for (auto& runs : m_ColumnRuns)
+  {
+    if (runs.empty())
+    {
+      continue;
+    }
+    std::sort(runs.begin(), runs.end());
+    std::size_t last = 0;
+    for (std::size_t i = 1; i < runs.size(); ++i)
+    {
+      if (runs[i].first <= runs[last].second + 1)
+      {
+        runs[last].second = std::max(runs[last].second, runs[i].second);
+      }
+      else
+      {
+        runs[++last] = runs[i];
+      }
+    }
+    runs.resize(last + 1);
+    runs.shrink_to_fit();
+    m_NumberOfRuns += runs.size();
+  }
+  otbMsgDevMacro(<< "Mask encoded with " << m_NumberOfRuns << " runs over " << m_ColumnRuns.size() << " columns");
+}
+
+template <class TInputImage>
+void PersistentColumnRunsImageFilter<TInputImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  InputImagePointer    inputPtr      = const_cast<TInputImage*>(this->GetInput());
+  const RegionType&    largestRegion = inputPtr->GetLargestPossibleRegion();
+  const IndexValueType firstCol      = outputRegionForThread.GetIndex(0) - largestRegion.GetIndex(0);
+  const IndexValueType firstRow      = outputRegionForThread.GetIndex(1) - largestRegion.GetIndex(1);
+  const IndexValueType nbCols        = outputRegionForThread.GetSize(0);
+  const IndexValueType nbRows        = outputRegionForThread.GetSize(1);
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, nbRows);
+
+  // First row of the run in progress in each column, or -1
+  std::vector<IndexValueType> runStart(nbCols, -1);
+  std::vector<ThreadRunType>& runs = m_ThreadRuns[threadId];
+
+  itk::ImageScanlineConstIterator<TInputImage> it(inputPtr, outputRegionForThread);
+  for (IndexValueType row = firstRow; !it.IsAtEnd(); ++row, it.NextLine())
+  {
+    for (IndexValueType col = 0; col < nbCols; ++col, ++it)
+    {
+      const bool feature = (it.Get() != itk::NumericTraits<PixelType>::ZeroValue());
+      if (feature && runStart[col] < 0)
+      {
+        runStart[col] = row;
+      }
+      else if (!feature && runStart[col] >= 0)
+      {
+        runs.emplace_back(firstCol + col, RunType(runStart[col], row - 1));
+        runStart[col] = -1;
+      }
+    }
+    progress.CompletedPixel();
+  }
+
+  // Close the runs reaching the last row of the region
+  for (IndexValueType col = 0; col < nbCols; ++col)
+  {
+    if (runStart[col] >= 0)
+    {
+      runs.emplace_back(firstCol + col, RunType(runStart[col], firstRow + nbRows - 1));
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentColumnRunsImageFilter<TInputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of columns: " << m_ColumnRuns.size() << std::endl;
+  os << indent << "Number of runs: " << m_NumberOfRuns << std::endl;
+}
+
+template <class TInputImage, class TOutputImage>
+StreamingEuclideanDistanceMapImageFilter<TInputImage, TOutputImage>::StreamingEuclideanDistanceMapImageFilter() : m_UseImageSpacing(true)
+{
+  m_ColumnRunsFilter = StreamingColumnRunsFilterType::New();
+}
+
+template <class TInputImage, class TOutputImage>
+void StreamingEuclideanDistanceMapImageFilter<TInputImage, TOutputImage>::SetInput(const InputImageType* input)
+{
+  m_ColumnRunsFilter->GetFilter()->SetInput(input);
+  this->Modified();
+}
+
+template <class TInputImage, class TOutputImage>
+const typename StreamingEuclideanDistanceMapImageFilter<TInputImage, TOutputImage>::InputImageType*
+StreamingEuclideanDistanceMapImageFilter<TInputImage, TOutputImage>::GetInput() const
+{
+  return m_ColumnRunsFilter->GetFilter()->GetInput();
+}
+
+template <class TInputImage, class TOutputImage>
+void StreamingEuclideanDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (input == nullptr)
+  {
+    itkExceptionMacro(<< "Input mask is not set");
+  }
+
+  input->UpdateOutputInformation();
+  this->GetOutput()->CopyInformation(input);
+
+  // Column pass: encode the whole mask once
+  m_ColumnRunsFilter->Update();
+}
+
+template <class TInputImage, class TOutputImage>
+typename StreamingEuclideanDistanceMapImageFilter<TInputImage, TOutputImage>::IndexValueType
+StreamingEuclideanDistanceMapImageFilter<TInputImage, TOutputImage>::VerticalDistance(const RunListType& runs, IndexValueType row, IndexValueType nbRows)
+{
+  // Rows -1 and nbRows are outside of the mask extent
+  IndexValueType distance = std::min(row + 1, nbRows - row);
+
+  // First run ending at or after the row
+  auto next = std::lower_bound(runs.begin(), runs.end(), row, [](const typename RunListType::value_type& run, IndexValueType r) { return run.second < r; });
+  if (next != runs.end())
+  {
+    if (next->first <= row)
+    {
+      return 0;
+    }
+    distance = std::min(distance, next->first - row);
+  }
+  if (next != runs.begin())
+  {
+    distance = std::min(distance, row - std::prev(next)->second);
+  }
+  return distance;
+}
+
+template <class TInputImage, class TOutputImage>
+void StreamingEuclideanDistanceMapImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                              itk::ThreadIdType            threadId)
+{
+  OutputImageType*             output        = this->GetOutput();
+  const OutputImageRegionType& largestRegion = output->GetLargestPossibleRegion();
+  const ColumnRunsType&        columnRuns    = m_ColumnRunsFilter->GetFilter()->GetColumnRuns();
+
+  const IndexValueType nbCols   = largestRegion.GetSize(0);
+  const IndexValueType nbRows   = largestRegion.GetSize(1);
+  const IndexValueType firstCol = outputRegionForThread.GetIndex(0) - largestRegion.GetIndex(0);
+  const IndexValueType lastCol  = firstCol + outputRegionForThread.GetSize(0) - 1;
+
+  double sx = 1.0;
+  double sy = 1.0;
+  if (m_UseImageSpacing)
+  {
+    sx = std::abs(output->GetSignedSpacing()[0]);
+    sy = std::abs(output->GetSignedSpacing()[1]);
+  }
+
+  // Squared vertical distances, and lower envelope of the parabolas:
+  // columns of the parabolas and abscissae of their boundaries
+  std::vector<double>         g2(nbCols);
+  std::vector<IndexValueType> v(nbCols);
+  std::vector<double>         z(nbCols + 1);
+  const double                infinity = std::numeric_limits<double>::infinity();
+
+  auto verticalPass = [&](IndexValueType col, IndexValueType row) {
+    const double dy = sy * VerticalDistance(columnRuns[col], row, nbRows);
+    g2[col]         = dy * dy;
+  };
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize(1));
+
+  itk::ImageScanlineIterator<OutputImageType> outIt(output, outputRegionForThread);
+  while (!outIt.IsAtEnd())
+  {
+    const IndexValueType row = outIt.GetIndex()[1] - largestRegion.GetIndex(1);
+
+    // Upper bound of the squared distances of the requested pixels: their
+    // vertical distance or their distance to the left and right borders
+    double bound = 0.0;
+    for (IndexValueType col = firstCol; col <= lastCol; ++col)
+    {
+      verticalPass(col, row);
+      const double dLeft  = sx * (col + 1);
+      const double dRight = sx * (nbCols - col);
+      bound               = std::max(bound, std::min({g2[col], dLeft * dLeft, dRight * dRight}));
+    }
+
+    // Only the columns within this bound can hold the closest feature
+    const IndexValueType radius = static_cast<IndexValueType>(std::ceil(std::sqrt(bound) / sx));
+    const IndexValueType lo     = std::max<IndexValueType>(0, firstCol - radius);
+    const IndexValueType hi     = std::min<IndexValueType>(nbCols - 1, lastCol + radius);
+    for (IndexValueType col = lo; col < firstCol; ++col)
+    {
+      verticalPass(col, row);
+    }
+    for (IndexValueType col = lastCol + 1; col <= hi; ++col)
+    {
+      verticalPass(col, row);
+    }
+
+    // Lower envelope of the parabolas (p - sx * q)^2 + g2[q]
+    IndexValueType k = 0;
+    v[0]             = lo;
+    z[0]             = -infinity;
+    z[1]             = infinity;
+    for (IndexValueType q = lo + 1; q <= hi; ++q)
+    {
+      const double pq = sx * q;
+      double       s  = 0.0;
+      while (true)
+      {
+        const double pv = sx * v[k];
+        s               = ((g2[q] + pq * pq) - (g2[v[k]] + pv * pv)) / (2.0 * (pq - pv));
+        if (s > z[k])
+        {
+          break;
+        }
+        --k;
+      }
+      ++k;
+      v[k]     = q;
+      z[k]     = s;
+      z[k + 1] = infinity;
+    }
+
+    // Distance to the closest feature, or to the left and right borders
+    k = 0;
+    for (IndexValueType col = firstCol; col <= lastCol; ++col, ++outIt)
+    {
+      const double p = sx * col;
+      while (z[k + 1] < p)
+      {
+        ++k;
+      }
+      const double dx     = p - sx * v[k];
+      const double dLeft  = sx * (col + 1);
+      const double dRight = sx * (nbCols - col);
+      const double d2     = std::min({dx * dx + g2[v[k]], dLeft * dLeft, dRight * dRight});
+      outIt.Set(static_cast<OutputImagePixelType>(std::sqrt(d2)));
+    }
+    outIt.NextLine();
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void StreamingEuclideanDistanceMapImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Use image spacing: " << m_UseImageSpacing << std::endl;
+}
+
+} // end namespace otb
+
+#endif
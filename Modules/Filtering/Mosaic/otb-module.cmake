@@ -28,8 +28,11 @@ otb_module(OTBMosaic
     OTBCommon
     OTBConversion
     OTBFunctor
+    OTBStreaming
 
   TEST_DEPENDS
+    OTBImageBase
+    OTBTestKernel
 
   DESCRIPTION
     "${DOCUMENTATION}"
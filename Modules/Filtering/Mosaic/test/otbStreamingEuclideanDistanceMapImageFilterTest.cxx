@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "otbImage.h"
+#include "otbStreamingEuclideanDistanceMapImageFilter.h"
+
+typedef otb::Image<unsigned char> MaskImageType;
+typedef otb::Image<double>        DistanceImageType;
+typedef otb::StreamingEuclideanDistanceMapImageFilter<MaskImageType, DistanceImageType> DistanceMapFilterType;
+
+namespace
+{
+
+/** Distance from each pixel to the closest non-zero pixel of the mask, the
+ * pixels around the mask being non-zero, by exhaustive search */
+std::vector<double> BruteForceDistances(const MaskImageType* mask, bool useSpacing)
+{
+  const MaskImageType::RegionType region = mask->GetLargestPossibleRegion();
+  const long                      width  = region.GetSize(0);
+  const long                      height = region.GetSize(1);
+  const double                    sx     = useSpacing ? std::abs(mask->GetSignedSpacing()[0]) : 1.0;
+  const double                    sy     = useSpacing ? std::abs(mask->GetSignedSpacing()[1]) : 1.0;
+
+  std::vector<std::pair<long, long>> features;
+  itk::ImageRegionConstIteratorWithIndex<MaskImageType> it(mask, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != 0)
+    {
+      features.emplace_back(it.GetIndex()[0] - region.GetIndex(0), it.GetIndex()[1] - region.GetIndex(1));
+    }
+  }
+
+  std::vector<double> distances(width * height);
+  for (long y = 0; y < height; ++y)
+  {
+    for (long x = 0; x < width; ++x)
+    {
+      // The closest pixel around the mask is on the same row or column
+      double squared = std::min({(x + 1) * sx, (width - x) * sx, (y + 1) * sy, (height - y) * sy});
+      squared *= squared;
+      for (const auto& feature : features)
+      {
+        const double dx = (x - feature.first) * sx;
+        const double dy = (y - feature.second) * sy;
+        squared         = std::min(squared, dx * dx + dy * dy);
+      }
+      distances[y * width + x] = std::sqrt(squared);
+    }
+  }
+  return distances;
+}
+
+/** Compare the output of the filter over its buffered region with the
+ * reference distances */
+bool CheckDistances(const DistanceImageType* output, const MaskImageType::RegionType& largest, const std::vector<double>& reference, const char* what)
+{
+  itk::ImageRegionConstIteratorWithIndex<DistanceImageType> it(output, output->GetBufferedRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const long   x        = it.GetIndex()[0] - largest.GetIndex(0);
+    const long   y        = it.GetIndex()[1] - largest.GetIndex(1);
+    const double expected = reference[y * largest.GetSize(0) + x];
+    if (std::abs(it.Get() - expected) > 1e-9 * std::max(1.0, expected))
+    {
+      std::cerr << what << ": distance at " << it.GetIndex() << " is " << it.Get() << " instead of " << expected << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anonymous namespace
+
+/** Check the exact distance map against an exhaustive search, with an
+ * anisotropic spacing, over the whole image and streamed regions */
+int otbStreamingEuclideanDistanceMapImageFilterTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  MaskImageType::RegionType region;
+  region.SetIndex(0, 5);
+  region.SetIndex(1, -3);
+  region.SetSize(0, 97);
+  region.SetSize(1, 61);
+
+  MaskImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = -2.0;
+
+  MaskImageType::Pointer mask = MaskImageType::New();
+  mask->SetRegions(region);
+  mask->SetSignedSpacing(spacing);
+  mask->Allocate();
+  mask->FillBuffer(0);
+
+  // Scattered pixels, a few vertical runs and a disk, far from the borders
+  itk::ImageRegionIteratorWithIndex<MaskImageType> it(mask, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const long x = it.GetIndex()[0] - region.GetIndex(0);
+    const long y = it.GetIndex()[1] - region.GetIndex(1);
+    const long dx = x - 60;
+    const long dy = y - 35;
+    if ((x * 7 + y * 13) % 211 == 0 || (x == 30 && y > 20 && y < 45) || dx * dx + 16 * dy * dy < 64)
+    {
+      it.Set(1);
+    }
+  }
+
+  for (bool useSpacing : {true, false})
+  {
+    const std::vector<double> reference = BruteForceDistances(mask, useSpacing);
+
+    // Whole image at once
+    DistanceMapFilterType::Pointer whole = DistanceMapFilterType::New();
+    whole->SetInput(mask);
+    whole->SetUseImageSpacing(useSpacing);
+    whole->Update();
+
+    if (!CheckDistances(whole->GetOutput(), region, reference, "Whole image"))
+    {
+      return EXIT_FAILURE;
+    }
+
+    // Mask encoded by strips, distances computed by tiles
+    DistanceMapFilterType::Pointer streamed = DistanceMapFilterType::New();
+    streamed->SetInput(mask);
+    streamed->SetUseImageSpacing(useSpacing);
+    streamed->GetColumnRunsFilter()->GetStreamer()->SetNumberOfLinesStrippedStreaming(7);
+    streamed->UpdateOutputInformation();
+
+    for (long ty = 0; ty < 61; ty += 16)
+    {
+      for (long tx = 0; tx < 97; tx += 24)
+      {
+        MaskImageType::RegionType tile;
+        tile.SetIndex(0, region.GetIndex(0) + tx);
+        tile.SetIndex(1, region.GetIndex(1) + ty);
+        tile.SetSize(0, 24);
+        tile.SetSize(1, 16);
+        tile.Crop(region);
+
+        streamed->GetOutput()->SetRequestedRegion(tile);
+        streamed->Update();
+
+        if (!CheckDistances(streamed->GetOutput(), region, reference, "Streamed tile"))
+        {
+          return EXIT_FAILURE;
+        }
+
+        // Tiles hold the same values as the whole image
+        itk::ImageRegionConstIteratorWithIndex<DistanceImageType> itTile(streamed->GetOutput(), tile);
+        for (itTile.GoToBegin(); !itTile.IsAtEnd(); ++itTile)
+        {
+          if (itTile.Get() != whole->GetOutput()->GetPixel(itTile.GetIndex()))
+          {
+            std::cerr << "Streamed distance at " << itTile.GetIndex() << " is " << itTile.Get() << " instead of "
+                      << whole->GetOutput()->GetPixel(itTile.GetIndex()) << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -46,6 +46,11 @@ namespace otb
  *  image parameters Size/Origin/Spacing so the hole image can be
  *  reprojected without setting any output parameter.
  *
+ *  The displacement grid can be cached across streaming tiles
+ *  (DisplacementFieldCachingOn()), retrieved with GetDisplacementField()
+ *  and reused by another resampler of the same scene through
+ *  SetDisplacementField().
+ *
  * \ingroup Projection
  *
  *
@@ -85,6 +90,8 @@ public:
   typedef typename ResamplerType::RegionType       RegionType;
   typedef typename ResamplerType::InterpolatorType InterpolatorType;
 
+  typedef typename ResamplerType::DisplacementFieldType DisplacementFieldType;
+
   /** Estimate the rpc model */
   typedef PhysicalToRPCSensorModelImageFilter<InputImageType> InputRpcModelEstimatorType;
   typedef typename InputRpcModelEstimatorType::Pointer        InputRpcModelEstimatorPointerType;
@@ -106,6 +113,22 @@ public:
 
   otbGetObjectMemberConstReferenceMacro(Resampler, DisplacementFieldSpacing, SpacingType);
 
+  /** Cache the displacement field across streaming tiles */
+  otbSetObjectMemberMacro(Resampler, DisplacementFieldCaching, bool);
+  otbGetObjectMemberConstMacro(Resampler, DisplacementFieldCaching, bool);
+  itkBooleanMacro(DisplacementFieldCaching);
+
+  /** Use a precomputed displacement field (null to compute it again) */
+  void SetDisplacementField(const DisplacementFieldType* field)
+  {
+    m_Resampler->SetDisplacementField(field);
+    this->Modified();
+  }
+
+  /** Get the displacement field used to warp the input. Its parameters
+   * are set once the output information has been updated. */
+  otbGetObjectMemberMacro(Resampler, DisplacementField, DisplacementFieldType*);
+
   /** The resampled image parameters */
   /** Output Origin */
   void SetOutputOrigin(const OriginType& origin)
@@ -101,8 +101,8 @@ void GenericRSResampleImageFilter<TInputImage, TOutputImage>::GenerateOutputInfo
 
   // Encapsulate output projRef and metadata
   if (this->GetOutputImageMetadata() != nullptr)
-    this->GetOutput()->m_Imd.Merge(*(this->GetOutputImageMetadata()));
-  this->GetOutput()->m_Imd.Add(MDGeom::ProjectionWKT, this->GetOutputProjectionRef());
+    this->GetOutput()->GetImageMetadata().Merge(*(this->GetOutputImageMetadata()));
+  this->GetOutput()->GetImageMetadata().Add(MDGeom::ProjectionWKT, this->GetOutputProjectionRef());
 }
 
 /**
@@ -121,7 +121,7 @@ void GenericRSResampleImageFilter<TInputImage, TOutputImage>::EstimateOutputRpcM
   tempPtr->SetRegions(region);
 
   // Encapsulate the output metadata in the temp image
-  tempPtr->m_Imd.Add(MDGeom::ProjectionWKT, this->GetOutputProjectionRef());
+  tempPtr->GetImageMetadata().Add(MDGeom::ProjectionWKT, this->GetOutputProjectionRef());
   tempPtr->SetImageMetadata(*(this->GetOutputImageMetadata()));
 
   // Estimate the rpc model from the temp image
@@ -129,7 +129,8 @@ void GenericRSResampleImageFilter<TInputImage, TOutputImage>::EstimateOutputRpcM
   m_OutputRpcEstimator->UpdateOutputInformation();
 
   // Fill the transform with the right metadata
-  m_Transform->SetInputImageMetadata(&(m_OutputRpcEstimator->GetOutput()->GetImageMetadata()));
+  const OutputImageType* outputRpcImage = m_OutputRpcEstimator->GetOutput();
+  m_Transform->SetInputImageMetadata(&(outputRpcImage->GetImageMetadata()));
 }
 
 /**
@@ -178,7 +179,8 @@ void GenericRSResampleImageFilter<TInputImage, TOutputImage>::EstimateInputRpcMo
   m_InputRpcEstimator->UpdateOutputInformation();
 
   // setup the transform with the estimated RPC model
-  m_Transform->SetOutputImageMetadata(&(m_InputRpcEstimator->GetOutput()->GetImageMetadata()));
+  const InputImageType* inputRpcImage = m_InputRpcEstimator->GetOutput();
+  m_Transform->SetOutputImageMetadata(&(inputRpcImage->GetImageMetadata()));
 
   // Update the flag for input rpcEstimation in order to not compute
   // the rpc model for each stream
@@ -332,6 +334,7 @@ void GenericRSResampleImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ost
   os << indent << "OutputSpacing: " << m_Resampler->GetOutputSpacing() << std::endl;
   os << indent << "OutputStartIndex: " << m_Resampler->GetOutputStartIndex() << std::endl;
   os << indent << "OutputSize: " << m_Resampler->GetOutputSize() << std::endl;
+  os << indent << "DisplacementFieldCaching: " << (m_Resampler->GetDisplacementFieldCaching() ? "On" : "Off") << std::endl;
   os << indent << "GenericRSTransform: " << std::endl;
   m_Transform->Print(os, indent.GetNextIndent());
 }
@@ -64,7 +64,7 @@ void PhysicalToRPCSensorModelImageFilter<TImage>::GenerateOutputInformation()
     // Build the grid
     // Generate GCPs from physical sensor model
     RSTransformPointerType rsTransform = RSTransformType::New();
-    rsTransform->SetInputImageMetadata(&(input->GetImageMetadata()));
+    rsTransform->SetInputImageMetadata(&(this->GetInput()->GetImageMetadata()));
     rsTransform->InstantiateTransform();
 
     // Compute the size of the grid
@@ -91,7 +91,8 @@ void PhysicalToRPCSensorModelImageFilter<TImage>::GenerateOutputInformation()
                             << ", Mean error: " << m_GCPsToSensorModelFilter->GetMeanError());
 
 
-    this->GetOutput()->SetImageMetadata(m_GCPsToSensorModelFilter->GetOutput()->GetImageMetadata());
+    const ImageType* rpcImage = m_GCPsToSensorModelFilter->GetOutput();
+    this->GetOutput()->SetImageMetadata(rpcImage->GetImageMetadata());
 
     // put the flag to true
     m_OutputInformationGenerated = true;
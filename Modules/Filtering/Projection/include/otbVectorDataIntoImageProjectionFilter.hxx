@@ -158,7 +158,7 @@ void VectorDataIntoImageProjectionFilter<TInputVectorData, TInputImage>::Generat
 
   if (m_InputImage->GetProjectionRef().empty() || boost::algorithm::istarts_with(m_InputImage->GetProjectionRef(), "LOCAL_CS"))
   {
-    rsRegion.SetImageMetadata(m_InputImage->GetImageMetadata());
+    rsRegion.SetImageMetadata(static_cast<const ImageType*>(m_InputImage.GetPointer())->GetImageMetadata());
   }
   else
   {
@@ -176,7 +176,7 @@ void VectorDataIntoImageProjectionFilter<TInputVectorData, TInputImage>::Generat
 
   if (m_InputImage->GetProjectionRef().empty() || boost::algorithm::istarts_with(m_InputImage->GetProjectionRef(), "LOCAL_CS"))
   {
-    m_VdProjFilter->SetOutputImageMetadata(&m_InputImage->GetImageMetadata());
+    m_VdProjFilter->SetOutputImageMetadata(&static_cast<const ImageType*>(m_InputImage.GetPointer())->GetImageMetadata());
   }
   else
   {
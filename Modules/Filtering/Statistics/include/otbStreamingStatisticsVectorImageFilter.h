@@ -42,6 +42,12 @@ namespace otb
  *
  * To get the statistics once the regions have been processed via the pipeline, use the Synthetize() method.
  *
+ * Each thread accumulates in local variables, written back once per requested region, so that
+ * threads do not share cache lines while processing pixels. Second order statistics are accumulated
+ * by blocks of pixels: each block updates the upper triangle of the thread accumulator at once
+ * (rank-k update), which keeps each row of the accumulator in cache while it is updated. The
+ * accumulation order of each element is the one of a pixel by pixel update.
+ *
  * \sa PersistentImageFilter
  * \ingroup Streamed
  * \ingroup Multithreaded
@@ -235,6 +241,14 @@ private:
   PersistentStreamingStatisticsVectorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Number of pixels gathered before updating the second order
+   * accumulator */
+  static const unsigned int SecondOrderBlockSize = 64;
+
+  /** Add the outer products of a block of pixels, stored one after the
+   * other, to the upper triangle of the accumulator */
+  static void AccumulateSecondOrderBlock(MatrixType& accumulator, const PrecisionType* block, unsigned int nbPixels);
+
   bool m_EnableMinMax;
   bool m_EnableFirstOrderStats;
   bool m_EnableSecondOrderStats;
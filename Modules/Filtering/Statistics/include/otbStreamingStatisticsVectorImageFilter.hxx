@@ -23,6 +23,7 @@
 #include "otbStreamingStatisticsVectorImageFilter.h"
 
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkProgressReporter.h"
 #include "otbMacro.h"
@@ -408,6 +409,18 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Sy
     itkExceptionMacro("nbPixels < ignoredInfinitePixelCount + ignoredUserPixelCount");
   }
 
+  // Threads only accumulate the upper triangle of the second order matrix
+  if (m_EnableSecondOrderStats)
+  {
+    for (unsigned int r = 1; r < numberOfComponent; ++r)
+    {
+      for (unsigned int c = 0; c < r; ++c)
+      {
+        streamSecondOrderAccumulator(r, c) = streamSecondOrderAccumulator(c, r);
+      }
+    }
+  }
+
   unsigned int nbRelevantPixel = nbPixels - (ignoredInfinitePixelCount + ignoredUserPixelCount);
 
   CountType nbRelevantPixels(numberOfComponent);
@@ -479,12 +492,25 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Th
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
   // Grab the input
-  InputImagePointer inputPtr  = const_cast<TInputImage*>(this->GetInput());
-  PixelType&        threadMin = m_ThreadMin[threadId];
-  PixelType&        threadMax = m_ThreadMax[threadId];
+  InputImagePointer  inputPtr          = const_cast<TInputImage*>(this->GetInput());
+  const unsigned int numberOfComponent = inputPtr->GetNumberOfComponentsPerPixel();
 
+  // Scalar accumulators are local to the thread, and written back at the
+  // end, so that threads never write to the same cache line
+  RealType     threadFirstOrderComponent  = itk::NumericTraits<RealType>::ZeroValue();
+  RealType     threadSecondOrderComponent = itk::NumericTraits<RealType>::ZeroValue();
+  unsigned int ignoredInfinitePixelCount  = 0;
+  unsigned int ignoredUserPixelCount      = 0;
 
-  itk::ImageRegionConstIteratorWithIndex<TInputImage> it(inputPtr, outputRegionForThread);
+  // Relevant pixels are gathered by blocks for the second order accumulator
+  std::vector<PrecisionType> block;
+  unsigned int               nbPixelsInBlock = 0;
+  if (m_EnableSecondOrderStats)
+  {
+    block.resize(SecondOrderBlockSize * numberOfComponent);
+  }
+
+  itk::ImageRegionConstIterator<TInputImage> it(inputPtr, outputRegionForThread);
 
   for (it.GoToBegin(); !it.IsAtEnd(); ++it, progress.CompletedPixel())
   {
@@ -500,18 +526,21 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Th
 
     if (m_IgnoreInfiniteValues && !(vnl_math_isfinite(finiteProbe)))
     {
-      m_IgnoredInfinitePixelCount[threadId]++;
+      ignoredInfinitePixelCount++;
     }
     else
     {
       if (userProbe)
       {
-        m_IgnoredUserPixelCount[threadId]++;
+        ignoredUserPixelCount++;
       }
       else
       {
         if (m_EnableMinMax)
         {
+          PixelType& threadMin = m_ThreadMin[threadId];
+          PixelType& threadMax = m_ThreadMax[threadId];
+
           for (unsigned int j = 0; j < vectorValue.GetSize(); ++j)
           {
             if (vectorValue[j] < threadMin[j])
@@ -527,8 +556,7 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Th
 
         if (m_EnableFirstOrderStats)
         {
-          RealPixelType& threadFirstOrder          = m_ThreadFirstOrderAccumulators[threadId];
-          RealType&      threadFirstOrderComponent = m_ThreadFirstOrderComponentAccumulators[threadId];
+          RealPixelType& threadFirstOrder = m_ThreadFirstOrderAccumulators[threadId];
 
           threadFirstOrder += vectorValue;
 
@@ -540,21 +568,65 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Th
 
         if (m_EnableSecondOrderStats)
         {
-          MatrixType& threadSecondOrder          = m_ThreadSecondOrderAccumulators[threadId];
-          RealType&   threadSecondOrderComponent = m_ThreadSecondOrderComponentAccumulators[threadId];
+          PrecisionType* blockPixel = &block[nbPixelsInBlock * numberOfComponent];
+          for (unsigned int i = 0; i < numberOfComponent; ++i)
+          {
+            blockPixel[i] = static_cast<PrecisionType>(vectorValue[i]);
+          }
 
-          for (unsigned int r = 0; r < threadSecondOrder.Rows(); ++r)
+          if (++nbPixelsInBlock == SecondOrderBlockSize)
           {
-            for (unsigned int c = 0; c < threadSecondOrder.Cols(); ++c)
-            {
-              threadSecondOrder(r, c) += static_cast<PrecisionType>(vectorValue[r]) * static_cast<PrecisionType>(vectorValue[c]);
-            }
+            AccumulateSecondOrderBlock(m_ThreadSecondOrderAccumulators[threadId], block.data(), nbPixelsInBlock);
+            nbPixelsInBlock = 0;
           }
           threadSecondOrderComponent += vectorValue.GetSquaredNorm();
         }
       }
     }
   }
+
+  // Flush the last block and the local accumulators
+  if (m_EnableSecondOrderStats)
+  {
+    AccumulateSecondOrderBlock(m_ThreadSecondOrderAccumulators[threadId], block.data(), nbPixelsInBlock);
+    m_ThreadSecondOrderComponentAccumulators[threadId] += threadSecondOrderComponent;
+  }
+  if (m_EnableFirstOrderStats)
+  {
+    m_ThreadFirstOrderComponentAccumulators[threadId] += threadFirstOrderComponent;
+  }
+  if (m_IgnoreInfiniteValues)
+  {
+    m_IgnoredInfinitePixelCount[threadId] += ignoredInfinitePixelCount;
+  }
+  if (m_IgnoreUserDefinedValue)
+  {
+    m_IgnoredUserPixelCount[threadId] += ignoredUserPixelCount;
+  }
+}
+
+template <class TInputImage, class TPrecision>
+void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::AccumulateSecondOrderBlock(MatrixType&          accumulator,
+                                                                                                         const PrecisionType* block,
+                                                                                                         unsigned int         nbPixels)
+{
+  const unsigned int nbComponents = accumulator.Rows();
+
+  // Each row of the upper triangle is updated by the whole block while
+  // it is in cache. The inner loop is a contiguous axpy.
+  for (unsigned int r = 0; r < nbComponents; ++r)
+  {
+    PrecisionType* row = accumulator[r];
+    for (unsigned int p = 0; p < nbPixels; ++p)
+    {
+      const PrecisionType* pixel = block + p * nbComponents;
+      const PrecisionType  value = pixel[r];
+      for (unsigned int c = r; c < nbComponents; ++c)
+      {
+        row[c] += value * pixel[c];
+      }
+    }
+  }
 }
 
 template <class TImage, class TPrecision>
@@ -43,6 +43,7 @@ void RegisterTests()
   REGISTER_TEST(otbStreamingStatisticsImageFilter);
   REGISTER_TEST(otbListSampleToBalancedListSampleFilter);
   REGISTER_TEST(otbStreamingStatisticsVectorImageFilter);
+  REGISTER_TEST(otbStreamingStatisticsVectorImageFilterBlockedCovariance);
   REGISTER_TEST(otbStreamingMinMaxVectorImageFilter);
   REGISTER_TEST(otbListSampleGenerator);
   REGISTER_TEST(otbImaginaryImageToComplexImageFilterTest);
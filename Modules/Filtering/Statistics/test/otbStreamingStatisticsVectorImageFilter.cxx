@@ -75,3 +75,67 @@ int otbStreamingStatisticsVectorImageFilter(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbStreamingStatisticsVectorImageFilterBlockedCovariance(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::VectorImage<float, 2> ImageType;
+  typedef otb::StreamingStatisticsVectorImageFilter<ImageType> StreamingStatisticsVectorImageFilterType;
+  typedef StreamingStatisticsVectorImageFilterType::MatrixType MatrixType;
+
+  // Hyperspectral-like cube, with a number of pixels which is not a
+  // multiple of the accumulation block size
+  const unsigned int    nbBands = 200;
+  ImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, 37);
+  region.SetSize(1, 29);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(nbBands);
+  image->Allocate();
+
+  // Small integer values keep all the sums exact, whatever the order
+  const unsigned int nbPixels = region.GetNumberOfPixels();
+  float*             buffer   = image->GetBufferPointer();
+  for (unsigned int i = 0; i < nbPixels * nbBands; ++i)
+  {
+    buffer[i] = static_cast<float>((i * 7919) % 16);
+  }
+
+  StreamingStatisticsVectorImageFilterType::Pointer filter = StreamingStatisticsVectorImageFilterType::New();
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(10);
+  filter->SetInput(image);
+  filter->Update();
+
+  MatrixType expected(nbBands, nbBands);
+  expected.Fill(0.);
+  for (unsigned int p = 0; p < nbPixels; ++p)
+  {
+    const float* pixel = buffer + p * nbBands;
+    for (unsigned int r = 0; r < nbBands; ++r)
+    {
+      for (unsigned int c = 0; c < nbBands; ++c)
+      {
+        expected(r, c) += static_cast<double>(pixel[r]) * static_cast<double>(pixel[c]);
+      }
+    }
+  }
+  expected /= nbPixels;
+
+  const MatrixType& correlation = filter->GetCorrelation();
+  for (unsigned int r = 0; r < nbBands; ++r)
+  {
+    for (unsigned int c = 0; c < nbBands; ++c)
+    {
+      if (correlation(r, c) != expected(r, c))
+      {
+        std::cerr << "Correlation(" << r << ", " << c << ") is " << correlation(r, c) << " instead of " << expected(r, c) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
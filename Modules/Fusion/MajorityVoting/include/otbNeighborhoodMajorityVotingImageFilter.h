@@ -29,6 +29,8 @@
 #include "itkMorphologyImageFilter.h"
 #include "itkBinaryBallStructuringElement.h"
 
+#include <vector>
+
 namespace otb
 {
 
@@ -57,6 +59,21 @@ namespace otb
  *     the image neighbors where the kernel has elements > 0.
  *   - Replace the original label value with the more representative label value
  *
+ * For integer labels spanning a small range of values, the filter uses
+ * by default a sliding histogram instead: each thread keeps a dense
+ * histogram of the labels of the current neighborhood, which is
+ * updated along each line of the output region by adding the pixels
+ * entering the kernel and removing the pixels leaving it. For a
+ * rectangular or disk shaped kernel, this costs two pixels per kernel
+ * row instead of a whole kernel per output pixel. The most frequent
+ * label and its uniqueness are tracked incrementally, so that results
+ * are identical to the per pixel evaluation, which can still be
+ * selected with SlidingHistogramOff(). The sliding histogram assumes
+ * that pixels outside the image are no data pixels, which is the
+ * default boundary condition of this filter: when another boundary
+ * condition is set with OverrideBoundaryCondition(), the per pixel
+ * evaluation is used.
+ *
  * \sa MorphologyImageFilter, GrayscaleFunctionDilateImageFilter, BinaryDilateImageFilter
  * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
  *
@@ -92,6 +109,9 @@ public:
   /** Kernel typedef. */
   typedef typename Superclass::KernelType KernelType;
 
+  /** Region typedef. */
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
 
   /** Default boundary condition type */
   typedef typename Superclass::DefaultBoundaryConditionType DefaultBoundaryConditionType;
@@ -141,6 +161,11 @@ public:
   itkSetMacro(OnlyIsolatedPixels, bool);
   itkSetMacro(IsolatedThreshold, unsigned int);
 
+  // Use a sliding histogram when the range of the labels allows it
+  itkSetMacro(SlidingHistogram, bool);
+  itkGetConstMacro(SlidingHistogram, bool);
+  itkBooleanMacro(SlidingHistogram);
+
 
 protected:
   NeighborhoodMajorityVotingImageFilter();
@@ -156,6 +181,8 @@ protected:
 
   void GenerateOutputInformation() override;
 
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
 
   // Type to store the useful information from the label histogram
   struct HistoSummary
@@ -180,6 +207,41 @@ protected:
   const HistoSummary ComputeNeighborhoodHistogramSummary(const NeighborhoodIteratorType& nit, const KernelIteratorType kernelBegin,
                                                          const KernelIteratorType kernelEnd) const;
 
+  // Choose the output label of a pixel from the summary of the
+  // histogram of its neighborhood
+  PixelType DecideLabel(const PixelType& centerPixel, const HistoSummary& histoSummary) const;
+
+  // Dense histogram of the labels of a neighborhood, tracking
+  // incrementally the most frequent label
+  class DenseLabelHistogram
+  {
+  public:
+    DenseLabelHistogram(const PixelType& minLabel, std::size_t nbLabels, unsigned int maxCount);
+
+    void Add(const PixelType& label);
+    void Remove(const PixelType& label);
+
+    // Summary of the histogram, as computed by ComputeNeighborhoodHistogramSummary
+    HistoSummary GetSummary(const PixelType& centerPixel);
+
+  private:
+    PixelType m_MinLabel;
+    // Count of each label
+    std::vector<unsigned int> m_Counts;
+    // Number of labels having each count
+    std::vector<unsigned int> m_CountFrequencies;
+    unsigned int              m_MaxCount;
+    // Number of labels with a positive count
+    unsigned int m_NumberOfLabels;
+    // The majority label, when known to be the only one with m_MaxCount
+    PixelType m_MajorityLabel;
+    bool      m_MajorityKnown;
+  };
+
+  // Process the region with a sliding histogram. Return false if the
+  // labels of the region do not fit in a dense histogram.
+  bool SlidingHistogramThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId);
+
 private:
   NeighborhoodMajorityVotingImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -197,6 +259,8 @@ private:
   // this threshold with the same label
   unsigned int m_IsolatedThreshold;
 
+  bool m_SlidingHistogram;
+
 }; // end of class
 
 } // end namespace otb
@@ -30,6 +30,12 @@
 #include "itkMetaDataObject.h"
 #include "otbMetaDataKey.h"
 #include "otbNoDataHelper.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace otb
 {
@@ -38,6 +44,7 @@ namespace otb
  */
 template <class TInputImage, class TOutputImage, class TKernel>
 NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::NeighborhoodMajorityVotingImageFilter()
+  : m_LabelForNoDataPixels(itk::NumericTraits<PixelType>::max()), m_SlidingHistogram(true)
 {
   this->SetLabelForNoDataPixels(itk::NumericTraits<PixelType>::NonpositiveMin());    // m_LabelForNoDataPixels = 0
   this->SetLabelForUndecidedPixels(itk::NumericTraits<PixelType>::NonpositiveMin()); // m_LabelForUndecidedPixels = 0
@@ -61,31 +68,38 @@ NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::Evalu
   {
     // Get a histogram of label frequencies where the 2 highest are at the beginning and sorted
     const HistoSummary histoSummary = this->ComputeNeighborhoodHistogramSummary(nit, kernelBegin, kernelEnd);
-    if (m_OnlyIsolatedPixels && histoSummary.freqCenterLabel > m_IsolatedThreshold)
-    {
-      // If we want to filter only isolated pixels, keep the label if
-      // there are enough pixels with the center label to consider that
-      // it is not isolated
-      return centerPixel;
-    }
-    else
+    return this->DecideLabel(centerPixel, histoSummary);
+  } // END if (centerPixel != m_LabelForNoDataPixels)
+}
+
+template <class TInputImage, class TOutputImage, class TKernel>
+typename NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::PixelType
+NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::DecideLabel(const PixelType& centerPixel, const HistoSummary& histoSummary) const
+{
+  if (m_OnlyIsolatedPixels && histoSummary.freqCenterLabel > m_IsolatedThreshold)
+  {
+    // If we want to filter only isolated pixels, keep the label if
+    // there are enough pixels with the center label to consider that
+    // it is not isolated
+    return centerPixel;
+  }
+  else
+  {
+    // If the majorityLabel is NOT unique in the neighborhood
+    if (!histoSummary.majorityUnique)
     {
-      // If the majorityLabel is NOT unique in the neighborhood
-      if (!histoSummary.majorityUnique)
+      if (m_KeepOriginalLabelBool == true)
       {
-        if (m_KeepOriginalLabelBool == true)
-        {
-          return centerPixel;
-        }
-        else
-        {
-          return m_LabelForUndecidedPixels;
-        }
+        return centerPixel;
+      }
+      else
+      {
+        return m_LabelForUndecidedPixels;
       }
-      // Extraction of the more representative Label in the neighborhood (majorityLabel)
-      return histoSummary.majorityLabel;
     }
-  } // END if (centerPixel != m_LabelForNoDataPixels)
+    // Extraction of the more representative Label in the neighborhood (majorityLabel)
+    return histoSummary.majorityLabel;
+  }
 }
 
 template <class TInputImage, class TOutputImage, class TKernel>
@@ -130,6 +144,285 @@ NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::Compu
   return result;
 }
 
+template <class TInputImage, class TOutputImage, class TKernel>
+NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::DenseLabelHistogram::DenseLabelHistogram(
+    const PixelType& minLabel, std::size_t nbLabels, unsigned int maxCount)
+  : m_MinLabel(minLabel),
+    m_Counts(nbLabels, 0),
+    m_CountFrequencies(maxCount + 1, 0),
+    m_MaxCount(0),
+    m_NumberOfLabels(0),
+    m_MajorityLabel(minLabel),
+    m_MajorityKnown(false)
+{
+}
+
+template <class TInputImage, class TOutputImage, class TKernel>
+void NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::DenseLabelHistogram::Add(const PixelType& label)
+{
+  unsigned int& count = m_Counts[label - m_MinLabel];
+  if (count == 0)
+  {
+    ++m_NumberOfLabels;
+  }
+  else
+  {
+    --m_CountFrequencies[count];
+  }
+  ++count;
+  ++m_CountFrequencies[count];
+
+  if (count > m_MaxCount)
+  {
+    // The label is the only one with the new maximum count
+    m_MaxCount      = count;
+    m_MajorityLabel = label;
+    m_MajorityKnown = true;
+  }
+  else if (count == m_MaxCount)
+  {
+    // The label ties with the majority label
+    m_MajorityKnown = false;
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TKernel>
+void NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::DenseLabelHistogram::Remove(const PixelType& label)
+{
+  unsigned int& count = m_Counts[label - m_MinLabel];
+  --m_CountFrequencies[count];
+
+  if (count == m_MaxCount)
+  {
+    if (m_CountFrequencies[count] == 0)
+    {
+      // The label was the only one with the maximum count, and it is
+      // still the only candidate for the new maximum count
+      --m_MaxCount;
+      m_MajorityLabel = label;
+      m_MajorityKnown = true;
+    }
+    else
+    {
+      // The majority label is among the other labels with the maximum count
+      m_MajorityKnown = false;
+    }
+  }
+
+  --count;
+  if (count == 0)
+  {
+    --m_NumberOfLabels;
+  }
+  else
+  {
+    ++m_CountFrequencies[count];
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TKernel>
+typename NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::HistoSummary
+NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::DenseLabelHistogram::GetSummary(const PixelType& centerPixel)
+{
+  HistoSummary result;
+  result.majorityUnique = m_MaxCount > 0 && m_CountFrequencies[m_MaxCount] == 1;
+  result.majorityLabel  = centerPixel;
+
+  if (result.majorityUnique)
+  {
+    if (!m_MajorityKnown)
+    {
+      // Rare case: a tie has just been broken by a removal
+      for (std::size_t i = 0; i < m_Counts.size(); ++i)
+      {
+        if (m_Counts[i] == m_MaxCount)
+        {
+          m_MajorityLabel = static_cast<PixelType>(m_MinLabel + i);
+          break;
+        }
+      }
+      m_MajorityKnown = true;
+    }
+    result.majorityLabel = m_MajorityLabel;
+  }
+
+  if (m_NumberOfLabels == 1)
+  {
+    result.freqCenterLabel = m_MaxCount;
+  }
+  else
+  {
+    result.freqCenterLabel = m_Counts[centerPixel - m_MinLabel];
+  }
+  return result;
+}
+
+template <class TInputImage, class TOutputImage, class TKernel>
+void NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                      itk::ThreadIdType            threadId)
+{
+  // The sliding histogram ignores the pixels outside of the image, which
+  // only matches the boundary condition of this filter
+  if (!m_SlidingHistogram || !std::numeric_limits<PixelType>::is_integer || this->GetBoundaryCondition() != &m_MajorityVotingBoundaryCondition ||
+      !this->SlidingHistogramThreadedGenerateData(outputRegionForThread, threadId))
+  {
+    Superclass::ThreadedGenerateData(outputRegionForThread, threadId);
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TKernel>
+bool NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::SlidingHistogramThreadedGenerateData(
+    const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  typedef typename TInputImage::IndexType  IndexType;
+  typedef typename TInputImage::RegionType RegionType;
+  typedef typename KernelType::OffsetType  OffsetType;
+
+  // Largest number of labels of a dense histogram
+  const double maximumHistogramSize = 1 << 16;
+
+  const TInputImage* input          = this->GetInput();
+  TOutputImage*      output         = this->GetOutput();
+  const KernelType&  kernel         = this->GetKernel();
+  const RegionType   bufferedRegion = input->GetBufferedRegion();
+  const PixelType*   inputBuffer    = input->GetBufferPointer();
+
+  // Range of the labels seen by this thread
+  RegionType inputRegion = outputRegionForThread;
+  inputRegion.PadByRadius(kernel.GetRadius());
+  inputRegion.Crop(bufferedRegion);
+
+  PixelType minLabel = itk::NumericTraits<PixelType>::max();
+  PixelType maxLabel = itk::NumericTraits<PixelType>::NonpositiveMin();
+  bool      hasLabel = false;
+  for (itk::ImageRegionConstIterator<TInputImage> it(input, inputRegion); !it.IsAtEnd(); ++it)
+  {
+    const PixelType label = it.Get();
+    if (label != m_LabelForNoDataPixels)
+    {
+      minLabel = std::min(minLabel, label);
+      maxLabel = std::max(maxLabel, label);
+      hasLabel = true;
+    }
+  }
+  if (!hasLabel || static_cast<double>(maxLabel) - static_cast<double>(minLabel) >= maximumHistogramSize)
+  {
+    return false;
+  }
+
+  // Offsets of the kernel, and of the pixels entering and leaving the
+  // kernel when its center moves by one pixel along the first dimension
+  auto isInKernel = [&kernel](OffsetType offset) {
+    for (unsigned int d = 0; d < KernelDimension; ++d)
+    {
+      if (offset[d] < -static_cast<typename OffsetType::OffsetValueType>(kernel.GetRadius(d)) ||
+          offset[d] > static_cast<typename OffsetType::OffsetValueType>(kernel.GetRadius(d)))
+      {
+        return false;
+      }
+    }
+    return kernel[kernel.GetNeighborhoodIndex(offset)] > itk::NumericTraits<KernelPixelType>::Zero;
+  };
+
+  std::vector<OffsetType> kernelOffsets;
+  std::vector<OffsetType> enteringOffsets;
+  std::vector<OffsetType> leavingOffsets;
+  for (unsigned int i = 0; i < kernel.Size(); ++i)
+  {
+    if (kernel[i] > itk::NumericTraits<KernelPixelType>::Zero)
+    {
+      const OffsetType offset = kernel.GetOffset(i);
+      kernelOffsets.push_back(offset);
+
+      OffsetType next = offset;
+      next[0] += 1;
+      if (!isInKernel(next))
+      {
+        enteringOffsets.push_back(offset);
+      }
+      OffsetType previous = offset;
+      previous[0] -= 1;
+      if (!isInKernel(previous))
+      {
+        leavingOffsets.push_back(offset);
+      }
+    }
+  }
+
+  DenseLabelHistogram histogram(minLabel, static_cast<std::size_t>(maxLabel - minLabel) + 1, kernelOffsets.size());
+
+  // Pixels outside of the image and no data pixels are not counted
+  auto addPixels = [&](const IndexType& center, const std::vector<OffsetType>& offsets) {
+    for (const auto& offset : offsets)
+    {
+      const IndexType index = center + offset;
+      if (bufferedRegion.IsInside(index))
+      {
+        const PixelType label = inputBuffer[input->ComputeOffset(index)];
+        if (label != m_LabelForNoDataPixels)
+        {
+          histogram.Add(label);
+        }
+      }
+    }
+  };
+  auto removePixels = [&](const IndexType& center, const std::vector<OffsetType>& offsets) {
+    for (const auto& offset : offsets)
+    {
+      const IndexType index = center + offset;
+      if (bufferedRegion.IsInside(index))
+      {
+        const PixelType label = inputBuffer[input->ComputeOffset(index)];
+        if (label != m_LabelForNoDataPixels)
+        {
+          histogram.Remove(label);
+        }
+      }
+    }
+  };
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  itk::ImageScanlineIterator<TOutputImage> outIt(output, outputRegionForThread);
+  outIt.GoToBegin();
+  while (!outIt.IsAtEnd())
+  {
+    IndexType center = outIt.GetIndex();
+    addPixels(center, kernelOffsets);
+
+    while (true)
+    {
+      const PixelType centerPixel = inputBuffer[input->ComputeOffset(center)];
+      if (centerPixel == m_LabelForNoDataPixels)
+      {
+        outIt.Set(static_cast<typename TOutputImage::PixelType>(m_LabelForNoDataPixels));
+      }
+      else
+      {
+        outIt.Set(static_cast<typename TOutputImage::PixelType>(this->DecideLabel(centerPixel, histogram.GetSummary(centerPixel))));
+      }
+      progress.CompletedPixel();
+
+      ++outIt;
+      if (outIt.IsAtEndOfLine())
+      {
+        break;
+      }
+
+      // Slide the kernel to the next pixel of the line
+      removePixels(center, leavingOffsets);
+      ++center[0];
+      addPixels(center, enteringOffsets);
+    }
+
+    // Empty the histogram for the next line
+    removePixels(center, kernelOffsets);
+    outIt.NextLine();
+  }
+
+  return true;
+}
+
 template <class TInputImage, class TOutputImage, class TKernel>
 void NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::GenerateOutputInformation()
 {
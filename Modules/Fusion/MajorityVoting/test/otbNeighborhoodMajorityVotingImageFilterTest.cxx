@@ -27,6 +27,10 @@
 #include "otbImageFileWriter.h"
 
 #include "otbNeighborhoodMajorityVotingImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkZeroFluxNeumannBoundaryCondition.h"
+
+#include <random>
 
 
 int otbNeighborhoodMajorityVotingImageFilterTest(int argc, char* argv[])
@@ -206,3 +210,97 @@ int otbNeighborhoodMajorityVotingImageFilterIsolatedTest(int itkNotUsed(argc), c
   }
   return EXIT_SUCCESS;
 }
+
+int otbNeighborhoodMajorityVotingImageFilterSlidingHistogramTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef unsigned short PixelType;
+  const unsigned int     Dimension = 2;
+
+  typedef otb::Image<PixelType, Dimension>                      ImageType;
+  typedef otb::NeighborhoodMajorityVotingImageFilter<ImageType> NeighborhoodMajorityVotingFilterType;
+  typedef NeighborhoodMajorityVotingFilterType::KernelType      StructuringType;
+  typedef StructuringType::RadiusType                           RadiusType;
+
+  // Random labels with few classes, so that ties are frequent, and some
+  // no data pixels
+  ImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, 61);
+  region.SetSize(1, 47);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  std::mt19937                       generator(42);
+  std::uniform_int_distribution<int> distribution(0, 5);
+  for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(1000 + distribution(generator));
+  }
+
+  // Boundary condition that does not treat the pixels outside of the
+  // image as no data, for which the sliding histogram must not be used
+  itk::ZeroFluxNeumannBoundaryCondition<ImageType> zeroFluxBoundaryCondition;
+
+  const unsigned int radii[][2] = {{1, 1}, {2, 5}, {5, 5}, {7, 0}};
+  for (const auto& radius : radii)
+  {
+    for (unsigned int config = 0; config < 5; ++config)
+    {
+      StructuringType seBall;
+      RadiusType      rad;
+      rad[0] = radius[0];
+      rad[1] = radius[1];
+      seBall.SetRadius(rad);
+      seBall.CreateStructuringElement();
+      if (config == 3)
+      {
+        // Remove some elements out of the center, to get a kernel that
+        // is not convex
+        for (unsigned int i = 0; i < seBall.Size(); i += 3)
+        {
+          if (i != seBall.Size() / 2)
+          {
+            seBall[i] = 0;
+          }
+        }
+      }
+
+      ImageType::Pointer outputs[2];
+      for (unsigned int sliding = 0; sliding < 2; ++sliding)
+      {
+        NeighborhoodMajorityVotingFilterType::Pointer filter = NeighborhoodMajorityVotingFilterType::New();
+        filter->SetInput(image);
+        filter->SetKernel(seBall);
+        filter->SetLabelForNoDataPixels(1000);
+        filter->SetLabelForUndecidedPixels(7);
+        filter->SetKeepOriginalLabelBool(config == 0);
+        filter->SetOnlyIsolatedPixels(config == 2);
+        filter->SetIsolatedThreshold(3);
+        filter->SetSlidingHistogram(sliding == 1);
+        if (config == 4)
+        {
+          filter->OverrideBoundaryCondition(&zeroFluxBoundaryCondition);
+        }
+        filter->Update();
+        outputs[sliding] = filter->GetOutput();
+      }
+
+      itk::ImageRegionConstIterator<ImageType> refIt(outputs[0], region);
+      itk::ImageRegionConstIterator<ImageType> slidingIt(outputs[1], region);
+      for (; !refIt.IsAtEnd(); ++refIt, ++slidingIt)
+      {
+        if (refIt.Get() != slidingIt.Get())
+        {
+          std::cerr << "Sliding histogram differs at " << refIt.GetIndex() << " with radius " << rad << " and configuration " << config << ": "
+                    << slidingIt.Get() << " instead of " << refIt.Get() << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -100,7 +100,7 @@ public:
 
     // Cache radiuses attributes for threading performances
     const int externalRadiusX = static_cast<int>(externalRadius[0]);
-    const int externalRadiusY = static_cast<int>(externalRadius[0]);
+    const int externalRadiusY = static_cast<int>(externalRadius[1]);
 
     for (int y = -externalRadiusY; y <= externalRadiusY; y++)
     {
@@ -146,6 +146,113 @@ public:
 };
 
 } // end namespace functor
+
+/** \class LocalRxDetectorFilter
+ * \brief Computes the local Rx score of each pixel of an hyperspectral image.
+ *
+ * The score of a pixel is the Mahalanobis distance between the pixel
+ * and the statistics of its dual neighborhood, made of the pixels
+ * inside the external radius and outside the internal radius. Pixels
+ * outside of the image are replaced by the nearest image pixel, as in
+ * LocalRxDetectionFunctor.
+ *
+ * Instead of gathering the dual neighborhood of each pixel, the first
+ * and second order moments of the neighborhood are obtained with
+ * sliding sums: each thread keeps the vertical sums of the moments of
+ * each column, updated when moving to the next row, and slides the
+ * window sums along the row. The mean and covariance of the
+ * neighborhood are then computed in O(bands^2) per pixel whatever the
+ * radius, and the Mahalanobis distance is obtained from the Cholesky
+ * factorization of the covariance instead of its inverse. Moments are
+ * computed relative to a pixel of the region, to limit rounding errors.
+ *
+ * The internal radius must be smaller than the external radius along
+ * each axis.
+ *
+ * \sa LocalRxDetectionFunctor
+ *
+ * \ingroup OTBAnomalyDetection
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT LocalRxDetectorFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef LocalRxDetectorFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(LocalRxDetectorFilter, ImageToImageFilter);
+
+  /** Some convenient typedefs. */
+  typedef TInputImage                                InputImageType;
+  typedef typename InputImageType::InternalPixelType InputInternalPixelType;
+  typedef typename InputImageType::RegionType        InputImageRegionType;
+  typedef typename InputImageType::IndexType         IndexType;
+  typedef typename InputImageType::SizeType          SizeType;
+  typedef TOutputImage                               OutputImageType;
+  typedef typename OutputImageType::PixelType        OutputPixelType;
+  typedef typename OutputImageType::RegionType       OutputImageRegionType;
+
+  /** Radius of the internal window, excluded from the neighborhood */
+  itkSetMacro(InternalRadius, SizeType);
+  itkGetConstReferenceMacro(InternalRadius, SizeType);
+
+  /** Radius of the external window */
+  itkSetMacro(ExternalRadius, SizeType);
+  itkGetConstReferenceMacro(ExternalRadius, SizeType);
+
+  void SetInternalRadius(unsigned int radiusX, unsigned int radiusY)
+  {
+    SizeType radius;
+    radius[0] = radiusX;
+    radius[1] = radiusY;
+    this->SetInternalRadius(radius);
+  }
+
+  void SetExternalRadius(unsigned int radiusX, unsigned int radiusY)
+  {
+    SizeType radius;
+    radius[0] = radiusX;
+    radius[1] = radiusY;
+    this->SetExternalRadius(radius);
+  }
+
+protected:
+  LocalRxDetectorFilter();
+  ~LocalRxDetectorFilter() override
+  {
+  }
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  void GenerateInputRequestedRegion() override;
+  void BeforeThreadedGenerateData() override;
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /** Compute the Rx score of a pixel from the moments of its
+   * neighborhood. The covariance buffer holds nbBands x nbBands values,
+   * and the work buffer 3 x nbBands values. */
+  static double ComputeRxScore(const double* centeredPixel, const double* sums, unsigned int count, unsigned int nbBands, double* covariance,
+                               double* work);
+
+private:
+  LocalRxDetectorFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  SizeType m_InternalRadius;
+  SizeType m_ExternalRadius;
+};
+
 } // end namespace otb
 
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbLocalRxDetectorFilter.hxx"
+#endif
+
 #endif
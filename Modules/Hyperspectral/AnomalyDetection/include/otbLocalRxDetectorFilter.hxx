@@ -0,0 +1,343 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLocalRxDetectorFilter_hxx
+#define otbLocalRxDetectorFilter_hxx
+
+#include "otbLocalRxDetectorFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
+#include "vnl/algo/vnl_svd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+LocalRxDetectorFilter<TInputImage, TOutputImage>::LocalRxDetectorFilter()
+{
+  m_InternalRadius.Fill(1);
+  m_ExternalRadius.Fill(5);
+}
+
+template <class TInputImage, class TOutputImage>
+void LocalRxDetectorFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  // pad the input requested region by the external radius, and crop it
+  // at the input's largest possible region: outer pixels are replaced
+  // by the nearest image pixels
+  InputImageRegionType inputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(m_ExternalRadius);
+  inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion());
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+}
+
+template <class TInputImage, class TOutputImage>
+void LocalRxDetectorFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  for (unsigned int d = 0; d < InputImageType::ImageDimension; ++d)
+  {
+    if (m_InternalRadius[d] >= m_ExternalRadius[d])
+    {
+      itkExceptionMacro(<< "The internal radius (" << m_InternalRadius << ") must be smaller than the external radius (" << m_ExternalRadius << ")");
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void LocalRxDetectorFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  // Maximum number of values stored in the column sums, per thread
+  const std::size_t maximumColumnSumsSize = 1 << 22;
+
+  const InputImageType*         input         = this->GetInput();
+  const InputImageRegionType&   largestRegion = input->GetLargestPossibleRegion();
+  const InputInternalPixelType* inputBuffer   = input->GetBufferPointer();
+  const unsigned int            nbBands       = input->GetNumberOfComponentsPerPixel();
+
+  // Moments of a pixel: nbBands values, then the products of the pairs of bands
+  const unsigned int nbMoments = nbBands + nbBands * (nbBands + 1) / 2;
+
+  const long         radiusX         = m_ExternalRadius[0];
+  const long         radiusY         = m_ExternalRadius[1];
+  const long         internalRadiusX = m_InternalRadius[0];
+  const long         internalRadiusY = m_InternalRadius[1];
+  const unsigned int count           = (2 * radiusX + 1) * (2 * radiusY + 1) - (2 * internalRadiusX + 1) * (2 * internalRadiusY + 1);
+
+  const long minX = largestRegion.GetIndex(0);
+  const long maxX = minX + static_cast<long>(largestRegion.GetSize(0)) - 1;
+  const long minY = largestRegion.GetIndex(1);
+  const long maxY = minY + static_cast<long>(largestRegion.GetSize(1)) - 1;
+
+  auto clampX = [minX, maxX](long x) { return std::min(std::max(x, minX), maxX); };
+  auto clampY = [minY, maxY](long y) { return std::min(std::max(y, minY), maxY); };
+
+  auto pixelAt = [input, inputBuffer, nbBands](long x, long y) {
+    IndexType index;
+    index[0] = x;
+    index[1] = y;
+    return inputBuffer + input->ComputeOffset(index) * nbBands;
+  };
+
+  // Moments are computed relative to the first pixel of the region
+  std::vector<double>           shift(nbBands);
+  const InputInternalPixelType* origin = pixelAt(outputRegionForThread.GetIndex(0), outputRegionForThread.GetIndex(1));
+  for (unsigned int b = 0; b < nbBands; ++b)
+  {
+    shift[b] = static_cast<double>(origin[b]);
+  }
+
+  std::vector<double> centered(nbBands);
+  auto accumulate = [&shift, &centered, nbBands](double* sums, const InputInternalPixelType* pixel, double sign) {
+    for (unsigned int b = 0; b < nbBands; ++b)
+    {
+      centered[b] = static_cast<double>(pixel[b]) - shift[b];
+      sums[b] += sign * centered[b];
+    }
+    double* pairSums = sums + nbBands;
+    for (unsigned int b = 0; b < nbBands; ++b)
+    {
+      const double value = sign * centered[b];
+      for (unsigned int c = b; c < nbBands; ++c)
+      {
+        *pairSums++ += value * centered[c];
+      }
+    }
+  };
+  auto add = [nbMoments](double* sums, const double* values, double sign) {
+    for (unsigned int i = 0; i < nbMoments; ++i)
+    {
+      sums[i] += sign * values[i];
+    }
+  };
+
+  std::vector<double> externalSums(nbMoments);
+  std::vector<double> internalSums(nbMoments);
+  std::vector<double> ringSums(nbMoments);
+  std::vector<double> centerPixel(nbBands);
+  std::vector<double> covariance(nbBands * nbBands);
+  std::vector<double> work(3 * nbBands);
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  // The region is processed by vertical strips, to bound the memory used by the column sums
+  const long regionStartX = outputRegionForThread.GetIndex(0);
+  const long regionEndX   = regionStartX + static_cast<long>(outputRegionForThread.GetSize(0));
+  const long regionStartY = outputRegionForThread.GetIndex(1);
+  const long regionEndY   = regionStartY + static_cast<long>(outputRegionForThread.GetSize(1));
+  const long stripWidth   = std::max<long>(1, static_cast<long>(maximumColumnSumsSize / (2 * nbMoments)) - 2 * radiusX);
+
+  for (long stripStartX = regionStartX; stripStartX < regionEndX; stripStartX += stripWidth)
+  {
+    const long stripEndX = std::min(stripStartX + stripWidth, regionEndX);
+
+    // Vertical sums of the moments of the columns of the strip, over the
+    // external and internal heights
+    const long          columnStartX = clampX(stripStartX - radiusX);
+    const long          nbColumns    = clampX(stripEndX - 1 + radiusX) - columnStartX + 1;
+    std::vector<double> externalColumns(nbColumns * nbMoments, 0.);
+    std::vector<double> internalColumns(nbColumns * nbMoments, 0.);
+    auto                externalColumn = [&](long x) { return externalColumns.data() + (clampX(x) - columnStartX) * nbMoments; };
+    auto                internalColumn = [&](long x) { return internalColumns.data() + (clampX(x) - columnStartX) * nbMoments; };
+
+    OutputImageRegionType stripRegion = outputRegionForThread;
+    stripRegion.SetIndex(0, stripStartX);
+    stripRegion.SetSize(0, stripEndX - stripStartX);
+    itk::ImageScanlineIterator<OutputImageType> outIt(this->GetOutput(), stripRegion);
+    outIt.GoToBegin();
+
+    for (long y = regionStartY; y < regionEndY; ++y)
+    {
+      for (long column = 0; column < nbColumns; ++column)
+      {
+        const long x = columnStartX + column;
+        if (y == regionStartY)
+        {
+          for (long dy = -radiusY; dy <= radiusY; ++dy)
+          {
+            accumulate(externalColumn(x), pixelAt(x, clampY(y + dy)), 1.);
+          }
+          for (long dy = -internalRadiusY; dy <= internalRadiusY; ++dy)
+          {
+            accumulate(internalColumn(x), pixelAt(x, clampY(y + dy)), 1.);
+          }
+        }
+        else
+        {
+          accumulate(externalColumn(x), pixelAt(x, clampY(y + radiusY)), 1.);
+          accumulate(externalColumn(x), pixelAt(x, clampY(y - 1 - radiusY)), -1.);
+          accumulate(internalColumn(x), pixelAt(x, clampY(y + internalRadiusY)), 1.);
+          accumulate(internalColumn(x), pixelAt(x, clampY(y - 1 - internalRadiusY)), -1.);
+        }
+      }
+
+      // Window sums at the beginning of the row
+      std::fill(externalSums.begin(), externalSums.end(), 0.);
+      std::fill(internalSums.begin(), internalSums.end(), 0.);
+      for (long dx = -radiusX; dx <= radiusX; ++dx)
+      {
+        add(externalSums.data(), externalColumn(stripStartX + dx), 1.);
+      }
+      for (long dx = -internalRadiusX; dx <= internalRadiusX; ++dx)
+      {
+        add(internalSums.data(), internalColumn(stripStartX + dx), 1.);
+      }
+
+      for (long x = stripStartX; x < stripEndX; ++x)
+      {
+        if (x > stripStartX)
+        {
+          // Slide the windows to the current pixel
+          add(externalSums.data(), externalColumn(x + radiusX), 1.);
+          add(externalSums.data(), externalColumn(x - 1 - radiusX), -1.);
+          add(internalSums.data(), internalColumn(x + internalRadiusX), 1.);
+          add(internalSums.data(), internalColumn(x - 1 - internalRadiusX), -1.);
+        }
+
+        for (unsigned int i = 0; i < nbMoments; ++i)
+        {
+          ringSums[i] = externalSums[i] - internalSums[i];
+        }
+
+        const InputInternalPixelType* pixel = pixelAt(x, y);
+        for (unsigned int b = 0; b < nbBands; ++b)
+        {
+          centerPixel[b] = static_cast<double>(pixel[b]) - shift[b];
+        }
+
+        outIt.Set(static_cast<OutputPixelType>(ComputeRxScore(centerPixel.data(), ringSums.data(), count, nbBands, covariance.data(), work.data())));
+        ++outIt;
+        progress.CompletedPixel();
+      }
+      outIt.NextLine();
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+double LocalRxDetectorFilter<TInputImage, TOutputImage>::ComputeRxScore(const double* centeredPixel, const double* sums, unsigned int count,
+                                                                        unsigned int nbBands, double* covariance, double* work)
+{
+  // Mean and unbiased covariance of the neighborhood, and centered test pixel
+  double*       diff     = work;
+  const double* pairSums = sums + nbBands;
+  for (unsigned int b = 0; b < nbBands; ++b)
+  {
+    diff[b] = centeredPixel[b] - sums[b] / count;
+    for (unsigned int c = b; c < nbBands; ++c)
+    {
+      const double value = (*pairSums++ - sums[b] * sums[c] / count) / (count - 1);
+      covariance[b * nbBands + c] = value;
+      covariance[c * nbBands + b] = value;
+    }
+  }
+
+  // Cholesky factorization L.L^T of the covariance, stored in its lower
+  // triangle. The Rx score is then the squared norm of L^-1.diff.
+  double* diagonal = work + 2 * nbBands;
+  for (unsigned int b = 0; b < nbBands; ++b)
+  {
+    diagonal[b] = covariance[b * nbBands + b];
+  }
+
+  bool positiveDefinite = true;
+  for (unsigned int j = 0; j < nbBands && positiveDefinite; ++j)
+  {
+    double* rowJ = covariance + j * nbBands;
+    double  sum  = rowJ[j];
+    for (unsigned int k = 0; k < j; ++k)
+    {
+      sum -= rowJ[k] * rowJ[k];
+    }
+    if (!(sum > 0.))
+    {
+      positiveDefinite = false;
+      break;
+    }
+    rowJ[j] = std::sqrt(sum);
+    for (unsigned int i = j + 1; i < nbBands; ++i)
+    {
+      double* rowI = covariance + i * nbBands;
+      double  s    = rowI[j];
+      for (unsigned int k = 0; k < j; ++k)
+      {
+        s -= rowI[k] * rowJ[k];
+      }
+      rowI[j] = s / rowJ[j];
+    }
+  }
+
+  if (positiveDefinite)
+  {
+    double  rx    = 0.;
+    double* solve = work + nbBands;
+    for (unsigned int i = 0; i < nbBands; ++i)
+    {
+      const double* rowI = covariance + i * nbBands;
+      double        s    = diff[i];
+      for (unsigned int k = 0; k < i; ++k)
+      {
+        s -= rowI[k] * solve[k];
+      }
+      solve[i] = s / rowI[i];
+      rx += solve[i] * solve[i];
+    }
+    return rx;
+  }
+
+  // Singular covariance: use the pseudo-inverse of the covariance, rebuilt
+  // from its diagonal and upper triangle
+  vnl_matrix<double> covarianceMatrix(nbBands, nbBands);
+  vnl_vector<double> diffVector(diff, nbBands);
+  for (unsigned int b = 0; b < nbBands; ++b)
+  {
+    covarianceMatrix(b, b) = diagonal[b];
+    for (unsigned int c = b + 1; c < nbBands; ++c)
+    {
+      covarianceMatrix(b, c) = covariance[b * nbBands + c];
+      covarianceMatrix(c, b) = covariance[b * nbBands + c];
+    }
+  }
+  return dot_product(diffVector, vnl_svd<double>(covarianceMatrix).inverse() * diffVector);
+}
+
+template <class TInputImage, class TOutputImage>
+void LocalRxDetectorFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Internal radius: " << m_InternalRadius << std::endl;
+  os << indent << "External radius: " << m_ExternalRadius << std::endl;
+}
+
+} // end namespace otb
+
+#endif
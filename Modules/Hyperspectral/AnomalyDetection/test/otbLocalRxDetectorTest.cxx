@@ -23,6 +23,10 @@
 #include "otbLocalRxDetectorFilter.h"
 #include "itkRescaleIntensityImageFilter.h"
 #include "otbFunctorImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+#include <algorithm>
+#include <cmath>
 
 int LocalRXDetectorTest(int itkNotUsed(argc), char* argv[])
 {
@@ -72,3 +76,47 @@ int LocalRXDetectorTest(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int LocalRXDetectorFilterTest(int itkNotUsed(argc), char* argv[])
+{
+  typedef double PixelType;
+  typedef otb::VectorImage<PixelType, 2> VectorImageType;
+  typedef otb::Image<PixelType, 2>       ImageType;
+  typedef otb::Functor::LocalRxDetectionFunctor<PixelType>       LocalRxDetectorFunctorType;
+  typedef otb::LocalRxDetectorFilter<VectorImageType, ImageType> LocalRxDetectorFilterType;
+
+  typedef otb::ImageFileReader<VectorImageType> ReaderType;
+
+  const char*        filename       = argv[1];
+  const unsigned int externalRadius = atoi(argv[2]);
+  const unsigned int internalRadius = atoi(argv[3]);
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(filename);
+
+  // Reference: statistics gathered on each neighborhood
+  LocalRxDetectorFunctorType detectorFunctor;
+  detectorFunctor.SetInternalRadius(internalRadius, internalRadius);
+  auto referenceDetector = otb::NewFunctorFilter(detectorFunctor, {{externalRadius, externalRadius}});
+  referenceDetector->SetInputs(reader->GetOutput());
+  referenceDetector->Update();
+
+  LocalRxDetectorFilterType::Pointer rxDetector = LocalRxDetectorFilterType::New();
+  rxDetector->SetInput(reader->GetOutput());
+  rxDetector->SetInternalRadius(internalRadius, internalRadius);
+  rxDetector->SetExternalRadius(externalRadius, externalRadius);
+  rxDetector->Update();
+
+  itk::ImageRegionConstIterator<ImageType> refIt(referenceDetector->GetOutput(), referenceDetector->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> it(rxDetector->GetOutput(), rxDetector->GetOutput()->GetLargestPossibleRegion());
+  for (; !refIt.IsAtEnd(); ++refIt, ++it)
+  {
+    if (std::abs(it.Get() - refIt.Get()) > 1e-6 * std::max(1., std::abs(refIt.Get())))
+    {
+      std::cerr << "Wrong Rx score at " << refIt.GetIndex() << ": " << it.Get() << " instead of " << refIt.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -105,8 +105,8 @@ void MapFileProductWriter<TInputImage>::Write()
   m_VectorImage = const_cast<TInputImage*>(this->GetInput());
   m_VectorImage->UpdateOutputInformation();
 
-  if (!m_VectorImage->GetImageMetadata().HasSensorGeometry()
-      && m_VectorImage->GetImageMetadata().HasSensorGeometry())
+  if (!this->GetInput()->GetImageMetadata().HasSensorGeometry()
+      && this->GetInput()->GetImageMetadata().HasSensorGeometry())
   {
     otbMsgDevMacro("Sensor Model detected : Reprojecting in the target SRID");
     m_GenericRSResampler->SetInput(this->GetInput());
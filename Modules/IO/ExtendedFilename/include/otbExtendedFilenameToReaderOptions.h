@@ -43,6 +43,8 @@ namespace otb
  *             - a range of bands : '3:' means 3rd band until the last one
  *                 ':-2' means the first bands until the second to last
  *                 '2:4' means bands 2,3 and 4
+ * - &mmap : switch to map uncompressed local files in memory instead of
+ *           reading them through GDAL
  *
  *  \sa ImageFileReader
  *
@@ -76,6 +78,7 @@ public:
     std::pair<bool, bool>         skipGeom;
     std::pair<bool, bool>         skipRpcTag;
     std::pair<bool, std::string>  bandRange;
+    std::pair<bool, bool>         memoryMapping;
     std::vector<std::string> optionList;
   };
 
@@ -99,6 +102,8 @@ public:
   bool         SkipRpcTagIsSet() const;
   bool         GetSkipRpcTag() const;
   std::string  GetBandRange() const;
+  bool         MemoryMappingIsSet() const;
+  bool         GetMemoryMapping() const;
 
   /** Test if band range extended filename is set */
   bool BandRangeIsSet() const;
@@ -51,6 +51,9 @@ ExtendedFilenameToReaderOptions::ExtendedFilenameToReaderOptions() : ExtendedFil
   m_Options.bandRange.first  = false;
   m_Options.bandRange.second = "";
 
+  m_Options.memoryMapping.first  = false;
+  m_Options.memoryMapping.second = false;
+
   m_Options.optionList.push_back("geom");
   m_Options.optionList.push_back("sdataidx");
   m_Options.optionList.push_back("resol");
@@ -58,6 +61,7 @@ ExtendedFilenameToReaderOptions::ExtendedFilenameToReaderOptions() : ExtendedFil
   m_Options.optionList.push_back("skipgeom");
   m_Options.optionList.push_back("skiprpctag");
   m_Options.optionList.push_back("bands");
+  m_Options.optionList.push_back("mmap");
 }
 
 void ExtendedFilenameToReaderOptions::SetExtendedFileName(const char* extFname)
@@ -140,6 +144,15 @@ void ExtendedFilenameToReaderOptions::SetExtendedFileName(const std::string& ext
     }
   }
 
+  if (!map["mmap"].empty())
+  {
+    m_Options.memoryMapping.first = true;
+    if (map["mmap"] == "On" || map["mmap"] == "on" || map["mmap"] == "ON" || map["mmap"] == "true" || map["mmap"] == "True" || map["mmap"] == "1")
+    {
+      m_Options.memoryMapping.second = true;
+    }
+  }
+
   // Option Checking
   MapIteratorType it;
   for (it = map.begin(); it != map.end(); it++)
@@ -224,4 +237,13 @@ std::string ExtendedFilenameToReaderOptions::GetBandRange() const
   return m_Options.bandRange.second;
 }
 
+bool ExtendedFilenameToReaderOptions::MemoryMappingIsSet() const
+{
+  return m_Options.memoryMapping.first;
+}
+bool ExtendedFilenameToReaderOptions::GetMemoryMapping() const
+{
+  return m_Options.memoryMapping.second;
+}
+
 } // end namespace otb
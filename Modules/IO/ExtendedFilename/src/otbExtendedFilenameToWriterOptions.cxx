@@ -48,6 +48,8 @@ ExtendedFilenameToWriterOptions::ExtendedFilenameToWriterOptions() : ExtendedFil
   m_Options.streamingType.first       = false;
   m_Options.streamingSizeMode.first   = false;
   m_Options.streamingSizeValue.first  = false;
+  m_Options.streamingAsync.first      = false;
+  m_Options.streamingAsync.second     = false;
 
   m_Options.bandRange.first  = false;
   m_Options.bandRange.second = "";
@@ -55,7 +57,7 @@ ExtendedFilenameToWriterOptions::ExtendedFilenameToWriterOptions() : ExtendedFil
   m_Options.srsValue.first = false;
 
   m_Options.optionList = {"writegeom", "writerpctags", "multiwrite", "streaming:type",
-    "streaming:sizemode", "streaming:sizevalue", "nodata", "box", "bands", "epsg"};
+    "streaming:sizemode", "streaming:sizevalue", "streaming:async", "nodata", "box", "bands", "epsg"};
 }
 
 void ExtendedFilenameToWriterOptions::SetExtendedFileName(const char* extFname)
@@ -183,6 +185,16 @@ void ExtendedFilenameToWriterOptions::SetExtendedFileName(const std::string& ext
     m_Options.streamingSizeValue.second = atof(map["streaming:sizevalue"].c_str());
   }
 
+  if (!map["streaming:async"].empty())
+  {
+    m_Options.streamingAsync.first = true;
+    if (map["streaming:async"] == "On" || map["streaming:async"] == "on" || map["streaming:async"] == "ON" ||
+        map["streaming:async"] == "true" || map["streaming:async"] == "True" || map["streaming:async"] == "1")
+    {
+      m_Options.streamingAsync.second = true;
+    }
+  }
+
   // Manage region size to write in output image
   if (!map["box"].empty())
   {
@@ -346,6 +358,16 @@ double ExtendedFilenameToWriterOptions::GetStreamingSizeValue() const
   return m_Options.streamingSizeValue.second;
 }
 
+bool ExtendedFilenameToWriterOptions::StreamingAsyncIsSet() const
+{
+  return m_Options.streamingAsync.first;
+}
+
+bool ExtendedFilenameToWriterOptions::GetStreamingAsync() const
+{
+  return m_Options.streamingAsync.second;
+}
+
 bool ExtendedFilenameToWriterOptions::BoxIsSet() const
 {
   return m_Options.box.first;
@@ -23,6 +23,7 @@
 
 #include "otbImage.h"
 #include "otbGDALDatasetWrapper.h"
+#include <cstdint>
 #include <string>
 #include <list>
 #include <vector>
@@ -108,6 +109,11 @@ class DEMHandlerTLS;
  * - SRTM available, but no geoid: srtm_value
  * - No SRTM and no geoid available: 0
  *
+ * DEM and geoid pixels are decoded by tiles, which are kept in a
+ * process-wide LRU cache shared by all threads. Its capacity can be set
+ * with SetTileCacheCapacity(), and its efficiency monitored with
+ * GetTileCacheHits() and GetTileCacheMisses().
+ *
  * \ingroup OTBIOGDAL
  */
 class DEMHandler : public DEMSubjectInterface
@@ -152,6 +158,14 @@ public:
 
   double GetHeightAboveEllipsoid(const PointType& geoPoint) const;
 
+  /** Batch version of GetHeightAboveEllipsoid().
+   * \param[in] lon input longitudes
+   * \param[in] lat input latitudes
+   * \param[out] h heights above ellipsoid
+   * \param[in] n number of points
+   */
+  void GetHeightAboveEllipsoid(const double* lon, const double* lat, double* h, std::size_t n) const;
+
   /** Return the height above the mean sea level :
    * - SRTM and geoid both available: srtm_value
    * - No SRTM but geoid available: 0
@@ -179,6 +193,24 @@ public:
 
   void SetDefaultHeightAboveEllipsoid(double height);
 
+  /** Set the maximum number of decoded DEM and geoid tiles kept in memory
+   * (a tile holds 257x257 double values). Default is 128.
+   */
+  void SetTileCacheCapacity(std::size_t nbTiles);
+  std::size_t GetTileCacheCapacity() const;
+
+  /** Return the number of tile lookups that were served from the tile
+   * cache since the last call to ResetTileCacheStatistics()
+   */
+  std::uint64_t GetTileCacheHits() const;
+
+  /** Return the number of tile lookups that required decoding a tile
+   * since the last call to ResetTileCacheStatistics()
+   */
+  std::uint64_t GetTileCacheMisses() const;
+
+  void ResetTileCacheStatistics();
+
   /** Get n-th DEM directory name.
    * \param[in] idx directory index
    * \return the DEM directory corresponding to index idx
@@ -309,6 +341,7 @@ double GetGeoidHeight         (DEMHandlerTLS const&, double lon, double lat);
 double GetHeightAboveEllipsoid(DEMHandlerTLS const&, itk::Point<double, 2> geoPoint);
 double GetHeightAboveMSL      (DEMHandlerTLS const&, itk::Point<double, 2> geoPoint);
 double GetGeoidHeight         (DEMHandlerTLS const&, itk::Point<double, 2> geoPoint);
+void   GetHeightAboveEllipsoid(DEMHandlerTLS const&, const double* lon, const double* lat, double* h, std::size_t n);
 /// @}
 
 }
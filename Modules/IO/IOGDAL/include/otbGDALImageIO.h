@@ -24,6 +24,7 @@
 
 
 /* C++ Libraries */
+#include <cstdint>
 #include <string>
 
 /* ITK Libraries */
@@ -158,6 +159,15 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   void Read(void* buffer) override;
 
+  /** Determine if the pixels of the IORegion can be mapped from the file:
+   * this requires a local file whose pixels are stored uncompressed, with
+   * the bands interleaved by pixel and in the native byte order (as in
+   * uncompressed stripped GeoTIFF or BIP ENVI files). */
+  bool CanMapRead() override;
+
+  /** Map the pixels of the IORegion from the file */
+  std::shared_ptr<MemoryMappedFile> MapRead(std::size_t& lineStride) override;
+
   /** Reads 3D data from multiple files assuming one slice per file. */
   virtual void ReadVolume(void* buffer);
 
@@ -282,6 +292,10 @@ private:
 
   std::string FilenameToGdalDriverShortName(const std::string& name) const;
 
+  /** Get the location of the pixels in the file, if they are stored
+   * uncompressed with the same layout as the buffer filled by Read() */
+  bool GetRawPixelLayout(std::string& fileName, std::uint64_t& imageOffset, std::size_t& lineStride) const;
+
   /** Parse a GML box from a Jpeg2000 file and get the origin */
   bool GetOriginFromGMLBox(std::vector<double>& origin);
 
@@ -33,10 +33,15 @@
 //TODO C++ 17 : use std::optional instead
 #include <boost/optional.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <map>
 #include <mutex>
 #include <thread>
 #include <memory>
 #include <sstream>
+#include <tuple>
 
 namespace
 { // Anonymous namespace
@@ -195,6 +200,17 @@ struct DatasetCache
     return true;
   }
 
+  /** Batch version of `convert_lon_lat()`.
+   * \param[out] success  per point conversion status
+   */
+  void convert_lon_lat(std::size_t n, double * lon, double * lat, int * success) const
+  {
+    assert((m_poCT || !isWGS84()) && "Expected: isWGS84() => projection is defined");
+    if (m_poCT && n > 0) {
+      m_poCT->Transform( static_cast<int>(n), lon, lat, nullptr, success );
+    }
+  }
+
   /// Apply geo transformation to return pixels associated to {lon, * lat}.
   std::pair<double, double> transform(double lon, double lat) const
   {
@@ -226,34 +242,252 @@ private:
   double      m_NoDataValue     = {};
 };
 
+/** Size, in pixels, of the DEM and geoid tiles kept in the `TileCache`. */
+constexpr int DEMTileSize = 256;
+
 /**
- * Obtain DEM value from dataset at specified position.
+ * Block of decoded DEM (or geoid) pixels.
  *
- * General operation sequence:
- * 1. Convert {lon, lat} in WGS84 case
- * 2. Computed associated pixel coordinates (in floatting point unit)
- *    thanks to geo transformation
- * 3. Extract 4 pixels around the desired position
- * 4. Interpolate the final elevation
+ * Tiles overlap their right and bottom neighbours by one pixel, so
+ * that the 2x2 neighbourhood needed by the bilinear interpolation
+ * always lies in a single tile.
+ * \internal
+ */
+struct DEMTile
+{
+  int                 x0     = 0;
+  int                 y0     = 0;
+  int                 width  = 0;
+  int                 height = 0;
+  double              noData = 0;
+  std::vector<double> values;
+
+  /// Tells whether the 2x2 neighbourhood starting at {x, y} is in the tile.
+  bool contains2x2(int x, int y) const noexcept
+  {
+    return x >= x0 && y >= y0 && x + 1 < x0 + width && y + 1 < y0 + height;
+  }
+
+  double at(int x, int y) const noexcept
+  {
+    return values[(y - y0) * width + (x - x0)];
+  }
+};
+
+using DEMTilePtr = std::shared_ptr<const DEMTile>;
+
+/**
+ * Decode the tile {tx, ty} of the first band of the dataset.
+ * \return `nullptr` if the pixels cannot be read
+ * \internal
+ */
+DEMTilePtr ReadTile(DatasetCache const& dsc, int tx, int ty)
+{
+  auto tile    = std::make_shared<DEMTile>();
+  tile->x0     = tx * DEMTileSize;
+  tile->y0     = ty * DEMTileSize;
+  tile->width  = std::min(DEMTileSize + 1, dsc->GetRasterXSize() - tile->x0);
+  tile->height = std::min(DEMTileSize + 1, dsc->GetRasterYSize() - tile->y0);
+  tile->noData = dsc.GetNoDataValue();
+
+  if (tile->width <= 0 || tile->height <= 0)
+  {
+    return nullptr;
+  }
+
+  tile->values.resize(static_cast<std::size_t>(tile->width) * tile->height);
+
+  auto const err = dsc->GetRasterBand(1)->RasterIO(GF_Read, tile->x0, tile->y0, tile->width, tile->height,
+      tile->values.data(), tile->width, tile->height, GDT_Float64,
+      0, 0, nullptr);
+
+  if (err)
+  {
+    return nullptr;
+  }
+  return tile;
+}
+
+/**
+ * Process-wide LRU cache of decoded DEM and geoid tiles.
  *
- * \return `boost::none` if {lon, lat} conversion cannot be achieved
- * \return `boost::none` if {lon, lat} conversion cannot be achieved
- * \return `boost::none` if pixel extractions from file fails
- * \return elevation according to DEM at {lot, lat} position
+ * Tiles are immutable once decoded, and are shared by all the
+ * `DEMHandlerTLS` instances. Each thread decodes the tiles it misses
+ * with its own `GDALDataset`, the cache itself only protects its
+ * index with a mutex.
+ *
+ * `Clear()` increments a generation counter: a tile decoded while the
+ * cache was cleared comes from a dataset that may have been replaced
+ * meanwhile, and is not inserted.
  * \internal
  */
-boost::optional<double> GetDEMValue(double lon, double lat, DatasetCache const& dsc)
+class TileCache
 {
-  if (!dsc.convert_lon_lat(lon, lat))
+public:
+  /// Dataset a tile belongs to
+  enum Slot { DEM = 0, Geoid = 1 };
+
+  TileCache() = default;
+  TileCache(TileCache const&) = delete;
+  TileCache& operator=(TileCache const&) = delete;
+
+  /** Fetch a tile, decoding it with `dsc` if it is not cached.
+   * \param[out] decoded  tells whether the tile has been decoded
+   * \return `nullptr` if the tile cannot be decoded
+   */
+  DEMTilePtr Get(Slot slot, DatasetCache const& dsc, int tx, int ty, bool& decoded)
   {
-    return boost::none;
+    Key const key{slot, tx, ty};
+    decoded = false;
+    unsigned long generation;
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      generation = m_Generation;
+      auto it = m_Tiles.find(key);
+      if (it != m_Tiles.end())
+      {
+        m_LRU.splice(m_LRU.begin(), m_LRU, it->second.second);
+        return it->second.first;
+      }
+    }
+
+    // Decode outside of the lock: other threads may hit other tiles meanwhile
+    auto tile = ReadTile(dsc, tx, ty);
+    decoded   = true;
+    if (!tile)
+    {
+      return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (generation != m_Generation)
+    {
+      // The cache has been cleared during the decoding
+      return tile;
+    }
+    auto it = m_Tiles.find(key);
+    if (it != m_Tiles.end())
+    {
+      // Another thread decoded the same tile
+      return it->second.first;
+    }
+    m_LRU.push_front(key);
+    m_Tiles.emplace(key, std::make_pair(tile, m_LRU.begin()));
+    Shrink();
+    return tile;
   }
 
-  // C++17 use: `auto const [x,y] = dsc.transform(lon, lat);`
-  auto const xy = dsc.transform(lon, lat);
-  auto const x = xy.first;
-  auto const y = xy.second;
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Tiles.clear();
+    m_LRU.clear();
+    ++m_Generation;
+  }
+
+  void SetCapacity(std::size_t nbTiles)
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Capacity = std::max<std::size_t>(nbTiles, 1);
+    Shrink();
+  }
+
+  std::size_t GetCapacity() const
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Capacity;
+  }
+
+private:
+  using Key = std::tuple<int, int, int>;
+
+  /// Evict the least recently used tiles. Must be called with `m_Mutex` held.
+  void Shrink()
+  {
+    while (m_Tiles.size() > m_Capacity)
+    {
+      m_Tiles.erase(m_LRU.back());
+      m_LRU.pop_back();
+    }
+  }
+
+  mutable std::mutex m_Mutex;
+  std::list<Key>     m_LRU;
+  std::map<Key, std::pair<DEMTilePtr, std::list<Key>::iterator>> m_Tiles;
+  std::size_t        m_Capacity = 128;
+  unsigned long      m_Generation = 0;
+};
+
+TileCache& GetTileCache()
+{
+  static TileCache s_cache;
+  return s_cache;
+}
+
+/**
+ * Thread-wise access to the tiles of one dataset.
+ *
+ * Keeps the last tile used, so that consecutive lookups on nearby
+ * positions don't even need to lock the shared `TileCache`, and counts
+ * the tile lookups.
+ * \internal
+ */
+class TileCursor
+{
+public:
+  explicit TileCursor(TileCache::Slot slot) : m_Slot(slot) {}
+
+  /** Return the tile containing the 2x2 neighbourhood starting at {x, y}.
+   * \return `nullptr` if the neighbourhood cannot be read
+   */
+  DEMTile const* Get(DatasetCache const& dsc, int x, int y)
+  {
+    if (m_Tile && m_Tile->contains2x2(x, y))
+    {
+      m_Hits.fetch_add(1, std::memory_order_relaxed);
+      return m_Tile.get();
+    }
+
+    bool decoded = false;
+    m_Tile = GetTileCache().Get(m_Slot, dsc, x / DEMTileSize, y / DEMTileSize, decoded);
+    (decoded ? m_Misses : m_Hits).fetch_add(1, std::memory_order_relaxed);
+
+    if (m_Tile && m_Tile->contains2x2(x, y))
+    {
+      return m_Tile.get();
+    }
+    return nullptr;
+  }
+
+  /// Forget the last tile, to be called whenever the dataset changes.
+  void Reset() { m_Tile.reset(); }
+
+  std::uint64_t GetHits()   const noexcept { return m_Hits.load(std::memory_order_relaxed); }
+  std::uint64_t GetMisses() const noexcept { return m_Misses.load(std::memory_order_relaxed); }
+
+  void ResetStatistics() noexcept
+  {
+    m_Hits.store(0, std::memory_order_relaxed);
+    m_Misses.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  TileCache::Slot            m_Slot;
+  DEMTilePtr                 m_Tile;
+  std::atomic<std::uint64_t> m_Hits{0};
+  std::atomic<std::uint64_t> m_Misses{0};
+};
 
+/**
+ * Interpolate the DEM value at pixel position {x, y}.
+ *
+ * \return `boost::none` if {x, y} is outside the raster
+ * \return `boost::none` if pixel extractions from file fails
+ * \return `boost::none` if any pixel of the interpolation has no data
+ * \internal
+ */
+boost::optional<double> InterpolateDEMValue(double x, double y, DatasetCache const& dsc, TileCursor& cursor)
+{
   auto is_out_raster = [&](auto x, auto y, GDALDataset & ds) {
     return x < 0
       ||   y < 0
@@ -273,20 +507,18 @@ boost::optional<double> GetDEMValue(double lon, double lat, DatasetCache const&
   auto const deltaY = y - y_int;
 
   // Bilinear interpolation.
-  double elevData[4];
-
-  auto const err = dsc->GetRasterBand(1)->RasterIO( GF_Read, x_int, y_int, 2, 2,
-      elevData, 2, 2, GDT_Float64,
-      0, 0, nullptr);
-
-  if (err)
+  auto const tile = cursor.Get(dsc, x_int, y_int);
+  if (!tile)
   {
     return boost::none;
   }
 
+  double const elevData[4] = {tile->at(x_int, y_int),     tile->at(x_int + 1, y_int),
+                              tile->at(x_int, y_int + 1), tile->at(x_int + 1, y_int + 1)};
+
   // Test for no data. Don't return a value if any pixel of the
   // interpolation has no data.
-  auto const no_data = dsc.GetNoDataValue();
+  double const no_data = tile->noData;
   auto const has_no_data = [=](auto const v){ return  v == no_data; };
   if(std::any_of(std::begin(elevData), std::end(elevData), has_no_data))
   {
@@ -301,6 +533,61 @@ boost::optional<double> GetDEMValue(double lon, double lat, DatasetCache const&
   return yBil;
 }
 
+/**
+ * Obtain DEM value from dataset at specified position.
+ *
+ * General operation sequence:
+ * 1. Convert {lon, lat} in WGS84 case
+ * 2. Computed associated pixel coordinates (in floatting point unit)
+ *    thanks to geo transformation
+ * 3. Extract 4 pixels around the desired position from the tile cache
+ * 4. Interpolate the final elevation
+ *
+ * \return `boost::none` if {lon, lat} conversion cannot be achieved
+ * \return `boost::none` if pixel extractions from file fails
+ * \return elevation according to DEM at {lot, lat} position
+ * \internal
+ */
+boost::optional<double> GetDEMValue(double lon, double lat, DatasetCache const& dsc, TileCursor& cursor)
+{
+  if (!dsc.convert_lon_lat(lon, lat))
+  {
+    return boost::none;
+  }
+
+  // C++17 use: `auto const [x,y] = dsc.transform(lon, lat);`
+  auto const xy = dsc.transform(lon, lat);
+  return InterpolateDEMValue(xy.first, xy.second, dsc, cursor);
+}
+
+/**
+ * Batch version of `GetDEMValue()`.
+ *
+ * The {lon, lat} conversion of all the points is done with a single
+ * call to the coordinate transformation.
+ * \internal
+ */
+void GetDEMValues(double const* lon, double const* lat, std::size_t n, DatasetCache const& dsc, TileCursor& cursor,
+                  boost::optional<double>* values)
+{
+  std::vector<double> x(lon, lon + n);
+  std::vector<double> y(lat, lat + n);
+  std::vector<int>    success(n, TRUE);
+
+  dsc.convert_lon_lat(n, x.data(), y.data(), success.data());
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    if (!success[i])
+    {
+      values[i] = boost::none;
+      continue;
+    }
+    auto const xy = dsc.transform(x[i], y[i]);
+    values[i]     = InterpolateDEMValue(xy.first, xy.second, dsc, cursor);
+  }
+}
+
 /**
  * Tells whether the dataset has a Geo Transformation.
  * \internal
@@ -345,6 +632,15 @@ public:
   boost::optional<double> GetHeightAboveMSL(double lon, double lat) const;
   boost::optional<double> GetGeoidHeight(double lon, double lat) const;
 
+  void GetHeightAboveEllipsoid(double const* lon, double const* lat, double* h, std::size_t n, double defaultHeight) const;
+
+  /** Number of DEM and geoid tile lookups done from this instance that
+   * were served by the tile cache (hits) or required decoding (misses).
+   */
+  std::uint64_t GetTileCacheHits() const noexcept;
+  std::uint64_t GetTileCacheMisses() const noexcept;
+  void ResetTileCacheStatistics() noexcept;
+
   DEMHandlerTLS() {
     otbMsgDevMacro(<<std::this_thread::get_id() << " § DEMHandlerTLS::DEMHandlerTLS() --> " << this);
   }
@@ -377,6 +673,10 @@ private:
 
   /** Pointer to the geoid dataset */
   DEMDetails::DatasetCache m_GeoidDS;
+
+  /** Access to the shared tiles of the DEM and of the geoid */
+  mutable DEMDetails::TileCursor m_DEMTiles{DEMDetails::TileCache::DEM};
+  mutable DEMDetails::TileCursor m_GeoidTiles{DEMDetails::TileCache::Geoid};
 };
 
 DEMHandlerTLS const& DEMHandler::GetHandlerForCurrentThread() const
@@ -477,6 +777,7 @@ DEMHandler::~DEMHandler()
 void DEMHandlerTLS::CloseDEMVRTFile()
 {
   m_DEMDS.release();
+  m_DEMTiles.Reset();
 }
 
 bool DEMHandlerTLS::OpenDEMVRTFile()
@@ -485,6 +786,7 @@ bool DEMHandlerTLS::OpenDEMVRTFile()
   // As we are reopening the same file: we should close it first!
   assert(! m_DEMDS);
   m_DEMDS = DEMDetails::DatasetCache(DEMHandler::DEM_DATASET_PATH);
+  m_DEMTiles.Reset();
 
   // Note: we don't try to call CreateShiftedDatasetOnce() as the
   // current implementation of DEMHandler::OpenGeoidFile() indirectly
@@ -505,6 +807,8 @@ void DEMHandler::OpenDEMFile(std::string path)
   for (auto tls : m_tlses) {
     tls->CloseDEMVRTFile();
   }
+  // Decoded tiles refer to the previous VRT
+  DEMDetails::GetTileCache().Clear();
   // TODO: why [0] and not back()???
   std::array<GDALDatasetH, 1> vrtDatasetList { m_DatasetList[0]->GetDataSet() };
   auto close_me = GDALBuildVRT(DEMHandler::DEM_DATASET_PATH, 1, vrtDatasetList.data(),
@@ -578,6 +882,9 @@ void DEMHandler::OpenDEMDirectory(std::string DEMDirectory)
     otbLogMacro(Info, << nb_new_DEM_opened << " DEM found in "<< DEMDirectory)
     m_DEMDirectories.push_back(move(DEMDirectory)); // => parameter voluntary taken by value
 
+    // Decoded tiles refer to the previous VRT
+    DEMDetails::GetTileCache().Clear();
+
     // Clean before anything else: Free the previous in-memory dataset (if any)
     if (m_DatasetList.size() != nb_new_DEM_opened)
     {
@@ -680,6 +987,7 @@ bool DEMHandlerTLS::OpenGeoidFile(const std::string& geoidFile)
   }
 
   m_GeoidDS = std::move(gdalds);
+  m_GeoidTiles.Reset();
 
   return true;
 }
@@ -694,6 +1002,9 @@ bool DEMHandler::OpenGeoidFile(std::string geoidFile)
   auto & tls = GetHandlerForCurrentThread();
   (void) tls;
 
+  // Decoded tiles may refer to the previous geoid
+  DEMDetails::GetTileCache().Clear();
+
   int nb_success = 0;
   {
     const std::lock_guard<std::mutex> lock(demMutex);
@@ -805,7 +1116,7 @@ boost::optional<double> DEMHandlerTLS::GetHeightAboveMSL(double lon, double lat)
 {
   if (m_DEMDS)
   {
-    return DEMDetails::GetDEMValue(lon, lat, m_DEMDS);
+    return DEMDetails::GetDEMValue(lon, lat, m_DEMDS, m_DEMTiles);
   }
   return boost::none;
 }
@@ -814,7 +1125,7 @@ boost::optional<double> DEMHandlerTLS::GetGeoidHeight(double lon, double lat) co
 {
   if (m_GeoidDS)
   {
-    return DEMDetails::GetDEMValue(lon, lat, m_GeoidDS);
+    return DEMDetails::GetDEMValue(lon, lat, m_GeoidDS, m_GeoidTiles);
   }
   return boost::none;
 }
@@ -842,6 +1153,50 @@ double DEMHandlerTLS::GetHeightAboveEllipsoid(double lon, double lat, double def
     return defaultHeight;
 }
 
+void DEMHandlerTLS::GetHeightAboveEllipsoid(double const* lon, double const* lat, double* h, std::size_t n, double defaultHeight) const
+{
+  std::vector<boost::optional<double>> DEMresults(n);
+  std::vector<boost::optional<double>> geoidResults(n);
+
+  if (m_DEMDS)
+  {
+    DEMDetails::GetDEMValues(lon, lat, n, m_DEMDS, m_DEMTiles, DEMresults.data());
+  }
+  if (m_GeoidDS)
+  {
+    DEMDetails::GetDEMValues(lon, lat, n, m_GeoidDS, m_GeoidTiles, geoidResults.data());
+  }
+
+  // Same rules as the single point version
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    if (DEMresults[i] || geoidResults[i])
+    {
+      h[i] = DEMresults[i].value_or(0.) + geoidResults[i].value_or(0.);
+    }
+    else
+    {
+      h[i] = defaultHeight;
+    }
+  }
+}
+
+std::uint64_t DEMHandlerTLS::GetTileCacheHits() const noexcept
+{
+  return m_DEMTiles.GetHits() + m_GeoidTiles.GetHits();
+}
+
+std::uint64_t DEMHandlerTLS::GetTileCacheMisses() const noexcept
+{
+  return m_DEMTiles.GetMisses() + m_GeoidTiles.GetMisses();
+}
+
+void DEMHandlerTLS::ResetTileCacheStatistics() noexcept
+{
+  m_DEMTiles.ResetStatistics();
+  m_GeoidTiles.ResetStatistics();
+}
+
 double DEMHandler::GetHeightAboveEllipsoid(double lon, double lat) const
 {
   auto & tls = GetHandlerForCurrentThread();
@@ -852,6 +1207,12 @@ double DEMHandler::GetHeightAboveEllipsoid(const PointType& geoPoint) const
   return GetHeightAboveEllipsoid(geoPoint[0], geoPoint[1]);
 }
 
+void DEMHandler::GetHeightAboveEllipsoid(const double* lon, const double* lat, double* h, std::size_t n) const
+{
+  auto & tls = GetHandlerForCurrentThread();
+  tls.GetHeightAboveEllipsoid(lon, lat, h, n, m_DefaultHeightAboveEllipsoid);
+}
+
 double DEMHandler::GetGeoidHeight(double lon, double lat) const
 {
   auto & tls = GetHandlerForCurrentThread();
@@ -916,6 +1277,8 @@ void DEMHandlerTLS::ClearElevationParameters()
 {
   m_GeoidDS.release();
   m_DEMDS.release();
+  m_GeoidTiles.Reset();
+  m_DEMTiles.Reset();
 }
 
 void DEMHandler::ClearElevationParameters()
@@ -925,6 +1288,7 @@ void DEMHandler::ClearElevationParameters()
 
   // This will call GDALClose on all datasets
   m_DatasetList.clear();
+  DEMDetails::GetTileCache().Clear();
   {
     const std::lock_guard<std::mutex> lock(demMutex);
     for (auto tls : m_tlses) {
@@ -949,6 +1313,47 @@ double DEMHandler::GetDefaultHeightAboveEllipsoid() const noexcept
   return m_DefaultHeightAboveEllipsoid;
 }
 
+void DEMHandler::SetTileCacheCapacity(std::size_t nbTiles)
+{
+  DEMDetails::GetTileCache().SetCapacity(nbTiles);
+}
+
+std::size_t DEMHandler::GetTileCacheCapacity() const
+{
+  return DEMDetails::GetTileCache().GetCapacity();
+}
+
+std::uint64_t DEMHandler::GetTileCacheHits() const
+{
+  const std::lock_guard<std::mutex> lock(demMutex); // protecting m_tlses
+  std::uint64_t hits = 0;
+  for (auto const& tls : m_tlses)
+  {
+    hits += tls->GetTileCacheHits();
+  }
+  return hits;
+}
+
+std::uint64_t DEMHandler::GetTileCacheMisses() const
+{
+  const std::lock_guard<std::mutex> lock(demMutex); // protecting m_tlses
+  std::uint64_t misses = 0;
+  for (auto const& tls : m_tlses)
+  {
+    misses += tls->GetTileCacheMisses();
+  }
+  return misses;
+}
+
+void DEMHandler::ResetTileCacheStatistics()
+{
+  const std::lock_guard<std::mutex> lock(demMutex); // protecting m_tlses
+  for (auto const& tls : m_tlses)
+  {
+    tls->ResetTileCacheStatistics();
+  }
+}
+
 void DEMHandler::Notify() const
 {
   for (const auto & observer: m_ObserverList)
@@ -970,6 +1375,9 @@ double GetGeoidHeight         (DEMHandlerTLS const& tls, double lon, double lat)
 double GetHeightAboveEllipsoid(DEMHandlerTLS const& tls, itk::Point<double, 2> geoPoint)
 { return GetHeightAboveEllipsoid(tls, geoPoint[0], geoPoint[1]); }
 
+void GetHeightAboveEllipsoid(DEMHandlerTLS const& tls, const double* lon, const double* lat, double* h, std::size_t n)
+{ tls.GetHeightAboveEllipsoid(lon, lat, h, n, DEMHandler::GetInstance().GetDefaultHeightAboveEllipsoid()); }
+
 double GetHeightAboveMSL      (DEMHandlerTLS const& tls, itk::Point<double, 2> geoPoint)
 { return GetHeightAboveMSL(tls, geoPoint[0], geoPoint[1]); }
 
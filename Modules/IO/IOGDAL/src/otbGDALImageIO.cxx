@@ -275,6 +275,94 @@ void GDALImageIO::Read(void* buffer)
   }
 }
 
+bool GDALImageIO::GetRawPixelLayout(std::string& fileName, std::uint64_t& imageOffset, std::size_t& lineStride) const
+{
+#if GDAL_VERSION_NUM >= 3010000
+  if (m_Dataset.IsNull() || m_IsIndexed || m_ResolutionFactor != 0)
+  {
+    return false;
+  }
+
+  // Real and imaginary parts are read from separate bands in this case
+  if (!GDALDataTypeIsComplex(m_PxType->pixType) && m_IsComplex && m_IsVectorImage && (m_NbBands > 1))
+  {
+    return false;
+  }
+
+  GDALDataset::RawBinaryLayout layout;
+  if (!m_Dataset->GetDataSet()->GetRawBinaryLayout(layout))
+  {
+    return false;
+  }
+
+  const bool bip = layout.eInterleaving == GDALDataset::RawBinaryLayout::Interleaving::BIP;
+
+  const GIntBig pixelSize   = static_cast<GIntBig>(m_BytePerPixel) * m_NbBands;
+  const bool    interleaved = (m_NbBands == 1) || (bip && layout.nBandOffset == m_BytePerPixel);
+  const bool    nativeOrder = (GDALGetDataTypeSizeBytes(layout.eDataType) == 1) || (layout.bLittleEndianOrder == static_cast<bool>(CPL_IS_LSB));
+
+  // Virtual file systems (/vsizip/, /vsicurl/, ...) can not be mapped
+  if (layout.eDataType != m_PxType->pixType || !interleaved || !nativeOrder || layout.nPixelOffset != pixelSize ||
+      layout.nLineOffset < pixelSize * static_cast<GIntBig>(m_OriginalDimensions[0]) || layout.osRawFilename.find("/vsi") == 0)
+  {
+    return false;
+  }
+
+  fileName    = layout.osRawFilename;
+  imageOffset = static_cast<std::uint64_t>(layout.nImageOffset);
+  lineStride  = static_cast<std::size_t>(layout.nLineOffset);
+  return true;
+#else
+  (void)fileName;
+  (void)imageOffset;
+  (void)lineStride;
+  return false;
+#endif
+}
+
+bool GDALImageIO::CanMapRead()
+{
+  std::string   fileName;
+  std::uint64_t imageOffset = 0;
+  std::size_t   lineStride  = 0;
+  return this->GetRawPixelLayout(fileName, imageOffset, lineStride);
+}
+
+std::shared_ptr<MemoryMappedFile> GDALImageIO::MapRead(std::size_t& lineStride)
+{
+  std::string   fileName;
+  std::uint64_t imageOffset = 0;
+  if (!this->GetRawPixelLayout(fileName, imageOffset, lineStride))
+  {
+    itkExceptionMacro(<< "Image file " << m_FileName << " can not be memory mapped");
+  }
+
+  const std::uint64_t firstLine   = this->GetIORegion().GetIndex()[1];
+  const std::uint64_t firstColumn = this->GetIORegion().GetIndex()[0];
+  const std::uint64_t nbLines     = this->GetIORegion().GetSize()[1];
+  const std::uint64_t nbColumns   = this->GetIORegion().GetSize()[0];
+  const std::uint64_t pixelSize   = static_cast<std::uint64_t>(m_BytePerPixel) * m_NbBands;
+
+  if (nbLines == 0 || nbColumns == 0 || firstLine + nbLines > m_OriginalDimensions[1] || firstColumn + nbColumns > m_OriginalDimensions[0])
+  {
+    itkExceptionMacro(<< "Invalid region to map from image file " << m_FileName);
+  }
+
+  const std::uint64_t offset = imageOffset + firstLine * lineStride + firstColumn * pixelSize;
+  const std::uint64_t length = (nbLines - 1) * lineStride + nbColumns * pixelSize;
+
+  // Accessing pages beyond the end of a truncated file would crash
+  if (offset + length > static_cast<std::uint64_t>(itksys::SystemTools::FileLength(fileName)))
+  {
+    itkExceptionMacro(<< "Image file " << fileName << " is truncated");
+  }
+
+  otbLogMacro(Debug, << "Mapping [" << firstColumn << ", " << firstColumn + nbColumns - 1 << "]x[" << firstLine << ", " << firstLine + nbLines - 1 << "] x "
+                     << m_NbBands << " bands of type " << GDALGetDataTypeName(m_PxType->pixType) << " from file " << fileName);
+
+  return std::make_shared<MemoryMappedFile>(fileName, offset, static_cast<std::size_t>(length));
+}
+
 bool GDALImageIO::GetSubDatasetInfo(std::vector<std::string>& names, std::vector<std::string>& desc)
 {
   // Note: we assume that the subdatasets are in order : SUBDATASET_ID_NAME, SUBDATASET_ID_DESC, SUBDATASET_ID+1_NAME, SUBDATASET_ID+1_DESC
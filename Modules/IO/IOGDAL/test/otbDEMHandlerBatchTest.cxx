@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "itkMacro.h"
+#include "otbDEMHandler.h"
+
+#include <cmath>
+#include <vector>
+
+int otbDEMHandlerBatchTest(int argc, char* argv[])
+{
+  if (argc != 8)
+  {
+    std::cerr << "Usage: " << argv[0] << " demdir geoid longitude latitude extent targetValue tolerance" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string demdir    = argv[1];
+  std::string geoid     = argv[2];
+  double      longitude = atof(argv[3]);
+  double      latitude  = atof(argv[4]);
+  double      extent    = atof(argv[5]);
+  double      target    = atof(argv[6]);
+  double      tolerance = atof(argv[7]);
+
+  auto& demHandler = otb::DEMHandler::GetInstance();
+  demHandler.OpenDEMDirectory(demdir);
+  demHandler.OpenGeoidFile(geoid);
+  demHandler.ResetTileCacheStatistics();
+
+  // Regular grid of points centered on (longitude, latitude)
+  const std::size_t   gridSize = 100;
+  const std::size_t   n        = gridSize * gridSize;
+  std::vector<double> lon(n), lat(n), h(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    lon[i] = longitude + extent * (static_cast<double>(i % gridSize) / gridSize - 0.5);
+    lat[i] = latitude + extent * (static_cast<double>(i / gridSize) / gridSize - 0.5);
+  }
+
+  demHandler.GetHeightAboveEllipsoid(lon.data(), lat.data(), h.data(), n);
+
+  std::cout << "Tile cache hits: " << demHandler.GetTileCacheHits() << ", misses: " << demHandler.GetTileCacheMisses() << std::endl;
+
+  if (demHandler.GetTileCacheMisses() == 0 || demHandler.GetTileCacheHits() == 0)
+  {
+    std::cerr << "Tile cache has not been used" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The center of the grid is the reference point
+  const std::size_t center = (gridSize / 2) * gridSize + gridSize / 2;
+  if (std::abs(h[center] - target) > tolerance)
+  {
+    std::cerr << "Target value at (" << lon[center] << ", " << lat[center] << ") is " << target << " meters, batch value is " << h[center] << " meters"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The batch version must match the single point version
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    double expected = demHandler.GetHeightAboveEllipsoid(lon[i], lat[i]);
+    if (h[i] != expected)
+    {
+      std::cerr << "Height above ellipsoid at (" << lon[i] << ", " << lat[i] << ") is " << h[i] << " with the batch version, " << expected
+                << " with the single point version" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  demHandler.ClearElevationParameters();
+
+  return EXIT_SUCCESS;
+}
@@ -34,6 +34,7 @@ void RegisterTests()
   REGISTER_TEST(otbMultiDatasetReadingInfo);
   REGISTER_TEST(otbOGRVectorDataIOTestCanRead);
   REGISTER_TEST(otbDEMHandlerTest);
+  REGISTER_TEST(otbDEMHandlerBatchTest);
   REGISTER_TEST(otbGDALRPCTransformerTest);
   REGISTER_TEST(otbGDALRPCTransformerTest2);
 }
@@ -140,12 +140,23 @@ protected:
   /** Convert a block of pixels from one type to another. */
   void DoConvertBuffer(void* buffer, size_t numberOfPixels);
 
+  /** Convert a block of pixels from one type to another, into the given
+   * part of the output buffer. */
+  void DoConvertBuffer(void* buffer, OutputImagePixelType* outputData, size_t numberOfPixels);
+
 private:
   /** Test whether m_ImageIO is valid (not NULL). This is intended to be called
    * after trying to create it via an ImageIOFactory. Throws an exception with
    * an appropriate message otherwise. */
   void TestValidImageIO();
 
+  /** Fill the output from a memory mapping of the IORegion (see the mmap
+   * extended filename option). Without type conversion, the mapped pages
+   * are used as the output buffer when the region is contiguous in the
+   * file. Returns false if the mapped pixels can not be converted in
+   * place, in which case the output is left unallocated. */
+  bool GenerateDataFromMapping(bool convert);
+
   /** Generate the filename (for GDALImageI for example). If filename is a directory, look if is a
     * CEOS product (file "DAT...") In this case, the GdalFileName contain the open image file.
     */
@@ -26,7 +26,10 @@
 
 #include "otbSystem.h"
 #include <itksys/SystemTools.hxx>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <string>
 
 #include "itkImageIOFactory.h"
@@ -38,6 +41,7 @@
 #include "otbImageIOFactory.h"
 #include "otbMetaDataKey.h"
 #include "otbImageMetadata.h"
+#include "otbMemoryMappedImageContainer.h"
 #include "otbImageMetadataInterfaceFactory.h"
 #include "otbImageCommons.h"
 #include "otbGeomMetadataSupplier.h"
@@ -120,16 +124,13 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
   typename TOutputImage::Pointer output = this->GetOutput();
 
-  // allocate the output buffer
   output->SetBufferedRegion(output->GetRequestedRegion());
-  output->Allocate();
 
   // Raise an exception if the file could not be opened
   // i.e. if this->m_ImageIO is Null
   this->TestValidImageIO();
 
   // Tell the ImageIO to read the file
-  OutputImagePixelType* buffer = output->GetPixelContainer()->GetBufferPointer();
   this->m_ImageIO->SetFileName(this->m_FileName);
 
   itk::ImageIORegion ioRegion(TOutputImage::ImageDimension);
@@ -180,11 +181,23 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   typedef otb::DefaultConvertPixelTraits<typename TOutputImage::IOPixelType> ConvertIOPixelTraits;
   typedef otb::DefaultConvertPixelTraits<typename TOutputImage::PixelType>   ConvertOutputPixelTraits;
 
-  if (this->m_ImageIO->GetComponentTypeInfo() == typeid(typename ConvertOutputPixelTraits::ComponentType) &&
-      (this->m_ImageIO->GetNumberOfComponents() == ConvertIOPixelTraits::GetNumberOfComponents()) && !m_FilenameHelper->BandRangeIsSet())
+  const bool convert = !(this->m_ImageIO->GetComponentTypeInfo() == typeid(typename ConvertOutputPixelTraits::ComponentType) &&
+                         (this->m_ImageIO->GetNumberOfComponents() == ConvertIOPixelTraits::GetNumberOfComponents()) && !m_FilenameHelper->BandRangeIsSet());
+
+  // Read the pixels directly from the file pages when possible
+  if (m_FilenameHelper->GetMemoryMapping() && !m_FilenameHelper->BandRangeIsSet() && this->m_ImageIO->CanStreamRead() && this->m_ImageIO->CanMapRead() &&
+      this->GenerateDataFromMapping(convert))
+  {
+    return;
+  }
+
+  // allocate the output buffer
+  output->Allocate();
+
+  if (!convert)
   {
     // Have the ImageIO read directly into the allocated buffer
-    this->m_ImageIO->Read(buffer);
+    this->m_ImageIO->Read(output->GetPixelContainer()->GetBufferPointer());
     return;
   }
   else // a type conversion is necessary
@@ -211,6 +224,66 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   }
 }
 
+template <class TOutputImage, class ConvertPixelTraits>
+bool ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateDataFromMapping(bool convert)
+{
+  typename TOutputImage::Pointer output = this->GetOutput();
+  ImageRegionType                region = output->GetBufferedRegion();
+
+  std::size_t                       lineStride = 0;
+  std::shared_ptr<MemoryMappedFile> mapping    = this->m_ImageIO->MapRead(lineStride);
+
+  const std::size_t nbColumns     = region.GetSize()[0];
+  const std::size_t nbLines       = region.GetNumberOfPixels() / nbColumns;
+  const std::size_t componentSize = this->m_ImageIO->GetComponentSize();
+  const std::size_t lineSize      = componentSize * this->m_ImageIO->GetNumberOfComponents() * nbColumns;
+  const bool        contiguous    = (nbLines == 1) || (lineStride == lineSize);
+  const bool        aligned       = (reinterpret_cast<std::uintptr_t>(mapping->GetData()) % componentSize == 0) && (lineStride % componentSize == 0);
+
+  // The conversion reads whole components from the mapped pages
+  if (convert && !aligned)
+  {
+    return false;
+  }
+
+  if (!convert && contiguous && aligned)
+  {
+    // The mapping is private: downstream filters may modify the buffer
+    // without altering the file
+    typedef MemoryMappedImageContainer<typename TOutputImage::PixelContainer> MappedContainerType;
+    typename MappedContainerType::Pointer container = MappedContainerType::New();
+    container->SetMapping(mapping, nbLines * lineSize / sizeof(OutputImagePixelType));
+    output->SetPixelContainer(container);
+    return true;
+  }
+
+  output->Allocate();
+
+  if (!convert)
+  {
+    char* outputData = reinterpret_cast<char*>(output->GetBufferPointer());
+    for (std::size_t line = 0; line < nbLines; ++line)
+    {
+      std::memcpy(outputData + line * lineSize, mapping->GetData() + line * lineStride, lineSize);
+    }
+  }
+  else
+  {
+    std::size_t outputLineLength = nbColumns;
+    if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+    {
+      outputLineLength *= output->GetNumberOfComponentsPerPixel();
+    }
+
+    OutputImagePixelType* outputData = output->GetBufferPointer();
+    for (std::size_t line = 0; line < nbLines; ++line)
+    {
+      this->DoConvertBuffer(mapping->GetData() + line * lineStride, outputData + line * outputLineLength, nbColumns);
+    }
+  }
+  return true;
+}
+
 template <class TOutputImage, class ConvertPixelTraits>
 void ImageFileReader<TOutputImage, ConvertPixelTraits>::EnlargeOutputRequestedRegion(itk::DataObject* output)
 {
@@ -502,7 +575,7 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformatio
 
   if (img_common != nullptr)
     {
-    img_common->SetImageMetadata(imd);
+    img_common->SetImageMetadata(std::move(imd));
     }
 
   output->SetLargestPossibleRegion(region);
@@ -664,8 +737,13 @@ std::vector<std::string> ImageFileReader<TOutputImage, ConvertPixelTraits>::GetO
 template <class TOutputImage, class ConvertPixelTraits>
 void ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void* inputData, size_t numberOfPixels)
 {
-  // get the pointer to the destination buffer
-  OutputImagePixelType* outputData = this->GetOutput()->GetPixelContainer()->GetBufferPointer();
+  // convert into the whole destination buffer
+  this->DoConvertBuffer(inputData, this->GetOutput()->GetPixelContainer()->GetBufferPointer(), numberOfPixels);
+}
+
+template <class TOutputImage, class ConvertPixelTraits>
+void ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void* inputData, OutputImagePixelType* outputData, size_t numberOfPixels)
+{
 
 // TODO:
 // Pass down the PixelType (RGB, VECTOR, etc.) so that any vector to
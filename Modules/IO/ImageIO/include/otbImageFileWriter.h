@@ -27,6 +27,8 @@
 #include "otbStreamingManager.h"
 #include "otbExtendedFilenameToWriterOptions.h"
 #include "itkFastMutexLock.h"
+#include "otbAsynchronousTaskQueue.h"
+#include "otbFusedTileExecutor.h"
 #include <string>
 #include "OTBImageIOExport.h"
 
@@ -50,6 +52,17 @@ namespace otb
  * ImageFileWriter will write directly the streaming buffer in the image file, so
  * that the output image never needs to be completely allocated
  *
+ * When AsynchronousWriting is on (or with the &streaming:async=on extended
+ * filename option), each piece is copied and written by a background thread
+ * while the upstream pipeline computes the next piece. At most
+ * NumberOfAsynchronousBuffers copies are pending at once, and they are
+ * accounted for when the number of pieces is computed from the available RAM.
+ *
+ * When FusedTileExecution is on, the chain of fusable filters (see
+ * FusableImageFilterInterface) at the end of the pipeline is executed
+ * tile by tile by a FusedTileExecutor for each piece: the intermediate
+ * images of the chain are only allocated for a few tiles per thread.
+ *
  * ImageFileWriter supports extended filenames, which allow controlling
  * some properties of the output file. See
  * http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for more
@@ -203,6 +216,26 @@ public:
 
   itkGetConstObjectMacro(FilenameHelper, FNameHelperType);
 
+  /** Set the asynchronous writing On or Off. When On, the write of a piece
+   *  overlaps the computation of the next one. */
+  itkSetMacro(AsynchronousWriting, bool);
+  itkGetConstReferenceMacro(AsynchronousWriting, bool);
+  itkBooleanMacro(AsynchronousWriting);
+
+  /** Maximum number of piece copies waiting to be written (default is 1,
+   *  i.e. double buffering with the pipeline output) */
+  itkSetMacro(NumberOfAsynchronousBuffers, unsigned int);
+  itkGetConstReferenceMacro(NumberOfAsynchronousBuffers, unsigned int);
+
+  /** Set the fused execution of the fusable filters of the input
+   *  pipeline On or Off (default is Off) */
+  itkSetMacro(FusedTileExecution, bool);
+  itkGetConstReferenceMacro(FusedTileExecution, bool);
+  itkBooleanMacro(FusedTileExecution);
+
+  /** Executor of the fused filters, to tune the tile size */
+  itkGetObjectMacro(FusedTileExecutor, FusedTileExecutor);
+
   /** This override doesn't return a const ref on the actual boolean */
   const bool& GetAbortGenerateData() const override;
 
@@ -219,6 +252,18 @@ protected:
   /** Prepare the streaming and write the output information on disk */
   void GenerateOutputInformation(void) override;
 
+  /** Write the ImageIO region from the buffer of the given image */
+  virtual void WriteImageRegion(const InputImageType* input);
+
+  /** Copy the ImageIO region of the input and queue its writing. The copy is
+   * made once the queue has a free slot, and the queued task only uses the
+   * copy, the ImageIO and values captured when it is queued. */
+  virtual void QueueImageRegion(AsynchronousTaskQueue& queue);
+
+  /** Set the pixel type and number of components of the ImageIO from the
+   * input, and resolve the band range into m_BandList */
+  virtual void SetupImageIOPixelType(const InputImageType* input);
+
 private:
   ImageFileWriter(const ImageFileWriter&) = delete;
   void operator=(const ImageFileWriter&) = delete;
@@ -268,6 +313,12 @@ private:
 
   FNameHelperType::Pointer m_FilenameHelper;
 
+  bool         m_AsynchronousWriting;
+  unsigned int m_NumberOfAsynchronousBuffers;
+
+  bool                       m_FusedTileExecution;
+  FusedTileExecutor::Pointer m_FusedTileExecutor;
+
   StreamingManagerPointerType m_StreamingManager;
 
   bool           m_IsObserving;
@@ -51,6 +51,8 @@
 #include "otbStringUtils.h"
 #include "otbUtils.h"
 
+#include <memory>
+
 namespace otb
 {
 
@@ -69,6 +71,10 @@ ImageFileWriter<TInputImage>::ImageFileWriter()
     m_UseInputMetaDataDictionary(false),
     m_WriteGeomFile(false),
     m_FilenameHelper(),
+    m_AsynchronousWriting(false),
+    m_NumberOfAsynchronousBuffers(1),
+    m_FusedTileExecution(false),
+    m_FusedTileExecutor(FusedTileExecutor::New()),
     m_IsObserving(true),
     m_ObserverID(0),
     m_IOComponents(0)
@@ -205,6 +211,17 @@ void ImageFileWriter<TInputImage>::PrintSelf(std::ostream& os, itk::Indent inden
   {
     os << indent << "FactorySpecifiedmageIO: Off\n";
   }
+
+  if (m_AsynchronousWriting)
+  {
+    os << indent << "AsynchronousWriting: On (" << m_NumberOfAsynchronousBuffers << " buffers)\n";
+  }
+  else
+  {
+    os << indent << "AsynchronousWriting: Off\n";
+  }
+
+  os << indent << "FusedTileExecution: " << (m_FusedTileExecution ? "On" : "Off") << "\n";
 }
 
 //---------------------------------------------------------
@@ -376,6 +393,11 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
     }
   }
 
+  if (m_FilenameHelper->StreamingAsyncIsSet())
+  {
+    this->SetAsynchronousWriting(m_FilenameHelper->GetStreamingAsync());
+  }
+
   /** Prepare ImageIO  : create ImageFactory */
 
   if (m_FileName == "")
@@ -514,6 +536,8 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
     otbLogMacro(Debug, << "Buffered region is the largest possible region, there is no need for streaming.");
     this->SetNumberOfDivisionsStrippedStreaming(1);
   }
+  // Pieces waiting to be written asynchronously take their share of the RAM
+  m_StreamingManager->SetNumberOfPendingBuffers(m_AsynchronousWriting ? m_NumberOfAsynchronousBuffers : 0);
   m_StreamingManager->PrepareStreaming(inputPtr, inputRegion);
   m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
 
@@ -617,14 +641,33 @@ void ImageFileWriter<TInputImage>::Update()
    */
   InputImageRegionType streamRegion;
 
+  // With a single piece there is nothing to overlap the write with
+  std::unique_ptr<AsynchronousTaskQueue> writeQueue;
+  if (m_AsynchronousWriting && m_NumberOfDivisions > 1)
+  {
+    otbLogMacro(Debug, << "Writing " << m_FileName << " asynchronously with " << m_NumberOfAsynchronousBuffers << " buffers");
+    writeQueue.reset(new AsynchronousTaskQueue(m_NumberOfAsynchronousBuffers));
+
+    // The pixel type and band mapping are the same for all pieces: they are
+    // resolved once here, before the I/O thread starts using m_ImageIO
+    this->SetupImageIOPixelType(inputPtr);
+  }
+
   for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
        m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
   {
     streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
 
     inputPtr->SetRequestedRegion(streamRegion);
-    inputPtr->PropagateRequestedRegion();
-    inputPtr->UpdateOutputData();
+
+    // Fall back on the regular pipeline update when the input is not
+    // produced by a chain of fusable filters
+    itk::ImageBase<2>* fusedImage = m_FusedTileExecution ? dynamic_cast<itk::ImageBase<2>*>(inputPtr.GetPointer()) : nullptr;
+    if (fusedImage == nullptr || !m_FusedTileExecutor->GenerateRegion(fusedImage, streamRegion))
+    {
+      inputPtr->PropagateRequestedRegion();
+      inputPtr->UpdateOutputData();
+    }
 
     // Write the whole image
     itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
@@ -635,10 +678,26 @@ void ImageFileWriter<TInputImage>::Update()
       ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
     }
     this->SetIORegion(ioRegion);
-    m_ImageIO->SetIORegion(m_IORegion);
 
-    // Start writing stream region in the image file
-    this->GenerateData();
+    if (writeQueue)
+    {
+      // The write happens on the I/O thread while the next piece is computed
+      this->QueueImageRegion(*writeQueue);
+    }
+    else
+    {
+      m_ImageIO->SetIORegion(m_IORegion);
+
+      // Start writing stream region in the image file
+      this->GenerateData();
+    }
+  }
+
+  if (writeQueue)
+  {
+    // Flush the pieces still waiting to be written
+    writeQueue->Wait();
+    writeQueue.reset();
   }
 
   /**
@@ -682,10 +741,98 @@ void ImageFileWriter<TInputImage>::Update()
  */
 template <class TInputImage>
 void ImageFileWriter<TInputImage>::GenerateData(void)
+{
+  this->WriteImageRegion(this->GetInput());
+}
+
+/**
+ *
+ */
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::QueueImageRegion(AsynchronousTaskQueue& queue)
 {
   const InputImageType* input = this->GetInput();
-  InputImagePointer     cacheImage;
 
+  InputImageRegionType ioRegion;
+  itk::ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(m_IORegion, ioRegion, m_ShiftOutputIndex);
+
+  if (!input->GetBufferedRegion().IsInside(ioRegion))
+  {
+    itk::ImageFileWriterException e(__FILE__, __LINE__);
+    std::ostringstream            msg;
+    msg << "Did not get requested region!" << std::endl;
+    msg << "Requested:" << std::endl;
+    msg << ioRegion;
+    msg << "Actual:" << std::endl;
+    msg << input->GetBufferedRegion();
+    e.SetDescription(msg.str());
+    e.SetLocation(ITK_LOCATION);
+    throw e;
+  }
+
+  // Wait for a free buffer before copying the piece: no more than
+  // NumberOfAsynchronousBuffers copies are alive at once, which is what the
+  // streaming manager accounted for when splitting the image.
+  queue.WaitForSlot();
+
+  // The upstream pipeline reuses its output buffer for the next piece, so the
+  // piece is copied into an image owned by the write task. Room is left for
+  // the band remapping when the band range has more bands than the input.
+  const bool expandBands = m_FilenameHelper->BandRangeIsSet() && (m_IOComponents < m_BandList.size());
+
+  InputImagePointer pieceImage = InputImageType::New();
+  pieceImage->CopyInformation(input);
+  if (expandBands)
+  {
+    pieceImage->SetNumberOfComponentsPerPixel(m_BandList.size());
+  }
+  pieceImage->SetBufferedRegion(ioRegion);
+  pieceImage->Allocate();
+  if (expandBands)
+  {
+    pieceImage->SetNumberOfComponentsPerPixel(m_IOComponents);
+  }
+
+  typedef itk::ImageRegionConstIterator<TInputImage> ConstIteratorType;
+  typedef itk::ImageRegionIterator<TInputImage>      IteratorType;
+
+  ConstIteratorType in(input, ioRegion);
+  IteratorType      out(pieceImage, ioRegion);
+
+  for (in.GoToBegin(), out.GoToBegin(); !in.IsAtEnd(); ++in, ++out)
+  {
+    out.Set(in.Get());
+  }
+
+  // The write task gets a copy of everything it needs, so that it never reads
+  // the writer state. Only the I/O thread uses m_ImageIO until the queue is
+  // flushed.
+  otb::ImageIOBase::Pointer imageIO        = m_ImageIO;
+  const itk::ImageIORegion  pieceIORegion  = m_IORegion;
+  const unsigned int        ioComponents   = m_IOComponents;
+  std::vector<unsigned int> bandList       = m_FilenameHelper->BandRangeIsSet() ? m_BandList : std::vector<unsigned int>();
+  const size_t              numberOfPixels = ioRegion.GetNumberOfPixels();
+
+  queue.Push([imageIO, pieceImage, pieceIORegion, ioComponents, bandList, numberOfPixels]() mutable {
+    imageIO->SetIORegion(pieceIORegion);
+    void* dataPtr = pieceImage->GetBufferPointer();
+    if (!bandList.empty())
+    {
+      // The previous piece left the number of components of the band range
+      imageIO->SetNumberOfComponents(ioComponents);
+      imageIO->DoMapBuffer(dataPtr, numberOfPixels, bandList);
+      imageIO->SetNumberOfComponents(bandList.size());
+    }
+    imageIO->Write(dataPtr);
+  });
+}
+
+/**
+ *
+ */
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::SetupImageIOPixelType(const InputImageType* input)
+{
   // Make sure that the image is the right type and no more than
   // four components.
   typedef typename InputImageType::PixelType ImagePixelType;
@@ -716,6 +863,17 @@ void ImageFileWriter<TInputImage>::GenerateData(void)
     // Set the pixel and component type; the number of components.
     m_ImageIO->SetPixelTypeInfo(typeid(ImagePixelType));
   }
+}
+
+/**
+ *
+ */
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::WriteImageRegion(const InputImageType* input)
+{
+  InputImagePointer cacheImage;
+
+  this->SetupImageIOPixelType(input);
 
   // Setup the image IO for writing.
   //
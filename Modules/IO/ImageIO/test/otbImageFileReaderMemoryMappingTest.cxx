@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "otbMemoryMappedImageContainer.h"
+
+namespace
+{
+
+// Read a region of the file, with or without memory mapping
+template <class TImage>
+typename TImage::Pointer ReadRegion(const std::string& fileName, const typename TImage::RegionType& region, bool mapping)
+{
+  typedef otb::ImageFileReader<TImage> ReaderType;
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(mapping ? fileName + "?&mmap=true" : fileName);
+  reader->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->GetOutput()->Update();
+
+  typename TImage::Pointer image = reader->GetOutput();
+  image->DisconnectPipeline();
+  return image;
+}
+
+// expectZeroCopy is 1 if the region must be read without copy, 0 if it
+// must not, and -1 if it depends on the file layout
+template <class TImage>
+bool CheckRegion(const std::string& fileName, const typename TImage::RegionType& region, int expectZeroCopy)
+{
+  typename TImage::Pointer reference = ReadRegion<TImage>(fileName, region, false);
+  typename TImage::Pointer mapped    = ReadRegion<TImage>(fileName, region, true);
+
+  typedef otb::MemoryMappedImageContainer<typename TImage::PixelContainer> MappedContainerType;
+  const bool zeroCopy = dynamic_cast<MappedContainerType*>(mapped->GetPixelContainer()) != nullptr;
+  if (expectZeroCopy >= 0 && zeroCopy != (expectZeroCopy == 1))
+  {
+    std::cerr << "Region " << region << " of " << fileName << (zeroCopy ? " was" : " was not") << " read without copy" << std::endl;
+    return false;
+  }
+
+  if (mapped->GetBufferedRegion() != region || mapped->GetNumberOfComponentsPerPixel() != reference->GetNumberOfComponentsPerPixel())
+  {
+    std::cerr << "Wrong buffered region " << mapped->GetBufferedRegion() << " for region " << region << " of " << fileName << std::endl;
+    return false;
+  }
+
+  itk::ImageRegionConstIterator<TImage> refIt(reference, region);
+  itk::ImageRegionConstIterator<TImage> mapIt(mapped, region);
+  for (; !refIt.IsAtEnd(); ++refIt, ++mapIt)
+  {
+    if (refIt.Get() != mapIt.Get())
+    {
+      std::cerr << "Pixel " << refIt.GetIndex() << " of " << fileName << " is " << mapIt.Get() << " instead of " << refIt.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int otbImageFileReaderMemoryMappingTest(int itkNotUsed(argc), char* argv[])
+{
+  // argv[1] is the file to write, with its creation options
+  // argv[2] is 1 if the pixels of the file are known to be contiguous,
+  // and 0 if it depends on the writing (GeoTIFF strips for instance)
+  const std::string outputFilename = argv[1];
+  const int         contiguous     = atoi(argv[2]) ? 1 : -1;
+
+  typedef otb::VectorImage<unsigned short, 2> ImageType;
+  typedef otb::VectorImage<float, 2>          FloatImageType;
+
+  ImageType::RegionType largest;
+  largest.SetIndex(0, 0);
+  largest.SetIndex(1, 0);
+  largest.SetSize(0, 101);
+  largest.SetSize(1, 67);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(largest);
+  image->SetNumberOfComponentsPerPixel(4);
+  image->Allocate();
+
+  ImageType::PixelType pixel(4);
+  for (itk::ImageRegionIterator<ImageType> it(image, largest); !it.IsAtEnd(); ++it)
+  {
+    for (unsigned int band = 0; band < 4; ++band)
+    {
+      pixel[band] = static_cast<unsigned short>(it.GetIndex()[0] * 257 + it.GetIndex()[1] * 31 + band * 4099);
+    }
+    it.Set(pixel);
+  }
+
+  typedef otb::ImageFileWriter<ImageType> WriterType;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(outputFilename);
+  writer->SetInput(image);
+  writer->Update();
+
+  // Strip the creation options from the file name
+  const std::string fileName = outputFilename.substr(0, outputFilename.find('?'));
+
+  // Full width regions are contiguous in the file
+  ImageType::RegionType lines;
+  lines.SetIndex(0, 0);
+  lines.SetIndex(1, 13);
+  lines.SetSize(0, 101);
+  lines.SetSize(1, 20);
+
+  ImageType::RegionType tile;
+  tile.SetIndex(0, 17);
+  tile.SetIndex(1, 5);
+  tile.SetSize(0, 33);
+  tile.SetSize(1, 41);
+
+  bool ok = CheckRegion<ImageType>(fileName, largest, contiguous);
+  ok      = CheckRegion<ImageType>(fileName, lines, contiguous) && ok;
+  ok      = CheckRegion<ImageType>(fileName, tile, 0) && ok;
+
+  // Pixels are converted from the mapped pages
+  ok = CheckRegion<FloatImageType>(fileName, largest, 0) && ok;
+  ok = CheckRegion<FloatImageType>(fileName, tile, 0) && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
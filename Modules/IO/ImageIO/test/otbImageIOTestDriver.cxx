@@ -149,6 +149,7 @@ void RegisterTests()
   REGISTER_TEST(otbImageFileWriterTest);
   REGISTER_TEST(otbCompareWritingComplexImageTest);
   REGISTER_TEST(otbImageFileReaderOptBandTest);
+  REGISTER_TEST(otbImageFileReaderMemoryMappingTest);
   REGISTER_TEST(otbImageFileWriterOptBandTest);
   REGISTER_TEST(otbMultiImageFileWriterTest);
 }
@@ -94,8 +94,8 @@ void KmzProductWriter<TInputImage>::Write()
 
   // Do some checks, If no metadata nor projection ref available,
   // input is not usable.
-  if (!(m_VectorImage->GetImageMetadata().HasSensorGeometry()
-        || m_VectorImage->GetImageMetadata().HasProjectedGeometry()))
+  if (!(this->GetInput()->GetImageMetadata().HasSensorGeometry()
+        || this->GetInput()->GetImageMetadata().HasProjectedGeometry()))
   {
     itkExceptionMacro(<< "The input image have empty keyword list, please use an image with metadata information");
   }
@@ -412,8 +412,9 @@ void KmzProductWriter<TInputImage>::Tiling()
 
         /** TODO : Generate KML for this tile */
         // Search Lat/Lon box
+        const InputImageType* resampleVectorImage = m_ResampleVectorImage;
         m_Transform = TransformType::New();
-        m_Transform->SetInputImageMetadata(&(m_ResampleVectorImage->GetImageMetadata()));
+        m_Transform->SetInputImageMetadata(&(resampleVectorImage->GetImageMetadata()));
         m_Transform->SetInputProjectionRef(m_VectorImage->GetProjectionRef());
         m_Transform->SetOutputProjectionRef(wgsRef);
         m_Transform->InstantiateTransform();
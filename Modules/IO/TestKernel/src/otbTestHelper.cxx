@@ -1672,8 +1672,10 @@ int TestHelper::RegressionTestMetaData(const char* testImageFilename, const char
     }
   }
   
-  const auto & baselineImageMetadata = blImPtr->GetImageMetadata();
-  const auto & testImageMetadata = testImPtr->GetImageMetadata();
+  const ImageType* blIm   = blImPtr;
+  const ImageType* testIm = testImPtr;
+  const auto & baselineImageMetadata = blIm->GetImageMetadata();
+  const auto & testImageMetadata = testIm->GetImageMetadata();
 
   // Compare string keys (strict equality)
   // Don't test OTB_VERSION, as it changes with the version of OTB used
@@ -24,6 +24,8 @@
 #include "otbImageClassificationFilter.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
+#include "otbMacro.h"
+#include "otbStopwatch.h"
 
 namespace otb
 {
@@ -277,7 +279,13 @@ void ImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::BatchThre
   if (computeProbaMap)
     probas = ProbaListSampleType::New();
   // This call is threadsafe
-  labels = m_Model->PredictBatch(samples, confidences, probas);
+  Stopwatch chrono = Stopwatch::StartNew();
+  labels           = m_Model->PredictBatch(samples, confidences, probas);
+  chrono.Stop();
+
+  const double seconds = chrono.GetElapsedMilliseconds() / 1000.;
+  otbMsgDevMacro(<< m_Model->GetNameOfClass() << ": " << samples->Size() << " samples predicted in " << chrono.GetElapsedMilliseconds() << " ms ("
+                 << (seconds > 0. ? samples->Size() / seconds : 0.) << " samples/s)");
 
   // Set the output values
   ConfidenceMapIteratorType confidenceIt;
@@ -128,8 +128,8 @@ public:
     * \param quality A pointer to the list were to store
     * quality value, or NULL
     * \return The predicted labels
-    * Note that this method will be multi-threaded if OTB is built
-    * with OpenMP.
+    * Note that this method is multi-threaded with the OTB thread
+    * pool, unless the model already multi-threads DoPredictBatch().
      */
   typename TargetListSampleType::Pointer PredictBatch(const InputListSampleType* input, ConfidenceListSampleType* quality = nullptr,
                                                       ProbaListSampleType* proba = nullptr) const;
@@ -21,13 +21,8 @@
 #ifndef otbMachineLearningModel_hxx
 #define otbMachineLearningModel_hxx
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
-
 #include "otbMachineLearningModel.h"
-
-#include "itkMultiThreader.h"
+#include "otbThreadPool.h"
 
 namespace otb
 {
@@ -94,33 +89,11 @@ MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::PredictBatch(
   }
   else
   {
-#ifdef _OPENMP
-    // OpenMP threading here
-    unsigned int nb_threads(0), threadId(0), nb_batches(0);
-
-#pragma omp parallel shared(nb_threads, nb_batches) private(threadId)
-    {
-      // Get number of threads configured with ITK
-      omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
-      nb_threads = omp_get_num_threads();
-      threadId   = omp_get_thread_num();
-      nb_batches = std::min(nb_threads, (unsigned int)input->Size());
-      // Ensure that we do not spawn unnecessary threads
-      if (threadId < nb_batches)
-      {
-        unsigned int batch_size  = ((unsigned int)input->Size() / nb_batches);
-        unsigned int batch_start = threadId * batch_size;
-        if (threadId == nb_threads - 1)
-        {
-          batch_size += input->Size() % nb_batches;
-        }
-
-        this->DoPredictBatch(input, batch_start, batch_size, targets, quality, proba);
-      }
-    }
-#else
-    this->DoPredictBatch(input, 0, input->Size(), targets, quality, proba);
-#endif
+    // Batches are run on the OTB thread pool: idle threads steal the
+    // remaining batches of the busy ones
+    ThreadPool::GetInstance().ParallelFor(0, input->Size(), [&](std::size_t batchStart, std::size_t batchEnd) {
+      this->DoPredictBatch(input, batchStart, batchEnd - batchStart, targets, quality, proba);
+    });
     return targets;
   }
 }
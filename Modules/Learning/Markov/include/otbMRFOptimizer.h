@@ -71,10 +71,32 @@ public:
 
   virtual bool Compute(double deltaEnergy) = 0;
 
+  /** Set the seed of the random generator used by the optimizer, if any */
+  virtual void InitializeSeed(int itkNotUsed(seed))
+  {
+  }
+
+  /** Create a copy of the optimizer, used by concurrent updates */
+  itkCloneMacro(Self);
+
 protected:
   MRFOptimizer() : m_NumberOfParameters(1), m_Parameters(1)
   {
   }
+
+  itk::LightObject::Pointer InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    Self*                     clone = dynamic_cast<Self*>(loPtr.GetPointer());
+    if (clone == nullptr)
+    {
+      itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+    }
+    clone->m_NumberOfParameters = m_NumberOfParameters;
+    clone->m_Parameters         = m_Parameters;
+    return loPtr;
+  }
+
   ~MRFOptimizer() override
   {
   }
@@ -81,6 +81,15 @@ public:
 
   virtual int Compute(const InputImageNeighborhoodIterator& itData, const LabelledImageNeighborhoodIterator& itRegul) = 0;
 
+  /** Set the seed of the random generator used by the sampler, if any */
+  virtual void InitializeSeed(int itkNotUsed(seed))
+  {
+  }
+
+  /** Create a copy of the sampler, sharing its energies, used by
+   * concurrent updates */
+  itkCloneMacro(Self);
+
 protected:
   unsigned int m_NumberOfClasses;
   double       m_EnergyBefore;
@@ -104,6 +113,21 @@ protected:
   ~MRFSampler() override
   {
   }
+
+  itk::LightObject::Pointer InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    Self*                     clone = dynamic_cast<Self*>(loPtr.GetPointer());
+    if (clone == nullptr)
+    {
+      itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+    }
+    clone->SetNumberOfClasses(m_NumberOfClasses);
+    clone->m_Lambda               = m_Lambda;
+    clone->m_EnergyRegularization = m_EnergyRegularization;
+    clone->m_EnergyFidelity       = m_EnergyFidelity;
+    return loPtr;
+  }
 };
 }
 
@@ -80,7 +80,7 @@ public:
   }
 
   /** Methods to cancel random effects.*/
-  void InitializeSeed(int seed)
+  void InitializeSeed(int seed) override
   {
     m_Generator->SetSeed(seed);
   }
@@ -100,6 +100,19 @@ protected:
   {
   }
 
+  /** The clones use their own random generator, to be used concurrently */
+  itk::LightObject::Pointer InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    Self*                     clone = dynamic_cast<Self*>(loPtr.GetPointer());
+    if (clone == nullptr)
+    {
+      itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+    }
+    clone->m_Generator = RandomGeneratorType::New();
+    return loPtr;
+  }
+
 private:
   RandomGeneratorType::Pointer m_Generator;
 };
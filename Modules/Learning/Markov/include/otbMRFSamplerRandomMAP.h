@@ -140,7 +140,7 @@ public:
   }
 
   /** Methods to cancel random effects.*/
-  void InitializeSeed(int seed)
+  void InitializeSeed(int seed) override
   {
     m_Generator->SetSeed(seed);
   }
@@ -164,6 +164,19 @@ protected:
       free(m_RepartitionFunction);
   }
 
+  /** The clones use their own random generator, to be used concurrently */
+  itk::LightObject::Pointer InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    Self*                     clone = dynamic_cast<Self*>(loPtr.GetPointer());
+    if (clone == nullptr)
+    {
+      itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+    }
+    clone->m_Generator = RandomGeneratorType::New();
+    return loPtr;
+  }
+
 private:
   double*                      m_RepartitionFunction;
   double*                      m_Energy;
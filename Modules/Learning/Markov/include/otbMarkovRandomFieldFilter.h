@@ -36,6 +36,8 @@
 #include "otbMRFOptimizer.h"
 #include "otbMRFSampler.h"
 
+#include <vector>
+
 namespace otb
 {
 /**
@@ -69,6 +71,30 @@ namespace otb
  *   markovFilter->SetSampler(sampler);
  * \endcode
  *
+ * By default, the pixels are updated one after the other in raster
+ * order, by a single thread. With CheckerboardUpdateOn(), the pixels are
+ * split in (radius + 1)^Dimension colour classes, the generalization of
+ * the red-black ordering to the square neighborhoods used by the
+ * energies: the neighborhood of a pixel contains no other pixel of its
+ * class. The classes are updated one after the other, and the pixels of
+ * a class are updated concurrently by all the threads. The sampler and
+ * the optimizer are cloned for each thread, the clones using their own
+ * random generators. With a deterministic sampler and optimizer (e.g.
+ * MAP and ICM), the result does not depend on the number of threads.
+ *
+ * The filter requires the whole image by default. With StreamingOn(),
+ * it only processes the requested region padded by StreamingMargin
+ * pixels, so that it can be used in a streamed pipeline. The margin
+ * bounds the influence of the block borders: with the checkerboard
+ * update, a pixel only depends on the pixels within the number of
+ * iterations times the number of colour classes times the radius, so that the
+ * streamed result is exact with a large enough margin and a training
+ * image to start from.
+ *
+ * The energy variation of each iteration and the number of iterations
+ * per second of the last update can be retrieved to monitor the
+ * convergence.
+ *
  *
  * \ingroup Markov
  *
@@ -234,6 +260,28 @@ public:
   itkSetMacro(Lambda, double);
   itkGetMacro(Lambda, double);
 
+  /** Update the pixels concurrently, colour class by colour class,
+   * instead of in raster order (default is false) */
+  itkSetMacro(CheckerboardUpdate, bool);
+  itkGetConstMacro(CheckerboardUpdate, bool);
+  itkBooleanMacro(CheckerboardUpdate);
+
+  /** Process the requested region with a margin instead of the whole
+   * image (default is false) */
+  itkSetMacro(Streaming, bool);
+  itkGetConstMacro(Streaming, bool);
+  itkBooleanMacro(Streaming);
+
+  /** Set/Get the margin around the requested region in streaming mode */
+  itkSetMacro(StreamingMargin, unsigned int);
+  itkGetConstMacro(StreamingMargin, unsigned int);
+
+  /** Get the energy variation of each iteration of the last update */
+  itkGetConstReferenceMacro(DeltaEnergies, std::vector<double>);
+
+  /** Get the number of iterations per second of the last update */
+  itkGetConstMacro(IterationsPerSecond, double);
+
   /** Set the neighborhood radius */
   void SetNeighborhoodRadius(const NeighborhoodRadiusType&);
 
@@ -313,6 +361,9 @@ protected:
 
   virtual void ApplyMarkovRandomFieldFilter();
 
+  /** Region of the labels optimized by GenerateData() */
+  LabelledImageRegionType GetProcessedRegion() const;
+
   void GenerateData() override;
   void GenerateInputRequestedRegion() override;
   void EnlargeOutputRequestedRegion(itk::DataObject*) override;
@@ -361,7 +412,42 @@ protected:
 
   virtual void MinimizeOnce();
 
+  /** Update all the colour classes once, concurrently */
+  virtual void CheckerboardMinimizeOnce();
+
+  /** Update the pixels of a colour class in a part of the image */
+  void ThreadedMinimizeOnce(const LabelledImageRegionType& region, unsigned int color, itk::ThreadIdType threadId);
+
+  /** Colour class of a pixel in the checkerboard update */
+  unsigned int GetColor(const LabelledImageIndexType& index) const;
+
+  /** Labels being optimized: the output, or a padded image in streaming mode */
+  LabelledImagePointer m_WorkingImage;
+
 private:
+  /** Clone the sampler and the optimizer for each thread */
+  void PrepareCheckerboardUpdate();
+
+  static ITK_THREAD_RETURN_TYPE CheckerboardThreaderCallback(void* arg);
+
+  struct CheckerboardThreadStruct
+  {
+    Pointer      Filter;
+    unsigned int Color;
+  };
+
+  bool         m_CheckerboardUpdate;
+  bool         m_Streaming;
+  unsigned int m_StreamingMargin;
+  unsigned int m_NumberOfColors;
+
+  std::vector<SamplerPointer>   m_ThreadSamplers;
+  std::vector<OptimizerPointer> m_ThreadOptimizers;
+  std::vector<int>              m_ThreadErrorCounter;
+  std::vector<double>           m_ThreadDeltaEnergy;
+
+  std::vector<double> m_DeltaEnergies;
+  double              m_IterationsPerSecond;
 }; // class MarkovRandomFieldFilter
 
 } // namespace otb
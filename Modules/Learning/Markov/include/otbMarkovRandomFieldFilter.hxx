@@ -22,6 +22,9 @@
 #ifndef otbMarkovRandomFieldFilter_hxx
 #define otbMarkovRandomFieldFilter_hxx
 #include "otbMarkovRandomFieldFilter.h"
+#include "otbStopwatch.h"
+
+#include <algorithm>
 
 namespace otb
 {
@@ -39,7 +42,12 @@ MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MarkovRandomFieldFilter(
     m_NumberOfIterations(0),
     m_Lambda(1.0),
     m_ExternalClassificationSet(false),
-    m_StopCondition(MaximumNumberOfIterations)
+    m_StopCondition(MaximumNumberOfIterations),
+    m_CheckerboardUpdate(false),
+    m_Streaming(false),
+    m_StreamingMargin(16),
+    m_NumberOfColors(1),
+    m_IterationsPerSecond(0.)
 {
   m_Generator = RandomGeneratorType::GetInstance();
   m_Generator->SetSeed();
@@ -52,6 +60,7 @@ MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MarkovRandomFieldFilter(
     throw itk::ExceptionObject(__FILE__, __LINE__, msg.str(), ITK_LOCATION);
   }
   m_InputImageNeighborhoodRadius.Fill(m_NeighborhoodRadius);
+  m_LabelledImageNeighborhoodRadius.Fill(m_NeighborhoodRadius);
   //     m_MRFNeighborhoodWeight.resize(0);
   //     m_NeighborInfluence.resize(0);
   //     m_DummyVector.resize(0);
@@ -101,6 +110,10 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::PrintSelf(std::ostr
   os << indent << " Number of iterations: " << m_NumberOfIterations << std::endl;
 
   os << indent << " Lambda: " << m_Lambda << std::endl;
+
+  os << indent << " Checkerboard update: " << m_CheckerboardUpdate << std::endl;
+
+  os << indent << " Streaming: " << m_Streaming << " (margin: " << m_StreamingMargin << ")" << std::endl;
 } // end PrintSelf
 
 /**
@@ -113,7 +126,34 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GenerateInputReques
   // to be at the size of the output requested region
   InputImagePointer  inputPtr  = const_cast<InputImageType*>(this->GetInput());
   OutputImagePointer outputPtr = this->GetOutput();
-  inputPtr->SetRequestedRegion(outputPtr->GetRequestedRegion());
+
+  if (!m_Streaming)
+  {
+    inputPtr->SetRequestedRegion(outputPtr->GetRequestedRegion());
+    return;
+  }
+
+  // In streaming mode, the requested region is processed with a margin
+  const LabelledImageRegionType region = this->GetProcessedRegion();
+  inputPtr->SetRequestedRegion(region);
+  if (m_ExternalClassificationSet)
+  {
+    TrainingImageType* trainingPtr = const_cast<TrainingImageType*>(this->GetTrainingInput());
+    trainingPtr->SetRequestedRegion(region);
+  }
+}
+
+template <class TInputImage, class TClassifiedImage>
+typename MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::LabelledImageRegionType
+MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GetProcessedRegion() const
+{
+  LabelledImageRegionType region = this->GetOutput()->GetRequestedRegion();
+  if (m_Streaming)
+  {
+    region.PadByRadius(m_StreamingMargin);
+    region.Crop(this->GetOutput()->GetLargestPossibleRegion());
+  }
+  return region;
 }
 
 /**
@@ -123,7 +163,11 @@ template <class TInputImage, class TClassifiedImage>
 void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::EnlargeOutputRequestedRegion(itk::DataObject* output)
 {
   // this filter requires the all of the output image to be in
-  // the buffer
+  // the buffer, unless it is streamed
+  if (m_Streaming)
+  {
+    return;
+  }
   TClassifiedImage* imgData;
   imgData = dynamic_cast<TClassifiedImage*>(output);
   imgData->SetRequestedRegionToLargestPossibleRegion();
@@ -155,6 +199,20 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GenerateData()
   // Run the Markov random field
   this->ApplyMarkovRandomFieldFilter();
 
+  // Keep the requested region of the labels optimized with a margin
+  if (m_WorkingImage != this->GetOutput())
+  {
+    LabelledImageRegionConstIterator workingIt(m_WorkingImage, this->GetOutput()->GetRequestedRegion());
+    LabelledImageRegionIterator      outputIt(this->GetOutput(), this->GetOutput()->GetRequestedRegion());
+    for (workingIt.GoToBegin(), outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++workingIt, ++outputIt)
+    {
+      outputIt.Set(workingIt.Get());
+    }
+  }
+  m_WorkingImage = nullptr;
+  m_ThreadSamplers.clear();
+  m_ThreadOptimizers.clear();
+
 } // end GenerateData
 
 /**
@@ -218,14 +276,27 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::Allocate()
   outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
   outputPtr->Allocate();
 
+  // In streaming mode, the labels are optimized on a padded region
+  if (m_Streaming)
+  {
+    m_WorkingImage = LabelledImageType::New();
+    m_WorkingImage->CopyInformation(outputPtr);
+    m_WorkingImage->SetRegions(this->GetProcessedRegion());
+    m_WorkingImage->Allocate();
+  }
+  else
+  {
+    m_WorkingImage = outputPtr;
+  }
+
   // Copy input data in the output buffer memory or
   // initialize to random values if not set
-  LabelledImageRegionIterator outImageIt(outputPtr, outputPtr->GetRequestedRegion());
+  LabelledImageRegionIterator outImageIt(m_WorkingImage, m_WorkingImage->GetBufferedRegion());
 
   if (m_ExternalClassificationSet)
   {
     typename TrainingImageType::ConstPointer trainingImage = this->GetTrainingInput();
-    LabelledImageRegionConstIterator         trainingImageIt(trainingImage, outputPtr->GetRequestedRegion());
+    LabelledImageRegionConstIterator         trainingImageIt(trainingImage, m_WorkingImage->GetBufferedRegion());
 
     while (!outImageIt.IsAtEnd())
     {
@@ -258,7 +329,7 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::Initialize()
 
   m_ImageDeltaEnergy = 0.0;
 
-  InputImageSizeType inputImageSize = this->GetInput()->GetBufferedRegion().GetSize();
+  InputImageSizeType inputImageSize = m_WorkingImage->GetBufferedRegion().GetSize();
 
   //---------------------------------------------------------------------
   // Get the number of valid pixels in the output MRF image
@@ -300,6 +371,43 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::Initialize()
   m_Sampler->SetEnergyRegularization(m_EnergyRegularization);
   m_Sampler->SetEnergyFidelity(m_EnergyFidelity);
   m_Sampler->SetNumberOfClasses(m_NumberOfClasses);
+
+  m_NumberOfColors = 1;
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    m_NumberOfColors *= m_LabelledImageNeighborhoodRadius[i] + 1;
+  }
+}
+
+/**
+* Clone the sampler and the optimizer for each thread
+*/
+template <class TInputImage, class TClassifiedImage>
+void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::PrepareCheckerboardUpdate()
+{
+  const unsigned int nbThreads = this->GetNumberOfThreads();
+
+  // Seeds are drawn first, as creating the clones may reset the global generator
+  std::vector<int> seeds(2 * nbThreads);
+  for (auto& seed : seeds)
+  {
+    seed = static_cast<int>(m_Generator->GetIntegerVariate() >> 1);
+  }
+
+  m_ThreadSamplers.resize(nbThreads);
+  m_ThreadOptimizers.resize(nbThreads);
+  for (unsigned int i = 0; i < nbThreads; ++i)
+  {
+    m_ThreadSamplers[i]   = m_Sampler->Clone();
+    m_ThreadOptimizers[i] = m_Optimizer->Clone();
+  }
+  for (unsigned int i = 0; i < nbThreads; ++i)
+  {
+    m_ThreadSamplers[i]->InitializeSeed(seeds[2 * i]);
+    m_ThreadOptimizers[i]->InitializeSeed(seeds[2 * i + 1]);
+  }
+  m_ThreadErrorCounter.assign(nbThreads, 0);
+  m_ThreadDeltaEnergy.assign(nbThreads, 0.);
 }
 
 /**
@@ -314,18 +422,39 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::ApplyMarkovRandomFi
 
   m_NumberOfIterations = 0;
   m_ErrorCounter       = m_TotalNumberOfValidPixelsInOutputImage;
+  m_DeltaEnergies.clear();
+
+  if (m_CheckerboardUpdate)
+  {
+    this->PrepareCheckerboardUpdate();
+  }
 
+  Stopwatch chrono = Stopwatch::StartNew();
   while ((m_NumberOfIterations < m_MaximumNumberOfIterations) && (m_ErrorCounter >= maxNumPixelError))
   {
     otbMsgDevMacro(<< "Iteration No." << m_NumberOfIterations);
 
-    this->MinimizeOnce();
+    const double energyBefore = m_ImageDeltaEnergy;
+    if (m_CheckerboardUpdate)
+    {
+      this->CheckerboardMinimizeOnce();
+    }
+    else
+    {
+      this->MinimizeOnce();
+    }
+    m_DeltaEnergies.push_back(m_ImageDeltaEnergy - energyBefore);
 
     otbMsgDevMacro(<< "m_ErrorCounter/m_TotalNumberOfPixelsInInputImage: " << m_ErrorCounter / ((double)(m_TotalNumberOfPixelsInInputImage)));
     otbMsgDevMacro(<< "m_ImageDeltaEnergy: " << m_ImageDeltaEnergy);
 
     ++m_NumberOfIterations;
   }
+  chrono.Stop();
+
+  const double seconds  = chrono.GetElapsedMilliseconds() / 1000.;
+  m_IterationsPerSecond = seconds > 0. ? m_NumberOfIterations / seconds : 0.;
+  otbMsgDevMacro(<< "Iterations per second: " << m_IterationsPerSecond);
 
   otbMsgDevMacro(<< "m_NumberOfIterations: " << m_NumberOfIterations);
   otbMsgDevMacro(<< "m_MaximumNumberOfIterations: " << m_MaximumNumberOfIterations);
@@ -350,8 +479,9 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::ApplyMarkovRandomFi
 template <class TInputImage, class TClassifiedImage>
 void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MinimizeOnce()
 {
-  LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, this->GetOutput(), this->GetOutput()->GetLargestPossibleRegion());
-  InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), this->GetInput()->GetLargestPossibleRegion());
+  const LabelledImageRegionType     region = m_WorkingImage->GetBufferedRegion();
+  LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, m_WorkingImage, region);
+  InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), region);
   m_ErrorCounter = 0;
 
   for (labelledIterator.GoToBegin(), dataIterator.GoToBegin(); !labelledIterator.IsAtEnd(); ++labelledIterator, ++dataIterator)
@@ -371,6 +501,108 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MinimizeOnce()
   }
 }
 
+/**
+*Update all the colour classes once, the pixels of a class being
+*updated concurrently
+*/
+template <class TInputImage, class TClassifiedImage>
+void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::CheckerboardMinimizeOnce()
+{
+  std::fill(m_ThreadErrorCounter.begin(), m_ThreadErrorCounter.end(), 0);
+  std::fill(m_ThreadDeltaEnergy.begin(), m_ThreadDeltaEnergy.end(), 0.);
+
+  CheckerboardThreadStruct str;
+  str.Filter = this;
+
+  this->GetMultiThreader()->SetNumberOfThreads(m_ThreadSamplers.size());
+  for (unsigned int color = 0; color < m_NumberOfColors; ++color)
+  {
+    // All the pixels of a class are updated before the next class
+    str.Color = color;
+    this->GetMultiThreader()->SetSingleMethod(this->CheckerboardThreaderCallback, &str);
+    this->GetMultiThreader()->SingleMethodExecute();
+  }
+
+  m_ErrorCounter = 0;
+  for (unsigned int i = 0; i < m_ThreadSamplers.size(); ++i)
+  {
+    m_ErrorCounter += m_ThreadErrorCounter[i];
+    m_ImageDeltaEnergy += m_ThreadDeltaEnergy[i];
+  }
+}
+
+template <class TInputImage, class TClassifiedImage>
+ITK_THREAD_RETURN_TYPE MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::CheckerboardThreaderCallback(void* arg)
+{
+  CheckerboardThreadStruct* str = (CheckerboardThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+
+  itk::ThreadIdType threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  itk::ThreadIdType threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+
+  LabelledImageRegionType region = str->Filter->m_WorkingImage->GetBufferedRegion();
+
+  const unsigned int total = str->Filter->GetImageRegionSplitter()->GetNumberOfSplits(region, threadCount);
+  if (threadId < total)
+  {
+    str->Filter->GetImageRegionSplitter()->GetSplit(threadId, total, region);
+    str->Filter->ThreadedMinimizeOnce(region, str->Color, threadId);
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage, class TClassifiedImage>
+void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::ThreadedMinimizeOnce(const LabelledImageRegionType& region, unsigned int color,
+                                                                                  itk::ThreadIdType threadId)
+{
+  // Neighbors outside of the region are read from the whole buffer
+  LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, m_WorkingImage, region);
+  InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), region);
+
+  SamplerType*   sampler      = m_ThreadSamplers[threadId];
+  OptimizerType* optimizer    = m_ThreadOptimizers[threadId];
+  int            errorCounter = 0;
+  double         deltaEnergy  = 0.;
+
+  for (labelledIterator.GoToBegin(), dataIterator.GoToBegin(); !labelledIterator.IsAtEnd(); ++labelledIterator, ++dataIterator)
+  {
+    if (this->GetColor(labelledIterator.GetIndex()) != color)
+    {
+      continue;
+    }
+    sampler->Compute(dataIterator, labelledIterator);
+    if (optimizer->Compute(sampler->GetDeltaEnergy()))
+    {
+      labelledIterator.SetCenterPixel(sampler->GetValue());
+      ++errorCounter;
+      deltaEnergy += sampler->GetDeltaEnergy();
+    }
+  }
+
+  m_ThreadErrorCounter[threadId] += errorCounter;
+  m_ThreadDeltaEnergy[threadId] += deltaEnergy;
+}
+
+template <class TInputImage, class TClassifiedImage>
+unsigned int MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GetColor(const LabelledImageIndexType& index) const
+{
+  // Pixels of the same class are at least radius + 1 apart along one
+  // dimension. The class only depends on the absolute index, so that
+  // streamed blocks use the same classes.
+  unsigned int color = 0;
+  for (int i = ClassifiedImageDimension - 1; i >= 0; --i)
+  {
+    const IndexValueType period = m_LabelledImageNeighborhoodRadius[i] + 1;
+    IndexValueType       rank   = index[i] % period;
+    if (rank < 0)
+    {
+      rank += period;
+    }
+    color = color * period + rank;
+  }
+  return color;
+}
+
 } // namespace otb
 
 #endif
@@ -30,6 +30,13 @@
 #include "otbMRFEnergyGaussianClassification.h"
 #include "otbMRFOptimizerMetropolis.h"
 #include "otbMRFSamplerRandom.h"
+#include "otbMRFOptimizerICM.h"
+#include "otbMRFSamplerMAP.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+#include <algorithm>
+#include <vector>
 
 int otbMarkovRandomFieldFilter(int itkNotUsed(argc), char* argv[])
 {
@@ -109,3 +116,160 @@ int otbMarkovRandomFieldFilter(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbMarkovRandomFieldFilterCheckerboard(int itkNotUsed(argc), char* argv[])
+{
+  const unsigned int Dimension = 2;
+
+  typedef double        InternalPixelType;
+  typedef unsigned char LabelledPixelType;
+  typedef otb::Image<InternalPixelType, Dimension> InputImageType;
+  typedef otb::Image<LabelledPixelType, Dimension> LabelledImageType;
+  typedef otb::ImageFileReader<InputImageType> ReaderType;
+
+  typedef otb::MarkovRandomFieldFilter<InputImageType, LabelledImageType> MarkovRandomFieldFilterType;
+  typedef otb::MRFSamplerMAP<InputImageType, LabelledImageType>           SamplerType;
+  typedef otb::MRFOptimizerICM OptimizerType;
+  typedef otb::MRFEnergyPotts<LabelledImageType, LabelledImageType>               EnergyRegularizationType;
+  typedef otb::MRFEnergyGaussianClassification<InputImageType, LabelledImageType> EnergyFidelityType;
+
+  const unsigned int nClass      = 4;
+  const unsigned int nbIter      = atoi(argv[2]);
+  const unsigned int nbThreads   = atoi(argv[3]);
+  const unsigned int radius      = 1;
+  const unsigned int nbColors    = (radius + 1) * (radius + 1);
+  const unsigned int margin      = nbIter * nbColors * radius;
+  const unsigned int nbDivisions = 3;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  reader->Update();
+
+  // Deterministic initial labels, from the gray levels
+  LabelledImageType::Pointer training = LabelledImageType::New();
+  training->CopyInformation(reader->GetOutput());
+  training->SetRegions(reader->GetOutput()->GetLargestPossibleRegion());
+  training->Allocate();
+  itk::ImageRegionConstIterator<InputImageType> inIt(reader->GetOutput(), training->GetLargestPossibleRegion());
+  itk::ImageRegionIterator<LabelledImageType>   trainingIt(training, training->GetLargestPossibleRegion());
+  for (inIt.GoToBegin(), trainingIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++trainingIt)
+  {
+    trainingIt.Set(std::min<unsigned int>(nClass - 1, static_cast<unsigned int>(inIt.Get()) / 64));
+  }
+
+  EnergyFidelityType::Pointer energyFidelity = EnergyFidelityType::New();
+  energyFidelity->SetNumberOfParameters(2 * nClass);
+  EnergyFidelityType::ParametersType parameters;
+  parameters.SetSize(energyFidelity->GetNumberOfParameters());
+  parameters[0] = 10.0;  // Class 0 mean
+  parameters[1] = 10.0;  // Class 0 stdev
+  parameters[2] = 80.0;  // Class 1 mean
+  parameters[3] = 10.0;  // Class 1 stdev
+  parameters[4] = 150.0; // Class 2 mean
+  parameters[5] = 10.0;  // Class 2 stdev
+  parameters[6] = 220.0; // Class 3 mean
+  parameters[7] = 10.0;  // Class 3 stde
+  energyFidelity->SetParameters(parameters);
+  EnergyRegularizationType::Pointer energyRegularization = EnergyRegularizationType::New();
+
+  auto createFilter = [&](bool checkerboard, unsigned int threads) {
+    MarkovRandomFieldFilterType::Pointer markovFilter = MarkovRandomFieldFilterType::New();
+    markovFilter->SetNumberOfClasses(nClass);
+    markovFilter->SetMaximumNumberOfIterations(nbIter);
+    markovFilter->SetErrorTolerance(0.0);
+    markovFilter->SetLambda(1.0);
+    markovFilter->SetNeighborhoodRadius(radius);
+    markovFilter->SetEnergyRegularization(energyRegularization);
+    markovFilter->SetEnergyFidelity(energyFidelity);
+    markovFilter->SetOptimizer(OptimizerType::New());
+    markovFilter->SetSampler(SamplerType::New());
+    markovFilter->SetCheckerboardUpdate(checkerboard);
+    markovFilter->SetNumberOfThreads(threads);
+    markovFilter->SetInput(reader->GetOutput());
+    markovFilter->SetTrainingInput(training);
+    return markovFilter;
+  };
+
+  auto report = [](const char* name, const MarkovRandomFieldFilterType* markovFilter) {
+    std::cout << name << ": " << markovFilter->GetIterationsPerSecond() << " iterations/s, energy variations:";
+    for (double delta : markovFilter->GetDeltaEnergies())
+    {
+      std::cout << " " << delta;
+    }
+    std::cout << std::endl;
+  };
+
+  auto sameLabels = [](const LabelledImageType* a, const LabelledImageType* b, const LabelledImageType::RegionType& region) {
+    itk::ImageRegionConstIterator<LabelledImageType> itA(a, region);
+    itk::ImageRegionConstIterator<LabelledImageType> itB(b, region);
+    for (itA.GoToBegin(), itB.GoToBegin(); !itA.IsAtEnd(); ++itA, ++itB)
+    {
+      if (itA.Get() != itB.Get())
+      {
+        std::cerr << "Labels differ at " << itA.GetIndex() << ": " << +itA.Get() << " != " << +itB.Get() << std::endl;
+        return false;
+      }
+    }
+    return true;
+  };
+
+  MarkovRandomFieldFilterType::Pointer serial = createFilter(false, 1);
+  serial->Update();
+  report("Raster order", serial);
+
+  MarkovRandomFieldFilterType::Pointer single = createFilter(true, 1);
+  single->Update();
+  report("Checkerboard, 1 thread", single);
+
+  MarkovRandomFieldFilterType::Pointer multi = createFilter(true, nbThreads);
+  multi->Update();
+  report("Checkerboard, several threads", multi);
+
+  // ICM never increases the energy
+  for (double delta : multi->GetDeltaEnergies())
+  {
+    if (delta > 0.)
+    {
+      std::cerr << "The energy increased during an iteration: " << delta << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The result does not depend on the number of threads
+  const LabelledImageType::RegionType largest = multi->GetOutput()->GetLargestPossibleRegion();
+  if (multi->GetDeltaEnergies().size() != nbIter || !sameLabels(single->GetOutput(), multi->GetOutput(), largest))
+  {
+    std::cerr << "The checkerboard update depends on the number of threads" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Streamed blocks, with a margin large enough, match the whole image
+  MarkovRandomFieldFilterType::Pointer streamed = createFilter(true, nbThreads);
+  streamed->StreamingOn();
+  streamed->SetStreamingMargin(margin);
+  for (unsigned int i = 0; i < nbDivisions; ++i)
+  {
+    for (unsigned int j = 0; j < nbDivisions; ++j)
+    {
+      LabelledImageType::RegionType block;
+      for (unsigned int dim = 0; dim < Dimension; ++dim)
+      {
+        const unsigned int k     = dim == 0 ? i : j;
+        const auto         size  = largest.GetSize(dim);
+        const auto         begin = k * size / nbDivisions;
+        block.SetIndex(dim, largest.GetIndex(dim) + begin);
+        block.SetSize(dim, (k + 1) * size / nbDivisions - begin);
+      }
+      streamed->GetOutput()->SetRequestedRegion(block);
+      streamed->Update();
+      if (!sameLabels(multi->GetOutput(), streamed->GetOutput(), block))
+      {
+        std::cerr << "The streamed block " << block << " differs from the whole image" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  report("Streamed checkerboard, last block", streamed);
+
+  return EXIT_SUCCESS;
+}
@@ -25,6 +25,8 @@
 #include "otbOGRDataSourceWrapper.h"
 #include "otbImage.h"
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace otb
 {
@@ -33,6 +35,14 @@ namespace otb
  *
  *  \note This class contains pure virtual method, and can not be instantiated.
  *
+ *  Polygons and line strings are rasterized row by row (see
+ *  ScanlineRasterization) : the pixels of each row inside a polygon are
+ *  found as spans between the crossings of its edges, and the pixels
+ *  crossed by a line are found among the few candidates around each
+ *  segment. The inclusion rules are the ones of IsSampleInsidePolygon()
+ *  and IsSampleOnLine(), which are still used for images with a rotated
+ *  grid, and for the pixels lying exactly on a line boundary.
+ *
  * \sa PersistentOGRDataToClassStatisticsFilter
  * \sa PersistentOGRDataToSamplePositionFilter
  *
@@ -55,7 +65,8 @@ public:
   typedef TInputImage InputImageType;
   typedef TMaskImage  MaskImageType;
 
-  typedef typename TInputImage::RegionType RegionType;
+  typedef typename TInputImage::RegionType               RegionType;
+  typedef typename TInputImage::IndexType::IndexValueType IndexValueType;
 
   typedef ogr::DataSource::Pointer OGRDataPointer;
 
@@ -93,6 +104,12 @@ public:
   itkSetMacro(OutLayerName, std::string);
   itkGetMacro(OutLayerName, std::string);
 
+  /** Rasterize polygons and lines row by row (default), instead of
+   * testing every pixel of their bounding region */
+  itkSetMacro(ScanlineRasterization, bool);
+  itkGetConstMacro(ScanlineRasterization, bool);
+  itkBooleanMacro(ScanlineRasterization);
+
 protected:
   /** Constructor */
   PersistentSamplingFilterBase();
@@ -193,6 +210,57 @@ private:
   PersistentSamplingFilterBase(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Segment of a ring or a line string, with the range of rows it may reach */
+  struct ScanlineEdge
+  {
+    double         X0;
+    double         Y0;
+    double         X1;
+    double         Y1;
+    IndexValueType LastRow;
+  };
+
+  /** Segments of a curve, bucketed by the first row of the region they may reach */
+  typedef std::vector<std::vector<ScanlineEdge>> EdgeTableType;
+
+  /** Spans [first, last) of columns */
+  typedef std::vector<std::pair<IndexValueType, IndexValueType>> SpanListType;
+
+  /** Check that rows and columns of the input image are aligned with the
+   * physical axes, as required by the scanline rasterization */
+  bool IsGridAlignedWithAxes() const;
+
+  /** Fill the edge table of a curve over the rows of a region. A closed
+   * curve (ring) also gets the edge from its last point to its first one */
+  void BuildEdgeTable(const OGRLineString* curve, const RegionType& region, EdgeTableType& table, bool closed = false) const;
+
+  /** Update the active edges when moving to a new row */
+  static void UpdateActiveEdges(std::vector<ScanlineEdge>& activeEdges, const std::vector<ScanlineEdge>& newEdges, IndexValueType row);
+
+  /** Compute the spans of a row whose pixel centers are inside a ring,
+   * following the rule of OGRLinearRing::isPointInRing() */
+  void ComputeRingSpans(const OGRLinearRing* ring, const std::vector<ScanlineEdge>& activeEdges, IndexValueType row, IndexValueType firstCol,
+                        IndexValueType lastCol, SpanListType& spans) const;
+
+  /** Check if a segment intersects a closed box : returns 1 if it does, 0 if
+   * it does not, and -1 when the rounding errors do not allow to decide */
+  static int ClassifySegment(const ScanlineEdge& edge, double minX, double minY, double maxX, double maxY);
+
+  /** Remove the columns of the second span list from the first one */
+  static void SubtractSpans(SpanListType& spans, const SpanListType& removed);
+
+  /** Rasterize a polygon row by row */
+  void ProcessPolygonScanlines(const ogr::Feature& feature, OGRPolygon* polygon, RegionType& region, itk::ThreadIdType& threadid);
+
+  /** Rasterize a line string row by row */
+  void ProcessLineScanlines(const ogr::Feature& feature, OGRLineString* line, RegionType& region, itk::ThreadIdType& threadid);
+
+  /** Call ProcessSample() on a pixel if it is not masked */
+  void ProcessSampleIfNotMasked(const ogr::Feature& feature, const typename TInputImage::IndexType& index, itk::ThreadIdType& threadid);
+
+  /** Rasterize polygons and lines row by row */
+  bool m_ScanlineRasterization;
+
   /** Field name containing the class name*/
   std::string m_FieldName;
 
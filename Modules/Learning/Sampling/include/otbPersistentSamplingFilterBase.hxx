@@ -28,6 +28,9 @@
 #include "otbMacro.h"
 #include "otbStopwatch.h"
 #include "itkProgressReporter.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace otb
 {
@@ -41,7 +44,8 @@ PersistentSamplingFilterBase<TInputImage, TMaskImage>::PersistentSamplingFilterB
     m_OGRLayerCreationOptions(),
     m_AdditionalFields(),
     m_InMemoryInputs(),
-    m_InMemoryOutputs()
+    m_InMemoryOutputs(),
+    m_ScanlineRasterization(true)
 {
   this->SetNthOutput(0, TInputImage::New());
 }
@@ -426,6 +430,12 @@ template <class TInputImage, class TMaskImage>
 void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessLine(const ogr::Feature& feature, OGRLineString* line, RegionType& region,
                                                                         itk::ThreadIdType& threadid)
 {
+  if (m_ScanlineRasterization && line->getNumPoints() > 1 && this->IsGridAlignedWithAxes())
+  {
+    this->ProcessLineScanlines(feature, line, region, threadid);
+    return;
+  }
+
   OGRPolygon    tmpPolygon;
   OGRLinearRing ring;
   ring.addPoint(0.0, 0.0, 0.0);
@@ -485,6 +495,12 @@ template <class TInputImage, class TMaskImage>
 void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessPolygon(const ogr::Feature& feature, OGRPolygon* polygon, RegionType& region,
                                                                            itk::ThreadIdType& threadid)
 {
+  if (m_ScanlineRasterization && this->IsGridAlignedWithAxes())
+  {
+    this->ProcessPolygonScanlines(feature, polygon, region, threadid);
+    return;
+  }
+
   const TInputImage*              img  = this->GetInput();
   TMaskImage*                     mask = const_cast<TMaskImage*>(this->GetMask());
   typename TInputImage::IndexType imgIndex;
@@ -575,6 +591,442 @@ inline bool PersistentSamplingFilterBase<TInputImage, TMaskImage>::IsSampleOnLin
   return line->Intersects(&tmpPolygon);
 }
 
+template <class TInputImage, class TMaskImage>
+bool PersistentSamplingFilterBase<TInputImage, TMaskImage>::IsGridAlignedWithAxes() const
+{
+  const typename TInputImage::DirectionType& direction = this->GetInput()->GetDirection();
+  return direction[0][1] == 0.0 && direction[1][0] == 0.0;
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::BuildEdgeTable(const OGRLineString* curve, const RegionType& region, EdgeTableType& table,
+                                                                           bool closed) const
+{
+  const TInputImage*   img      = this->GetInput();
+  const double         originY  = img->GetOrigin()[1];
+  const double         stepY    = img->GetDirection()[1][1] * img->GetSignedSpacing()[1];
+  const IndexValueType firstRow = region.GetIndex(1);
+  const IndexValueType lastRow  = firstRow + region.GetSize(1) - 1;
+
+  table.assign(region.GetSize(1), std::vector<ScanlineEdge>());
+
+  // Like isPointInRing(), a ring is closed by an edge from its last point
+  // to its first point, which is degenerate when the ring is closed
+  const int numPoints = curve->getNumPoints();
+  const int numEdges  = closed && numPoints > 1 ? numPoints : numPoints - 1;
+  for (int i = 1; i <= numEdges; ++i)
+  {
+    ScanlineEdge edge;
+    edge.X0 = curve->getX(i - 1);
+    edge.Y0 = curve->getY(i - 1);
+    edge.X1 = curve->getX(i % numPoints);
+    edge.Y1 = curve->getY(i % numPoints);
+
+    // Rows reached by the edge, with a margin of one row
+    const double         row0         = (edge.Y0 - originY) / stepY;
+    const double         row1         = (edge.Y1 - originY) / stepY;
+    const IndexValueType edgeFirstRow = std::max(firstRow, static_cast<IndexValueType>(std::floor(std::min(row0, row1))) - 1);
+    edge.LastRow                      = std::min(lastRow, static_cast<IndexValueType>(std::ceil(std::max(row0, row1))) + 1);
+    if (edgeFirstRow <= edge.LastRow)
+    {
+      table[edgeFirstRow - firstRow].push_back(edge);
+    }
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::UpdateActiveEdges(std::vector<ScanlineEdge>& activeEdges, const std::vector<ScanlineEdge>& newEdges,
+                                                                              IndexValueType row)
+{
+  activeEdges.insert(activeEdges.end(), newEdges.begin(), newEdges.end());
+  activeEdges.erase(std::remove_if(activeEdges.begin(), activeEdges.end(), [row](const ScanlineEdge& edge) { return edge.LastRow < row; }),
+                    activeEdges.end());
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ComputeRingSpans(const OGRLinearRing* ring, const std::vector<ScanlineEdge>& activeEdges,
+                                                                             IndexValueType row, IndexValueType firstCol, IndexValueType lastCol,
+                                                                             SpanListType& spans) const
+{
+  spans.clear();
+
+  // Same early exits as isPointInRing()
+  if (ring == nullptr || ring->getNumPoints() < 4)
+  {
+    return;
+  }
+
+  const TInputImage*              img     = this->GetInput();
+  const double                    originX = img->GetOrigin()[0];
+  const double                    stepX   = img->GetDirection()[0][0] * img->GetSignedSpacing()[0];
+  typename TInputImage::IndexType index;
+  typename TInputImage::PointType point;
+  index[0] = firstCol;
+  index[1] = row;
+  img->TransformIndexToPhysicalPoint(index, point);
+  const double y = point[1];
+
+  auto physicalX = [&](IndexValueType col) {
+    index[0] = col;
+    img->TransformIndexToPhysicalPoint(index, point);
+    return point[0];
+  };
+
+  OGREnvelope envelope;
+  ring->getEnvelope(&envelope);
+  if (!(y >= envelope.MinY && y <= envelope.MaxY))
+  {
+    return;
+  }
+
+  // Columns whose center is within the ring envelope
+  auto inEnvelope = [&](IndexValueType col) {
+    const double x = physicalX(col);
+    return x >= envelope.MinX && x <= envelope.MaxX;
+  };
+  double envelopeFirstCol = (envelope.MinX - originX) / stepX;
+  double envelopeLastCol  = (envelope.MaxX - originX) / stepX;
+  if (envelopeFirstCol > envelopeLastCol)
+  {
+    std::swap(envelopeFirstCol, envelopeLastCol);
+  }
+  IndexValueType col0 = std::max(firstCol, static_cast<IndexValueType>(std::ceil(envelopeFirstCol)) - 1);
+  IndexValueType col1 = std::min(lastCol, static_cast<IndexValueType>(std::floor(envelopeLastCol)) + 1);
+  while (col0 <= col1 && !inEnvelope(col0))
+  {
+    ++col0;
+  }
+  while (col1 >= col0 && !inEnvelope(col1))
+  {
+    --col1;
+  }
+  if (col0 > col1)
+  {
+    return;
+  }
+
+  // Each edge crossed by the ray starting from a pixel center toggles the
+  // pixel inside/outside state. The crossing pixels are the ones at the left
+  // of the edge: they form a span starting or ending at a bound of the row.
+  std::vector<IndexValueType> bounds;
+  for (const auto& edge : activeEdges)
+  {
+    const double y1 = edge.Y1 - y;
+    const double y2 = edge.Y0 - y;
+    if (!(((y1 > 0) && (y2 <= 0)) || ((y2 > 0) && (y1 <= 0))))
+    {
+      continue;
+    }
+
+    // Same expression as isPointInRing(), evaluated around the crossing
+    auto crosses = [&](IndexValueType col) {
+      const double x  = physicalX(col);
+      const double x1 = edge.X1 - x;
+      const double x2 = edge.X0 - x;
+      return 0.0 < (x1 * y2 - x2 * y1) / (y2 - y1);
+    };
+
+    const double crossingX   = edge.X0 + (y - edge.Y0) * (edge.X1 - edge.X0) / (edge.Y1 - edge.Y0);
+    const double crossingCol = (crossingX - originX) / stepX;
+    if (stepX > 0)
+    {
+      IndexValueType last = std::min(col1 + 1, std::max(col0, static_cast<IndexValueType>(std::ceil(crossingCol))));
+      while (last > col0 && !crosses(last - 1))
+      {
+        --last;
+      }
+      while (last <= col1 && crosses(last))
+      {
+        ++last;
+      }
+      bounds.push_back(col0);
+      bounds.push_back(last);
+    }
+    else
+    {
+      IndexValueType first = std::min(col1 + 1, std::max(col0, static_cast<IndexValueType>(std::floor(crossingCol)) + 1));
+      while (first > col0 && crosses(first - 1))
+      {
+        --first;
+      }
+      while (first <= col1 && !crosses(first))
+      {
+        ++first;
+      }
+      bounds.push_back(first);
+      bounds.push_back(col1 + 1);
+    }
+  }
+
+  // Pixels crossing an odd number of edges are between the bounds of odd
+  // and even ranks
+  std::sort(bounds.begin(), bounds.end());
+  for (std::size_t i = 0; i + 1 < bounds.size(); i += 2)
+  {
+    if (bounds[i] < bounds[i + 1])
+    {
+      spans.emplace_back(bounds[i], bounds[i + 1]);
+    }
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+int PersistentSamplingFilterBase<TInputImage, TMaskImage>::ClassifySegment(const ScanlineEdge& edge, double minX, double minY, double maxX, double maxY)
+{
+  if (std::max(edge.X0, edge.X1) < minX || std::min(edge.X0, edge.X1) > maxX || std::max(edge.Y0, edge.Y1) < minY || std::min(edge.Y0, edge.Y1) > maxY)
+  {
+    return 0;
+  }
+
+  // Side of the box corners with respect to the segment
+  const double dx            = edge.X1 - edge.X0;
+  const double dy            = edge.Y1 - edge.Y0;
+  const double corners[4][2] = {{minX, minY}, {maxX, minY}, {maxX, maxY}, {minX, maxY}};
+  bool         left          = false;
+  bool         right         = false;
+  bool         undecided     = false;
+  for (const auto& corner : corners)
+  {
+    const double a     = dx * (corner[1] - edge.Y0);
+    const double b     = dy * (corner[0] - edge.X0);
+    const double bound = 8.0 * std::numeric_limits<double>::epsilon() * (std::abs(a) + std::abs(b));
+    if (a - b > bound)
+    {
+      left = true;
+    }
+    else if (a - b < -bound)
+    {
+      right = true;
+    }
+    else
+    {
+      undecided = true;
+    }
+  }
+  if (left && right)
+  {
+    return 1;
+  }
+  return undecided ? -1 : 0;
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::SubtractSpans(SpanListType& spans, const SpanListType& removed)
+{
+  if (removed.empty())
+  {
+    return;
+  }
+  SpanListType result;
+  auto         removedIt = removed.begin();
+  for (const auto& span : spans)
+  {
+    IndexValueType start = span.first;
+    while (removedIt != removed.end() && removedIt->second <= start)
+    {
+      ++removedIt;
+    }
+    for (auto it = removedIt; it != removed.end() && it->first < span.second; ++it)
+    {
+      if (it->first > start)
+      {
+        result.emplace_back(start, it->first);
+      }
+      start = std::max(start, it->second);
+    }
+    if (start < span.second)
+    {
+      result.emplace_back(start, span.second);
+    }
+  }
+  spans.swap(result);
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessPolygonScanlines(const ogr::Feature& feature, OGRPolygon* polygon, RegionType& region,
+                                                                                    itk::ThreadIdType& threadid)
+{
+  // An empty polygon contains no pixel
+  if (polygon->getExteriorRing() == nullptr)
+  {
+    return;
+  }
+
+  const IndexValueType firstCol = region.GetIndex(0);
+  const IndexValueType lastCol  = firstCol + region.GetSize(0) - 1;
+  const IndexValueType firstRow = region.GetIndex(1);
+
+  // Exterior ring first, then the holes
+  std::vector<const OGRLinearRing*> rings(1, polygon->getExteriorRing());
+  for (int k = 0; k < polygon->getNumInteriorRings(); ++k)
+  {
+    rings.push_back(polygon->getInteriorRing(k));
+  }
+  std::vector<EdgeTableType>             tables(rings.size());
+  std::vector<std::vector<ScanlineEdge>> activeEdges(rings.size());
+  for (std::size_t k = 0; k < rings.size(); ++k)
+  {
+    this->BuildEdgeTable(rings[k], region, tables[k], true);
+  }
+
+  SpanListType                    spans;
+  SpanListType                    holeSpans;
+  typename TInputImage::IndexType imgIndex;
+  for (IndexValueType r = 0; r < static_cast<IndexValueType>(region.GetSize(1)); ++r)
+  {
+    imgIndex[1] = firstRow + r;
+    for (std::size_t k = 0; k < rings.size(); ++k)
+    {
+      UpdateActiveEdges(activeEdges[k], tables[k][r], imgIndex[1]);
+    }
+
+    this->ComputeRingSpans(rings[0], activeEdges[0], imgIndex[1], firstCol, lastCol, spans);
+    for (std::size_t k = 1; k < rings.size() && !spans.empty(); ++k)
+    {
+      this->ComputeRingSpans(rings[k], activeEdges[k], imgIndex[1], firstCol, lastCol, holeSpans);
+      SubtractSpans(spans, holeSpans);
+    }
+
+    for (const auto& span : spans)
+    {
+      for (imgIndex[0] = span.first; imgIndex[0] < span.second; ++imgIndex[0])
+      {
+        this->ProcessSampleIfNotMasked(feature, imgIndex, threadid);
+      }
+    }
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessLineScanlines(const ogr::Feature& feature, OGRLineString* line, RegionType& region,
+                                                                                 itk::ThreadIdType& threadid)
+{
+  const TInputImage*                img     = this->GetInput();
+  const double                      originX = img->GetOrigin()[0];
+  const double                      stepX   = img->GetDirection()[0][0] * img->GetSignedSpacing()[0];
+  typename TInputImage::SpacingType imgAbsSpacing;
+  imgAbsSpacing[0] = std::abs(img->GetSignedSpacing()[0]);
+  imgAbsSpacing[1] = std::abs(img->GetSignedSpacing()[1]);
+
+  const IndexValueType firstCol = region.GetIndex(0);
+  const IndexValueType lastCol  = firstCol + region.GetSize(0) - 1;
+  const IndexValueType firstRow = region.GetIndex(1);
+
+  // Pixel polygon used for the undecided cases
+  OGRPolygon    tmpPolygon;
+  OGRLinearRing ring;
+  ring.addPoint(0.0, 0.0, 0.0);
+  ring.addPoint(1.0, 0.0, 0.0);
+  ring.addPoint(1.0, 1.0, 0.0);
+  ring.addPoint(0.0, 1.0, 0.0);
+  ring.addPoint(0.0, 0.0, 0.0);
+  tmpPolygon.addRing(&ring);
+
+  EdgeTableType             table;
+  std::vector<ScanlineEdge> activeEdges;
+  this->BuildEdgeTable(line, region, table);
+
+  SpanListType                    candidates;
+  typename TInputImage::IndexType imgIndex;
+  typename TInputImage::PointType imgPoint;
+  for (IndexValueType r = 0; r < static_cast<IndexValueType>(region.GetSize(1)); ++r)
+  {
+    imgIndex[1] = firstRow + r;
+    UpdateActiveEdges(activeEdges, table[r], imgIndex[1]);
+    if (activeEdges.empty())
+    {
+      continue;
+    }
+    imgIndex[0] = firstCol;
+    img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+    const double y = imgPoint[1];
+
+    // Candidate columns around the part of each segment within one pixel of the row
+    candidates.clear();
+    for (const auto& edge : activeEdges)
+    {
+      const double minY = y - imgAbsSpacing[1];
+      const double maxY = y + imgAbsSpacing[1];
+      if (std::max(edge.Y0, edge.Y1) < minY || std::min(edge.Y0, edge.Y1) > maxY)
+      {
+        continue;
+      }
+      double x0 = edge.X0;
+      double x1 = edge.X1;
+      if (edge.Y0 != edge.Y1)
+      {
+        const double t0 = std::min(1.0, std::max(0.0, (minY - edge.Y0) / (edge.Y1 - edge.Y0)));
+        const double t1 = std::min(1.0, std::max(0.0, (maxY - edge.Y0) / (edge.Y1 - edge.Y0)));
+        x0              = edge.X0 + t0 * (edge.X1 - edge.X0);
+        x1              = edge.X0 + t1 * (edge.X1 - edge.X0);
+      }
+      double col0 = (x0 - originX) / stepX;
+      double col1 = (x1 - originX) / stepX;
+      if (col0 > col1)
+      {
+        std::swap(col0, col1);
+      }
+      const IndexValueType first = std::max(firstCol, static_cast<IndexValueType>(std::floor(col0)) - 1);
+      const IndexValueType last  = std::min(lastCol, static_cast<IndexValueType>(std::ceil(col1)) + 1);
+      if (first <= last)
+      {
+        candidates.emplace_back(first, last + 1);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    IndexValueType nextCol = firstCol;
+    for (const auto& candidate : candidates)
+    {
+      for (imgIndex[0] = std::max(nextCol, candidate.first); imgIndex[0] < candidate.second; ++imgIndex[0])
+      {
+        img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+        const double minX = imgPoint[0] - 0.5 * imgAbsSpacing[0];
+        const double maxX = imgPoint[0] + 0.5 * imgAbsSpacing[0];
+        const double minY = imgPoint[1] - 0.5 * imgAbsSpacing[1];
+        const double maxY = imgPoint[1] + 0.5 * imgAbsSpacing[1];
+
+        int crossed = 0;
+        for (const auto& edge : activeEdges)
+        {
+          const int status = ClassifySegment(edge, minX, minY, maxX, maxY);
+          if (status > 0)
+          {
+            crossed = 1;
+            break;
+          }
+          crossed = std::min(crossed, status);
+        }
+        if (crossed < 0)
+        {
+          crossed = this->IsSampleOnLine(line, imgPoint, imgAbsSpacing, tmpPolygon) ? 1 : 0;
+        }
+        if (crossed > 0)
+        {
+          this->ProcessSampleIfNotMasked(feature, imgIndex, threadid);
+        }
+      }
+      nextCol = std::max(nextCol, candidate.second);
+    }
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessSampleIfNotMasked(const ogr::Feature&                    feature,
+                                                                                     const typename TInputImage::IndexType& index,
+                                                                                     itk::ThreadIdType&                     threadid)
+{
+  const TMaskImage* mask = this->GetMask();
+  if ((mask != nullptr) && !mask->GetPixel(index))
+  {
+    return;
+  }
+  typename TInputImage::IndexType imgIndex = index;
+  typename TInputImage::PointType imgPoint;
+  this->GetInput()->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+  this->ProcessSample(feature, imgIndex, imgPoint, threadid);
+}
+
 template <class TInputImage, class TMaskImage>
 typename PersistentSamplingFilterBase<TInputImage, TMaskImage>::RegionType
 PersistentSamplingFilterBase<TInputImage, TMaskImage>::FeatureBoundingRegion(const TInputImage* image, otb::ogr::Layer::const_iterator& featIt) const
@@ -23,6 +23,7 @@
 #include "otbVectorImage.h"
 #include "otbImage.h"
 #include <fstream>
+#include <utility>
 
 
 int otbOGRDataToClassStatisticsFilter(int argc, char* argv[])
@@ -139,3 +140,122 @@ int otbOGRDataToClassStatisticsFilter(int argc, char* argv[])
   ofs.close();
   return EXIT_SUCCESS;
 }
+
+int otbOGRDataToClassStatisticsFilterScanline(int itkNotUsed(argc), char* argv[])
+{
+  typedef otb::VectorImage<float>   InputImageType;
+  typedef otb::Image<unsigned char> MaskImageType;
+  typedef otb::OGRDataToClassStatisticsFilter<InputImageType, MaskImageType> FilterType;
+
+  otb::ogr::DataSource::Pointer vectors = otb::ogr::DataSource::New(argv[1]);
+
+  InputImageType::RegionType region;
+  region.SetSize(0, 99);
+  region.SetSize(1, 50);
+
+  InputImageType::PointType origin;
+  origin.Fill(0.5);
+
+  InputImageType::SpacingType spacing;
+  spacing[0] = 1.0;
+  spacing[1] = -1.0;
+
+  InputImageType::Pointer inputImage = InputImageType::New();
+  inputImage->SetNumberOfComponentsPerPixel(3);
+  inputImage->SetLargestPossibleRegion(region);
+  inputImage->SetOrigin(origin);
+  inputImage->SetSignedSpacing(spacing);
+
+  MaskImageType::Pointer mask = MaskImageType::New();
+  mask->SetRegions(region);
+  mask->SetOrigin(origin);
+  mask->SetSignedSpacing(spacing);
+  mask->Allocate();
+  itk::ImageRegionIterator<MaskImageType> it(mask, region);
+  unsigned int                            count = 0;
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++count)
+  {
+    it.Set(count % 2);
+  }
+
+  // Polygons whose rings are not closed: isPointInRing() closes them
+  // implicitly, with an edge from the last point to the first one
+  otb::ogr::DataSource::Pointer unclosedVectors = otb::ogr::DataSource::New();
+  otb::ogr::Layer               unclosedLayer   = unclosedVectors->CreateLayer("unclosed", nullptr, wkbPolygon);
+  OGRFieldDefn                  labelField("Label", OFTInteger);
+  unclosedLayer.CreateField(labelField);
+  {
+    OGRLinearRing exterior;
+    exterior.addPoint(3.2, -2.7);
+    exterior.addPoint(40.6, -5.1);
+    exterior.addPoint(52.3, -30.4);
+    exterior.addPoint(21.7, -44.9);
+    exterior.addPoint(8.1, -25.3);
+    OGRPolygon polygon;
+    polygon.addRing(&exterior);
+
+    otb::ogr::Feature feature(unclosedLayer.GetLayerDefn());
+    feature[0].SetValue(1);
+    feature.SetGeometry(&polygon);
+    unclosedLayer.CreateFeature(feature);
+  }
+  {
+    OGRLinearRing exterior;
+    exterior.addPoint(60.4, -3.3);
+    exterior.addPoint(95.2, -8.6);
+    exterior.addPoint(90.7, -46.1);
+    exterior.addPoint(57.9, -40.2);
+    exterior.addPoint(60.4, -3.3);
+    OGRLinearRing hole;
+    hole.addPoint(68.3, -12.8);
+    hole.addPoint(84.6, -15.2);
+    hole.addPoint(80.1, -35.7);
+    hole.addPoint(66.2, -30.9);
+    OGRPolygon polygon;
+    polygon.addRing(&exterior);
+    polygon.addRing(&hole);
+
+    otb::ogr::Feature feature(unclosedLayer.GetLayerDefn());
+    feature[0].SetValue(2);
+    feature.SetGeometry(&polygon);
+    unclosedLayer.CreateFeature(feature);
+  }
+
+  // The scanline rasterization must select exactly the same pixels as the
+  // pixel by pixel tests, for polygons (layer 0), lines (layer 1) and
+  // polygons with unclosed rings
+  const std::pair<otb::ogr::DataSource::Pointer, int> layers[] = {{vectors, 0}, {vectors, 1}, {unclosedVectors, 0}};
+  for (const auto& layer : layers)
+  {
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(inputImage);
+    filter->SetMask(mask);
+    filter->SetOGRData(layer.first);
+    filter->SetFieldName("Label");
+    filter->SetLayerIndex(layer.second);
+
+    filter->GetFilter()->ScanlineRasterizationOff();
+    filter->Update();
+    FilterType::ClassCountMapType  refClassCount = filter->GetClassCountOutput()->Get();
+    FilterType::PolygonSizeMapType refPolySize   = filter->GetPolygonSizeOutput()->Get();
+
+    filter->GetFilter()->ScanlineRasterizationOn();
+    filter->Update();
+    const FilterType::ClassCountMapType&  classCount = filter->GetClassCountOutput()->Get();
+    const FilterType::PolygonSizeMapType& polySize   = filter->GetPolygonSizeOutput()->Get();
+
+    const std::string layerName = layer.first->GetLayer(layer.second).GetName();
+    if (classCount != refClassCount || polySize != refPolySize)
+    {
+      std::cerr << "Scanline and pixelwise rasterizations differ on layer " << layerName << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (refPolySize.empty())
+    {
+      std::cerr << "No sample found on layer " << layerName << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,7 @@ void RegisterTests()
   REGISTER_TEST(otbOGRDataToSamplePositionFilter);
   REGISTER_TEST(otbOGRDataToSamplePositionFilterPattern);
   REGISTER_TEST(otbOGRDataToClassStatisticsFilter);
+  REGISTER_TEST(otbOGRDataToClassStatisticsFilterScanline);
   REGISTER_TEST(otbImageSampleExtractorFilter);
   REGISTER_TEST(otbImageSampleExtractorFilterUpdate);
   REGISTER_TEST(otbSamplingRateCalculatorList);
@@ -27,6 +27,8 @@
 
 #include <fstream>
 #include <set>
+#include <algorithm>
+#include <vector>
 #include "itkMacro.h"
 
 namespace otb
@@ -133,6 +135,78 @@ KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::DoPredict(cons
   return target;
 }
 
+template <class TInputValue, class TTargetValue>
+void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                      const unsigned int& size, TargetListSampleType* targets,
+                                                                                      ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  assert(input->Size() == targets->Size() && "Input sample list and target label list do not have the same size.");
+  assert(((quality == nullptr) || (quality->Size() == input->Size())) &&
+         "Quality samples list is not null and does not have the same size as input samples list");
+  assert(((proba == nullptr) || (input->Size() == proba->Size())) && "Proba sample list and target label list do not have the same size.");
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  if (size == 0)
+  {
+    return;
+  }
+
+  // Convert the whole batch at once, and predict all the samples in one call
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, samples, startIndex, size);
+
+  cv::Mat results;
+  cv::Mat nearest;
+  m_KNearestModel->findNearest(samples, m_K, results, nearest, cv::noArray());
+
+  std::vector<float> values(m_K);
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    float        result    = results.at<float>(i);
+    const float* neighbors = nearest.ptr<float>(i);
+
+    // compute quality if asked (only happens in classification mode)
+    if (quality != nullptr)
+    {
+      assert(!this->m_RegressionMode);
+      unsigned int accuracy = 0;
+      for (int k = 0; k < m_K; ++k)
+      {
+        if (neighbors[k] == result)
+        {
+          accuracy++;
+        }
+      }
+      ConfidenceSampleType confidence;
+      confidence[0] = static_cast<ConfidenceValueType>(accuracy);
+      quality->SetMeasurementVector(startIndex + i, confidence);
+    }
+
+    // MEDIAN decision rule : only case that must be handled here
+    if (this->m_DecisionRule == KNN_MEDIAN)
+    {
+      values.assign(neighbors, neighbors + m_K);
+      std::nth_element(values.begin(), values.begin() + (m_K >> 1), values.end());
+      result = values[m_K >> 1];
+    }
+
+    TargetSampleType target;
+    target[0] = static_cast<TTargetValue>(result);
+    targets->SetMeasurementVector(startIndex + i, target);
+  }
+}
+
 template <class TInputValue, class TTargetValue>
 void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::Save(const std::string& filename, const std::string& name)
 {
@@ -22,6 +22,8 @@
 #define otbLibSVMMachineLearningModel_hxx
 
 #include <fstream>
+#include <algorithm>
+#include <vector>
 #include "otbLibSVMMachineLearningModel.h"
 #include "otbSVMCrossValidationCostFunction.h"
 #include "otbExhaustiveExponentialOptimizer.h"
@@ -105,12 +107,8 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
   TargetSampleType target;
   target.Fill(0);
 
-  // Get type and number of classes
-  int svm_type = svm_get_svm_type(m_Model);
-
-  // Allocate nodes (/TODO if performances problems are related to too
-  // many allocations, a cache approach can be set)
-  struct svm_node* x = new struct svm_node[input.Size() + 1];
+  // Allocate nodes
+  std::vector<struct svm_node> x(input.Size() + 1);
 
   // Fill the node
   for (unsigned int i = 0; i < input.Size(); i++)
@@ -125,78 +123,144 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
   if (proba != nullptr && !this->m_ProbaIndex)
     itkExceptionMacro("Probability per class not available for this classifier !");
 
-  if (quality != nullptr)
+  if (quality != nullptr && !this->m_ConfidenceIndex)
   {
-    if (!this->m_ConfidenceIndex)
+    itkExceptionMacro("Confidence index not available for this classifier !");
+  }
+
+  std::vector<double> probEstimates(svm_get_nr_class(m_Model));
+  target[0] = this->PredictNodes(x.data(), quality, probEstimates.data());
+
+  return target;
+}
+
+template <class TInputValue, class TOutputValue>
+void LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                           const unsigned int& size, TargetListSampleType* targets,
+                                                                           ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  assert(input->Size() == targets->Size() && "Input sample list and target label list do not have the same size.");
+  assert(((quality == nullptr) || (quality->Size() == input->Size())) &&
+         "Quality samples list is not null and does not have the same size as input samples list");
+  assert(((proba == nullptr) || (input->Size() == proba->Size())) && "Proba sample list and target label list do not have the same size.");
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  if (quality != nullptr && !this->m_ConfidenceIndex)
+  {
+    itkExceptionMacro("Confidence index not available for this classifier !");
+  }
+
+  // libsvm has no batch prediction: the nodes of the whole batch are
+  // converted at once in a single buffer, and the buffers for the
+  // probabilities and the decision values are shared by all the samples
+  const unsigned int           nbFeatures = input->GetMeasurementVectorSize();
+  std::vector<struct svm_node> nodes(static_cast<size_t>(size) * (nbFeatures + 1));
+  for (unsigned int id = 0; id < size; ++id)
+  {
+    const InputSampleType& sample = input->GetMeasurementVector(startIndex + id);
+    struct svm_node*       x      = &nodes[static_cast<size_t>(id) * (nbFeatures + 1)];
+    for (unsigned int i = 0; i < nbFeatures; ++i)
     {
-      itkExceptionMacro("Confidence index not available for this classifier !");
+      x[i].index = i + 1;
+      x[i].value = sample[i];
     }
+    x[nbFeatures].index = -1;
+    x[nbFeatures].value = 0;
+  }
+
+  const unsigned int               nr_class = svm_get_nr_class(m_Model);
+  std::vector<double>              probEstimates(nr_class);
+  std::vector<ConfidenceValueType> confidences(std::max(1u, std::max(nr_class, nr_class * (nr_class - 1) / 2)));
+
+  for (unsigned int id = 0; id < size; ++id)
+  {
+    const struct svm_node* x = &nodes[static_cast<size_t>(id) * (nbFeatures + 1)];
+
+    TargetSampleType target;
+    target[0] = this->PredictNodes(x, quality != nullptr ? confidences.data() : nullptr, probEstimates.data());
+    targets->SetMeasurementVector(startIndex + id, target);
+
+    if (quality != nullptr)
+    {
+      // Only the first value is kept in CM_PROBA and CM_HYPER modes
+      ConfidenceSampleType confidence;
+      confidence[0] = confidences[0];
+      quality->SetMeasurementVector(startIndex + id, confidence);
+    }
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+typename LibSVMMachineLearningModel<TInputValue, TOutputValue>::TargetValueType
+LibSVMMachineLearningModel<TInputValue, TOutputValue>::PredictNodes(const struct svm_node* x, ConfidenceValueType* quality, double* probEstimates) const
+{
+  // Get type and number of classes
+  int          svm_type = svm_get_svm_type(m_Model);
+  unsigned int nr_class = svm_get_nr_class(m_Model);
+
+  if (quality != nullptr)
+  {
     if (this->m_ConfidenceMode == CM_INDEX)
     {
       if (svm_type == C_SVC || svm_type == NU_SVC)
       {
-        // Eventually allocate space for probabilities
-        unsigned int nr_class       = svm_get_nr_class(m_Model);
-        double*      prob_estimates = new double[nr_class];
         // predict
-        target[0]      = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, prob_estimates));
-        double maxProb = 0.0;
-        double secProb = 0.0;
+        TargetValueType target  = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, probEstimates));
+        double          maxProb = 0.0;
+        double          secProb = 0.0;
         for (unsigned int i = 0; i < nr_class; ++i)
         {
-          if (maxProb < prob_estimates[i])
+          if (maxProb < probEstimates[i])
           {
             secProb = maxProb;
-            maxProb = prob_estimates[i];
+            maxProb = probEstimates[i];
           }
-          else if (secProb < prob_estimates[i])
+          else if (secProb < probEstimates[i])
           {
-            secProb = prob_estimates[i];
+            secProb = probEstimates[i];
           }
         }
         (*quality) = static_cast<ConfidenceValueType>(maxProb - secProb);
-
-        delete[] prob_estimates;
+        return target;
       }
       else
       {
-        target[0] = static_cast<TargetValueType>(svm_predict(m_Model, x));
         // Prob. model for test data: target value = predicted value + z
         // z: Laplace distribution e^(-|z|/sigma)/(2sigma)
         // sigma is output as confidence index
         (*quality) = svm_get_svr_probability(m_Model);
+        return static_cast<TargetValueType>(svm_predict(m_Model, x));
       }
     }
     else if (this->m_ConfidenceMode == CM_PROBA)
     {
-      target[0] = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, quality));
+      return static_cast<TargetValueType>(svm_predict_probability(m_Model, x, quality));
     }
     else if (this->m_ConfidenceMode == CM_HYPER)
     {
-      target[0] = static_cast<TargetValueType>(svm_predict_values(m_Model, x, quality));
+      return static_cast<TargetValueType>(svm_predict_values(m_Model, x, quality));
     }
+    return 0;
   }
-  else
+
+  // default case : if the model has probabilities, we call svm_predict_probabilities()
+  // which gives different results than svm_predict()
+  if (svm_check_probability_model(m_Model))
   {
-    // default case : if the model has probabilities, we call svm_predict_probabilities()
-    // which gives different results than svm_predict()
-    if (svm_check_probability_model(m_Model))
-    {
-      unsigned int nr_class       = svm_get_nr_class(m_Model);
-      double*      prob_estimates = new double[nr_class];
-      target[0]                   = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, prob_estimates));
-      delete[] prob_estimates;
-    }
-    else
-    {
-      target[0] = static_cast<TargetValueType>(svm_predict(m_Model, x));
-    }
+    return static_cast<TargetValueType>(svm_predict_probability(m_Model, x, probEstimates));
   }
-
-  // Free allocated memory
-  delete[] x;
-
-  return target;
+  return static_cast<TargetValueType>(svm_predict(m_Model, x));
 }
 
 template <class TInputValue, class TOutputValue>
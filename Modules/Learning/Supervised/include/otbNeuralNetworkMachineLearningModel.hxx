@@ -238,6 +238,86 @@ NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const In
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                  const unsigned int& size, TargetListSampleType* targets,
+                                                                                  ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  assert(input->Size() == targets->Size() && "Input sample list and target label list do not have the same size.");
+  assert(((quality == nullptr) || (quality->Size() == input->Size())) &&
+         "Quality samples list is not null and does not have the same size as input samples list");
+  assert(((proba == nullptr) || (input->Size() == proba->Size())) && "Proba sample list and target label list do not have the same size.");
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  if (size == 0)
+  {
+    return;
+  }
+
+  // Convert the whole batch at once, and predict all the samples in one call
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, samples, startIndex, size);
+
+  cv::Mat responses;
+  m_ANNModel->predict(samples, responses);
+
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    const float*     response    = responses.ptr<float>(i);
+    float            maxResponse = response[0];
+    TargetSampleType target;
+
+    if (this->m_RegressionMode)
+    {
+      // MODE REGRESSION : only output first response
+      target[0] = maxResponse;
+      targets->SetMeasurementVector(startIndex + i, target);
+      continue;
+    }
+
+    // MODE CLASSIFICATION : find the highest response
+    float secondResponse = -1e10;
+
+    target[0] = m_MatrixOfLabels.at<TOutputValue>(0);
+    unsigned int nbClasses = m_MatrixOfLabels.size[1];
+
+    for (unsigned itLabel = 1; itLabel < nbClasses; ++itLabel)
+    {
+      const float currentResponse = response[itLabel];
+      if (currentResponse > maxResponse)
+      {
+        secondResponse = maxResponse;
+
+        maxResponse = currentResponse;
+        target[0] = m_MatrixOfLabels.at<TOutputValue>(itLabel);
+      }
+      else if (currentResponse > secondResponse)
+      {
+        secondResponse = currentResponse;
+      }
+    }
+    targets->SetMeasurementVector(startIndex + i, target);
+
+    if (quality != nullptr)
+    {
+      ConfidenceSampleType confidence;
+      confidence[0] = static_cast<ConfidenceValueType>(maxResponse) - static_cast<ConfidenceValueType>(secondResponse);
+      quality->SetMeasurementVector(startIndex + i, confidence);
+    }
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
@@ -83,6 +83,54 @@ NormalBayesMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const Inpu
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void NormalBayesMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                const unsigned int& size, TargetListSampleType* targets,
+                                                                                ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  assert(input->Size() == targets->Size() && "Input sample list and target label list do not have the same size.");
+  assert(((quality == nullptr) || (quality->Size() == input->Size())) &&
+         "Quality samples list is not null and does not have the same size as input samples list");
+  assert(((proba == nullptr) || (input->Size() == proba->Size())) && "Proba sample list and target label list do not have the same size.");
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  if (quality != nullptr && !this->HasConfidenceIndex())
+  {
+    itkExceptionMacro("Confidence index not available for this classifier !");
+  }
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  if (size == 0)
+  {
+    return;
+  }
+
+  // Convert the whole batch at once, and predict all the samples in one call
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, samples, startIndex, size);
+
+  // The labels are returned as integers
+  cv::Mat results;
+  m_NormalBayesModel->predict(samples, results);
+  results.convertTo(results, CV_32F);
+
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    TargetSampleType target;
+    target[0] = static_cast<TOutputValue>(results.at<float>(i));
+    targets->SetMeasurementVector(startIndex + i, target);
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void NormalBayesMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
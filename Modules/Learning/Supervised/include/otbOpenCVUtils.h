@@ -119,6 +119,27 @@ void ListSampleToMat(const T* listSample, cv::Mat& output)
   }
 }
 
+/** Converts the samples [startIndex, startIndex + size[ of a ListSample
+ *  to a contiguous cv::Mat, one sample per row.
+ */
+template <class T>
+void ListSampleRangeToMat(const T* listSample, cv::Mat& output, unsigned int startIndex, unsigned int size)
+{
+  const unsigned int sampleSize = listSample->GetMeasurementVectorSize();
+  output.create(size, sampleSize, CV_32FC1);
+
+  for (unsigned int sampleIdx = 0; sampleIdx < size; ++sampleIdx)
+  {
+    const typename T::MeasurementVectorType& sample = listSample->GetMeasurementVector(startIndex + sampleIdx);
+
+    float* row = output.ptr<float>(sampleIdx);
+    for (unsigned int i = 0; i < sampleSize; ++i)
+    {
+      row[i] = sample[i];
+    }
+  }
+}
+
 template <typename T>
 void ListSampleToMat(typename T::Pointer listSample, cv::Mat& output)
 {
@@ -137,6 +137,62 @@ RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const In
   return target[0];
 }
 
+template <class TInputValue, class TOutputValue>
+void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                  const unsigned int& size, TargetListSampleType* targets,
+                                                                                  ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  assert(input->Size() == targets->Size() && "Input sample list and target label list do not have the same size.");
+  assert(((quality == nullptr) || (quality->Size() == input->Size())) &&
+         "Quality samples list is not null and does not have the same size as input samples list");
+  assert(((proba == nullptr) || (input->Size() == proba->Size())) && "Proba sample list and target label list do not have the same size.");
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  if (size == 0)
+  {
+    return;
+  }
+
+  // Convert the whole batch at once, and predict all the samples in one call
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, samples, startIndex, size);
+
+  cv::Mat results;
+  m_RFModel->predict(samples, results);
+
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    TargetSampleType target;
+    target[0] = static_cast<TOutputValue>(results.at<float>(i));
+    targets->SetMeasurementVector(startIndex + i, target);
+  }
+
+  if (quality != nullptr)
+  {
+    for (unsigned int i = 0; i < size; ++i)
+    {
+      const cv::Mat        sample = samples.row(i);
+      ConfidenceSampleType confidence;
+      if (m_ComputeMargin)
+        confidence[0] = m_RFModel->predict_margin(sample);
+      else
+        confidence[0] = m_RFModel->predict_confidence(sample);
+      quality->SetMeasurementVector(startIndex + i, confidence);
+    }
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
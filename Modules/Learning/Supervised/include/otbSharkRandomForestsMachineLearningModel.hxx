@@ -23,6 +23,7 @@
 
 #include <fstream>
 #include "itkMacro.h"
+#include "itkMultiThreader.h"
 #include "otbSharkRandomForestsMachineLearningModel.h"
 
 #if defined(__GNUC__) || defined(__clang__)
@@ -38,6 +39,11 @@
 
 
 #include "otbSharkUtils.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
 
 namespace otb
@@ -23,6 +23,7 @@
 #include <string>
 #include <algorithm>
 #include <chrono>
+#include <vector>
 
 #include "otbMacro.h"
 
@@ -71,6 +72,53 @@ void SetupModel(TModel* /*model*/)
   // do nothing by default
 }
 
+// Check that the batch prediction gives the same labels and confidences
+// as the prediction of the samples one by one
+template <class TModel>
+bool CheckBatchPrediction(TModel* classifier, InputListSampleType* samples)
+{
+  typedef typename TModel::ConfidenceValueType      ConfidenceValueType;
+  typedef typename TModel::ConfidenceListSampleType ConfidenceListSampleType;
+
+  const bool                                 withConfidence = classifier->HasConfidenceIndex();
+  typename ConfidenceListSampleType::Pointer confidences;
+  if (withConfidence)
+  {
+    confidences = ConfidenceListSampleType::New();
+  }
+
+  auto                          start     = std::chrono::system_clock::now();
+  TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, confidences);
+  auto                          batchTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - start).count();
+
+  std::vector<TargetValueType>     labels(samples->Size());
+  std::vector<ConfidenceValueType> qualities(samples->Size());
+  start = std::chrono::system_clock::now();
+  for (unsigned int id = 0; id < samples->Size(); ++id)
+  {
+    labels[id] = classifier->Predict(samples->GetMeasurementVector(id), withConfidence ? &qualities[id] : nullptr)[0];
+  }
+  auto sampleTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - start).count();
+
+  otbLogMacro(Info, << classifier->GetNameOfClass() << ": " << samples->Size() << " samples predicted in " << batchTime << " us by batch, " << sampleTime
+                    << " us one by one");
+
+  for (unsigned int id = 0; id < samples->Size(); ++id)
+  {
+    if (predicted->GetMeasurementVector(id)[0] != labels[id])
+    {
+      std::cout << "Batch prediction of sample " << id << " differs: " << predicted->GetMeasurementVector(id)[0] << " != " << labels[id] << std::endl;
+      return false;
+    }
+    if (withConfidence && std::abs(confidences->GetMeasurementVector(id)[0] - qualities[id]) > 1e-5 * std::max<double>(1., std::abs(qualities[id])))
+    {
+      std::cout << "Batch confidence of sample " << id << " differs: " << confidences->GetMeasurementVector(id)[0] << " != " << qualities[id] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
 template <class TModel>
 int otbGenericMachineLearningModel(int argc, char* argv[])
 {
@@ -108,6 +156,11 @@ int otbGenericMachineLearningModel(int argc, char* argv[])
   otbLogMacro(Debug, << "PredictBatch took " << elapsed << " ms");
   const float kappaLoad = GetConfusionMatrixResults(predictedLoad, labels);
 
+  if (!CheckBatchPrediction<TModel>(classifierLoad, samples))
+  {
+    return EXIT_FAILURE;
+  }
+
   return (std::abs(kappaLoad - kappa) < 0.00000001 ? EXIT_SUCCESS : EXIT_FAILURE);
 }
 
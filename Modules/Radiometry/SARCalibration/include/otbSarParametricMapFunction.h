@@ -124,6 +124,13 @@ public:
   /** Set constante value for evaluation*/
   void SetConstantValue(const RealType& value);
 
+  /** Return true if the value of the function at a pixel only depends
+   * on the column of the pixel, so that it can be evaluated once per
+   * column. This is the case of constant functions, and of polynomials
+   * of degree 0 along the lines when the physical X coordinate does not
+   * depend on the line index. */
+  bool DependsOnColumnOnly() const;
+
 protected:
   SarParametricMapFunction();
   ~SarParametricMapFunction() override
@@ -74,6 +74,18 @@ void SarParametricMapFunction<TInputImage, TCoordRep>::SetPolynomalSize(const Ar
   SetPolynomalSize(IndexType {polynomalSize[0], polynomalSize[1]});
 }
 
+template <class TInputImage, class TCoordRep>
+bool SarParametricMapFunction<TInputImage, TCoordRep>::DependsOnColumnOnly() const
+{
+  if (m_Coeff.Rows() * m_Coeff.Cols() == 1)
+  {
+    return true;
+  }
+  // With a single row of coefficients, Horner() only uses the Y
+  // coordinate multiplied by zero
+  return m_Coeff.Rows() == 1 && this->GetInputImage() != nullptr && this->GetInputImage()->GetIndexToPhysicalPoint()(0, 1) == 0.;
+}
+
 template <class TInputImage, class TCoordRep>
 double SarParametricMapFunction<TInputImage, TCoordRep>::Horner(PointType point) const
 {
@@ -70,6 +70,7 @@ public:
   typedef typename Superclass::IndexType           IndexType;
   typedef typename Superclass::ContinuousIndexType ContinuousIndexType;
   typedef typename Superclass::PointType           PointType;
+  typedef typename InputImageType::RegionType      RegionType;
 
   itkStaticConstMacro(ImageDimension, unsigned int, InputImageType::ImageDimension);
 
@@ -88,6 +89,13 @@ public:
   /** Evalulate the function at specified index */
   OutputType EvaluateAtIndex(const IndexType& index) const override;
 
+  /** Evaluate the function on all the pixels of a region of the
+   * buffer, stored in scanline order in values. The parametric terms
+   * depending on the column only are computed once per column, and the
+   * lookup tables once per line, with the same arithmetic as
+   * EvaluateAtIndex(). */
+  void EvaluateAtRegion(const RegionType& region, OutputType* values) const;
+
   /** Evaluate the function at non-integer positions */
   OutputType Evaluate(const PointType& point) const override
   {
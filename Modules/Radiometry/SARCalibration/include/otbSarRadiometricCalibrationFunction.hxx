@@ -24,6 +24,9 @@
 
 #include "otbSarRadiometricCalibrationFunction.h"
 #include "itkNumericTraits.h"
+#include "itkImageScanlineConstIterator.h"
+
+#include <vector>
 
 namespace otb
 {
@@ -166,6 +169,138 @@ SarRadiometricCalibrationFunction<TInputImage, TCoordRep>::EvaluateAtIndex(const
   return static_cast<OutputType>(sigma);
 }
 
+template <class TInputImage, class TCoordRep>
+void SarRadiometricCalibrationFunction<TInputImage, TCoordRep>::EvaluateAtRegion(const RegionType& region, OutputType* values) const
+{
+  const InputImageType* image = this->GetInputImage();
+  const unsigned int    width = region.GetSize(0);
+
+  // Parametric terms, in the order they are applied by EvaluateAtIndex()
+  enum
+  {
+    NOISE = 0,
+    INCIDENCE_ANGLE,
+    ANTENNA_PATTERN_NEW_GAIN,
+    ANTENNA_PATTERN_OLD_GAIN,
+    RANGE_SPREAD_LOSS,
+    NUMBER_OF_TERMS
+  };
+  const ParametricFunctionType* terms[NUMBER_OF_TERMS] = {m_Noise, m_IncidenceAngle, m_AntennaPatternNewGain, m_AntennaPatternOldGain, m_RangeSpreadLoss};
+  const bool applied[NUMBER_OF_TERMS] = {m_EnableNoise, m_ApplyIncidenceAngleCorrection, m_ApplyAntennaPatternGain, m_ApplyAntennaPatternGain,
+                                         m_ApplyRangeSpreadLossCorrection};
+
+  // Terms depending on the column only are evaluated on the first line
+  std::vector<RealType> columnValues[NUMBER_OF_TERMS];
+  bool                  perPixel = false;
+  for (unsigned int t = 0; t < NUMBER_OF_TERMS; ++t)
+  {
+    if (!applied[t])
+    {
+      continue;
+    }
+    if (terms[t]->DependsOnColumnOnly())
+    {
+      columnValues[t].resize(width);
+      IndexType index = region.GetIndex();
+      for (unsigned int x = 0; x < width; ++x, ++index[0])
+      {
+        PointType point;
+        image->TransformIndexToPhysicalPoint(index, point);
+        columnValues[t][x] = static_cast<RealType>(terms[t]->Evaluate(point));
+        if (t == INCIDENCE_ANGLE)
+        {
+          columnValues[t][x] = std::sin(columnValues[t][x]);
+        }
+      }
+    }
+    else
+    {
+      perPixel = true;
+    }
+  }
+
+  // Value of an applied term at a pixel
+  auto termValue = [&](unsigned int t, unsigned int x, const PointType& point) {
+    if (!columnValues[t].empty())
+    {
+      return columnValues[t][x];
+    }
+    const RealType value = static_cast<RealType>(terms[t]->Evaluate(point));
+    return t == INCIDENCE_ANGLE ? std::sin(value) : value;
+  };
+
+  const bool            applyNoiseLut = m_ApplyLookupDataCorrection && m_EnableNoise && m_NoiseLut;
+  std::vector<RealType> lutValues(m_ApplyLookupDataCorrection ? width : 0);
+  std::vector<RealType> noiseLutValues(applyNoiseLut ? width : 0);
+
+  itk::ImageScanlineConstIterator<InputImageType> it(image, region);
+  it.GoToBegin();
+  while (!it.IsAtEnd())
+  {
+    const IndexType lineStart = it.GetIndex();
+    if (m_ApplyLookupDataCorrection)
+    {
+      m_Lut->GetValues(lineStart[0], lineStart[1], width, lutValues.data());
+      if (applyNoiseLut)
+      {
+        m_NoiseLut->GetValues(lineStart[0], lineStart[1], width, noiseLutValues.data());
+      }
+    }
+
+    PointType point;
+    IndexType index = lineStart;
+    for (unsigned int x = 0; !it.IsAtEndOfLine(); ++it, ++x, ++index[0])
+    {
+      if (perPixel)
+      {
+        image->TransformIndexToPhysicalPoint(index, point);
+      }
+
+      const std::complex<float> pVal          = it.Get();
+      const RealType            digitalNumber = std::sqrt((pVal.real() * pVal.real()) + (pVal.imag() * pVal.imag()));
+
+      RealType sigma = m_Scale * digitalNumber * digitalNumber;
+
+      if (m_EnableNoise)
+      {
+        sigma -= termValue(NOISE, x, point);
+      }
+      if (m_ApplyIncidenceAngleCorrection)
+      {
+        sigma *= termValue(INCIDENCE_ANGLE, x, point);
+      }
+      if (m_ApplyAntennaPatternGain)
+      {
+        sigma *= termValue(ANTENNA_PATTERN_NEW_GAIN, x, point);
+        sigma /= termValue(ANTENNA_PATTERN_OLD_GAIN, x, point);
+      }
+      if (m_ApplyRangeSpreadLossCorrection)
+      {
+        sigma *= termValue(RANGE_SPREAD_LOSS, x, point);
+      }
+      if (m_ApplyLookupDataCorrection)
+      {
+        if (applyNoiseLut)
+        {
+          sigma = std::max(0., sigma - noiseLutValues[x]);
+        }
+        sigma /= lutValues[x] * lutValues[x];
+      }
+      if (m_ApplyRescalingFactor)
+      {
+        sigma /= m_RescalingFactor;
+      }
+      if (sigma < 0.0)
+      {
+        sigma = 0.0;
+      }
+
+      *values++ = static_cast<OutputType>(sigma);
+    }
+    it.NextLine();
+  }
+}
+
 } // end namespace otb
 
 #endif
@@ -43,6 +43,12 @@ namespace otb
  * class. Each have a Evaluate() method and a special
  * EvaluateParametricCoefficient() which computes the actual value.
  *
+ * By default, the function is evaluated on blocks of lines: the
+ * parametric terms which only depend on the column are computed once
+ * per column, and the lookup data once per line, instead of once per
+ * pixel. Results are identical to the pixel by pixel evaluation, which
+ * can still be selected with PrecomputeLineTermsOff().
+ *
  * \see \c otb::SarParametricFunction
  * \see \c otb::SarCalibrationLookupBase
  * References (Retrieved on 08-Sept-2015)
@@ -101,6 +107,12 @@ public:
   itkSetMacro(LookupSelected, short);
   itkGetConstMacro(LookupSelected, short);
 
+  /** Evaluate the calibration on blocks of lines (default) or pixel by
+   * pixel */
+  itkSetMacro(PrecomputeLineTerms, bool);
+  itkGetConstMacro(PrecomputeLineTerms, bool);
+  itkBooleanMacro(PrecomputeLineTerms);
+
 protected:
   /** Default ctor */
   SarRadiometricCalibrationToImageFilter();
@@ -116,12 +128,16 @@ protected:
   /** Update the function list and input parameters*/
   void BeforeThreadedGenerateData() override;
 
+  /** Evaluate the function on blocks of lines of the region */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
 private:
   SarRadiometricCalibrationToImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
 
   short m_LookupSelected;
+  bool  m_PrecomputeLineTerms;
 };
 
 } // end namespace otb
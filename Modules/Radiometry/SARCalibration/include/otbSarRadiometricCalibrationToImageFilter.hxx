@@ -25,7 +25,11 @@
 #include "otbSarRadiometricCalibrationToImageFilter.h"
 #include "otbSarCalibrationLookupData.h"
 #include "otbSARMetadata.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
 #include <boost/any.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace otb
 {
@@ -34,7 +38,7 @@ namespace otb
  * Constructor
  */
 template <class TInputImage, class TOutputImage>
-SarRadiometricCalibrationToImageFilter<TInputImage, TOutputImage>::SarRadiometricCalibrationToImageFilter() : m_LookupSelected(0)
+SarRadiometricCalibrationToImageFilter<TInputImage, TOutputImage>::SarRadiometricCalibrationToImageFilter() : m_LookupSelected(0), m_PrecomputeLineTerms(true)
 {
 }
 
@@ -188,6 +192,55 @@ void SarRadiometricCalibrationToImageFilter<TInputImage, TOutputImage>::BeforeTh
   }
 }
 
+template <class TInputImage, class TOutputImage>
+void SarRadiometricCalibrationToImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                itk::ThreadIdType            threadId)
+{
+  if (!m_PrecomputeLineTerms)
+  {
+    Superclass::ThreadedGenerateData(outputRegionForThread, threadId);
+    return;
+  }
+
+  const FunctionType* function = this->GetFunction();
+  OutputImageType*    outputPtr = this->GetOutput();
+
+  // Blocks of lines are processed at once, to share the column terms
+  // while keeping the buffer of values small
+  const unsigned long width         = outputRegionForThread.GetSize(0);
+  const unsigned long nbLines       = outputRegionForThread.GetNumberOfPixels() / std::max(width, 1UL);
+  const unsigned long linesPerBlock = std::max(1UL, (1UL << 16) / std::max(width, 1UL));
+
+  std::vector<FunctionValueType> values(std::min(nbLines, linesPerBlock) * width);
+
+  itk::ProgressReporter progress(this, threadId, nbLines);
+
+  itk::ImageScanlineIterator<OutputImageType> outputIt(outputPtr, outputRegionForThread);
+  outputIt.GoToBegin();
+
+  OutputImageRegionType block = outputRegionForThread;
+  for (unsigned long line = 0; line < nbLines; line += linesPerBlock)
+  {
+    // Split the region along the second dimension only
+    const unsigned long blockLines = std::min(linesPerBlock, nbLines - line);
+    block.SetIndex(1, outputRegionForThread.GetIndex(1) + line);
+    block.SetSize(1, blockLines);
+
+    function->EvaluateAtRegion(block, values.data());
+
+    const FunctionValueType* value = values.data();
+    for (unsigned long l = 0; l < blockLines; ++l)
+    {
+      for (; !outputIt.IsAtEndOfLine(); ++outputIt, ++value)
+      {
+        outputIt.Set(static_cast<OutputImagePixelType>(*value));
+      }
+      outputIt.NextLine();
+      progress.CompletedPixel();
+    }
+  }
+}
+
 } // end namespace otb
 
 #endif
@@ -34,6 +34,7 @@ void RegisterTests()
   REGISTER_TEST(otbSarBrightnessToImageWithComplexPixelFilterTest);
   REGISTER_TEST(otbSarParametricMapFunctionTest);
   REGISTER_TEST(otbSarRadiometricCalibrationToImageFilterCompareTest);
+  REGISTER_TEST(otbSarRadiometricCalibrationToImageFilterPrecomputeLineTermsTest);
   REGISTER_TEST(otbSarBrightnessFunctor);
   REGISTER_TEST(otbSarBrightnessFunctionWithoutNoise);
   REGISTER_TEST(otbSarRadiometricCalibrationFunction);
@@ -94,5 +94,70 @@ int otbSarRadiometricCalibrationToImageFilterCompareTest(int argc, char* argv[])
   }
 
 
+  return EXIT_SUCCESS;
+}
+
+int otbSarRadiometricCalibrationToImageFilterPrecomputeLineTermsTest(int argc, char* argv[])
+{
+  const unsigned int             Dimension = 2;
+  typedef float                  RealType;
+  typedef std::complex<RealType> PixelType;
+  typedef otb::Image<PixelType, Dimension> InputImageType;
+  typedef otb::Image<RealType, Dimension>  OutputImageType;
+  typedef otb::ImageFileReader<InputImageType> ReaderType;
+  typedef otb::SarRadiometricCalibrationToImageFilter<InputImageType, OutputImageType> FilterType;
+  typedef otb::ExtractROI<RealType, RealType>                                          ExtractorType;
+  typedef otb::StreamingCompareImageFilter<OutputImageType> CompareFilterType;
+
+  if (argc < 7)
+  {
+    std::cerr << "Usage: " << argv[0] << " input enableNoise startX startY sizeX sizeY" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ReaderType::Pointer        reader      = ReaderType::New();
+  FilterType::Pointer        precomputed = FilterType::New();
+  FilterType::Pointer        perPixel    = FilterType::New();
+  ExtractorType::Pointer     extractor1  = ExtractorType::New();
+  ExtractorType::Pointer     extractor2  = ExtractorType::New();
+  CompareFilterType::Pointer compare     = CompareFilterType::New();
+
+  reader->SetFileName(argv[1]);
+  const bool enableNoise = atoi(argv[2]) != 0;
+
+  precomputed->SetInput(reader->GetOutput());
+  precomputed->SetEnableNoise(enableNoise);
+  precomputed->PrecomputeLineTermsOn();
+
+  perPixel->SetInput(reader->GetOutput());
+  perPixel->SetEnableNoise(enableNoise);
+  perPixel->PrecomputeLineTermsOff();
+
+  OutputImageType::RegionType region;
+  OutputImageType::IndexType  id;
+  id[0] = atoi(argv[3]);
+  id[1] = atoi(argv[4]);
+  OutputImageType::SizeType size;
+  size[0] = atoi(argv[5]);
+  size[1] = atoi(argv[6]);
+  region.SetIndex(id);
+  region.SetSize(size);
+
+  extractor1->SetExtractionRegion(region);
+  extractor1->SetInput(precomputed->GetOutput());
+  extractor2->SetExtractionRegion(region);
+  extractor2->SetInput(perPixel->GetOutput());
+
+  compare->SetInput1(extractor1->GetOutput());
+  compare->SetInput2(extractor2->GetOutput());
+  compare->Update();
+
+  // Both evaluations use the same arithmetic and must match exactly
+  if (compare->GetMAE() != 0.)
+  {
+    std::cout << "MAE : " << compare->GetMAE() << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
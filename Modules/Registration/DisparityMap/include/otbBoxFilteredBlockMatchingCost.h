@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbBoxFilteredBlockMatchingCost_h
+#define otbBoxFilteredBlockMatchingCost_h
+
+#include "itkMacro.h"
+#include <type_traits>
+#include <vector>
+
+namespace otb
+{
+
+namespace Functor
+{
+/** \struct HasWindowTerms
+ *  \brief Tells whether a block-matching functor can be evaluated with box filters
+ *
+ *  A functor whose metric only depends on window sums of per-pixel terms
+ *  declares the number of terms in NumberOfWindowTerms, and provides the
+ *  ComputeWindowTerms() and ComputeMetricFromWindowSums() methods.
+ *
+ * \ingroup OTBDisparityMap
+ */
+template <class TFunctor, class = void>
+struct HasWindowTerms : std::false_type
+{
+};
+
+template <class TFunctor>
+struct HasWindowTerms<TFunctor, decltype(void(TFunctor::NumberOfWindowTerms))> : std::true_type
+{
+};
+
+
+} // End Namespace Functor
+
+/** \class BoxFilteredBlockMatchingCost
+ *  \brief Evaluate a block-matching metric for a given disparity with box filters
+ *
+ *  For a given disparity, the per-pixel terms of the metric are computed
+ *  once for each pixel, and summed over the block-matching windows with
+ *  separable running sums: column sums are updated from one line to the
+ *  next, then summed along the line. The cost per pixel is thus independent
+ *  of the window size. The inner loops work on contiguous buffers of
+ *  doubles, so that the compiler can vectorize them.
+ *
+ *  As with itk::ConstantBoundaryCondition, pixels outside of the buffered
+ *  region of an image are read as zero.
+ *
+ *  The functor must provide window terms (see Functor::HasWindowTerms).
+ *  Otherwise, IsSupported is false and the class must not be used.
+ *
+ *  \sa PixelWiseBlockMatchingImageFilter
+ *
+ * \ingroup OTBDisparityMap
+ */
+template <class TInputImage, class TBlockMatchingFunctor, bool = Functor::HasWindowTerms<TBlockMatchingFunctor>::value>
+class ITK_EXPORT BoxFilteredBlockMatchingCost
+{
+public:
+  /** Standard typedefs */
+  typedef BoxFilteredBlockMatchingCost Self;
+
+  typedef TInputImage                         InputImageType;
+  typedef TBlockMatchingFunctor               BlockMatchingFunctorType;
+  typedef typename InputImageType::PixelType  InputPixelType;
+  typedef typename InputImageType::RegionType RegionType;
+  typedef typename InputImageType::IndexType  IndexType;
+  typedef typename InputImageType::SizeType   SizeType;
+  typedef typename IndexType::IndexValueType  IndexValueType;
+
+  static const bool         IsSupported   = true;
+  static const unsigned int NumberOfTerms = BlockMatchingFunctorType::NumberOfWindowTerms;
+
+  /** Constructor. The functor and the images must outlive this object. */
+  BoxFilteredBlockMatchingCost(const BlockMatchingFunctorType& functor, const InputImageType* left, const InputImageType* right, const SizeType& radius);
+
+  BoxFilteredBlockMatchingCost(const Self&) = delete;
+  Self& operator=(const Self&) = delete;
+
+  /** Set the left region where the metric is evaluated, and the disparity
+   * between the left and right images */
+  void Initialize(const RegionType& leftRegion, IndexValueType hdisparity, IndexValueType vdisparity);
+
+  /** Get the metric values along line y of the left region. Lines are
+   * computed incrementally when requested in increasing order. The
+   * returned buffer is valid until the next call. */
+  const double* GetLine(IndexValueType y);
+
+private:
+  /** Add (or remove) the terms of the given image line of the padded region to the column sums */
+  void UpdateColumnSums(IndexValueType y, double sign);
+
+  /** Read m_PaddedWidth pixels starting at the given index, outside pixels being zero */
+  void ReadLine(const InputImageType* image, const IndexType& start, double* out) const;
+
+  const BlockMatchingFunctorType& m_Functor;
+  const InputImageType*           m_LeftImage;
+  const InputImageType*           m_RightImage;
+  SizeType                        m_Radius;
+  double                          m_WindowSize;
+
+  RegionType     m_LeftRegion;
+  IndexValueType m_HorizontalDisparity;
+  IndexValueType m_VerticalDisparity;
+  IndexValueType m_PaddedWidth;
+  IndexValueType m_CurrentLine;
+  bool           m_IsLineValid;
+
+  std::vector<double> m_LeftLine;
+  std::vector<double> m_RightLine;
+  std::vector<double> m_ColumnSums;
+  std::vector<double> m_Metric;
+};
+
+/** Placeholder for functors without window terms: never used */
+template <class TInputImage, class TBlockMatchingFunctor>
+class ITK_EXPORT BoxFilteredBlockMatchingCost<TInputImage, TBlockMatchingFunctor, false>
+{
+public:
+  typedef typename TInputImage::RegionType                RegionType;
+  typedef typename TInputImage::SizeType                  SizeType;
+  typedef typename TInputImage::IndexType::IndexValueType IndexValueType;
+
+  static const bool IsSupported = false;
+
+  BoxFilteredBlockMatchingCost(const TBlockMatchingFunctor&, const TInputImage*, const TInputImage*, const SizeType&)
+  {
+  }
+
+  void Initialize(const RegionType&, IndexValueType, IndexValueType)
+  {
+  }
+
+  const double* GetLine(IndexValueType)
+  {
+    return nullptr;
+  }
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbBoxFilteredBlockMatchingCost.hxx"
+#endif
+
+#endif
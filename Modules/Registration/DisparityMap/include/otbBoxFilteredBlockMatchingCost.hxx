@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbBoxFilteredBlockMatchingCost_hxx
+#define otbBoxFilteredBlockMatchingCost_hxx
+
+#include "otbBoxFilteredBlockMatchingCost.h"
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TInputImage, class TBlockMatchingFunctor, bool TSupported>
+BoxFilteredBlockMatchingCost<TInputImage, TBlockMatchingFunctor, TSupported>::BoxFilteredBlockMatchingCost(const BlockMatchingFunctorType& functor,
+                                                                                                           const InputImageType*           left,
+                                                                                                           const InputImageType*           right,
+                                                                                                           const SizeType&                 radius)
+  : m_Functor(functor),
+    m_LeftImage(left),
+    m_RightImage(right),
+    m_Radius(radius),
+    m_WindowSize(static_cast<double>((2 * radius[0] + 1) * (2 * radius[1] + 1))),
+    m_LeftRegion(),
+    m_HorizontalDisparity(0),
+    m_VerticalDisparity(0),
+    m_PaddedWidth(0),
+    m_CurrentLine(0),
+    m_IsLineValid(false)
+{
+}
+
+template <class TInputImage, class TBlockMatchingFunctor, bool TSupported>
+void BoxFilteredBlockMatchingCost<TInputImage, TBlockMatchingFunctor, TSupported>::Initialize(const RegionType& leftRegion, IndexValueType hdisparity,
+                                                                                              IndexValueType vdisparity)
+{
+  m_LeftRegion          = leftRegion;
+  m_HorizontalDisparity = hdisparity;
+  m_VerticalDisparity   = vdisparity;
+  m_PaddedWidth         = static_cast<IndexValueType>(leftRegion.GetSize(0) + 2 * m_Radius[0]);
+  m_IsLineValid         = false;
+
+  m_LeftLine.resize(m_PaddedWidth);
+  m_RightLine.resize(m_PaddedWidth);
+  m_ColumnSums.resize(m_PaddedWidth * NumberOfTerms);
+  m_Metric.resize(leftRegion.GetSize(0));
+}
+
+template <class TInputImage, class TBlockMatchingFunctor, bool TSupported>
+const double* BoxFilteredBlockMatchingCost<TInputImage, TBlockMatchingFunctor, TSupported>::GetLine(IndexValueType y)
+{
+  if (m_IsLineValid && y == m_CurrentLine)
+  {
+    return m_Metric.data();
+  }
+
+  const IndexValueType ry = static_cast<IndexValueType>(m_Radius[1]);
+  if (m_IsLineValid && y > m_CurrentLine && y - m_CurrentLine <= 2 * ry)
+  {
+    // Slide the window down: remove the lines leaving it, add the entering ones
+    for (IndexValueType line = m_CurrentLine + 1; line <= y; ++line)
+    {
+      this->UpdateColumnSums(line - ry - 1, -1.);
+      this->UpdateColumnSums(line + ry, 1.);
+    }
+  }
+  else
+  {
+    // Compute the column sums from scratch
+    std::fill(m_ColumnSums.begin(), m_ColumnSums.end(), 0.);
+    for (IndexValueType line = y - ry; line <= y + ry; ++line)
+    {
+      this->UpdateColumnSums(line, 1.);
+    }
+  }
+  m_CurrentLine = y;
+  m_IsLineValid = true;
+
+  // Running sum of the column sums along the line
+  const IndexValueType wx    = static_cast<IndexValueType>(2 * m_Radius[0] + 1);
+  const IndexValueType width = static_cast<IndexValueType>(m_LeftRegion.GetSize(0));
+  const double*        cols  = m_ColumnSums.data();
+
+  double sums[NumberOfTerms];
+  std::fill(sums, sums + NumberOfTerms, 0.);
+  for (IndexValueType x = 0; x < wx; ++x)
+  {
+    for (unsigned int k = 0; k < NumberOfTerms; ++k)
+    {
+      sums[k] += cols[x * NumberOfTerms + k];
+    }
+  }
+  for (IndexValueType x = 0; x < width; ++x)
+  {
+    if (x > 0)
+    {
+      const double* entering = cols + (x + wx - 1) * NumberOfTerms;
+      const double* leaving  = cols + (x - 1) * NumberOfTerms;
+      for (unsigned int k = 0; k < NumberOfTerms; ++k)
+      {
+        sums[k] += entering[k] - leaving[k];
+      }
+    }
+    m_Metric[x] = m_Functor.ComputeMetricFromWindowSums(sums, m_WindowSize);
+  }
+  return m_Metric.data();
+}
+
+template <class TInputImage, class TBlockMatchingFunctor, bool TSupported>
+void BoxFilteredBlockMatchingCost<TInputImage, TBlockMatchingFunctor, TSupported>::UpdateColumnSums(IndexValueType y, double sign)
+{
+  IndexType leftStart;
+  leftStart[0] = m_LeftRegion.GetIndex(0) - static_cast<IndexValueType>(m_Radius[0]);
+  leftStart[1] = y;
+
+  IndexType rightStart;
+  rightStart[0] = leftStart[0] + m_HorizontalDisparity;
+  rightStart[1] = leftStart[1] + m_VerticalDisparity;
+
+  this->ReadLine(m_LeftImage, leftStart, m_LeftLine.data());
+  this->ReadLine(m_RightImage, rightStart, m_RightLine.data());
+
+  const double* left  = m_LeftLine.data();
+  const double* right = m_RightLine.data();
+  double*       cols  = m_ColumnSums.data();
+  for (IndexValueType x = 0; x < m_PaddedWidth; ++x)
+  {
+    double terms[NumberOfTerms];
+    m_Functor.ComputeWindowTerms(left[x], right[x], terms);
+    for (unsigned int k = 0; k < NumberOfTerms; ++k)
+    {
+      cols[x * NumberOfTerms + k] += sign * terms[k];
+    }
+  }
+}
+
+template <class TInputImage, class TBlockMatchingFunctor, bool TSupported>
+void BoxFilteredBlockMatchingCost<TInputImage, TBlockMatchingFunctor, TSupported>::ReadLine(const InputImageType* image, const IndexType& start,
+                                                                                            double* out) const
+{
+  std::fill(out, out + m_PaddedWidth, 0.);
+
+  const RegionType&    buffered = image->GetBufferedRegion();
+  const IndexValueType firstY   = buffered.GetIndex(1);
+  const IndexValueType endY     = firstY + static_cast<IndexValueType>(buffered.GetSize(1));
+  if (start[1] < firstY || start[1] >= endY)
+  {
+    return;
+  }
+
+  const IndexValueType first = std::max(start[0], buffered.GetIndex(0));
+  const IndexValueType end   = std::min(start[0] + m_PaddedWidth, buffered.GetIndex(0) + static_cast<IndexValueType>(buffered.GetSize(0)));
+  if (first >= end)
+  {
+    return;
+  }
+
+  IndexType firstIndex;
+  firstIndex[0] = first;
+  firstIndex[1] = start[1];
+
+  const InputPixelType* in = image->GetBufferPointer() + image->ComputeOffset(firstIndex);
+  std::transform(in, in + (end - first), out + (first - start[0]), [](const InputPixelType& value) { return static_cast<double>(value); });
+}
+
+} // End namespace otb
+
+#endif
@@ -26,6 +26,8 @@
 #include "itkConstNeighborhoodIterator.h"
 #include "itkImageRegionIterator.h"
 #include "otbImage.h"
+#include "otbBoxFilteredBlockMatchingCost.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -63,6 +65,20 @@ public:
 
     return ssd;
   }
+
+  /** The SSD is the window sum of a single term, which allows the
+   * box-filtered evaluation (see PixelWiseBlockMatchingImageFilter) */
+  static const unsigned int NumberOfWindowTerms = 1;
+
+  inline void ComputeWindowTerms(double a, double b, double* terms) const
+  {
+    terms[0] = (a - b) * (a - b);
+  }
+
+  inline MetricValueType ComputeMetricFromWindowSums(const double* sums, double itkNotUsed(size)) const
+  {
+    return static_cast<MetricValueType>(sums[0]);
+  }
 };
 
 
@@ -178,6 +194,38 @@ public:
 
     return static_cast<MetricValueType>(ncc);
   }
+
+  /** The NCC only depends on the window sums of a, b, a^2, b^2 and ab,
+   * which allows the box-filtered evaluation (see
+   * PixelWiseBlockMatchingImageFilter) */
+  static const unsigned int NumberOfWindowTerms = 5;
+
+  inline void ComputeWindowTerms(double a, double b, double* terms) const
+  {
+    terms[0] = a;
+    terms[1] = b;
+    terms[2] = a * a;
+    terms[3] = b * b;
+    terms[4] = a * b;
+  }
+
+  inline MetricValueType ComputeMetricFromWindowSums(const double* sums, double size) const
+  {
+    // Centered moments, scaled by size * (size - 1). The numerators are
+    // exact for integer pixel values.
+    const double norm   = size * (size - 1);
+    const double cov    = (size * sums[4] - sums[0] * sums[1]) / norm;
+    const double sigmaA = std::sqrt(std::max(size * sums[2] - sums[0] * sums[0], 0.) / norm);
+    const double sigmaB = std::sqrt(std::max(size * sums[3] - sums[1] * sums[1], 0.) / norm);
+
+    double ncc = 0.0;
+    if (sigmaA > 1e-20 && sigmaB > 1e-20)
+    {
+      ncc = std::abs(cov) / (sigmaA * sigmaB);
+    }
+
+    return static_cast<MetricValueType>(ncc);
+  }
 };
 
 /** \class LPBlockMatching
@@ -282,6 +330,14 @@ private:
  *  an exploration radius indicates the disparity range to be explored around
  *  the initial estimate (global minimum and maximum values are still in use).
  *
+ *  When BoxFilteringOn() is set and the functor provides window terms (this
+ *  is the case of SSDBlockMatching and NCCBlockMatching), the metric is
+ *  computed for each disparity with box filters (see
+ *  BoxFilteredBlockMatchingCost) instead of being evaluated on each window,
+ *  so that its cost does not depend on the radius. The results are the same
+ *  up to floating-point rounding. Other functors are always evaluated on
+ *  each window.
+ *
  *  \sa FineRegistrationImageFilter
  *  \sa StereorectificationDisplacementFieldSource
  *  \sa SubPixelDisparityImageFilter
@@ -390,6 +446,12 @@ public:
   itkGetConstReferenceMacro(Minimize, bool);
   itkBooleanMacro(Minimize);
 
+  /** Set/Get the use of box filters to compute the metric, if the functor
+   * supports it */
+  itkSetMacro(BoxFiltering, bool);
+  itkGetConstReferenceMacro(BoxFiltering, bool);
+  itkBooleanMacro(BoxFiltering);
+
   /** Set/Get the exploration radius in the disparity space */
   itkSetMacro(ExplorationRadius, SizeType);
   itkGetConstReferenceMacro(ExplorationRadius, SizeType);
@@ -479,6 +541,9 @@ private:
   /** Should we minimize or maximize ? */
   bool m_Minimize;
 
+  /** Compute the metric with box filters (if supported by the functor) */
+  bool m_BoxFiltering;
+
   /** The exploration radius for disparities (used if non null) */
   SizeType m_ExplorationRadius;
 
@@ -47,6 +47,9 @@ PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDispar
   // Minimize by default
   m_Minimize = true;
 
+  // Evaluate the functor on each window by default
+  m_BoxFiltering = false;
+
   // Default disparity range
   m_MinimumHorizontalDisparity = -10;
   m_MaximumHorizontalDisparity = 10;
@@ -514,6 +517,18 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
   // step value as disparityType
   DisparityPixelType stepDisparityInv = 1. / static_cast<DisparityPixelType>(this->m_Step);
 
+  // Use box filters to compute the metric if possible. In that case, the
+  // neighborhood iterators are only used to walk the region.
+  typedef BoxFilteredBlockMatchingCost<TInputImage, TBlockMatchingFunctor> BoxFilteredCostType;
+  const bool          useBoxFiltering = m_BoxFiltering && BoxFilteredCostType::IsSupported;
+  BoxFilteredCostType boxFilteredCost(m_Functor, inLeftPtr, inRightPtr, m_Radius);
+
+  SizeType iteratorRadius = m_Radius;
+  if (useBoxFiltering)
+  {
+    iteratorRadius.Fill(0);
+  }
+
   // We loop on disparities
   for (int vdisparity = m_MinimumVerticalDisparity; vdisparity <= m_MaximumVerticalDisparity; ++vdisparity)
   {
@@ -542,9 +557,14 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
       // Compute the equivalent region in subsampled grid
       RegionType outputRegion = this->ConvertFullToSubsampledRegion(inputLeftRegion, this->m_Step, this->m_GridIndex);
 
+      if (useBoxFiltering)
+      {
+        boxFilteredCost.Initialize(inputLeftRegion, hdisparity, vdisparity);
+      }
+
       // Define iterators
-      itk::ConstNeighborhoodIterator<TInputImage>          leftIt(m_Radius, inLeftPtr, inputLeftRegion);
-      itk::ConstNeighborhoodIterator<TInputImage>          rightIt(m_Radius, inRightPtr, inputRightRegion);
+      itk::ConstNeighborhoodIterator<TInputImage>          leftIt(iteratorRadius, inLeftPtr, inputLeftRegion);
+      itk::ConstNeighborhoodIterator<TInputImage>          rightIt(iteratorRadius, inRightPtr, inputRightRegion);
       itk::ImageRegionIterator<TOutputMetricImage>         outMetricIt(outMetricPtr, outputRegion);
       itk::ImageRegionIterator<TOutputDisparityImage>      outHDispIt(outHDispPtr, outputRegion);
       itk::ImageRegionIterator<TOutputDisparityImage>      outVDispIt(outVDispPtr, outputRegion);
@@ -637,7 +657,15 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
               if (vdisparity >= estimatedMinVDisp && vdisparity <= estimatedMaxVDisp && hdisparity >= estimatedMinHDisp && hdisparity <= estimatedMaxHDisp)
               {
                 // Compute the block matching value
-                double metric = m_Functor(leftIt, rightIt);
+                double metric;
+                if (useBoxFiltering)
+                {
+                  metric = boxFilteredCost.GetLine(tmpIndex[1])[tmpIndex[0] - inputLeftRegion.GetIndex(0)];
+                }
+                else
+                {
+                  metric = m_Functor(leftIt, rightIt);
+                }
 
                 // If we are at first loop, fill both outputs
                 // We adapt the disparity value to keep consistent with disparity map index space
@@ -33,4 +33,5 @@ void RegisterTests()
   REGISTER_TEST(otbNCCRegistrationFilter);
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilter);
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterNCC);
+  REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterBoxFiltering);
 }
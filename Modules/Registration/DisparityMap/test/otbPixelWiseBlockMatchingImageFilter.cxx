@@ -23,6 +23,12 @@
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
 #include "otbStandardWriterWatcher.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
 
 typedef otb::Image<unsigned short>           ImageType;
 typedef otb::Image<float>                    FloatImageType;
@@ -120,3 +126,119 @@ int otbPixelWiseBlockMatchingImageFilterNCC(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+namespace
+{
+// Run the block-matching with and without box filtering, and compare the outputs
+template <class TFilter>
+bool CompareBoxFiltering(const ImageType* left, const ImageType* right, const ImageType* mask, unsigned int radius, unsigned int step, bool minimize,
+                         unsigned int explorationRadius)
+{
+  typename TFilter::Pointer filters[2];
+  for (unsigned int k = 0; k < 2; ++k)
+  {
+    filters[k] = TFilter::New();
+    filters[k]->SetLeftInput(left);
+    filters[k]->SetRightInput(right);
+    filters[k]->SetLeftMaskInput(mask);
+    filters[k]->SetRadius(radius);
+    filters[k]->SetMinimumHorizontalDisparity(-4);
+    filters[k]->SetMaximumHorizontalDisparity(5);
+    filters[k]->SetMinimumVerticalDisparity(-1);
+    filters[k]->SetMaximumVerticalDisparity(1);
+    filters[k]->SetStep(step);
+    filters[k]->SetMinimize(minimize);
+    typename TFilter::SizeType expRadius;
+    expRadius.Fill(explorationRadius);
+    filters[k]->SetExplorationRadius(expRadius);
+    filters[k]->SetInitHorizontalDisparity(1);
+    filters[k]->SetBoxFiltering(k == 1);
+    filters[k]->Update();
+  }
+
+  typedef itk::ImageRegionConstIterator<FloatImageType> IteratorType;
+  const FloatImageType* metric[2] = {filters[0]->GetMetricOutput(), filters[1]->GetMetricOutput()};
+  const FloatImageType* hdisp[2]  = {filters[0]->GetHorizontalDisparityOutput(), filters[1]->GetHorizontalDisparityOutput()};
+  const FloatImageType* vdisp[2]  = {filters[0]->GetVerticalDisparityOutput(), filters[1]->GetVerticalDisparityOutput()};
+
+  itk::ImageRegionConstIteratorWithIndex<FloatImageType> metricIt(metric[0], metric[0]->GetBufferedRegion());
+  IteratorType                                           boxMetricIt(metric[1], metric[1]->GetBufferedRegion());
+  IteratorType                                           hdispIt(hdisp[0], hdisp[0]->GetBufferedRegion());
+  IteratorType                                           boxHDispIt(hdisp[1], hdisp[1]->GetBufferedRegion());
+  IteratorType                                           vdispIt(vdisp[0], vdisp[0]->GetBufferedRegion());
+  IteratorType                                           boxVDispIt(vdisp[1], vdisp[1]->GetBufferedRegion());
+
+  for (; !metricIt.IsAtEnd(); ++metricIt, ++boxMetricIt, ++hdispIt, ++boxHDispIt, ++vdispIt, ++boxVDispIt)
+  {
+    const double value = metricIt.Get();
+    if (std::abs(boxMetricIt.Get() - value) > 1e-5 * std::max(1., std::abs(value)))
+    {
+      std::cerr << "Metric differs at " << metricIt.GetIndex() << ": " << boxMetricIt.Get() << " instead of " << value << std::endl;
+      return false;
+    }
+    // Equal metrics may lead to different disparities through rounding:
+    // only exact metrics are expected to give the same disparities
+    if (boxMetricIt.Get() == value && (boxHDispIt.Get() != hdispIt.Get() || boxVDispIt.Get() != vdispIt.Get()))
+    {
+      std::cerr << "Disparity differs at " << metricIt.GetIndex() << ": (" << boxHDispIt.Get() << ", " << boxVDispIt.Get() << ") instead of ("
+                << hdispIt.Get() << ", " << vdispIt.Get() << ")" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int otbPixelWiseBlockMatchingImageFilterBoxFiltering(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // Right image is the left one shifted by (2, 1), with noise. Values are
+  // small enough for the SSD to be exact in single precision.
+  ImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, 61);
+  region.SetSize(1, 47);
+
+  ImageType::Pointer left  = ImageType::New();
+  ImageType::Pointer right = ImageType::New();
+  ImageType::Pointer mask  = ImageType::New();
+  for (ImageType* image : {left.GetPointer(), right.GetPointer(), mask.GetPointer()})
+  {
+    image->SetRegions(region);
+    image->Allocate();
+  }
+
+  std::mt19937                       generator(0);
+  std::uniform_int_distribution<int> values(0, 200);
+  std::uniform_int_distribution<int> noise(0, 20);
+  for (itk::ImageRegionIterator<ImageType> it(left, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(values(generator));
+  }
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(right, region); !it.IsAtEnd(); ++it)
+  {
+    ImageType::IndexType index = it.GetIndex();
+    index[0] -= 2;
+    index[1] -= 1;
+    it.Set(region.IsInside(index) ? left->GetPixel(index) + noise(generator) : values(generator));
+  }
+  for (itk::ImageRegionIterator<ImageType> it(mask, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(noise(generator) > 2);
+  }
+
+  bool ok = true;
+  for (unsigned int radius = 1; radius <= 3; radius += 2)
+  {
+    for (unsigned int step = 1; step <= 2; ++step)
+    {
+      for (unsigned int explorationRadius = 0; explorationRadius <= 2; explorationRadius += 2)
+      {
+        ok = ok && CompareBoxFiltering<PixelWiseBlockMatchingImageFilterType>(left, right, mask, radius, step, true, explorationRadius);
+        ok = ok && CompareBoxFiltering<PixelWiseNCCBlockMatchingImageFilterType>(left, right, mask, radius, step, false, explorationRadius);
+      }
+    }
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -146,8 +146,8 @@ void StereoSensorModelToElevationFilter<TInputImage, TOutputHeight>::GenerateInp
 
   // Build the transform to switch from the master to the slave image
   typename GenericRSTransformType::Pointer transform = GenericRSTransformType::New();
-  transform->SetInputImageMetadata(&(masterPtr->GetImageMetadata()));
-  transform->SetOutputImageMetadata(&(slavePtr->GetImageMetadata()));
+  transform->SetInputImageMetadata(&(this->GetMasterInput()->GetImageMetadata()));
+  transform->SetOutputImageMetadata(&(this->GetSlaveInput()->GetImageMetadata()));
 
   transform->InstantiateTransform();
 
@@ -266,7 +266,7 @@ void StereoSensorModelToElevationFilter<TInputImage, TOutputHeight>::BeforeThrea
   OutputImageType* outputPtr = this->GetOutput();
 
   typename GenericRSTransformType::Pointer rsTransform = GenericRSTransformType::New();
-  rsTransform->SetInputImageMetadata(&(outputPtr->GetImageMetadata()));
+  rsTransform->SetInputImageMetadata(&(static_cast<const OutputImageType*>(outputPtr)->GetImageMetadata()));
   rsTransform->InstantiateTransform();
 
   // Fill output
@@ -117,6 +117,8 @@ void StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::Gene
   // Ensure input images have up-to-date information
   m_LeftImage->UpdateOutputInformation();
   m_RightImage->UpdateOutputInformation();
+  const InputImageType* leftImage  = m_LeftImage;
+  const InputImageType* rightImage = m_RightImage;
 
   // Setup the DEM handler if needed
   auto & demHandler = DEMHandler::GetInstance();
@@ -124,7 +126,7 @@ void StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::Gene
   // Set-up a transform to use the DEMHandler
   typedef otb::GenericRSTransform<> RSTransform2DType;
   RSTransform2DType::Pointer        leftToGroundTransform = RSTransform2DType::New();
-  leftToGroundTransform->SetInputImageMetadata(&(m_LeftImage->GetImageMetadata()));
+  leftToGroundTransform->SetInputImageMetadata(&(leftImage->GetImageMetadata()));
 
   leftToGroundTransform->InstantiateTransform();
 
@@ -133,12 +135,12 @@ void StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::Gene
   OutputImageType* rightDFPtr = this->GetRightDisplacementFieldOutput();
 
   // Set up the RS transforms
-  m_LeftToRightTransform->SetInputImageMetadata(&(m_LeftImage->GetImageMetadata()));
-  m_LeftToRightTransform->SetOutputImageMetadata(&(m_RightImage->GetImageMetadata()));
+  m_LeftToRightTransform->SetInputImageMetadata(&(leftImage->GetImageMetadata()));
+  m_LeftToRightTransform->SetOutputImageMetadata(&(rightImage->GetImageMetadata()));
   m_LeftToRightTransform->InstantiateTransform();
 
-  m_RightToLeftTransform->SetInputImageMetadata(&(m_RightImage->GetImageMetadata()));
-  m_RightToLeftTransform->SetOutputImageMetadata(&(m_LeftImage->GetImageMetadata()));
+  m_RightToLeftTransform->SetInputImageMetadata(&(rightImage->GetImageMetadata()));
+  m_RightToLeftTransform->SetOutputImageMetadata(&(leftImage->GetImageMetadata()));
   m_RightToLeftTransform->InstantiateTransform();
 
   // Now, we must determine the optimized size, spacing and origin of the
@@ -301,8 +303,9 @@ void StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::Gene
   // Set-up a transform to use the DEMHandler
   typedef otb::GenericRSTransform<> RSTransform2DType;
   RSTransform2DType::Pointer        leftToGroundTransform = RSTransform2DType::New();
+  const InputImageType*             leftImage             = m_LeftImage;
 
-  leftToGroundTransform->SetInputImageMetadata(&(m_LeftImage->GetImageMetadata()));
+  leftToGroundTransform->SetInputImageMetadata(&(leftImage->GetImageMetadata()));
 
   leftToGroundTransform->InstantiateTransform();
 
@@ -311,7 +314,8 @@ void StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::Gene
   OutputImageType* rightDFPtr = this->GetRightDisplacementFieldOutput();
 
   // Declare all the TDPoint variables we will need
-  TDPointType currentPoint1, currentPoint2, nextLineStart1, nextLineStart2, startLine1, endLine1, startLine2, endLine2, epiPoint1, epiPoint2;
+  TDPointType currentPoint1, currentPoint2, nextLineStart1, nextLineStart2, startLine1, endLine1;
+  TDPointType epiPoints2[2], epiLine1[2];
 
   // Then, we retrieve the origin of the left input image
   double localElevation = demHandler.GetDefaultHeightAboveEllipsoid();
@@ -389,19 +393,18 @@ void StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::Gene
 
     // First, for image 1
 
-    // This point is the image of the left input image origin at the
-    // average elevation
-    epiPoint2 = m_LeftToRightTransform->TransformPoint(currentPoint1);
-
-    // The beginning of the epipolar line in the left image is the image
-    // of epiPoint2 at a lower elevation (using the offset)
-    epiPoint2[2] = localElevation - m_ElevationOffset;
-    startLine1   = m_RightToLeftTransform->TransformPoint(epiPoint2);
-
-    // The endning of the epipolar line in the left image is the image
-    // of epiPoint2 at a higher elevation (using the offset)
-    epiPoint2[2] = localElevation + m_ElevationOffset;
-    endLine1     = m_RightToLeftTransform->TransformPoint(epiPoint2);
+    // epiPoint2 is the image of currentPoint1 in the right image, which is
+    // currentPoint2 by construction. The beginning (resp. the end) of the
+    // epipolar line in the left image is the image of epiPoint2 at a lower
+    // (resp. higher) elevation, using the offset. Both ends are computed
+    // with a single call.
+    epiPoints2[0]    = currentPoint2;
+    epiPoints2[0][2] = localElevation - m_ElevationOffset;
+    epiPoints2[1]    = currentPoint2;
+    epiPoints2[1][2] = localElevation + m_ElevationOffset;
+    m_RightToLeftTransform->TransformPoints(Span<const TDPointType>(epiPoints2, 2), Span<TDPointType>(epiLine1, 2));
+    startLine1 = epiLine1[0];
+    endLine1   = epiLine1[1];
 
     // Estimate the local baseline ratio
     double localBaselineRatio =
@@ -437,16 +440,6 @@ void StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::Gene
       }
     }
 
-    // We do the same for image 2
-    currentPoint2[2] = localElevation;
-    epiPoint1        = m_RightToLeftTransform->TransformPoint(currentPoint2);
-
-    epiPoint1[2] = localElevation - m_ElevationOffset;
-    startLine2   = m_LeftToRightTransform->TransformPoint(epiPoint1);
-
-    epiPoint1[2] = localElevation + m_ElevationOffset;
-    endLine2     = m_LeftToRightTransform->TransformPoint(epiPoint1);
-
     // 4 - Determine position of next points
 
     // We want to move m_Scale pixels away in the epipolar line of the
@@ -26,6 +26,8 @@
 #include "itkImageToImageFilter.h"
 
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace otb
 {
@@ -36,6 +38,17 @@ namespace otb
  * This class merges regions in the input label image according to the input
  * image of spectral values and the RangeBandwidth parameter.
  *
+ * Merging is iterative: at each iteration, all the pairs of adjacent regions
+ * whose spectral values are closer than half the RangeBandwidth are merged,
+ * and the spectral value of each merged region is the mean of its pixels.
+ * Iterations stop when no more regions are merged (or after 10 iterations).
+ *
+ * The region adjacency graph is extracted from the label image only once,
+ * as a sorted list of edges. Each iteration merges regions with a union-find
+ * over these edges, then contracts the edges, so that the label image is
+ * only relabeled at the end. The merge throughput is reported in the debug
+ * log.
+ *
  *
  * \ingroup ImageSegmentation
  *
@@ -90,6 +103,10 @@ public:
   typedef std::set<LabelType>                      AdjacentLabelsContainerType;
   typedef std::vector<AdjacentLabelsContainerType> RegionAdjacencyMapType;
 
+  /** Typedefs for the list of edges of the region adjacency graph */
+  typedef std::pair<LabelType, LabelType> RegionEdgeType;
+  typedef std::vector<RegionEdgeType>     RegionEdgeListType;
+
 
   /** Setters / Getters */
   itkSetMacro(RangeBandwidth, RealType);
@@ -132,6 +149,10 @@ protected:
   /** Method to build a map of adjacent regions */
   RegionAdjacencyMapType LabelImageToRegionAdjacencyMap(typename OutputLabelImageType::Pointer inputLabelImage);
 
+  /** Method to build the sorted list of edges (l1 < l2) between adjacent regions.
+   * The adjacencies are the same as the ones of LabelImageToRegionAdjacencyMap(). */
+  RegionEdgeListType LabelImageToRegionEdges(const InputLabelImageType* labelImage, LabelType& maxLabel);
+
 private:
   LabelImageRegionMergingFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
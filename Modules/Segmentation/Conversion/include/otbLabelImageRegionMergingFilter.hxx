@@ -26,6 +26,10 @@
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
+#include "otbMacro.h"
+#include "otbStopwatch.h"
+
+#include <algorithm>
 
 
 namespace otb
@@ -161,21 +165,14 @@ void LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutpu
 
   m_NumberOfComponentsPerPixel = spectralImage->GetNumberOfComponentsPerPixel();
 
-  // std::cout << "Copy input label image to output label image" << std::endl;
-  // Copy input label image to output label image
-  typename itk::ImageRegionConstIterator<InputLabelImageType> inputIt(inputLabelImage, outputLabelImage->GetRequestedRegion());
-  typename itk::ImageRegionIterator<OutputLabelImageType>     outputIt(outputLabelImage, outputLabelImage->GetRequestedRegion());
-  inputIt.GoToBegin();
-  outputIt.GoToBegin();
-  while (!inputIt.IsAtEnd())
-  {
-    outputIt.Set(inputIt.Get());
-    ++inputIt;
-    ++outputIt;
-  }
+  otb::Stopwatch chrono = otb::Stopwatch::StartNew();
 
-  RegionAdjacencyMapType regionAdjacencyMap = LabelImageToRegionAdjacencyMap(outputLabelImage);
-  unsigned int           regionCount        = regionAdjacencyMap.size() - 1;
+  LabelType          maxLabel    = 0;
+  RegionEdgeListType edges       = LabelImageToRegionEdges(inputLabelImage, maxLabel);
+  unsigned int       regionCount = maxLabel;
+
+  const unsigned int initialRegionCount = regionCount;
+  const std::size_t  initialEdgeCount   = edges.size();
 
   // Initialize arrays for mode information
   m_CanonicalLabels.clear();
@@ -207,112 +204,87 @@ void LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutpu
     m_PointCounts[label]++;
     ++inputItWithIndex;
   }
+
+  // Current label of each input label: the label image is only relabeled
+  // once merging is finished
+  std::vector<LabelType> currentLabels(regionCount + 1);
+  for (unsigned int i = 0; i < regionCount + 1; ++i)
+  {
+    currentLabels[i] = i;
+  }
+
   // Region Merging
 
   bool         finishedMerging = false;
   unsigned int mergeIterations = 0;
 
-  // std::cout << "Start merging" << std::endl;
   // Iterate until no more merge to do
-  // while(!finishedMerging)
-  //   {
   while (!finishedMerging)
   {
-
     // Initialize Canonical Labels
-    for (LabelType curLabel       = 1; curLabel <= regionCount; ++curLabel)
+    for (LabelType curLabel = 0; curLabel <= regionCount; ++curLabel)
       m_CanonicalLabels[curLabel] = curLabel;
 
-    // Iterate over all regions
-
-    for (LabelType curLabel = 1; curLabel <= regionCount; ++curLabel)
+    // Merge all the pairs of similar adjacent regions. The canonical label of
+    // a group of merged regions is its smallest label.
+    for (typename RegionEdgeListType::const_iterator edgeIt = edges.begin(); edgeIt != edges.end(); ++edgeIt)
     {
+      const SpectralPixelType& curSpectral = m_Modes[edgeIt->first];
+      const SpectralPixelType& adjSpectral = m_Modes[edgeIt->second];
 
-      if (m_PointCounts[curLabel] == 0)
+      // Check condition to merge regions
+      RealType norm2 = 0;
+      for (unsigned int comp = 0; comp < m_NumberOfComponentsPerPixel; ++comp)
       {
-        // do not process empty regions
-        continue;
+        RealType e;
+        e = (curSpectral[comp] - adjSpectral[comp]) / m_RangeBandwidth;
+        norm2 += e * e;
       }
-      // std::cout<<" point in label "<<curLabel<<" "<<m_PointCounts[curLabel]<<std::endl;
-      const SpectralPixelType& curSpectral = m_Modes[curLabel];
 
-      // Iterate over all adjacent regions and check for merge
-      typename AdjacentLabelsContainerType::const_iterator adjIt = regionAdjacencyMap[curLabel].begin();
-      while (adjIt != regionAdjacencyMap[curLabel].end())
+      if (norm2 < 0.25)
       {
-        LabelType adjLabel = *adjIt;
-        assert(adjLabel <= regionCount);
-        const SpectralPixelType& adjSpectral = m_Modes[adjLabel];
-        // Check condition to merge regions
-        bool     isSimilar = true;
-        RealType norm2     = 0;
-        for (unsigned int comp = 0; comp < m_NumberOfComponentsPerPixel; ++comp)
+        // Find canonical labels, with path halving
+        LabelType curCanLabel = edgeIt->first;
+        while (m_CanonicalLabels[curCanLabel] != curCanLabel)
+        {
+          m_CanonicalLabels[curCanLabel] = m_CanonicalLabels[m_CanonicalLabels[curCanLabel]];
+          curCanLabel                    = m_CanonicalLabels[curCanLabel];
+        }
+        LabelType adjCanLabel = edgeIt->second;
+        while (m_CanonicalLabels[adjCanLabel] != adjCanLabel)
         {
-          RealType e;
-          e = (curSpectral[comp] - adjSpectral[comp]) / m_RangeBandwidth;
-          norm2 += e * e;
+          m_CanonicalLabels[adjCanLabel] = m_CanonicalLabels[m_CanonicalLabels[adjCanLabel]];
+          adjCanLabel                    = m_CanonicalLabels[adjCanLabel];
         }
-        isSimilar = norm2 < 0.25;
 
-        if (isSimilar)
+        // Assign same canonical label to both regions
+        if (curCanLabel < adjCanLabel)
         {
-          // Find canonical label for current region
-          LabelType curCanLabel = curLabel; // m_CanonicalLabels[curLabel];
-          while (m_CanonicalLabels[curCanLabel] != curCanLabel)
-          {
-            curCanLabel = m_CanonicalLabels[curCanLabel];
-          }
-
-          // Find canonical label for adjacent region
-          LabelType adjCanLabel = adjLabel; // m_CanonicalLabels[curLabel];
-          while (m_CanonicalLabels[adjCanLabel] != adjCanLabel)
-          {
-            adjCanLabel = m_CanonicalLabels[adjCanLabel];
-          }
-
-          // Assign same canonical label to both regions
-          if (curCanLabel < adjCanLabel)
-          {
-            m_CanonicalLabels[adjCanLabel] = curCanLabel;
-          }
-          else
-          {
-            m_CanonicalLabels[m_CanonicalLabels[curCanLabel]] = adjCanLabel;
-            m_CanonicalLabels[curCanLabel]                    = adjCanLabel;
-          }
+          m_CanonicalLabels[adjCanLabel] = curCanLabel;
         }
-        ++adjIt;
-      } // end of loop over adjacent labels
-    }   // end of loop over labels
+        else
+        {
+          m_CanonicalLabels[curCanLabel] = adjCanLabel;
+        }
+      }
+    } // end of loop over edges
 
-    // std::cout << "Simplify the table of canonical labels" << std::endl;
     /* Simplify the table of canonical labels */
     for (LabelType i = 1; i < regionCount + 1; ++i)
     {
-      LabelType can = i;
-      while (m_CanonicalLabels[can] != can)
-      {
-        can = m_CanonicalLabels[can];
-      }
-      m_CanonicalLabels[i] = can;
+      m_CanonicalLabels[i] = m_CanonicalLabels[m_CanonicalLabels[i]];
     }
 
-    // std::cout << "merge regions with same canonical label" << std::endl;
     /* Merge regions with same canonical label */
     /* - update modes and point counts */
     std::vector<SpectralPixelType> newModes;
-    newModes.reserve(regionCount + 1); //(regionCount+1, SpectralPixelType(m_NumberOfComponentsPerPixel));
+    newModes.reserve(regionCount + 1);
     for (unsigned int i = 0; i < regionCount + 1; ++i)
     {
       newModes.push_back(SpectralPixelType(m_NumberOfComponentsPerPixel));
+      newModes.back().Fill(0);
     }
-    std::vector<unsigned int> newPointCounts(regionCount + 1);
-
-    for (unsigned int i = 1; i < regionCount + 1; ++i)
-    {
-      newModes[i].Fill(0);
-      newPointCounts[i] = 0;
-    }
+    std::vector<unsigned int> newPointCounts(regionCount + 1, 0);
 
     for (unsigned int i = 1; i < regionCount + 1; ++i)
     {
@@ -325,14 +297,9 @@ void LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutpu
       newPointCounts[canLabel] += nPoints;
     }
 
-    // std::cout << "re-labeling" << std::endl;
     /* re-labeling */
-    std::vector<LabelType> newLabels(regionCount + 1);
-    std::vector<bool>      newLabelSet(regionCount + 1);
-    for (unsigned int i = 1; i < regionCount + 1; ++i)
-    {
-      newLabelSet[i] = false;
-    }
+    std::vector<LabelType> newLabels(regionCount + 1, 0);
+    std::vector<bool>      newLabelSet(regionCount + 1, false);
 
     LabelType label = 0;
     for (unsigned int i = 1; i < regionCount + 1; ++i)
@@ -356,46 +323,57 @@ void LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutpu
     unsigned int oldRegionCount = regionCount;
     regionCount                 = label;
 
-    /* reassign labels in label image */
-    outputIt.GoToBegin();
-    while (!outputIt.IsAtEnd())
+    /* reassign labels */
+    for (unsigned int i = 0; i < currentLabels.size(); ++i)
     {
-
-      LabelType l = outputIt.Get();
-      LabelType canLabel;
-      assert(m_CanonicalLabels[l] <= oldRegionCount);
-      canLabel = newLabels[m_CanonicalLabels[l]];
-      outputIt.Set(canLabel);
-
-      ++outputIt;
+      assert(m_CanonicalLabels[currentLabels[i]] <= oldRegionCount);
+      currentLabels[i] = newLabels[m_CanonicalLabels[currentLabels[i]]];
     }
 
     finishedMerging = oldRegionCount == regionCount || mergeIterations >= 10 || regionCount == 1;
 
-    // only one iteration for now
-
     if (!finishedMerging)
     {
-      /* Update adjacency table */
-      regionAdjacencyMap = LabelImageToRegionAdjacencyMap(outputLabelImage);
+      /* Update adjacency: contract the edges of the merged regions */
+      typename RegionEdgeListType::iterator outEdgeIt = edges.begin();
+      for (typename RegionEdgeListType::const_iterator edgeIt = edges.begin(); edgeIt != edges.end(); ++edgeIt)
+      {
+        LabelType l1 = newLabels[m_CanonicalLabels[edgeIt->first]];
+        LabelType l2 = newLabels[m_CanonicalLabels[edgeIt->second]];
+        if (l1 != l2)
+        {
+          *outEdgeIt = RegionEdgeType(std::min(l1, l2), std::max(l1, l2));
+          ++outEdgeIt;
+        }
+      }
+      edges.erase(outEdgeIt, edges.end());
+      std::sort(edges.begin(), edges.end());
+      edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
     }
 
     mergeIterations++;
   } // end of main iteration loop
-  // std::cout << "merge iterations: " << mergeIterations << std::endl;
-  // std::cout << "number of label objects: " << regionCount << std::endl;
 
-  // Generate clustered output
-  itk::ImageRegionIterator<OutputClusteredImageType> outputClusteredIt(outputClusteredImage, outputClusteredImage->GetRequestedRegion());
-  outputClusteredIt.GoToBegin();
+  chrono.Stop();
+  otbMsgDevMacro(<< "Merged " << initialRegionCount << " regions (" << initialEdgeCount << " adjacencies) into " << regionCount << " regions in "
+                 << mergeIterations << " iterations and " << chrono.GetElapsedMilliseconds() << " ms ("
+                 << 1000. * initialRegionCount / std::max<Stopwatch::DurationType>(chrono.GetElapsedMilliseconds(), 1) << " regions/s)");
+
+  // Generate label and clustered outputs
+  typename itk::ImageRegionConstIterator<InputLabelImageType> inputIt(inputLabelImage, outputLabelImage->GetRequestedRegion());
+  typename itk::ImageRegionIterator<OutputLabelImageType>     outputIt(outputLabelImage, outputLabelImage->GetRequestedRegion());
+  itk::ImageRegionIterator<OutputClusteredImageType>          outputClusteredIt(outputClusteredImage, outputClusteredImage->GetRequestedRegion());
+  inputIt.GoToBegin();
   outputIt.GoToBegin();
-  while (!outputClusteredIt.IsAtEnd())
+  outputClusteredIt.GoToBegin();
+  while (!outputIt.IsAtEnd())
   {
-    LabelType                label = outputIt.Get();
-    const SpectralPixelType& p     = m_Modes[label];
-    outputClusteredIt.Set(p);
-    ++outputClusteredIt;
+    LabelType label = currentLabels[inputIt.Get()];
+    outputIt.Set(label);
+    outputClusteredIt.Set(m_Modes[label]);
+    ++inputIt;
     ++outputIt;
+    ++outputClusteredIt;
   }
 }
 
@@ -466,6 +444,75 @@ LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutputLabe
   return ram;
 }
 
+template <class TInputLabelImage, class TInputSpectralImage, class TOutputLabelImage, class TOutputClusteredImage>
+typename LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutputLabelImage, TOutputClusteredImage>::RegionEdgeListType
+LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutputLabelImage, TOutputClusteredImage>::LabelImageToRegionEdges(
+    const InputLabelImageType* labelImage, LabelType& maxLabel)
+{
+  RegionEdgeListType edges;
+
+  // Find the maximum label value
+  itk::ImageRegionConstIterator<InputLabelImageType> it(labelImage, labelImage->GetRequestedRegion());
+  it.GoToBegin();
+  maxLabel = 0;
+  while (!it.IsAtEnd())
+  {
+    maxLabel = std::max(maxLabel, it.Get());
+    ++it;
+  }
+
+  // set the image region without bottom and right borders so that bottom and
+  // right neighbors always exist
+  RegionType regionWithoutBottomRightBorders = labelImage->GetRequestedRegion();
+  SizeType   size                            = regionWithoutBottomRightBorders.GetSize();
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+    size[d] -= 1;
+  regionWithoutBottomRightBorders.SetSize(size);
+  itk::ImageRegionConstIteratorWithIndex<InputLabelImageType> inputIt(labelImage, regionWithoutBottomRightBorders);
+
+  // Duplicated edges are removed whenever the list doubles, to bound memory
+  std::size_t uniqueEdgeCount = 0;
+
+  inputIt.GoToBegin();
+  while (!inputIt.IsAtEnd())
+  {
+    const InputIndexType& index = inputIt.GetIndex();
+    LabelType             label = inputIt.Get();
+
+    // check neighbors
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      InputIndexType neighborIndex = index;
+      neighborIndex[d]++;
+
+      LabelType neighborLabel = labelImage->GetPixel(neighborIndex);
+
+      // add adjacency if different labels, skipping repeats along boundaries
+      if (neighborLabel != label)
+      {
+        RegionEdgeType edge(std::min(label, neighborLabel), std::max(label, neighborLabel));
+        if (edges.empty() || edges.back() != edge)
+        {
+          edges.push_back(edge);
+        }
+      }
+    }
+
+    if (edges.size() > 2 * uniqueEdgeCount + 1024 * 1024)
+    {
+      std::sort(edges.begin(), edges.end());
+      edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+      uniqueEdgeCount = edges.size();
+    }
+    ++inputIt;
+  }
+
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  return edges;
+}
+
 } // end namespace otb
 
 #endif
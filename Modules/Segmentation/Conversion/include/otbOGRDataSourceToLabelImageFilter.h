@@ -28,6 +28,7 @@
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "otbOGRDataSourceWrapper.h"
+#include "otbRasterizationIndex.h"
 #include <string>
 
 namespace otb
@@ -52,6 +53,14 @@ namespace otb
  *    - Setting the Origin/Size/Spacing of the output image
  *    - Using an existing image as support via SetOutputParametersFromImage(ImageBase)
  *
+ *  The geometries of all the layers are read once, reprojected to the
+ *  output projection, and indexed by their envelopes (see
+ *  RasterizationIndex). Each thread then burns its own part of the
+ *  requested region with the geometries intersecting it only, so that
+ *  streaming over many tiles no longer scans every feature for each
+ *  tile. The burn order, the burn values and the AllTouchedMode are
+ *  the ones of GDALRasterizeLayers().
+ *
  *
  * \ingroup OTBConversion
  */
@@ -147,7 +156,9 @@ public:
   void SetOutputParametersFromImage(const ImagePointerType image);
 
 protected:
-  void GenerateData() override;
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
   OGRDataSourceToLabelImageFilter();
   ~OGRDataSourceToLabelImageFilter() override = default;
@@ -160,8 +171,11 @@ private:
   OGRDataSourceToLabelImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
-  std::vector<OGRLayerH> m_SrcDataSetLayers;
-  std::vector<int>       m_BandsToBurn;
+  /** Read, reproject and index the geometries of the input layers */
+  void BuildRasterizationIndex();
+
+  RasterizationIndex m_RasterizationIndex;
+  std::vector<int>   m_BandsToBurn;
 
   // Field used to extract the burn value
   std::string m_BurnAttribute;
@@ -30,8 +30,10 @@
 #include "otbImage.h"
 #include "otbNoDataHelper.h"
 
-#include "gdal_alg.h"
-#include "stdint.h" //needed for uintptr_t
+#include "ogr_spatialref.h"
+
+#include <algorithm>
+#include <memory>
 
 namespace otb
 {
@@ -134,17 +136,8 @@ void OGRDataSourceToLabelImageFilter<TOutputImage>::GenerateOutputInformation()
   outputPtr->SetOrigin(m_OutputOrigin);
   outputPtr->SetProjectionRef(this->GetOutputProjectionRef());
  
-  // Generate the OGRLayers from the input OGRDataSource
-  for (unsigned int idx = 0; idx < this->GetNumberOfInputs(); ++idx)
-  {
-    OGRDataSourcePointerType ogrDS    = dynamic_cast<OGRDataSourceType*>(this->itk::ProcessObject::GetInput(idx));
-    const unsigned int       nbLayers = ogrDS->GetLayersCount();
-
-    for (unsigned int layer = 0; layer < nbLayers; ++layer)
-    {
-      m_SrcDataSetLayers.push_back(&(ogrDS->GetLayer(layer).ogr()));
-    }
-  }
+  // Read and index the geometries once for all the requested regions
+  this->BuildRasterizationIndex();
 
   // Set the NoData value using the background
   const unsigned int& nbBands = outputPtr->GetNumberOfComponentsPerPixel();
@@ -157,82 +150,105 @@ void OGRDataSourceToLabelImageFilter<TOutputImage>::GenerateOutputInformation()
 }
 
 template <class TOutputImage>
-void OGRDataSourceToLabelImageFilter<TOutputImage>::GenerateData()
+void OGRDataSourceToLabelImageFilter<TOutputImage>::BuildRasterizationIndex()
 {
-  // Call Superclass GenerateData
-  this->AllocateOutputs();
-
-  // Get the buffered region
-  OutputImageRegionType bufferedRegion = this->GetOutput()->GetBufferedRegion();
+  m_RasterizationIndex.Clear();
 
-  // nb bands
-  const unsigned int& nbBands = this->GetOutput()->GetNumberOfComponentsPerPixel();
-
-  // register drivers
-  GDALAllRegister();
-
-  std::ostringstream stream;
-  stream << "MEM:::"
-         << "DATAPOINTER=" << (uintptr_t)(this->GetOutput()->GetBufferPointer()) << ","
-         << "PIXELS=" << bufferedRegion.GetSize()[0] << ","
-         << "LINES=" << bufferedRegion.GetSize()[1] << ","
-         << "BANDS=" << nbBands << ","
-         << "DATATYPE=" << GDALGetDataTypeName(GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>()) << ","
-         << "PIXELOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands << ","
-         << "LINEOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands * bufferedRegion.GetSize()[0] << ","
-         << "BANDOFFSET=" << sizeof(OutputImageInternalPixelType);
-
-  GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
-
-  // Add the projection ref to the dataset
-  GDALSetProjection(dataset, this->GetOutput()->GetProjectionRef().c_str());
-
-  // Set the nodata value
+  // Every band is burnt with the same value
+  const unsigned int nbBands = this->GetOutput()->GetNumberOfComponentsPerPixel();
+  m_BandsToBurn.resize(nbBands);
   for (unsigned int band = 0; band < nbBands; ++band)
   {
-    GDALRasterBandH hBand = GDALGetRasterBand(dataset, band + 1);
-    GDALFillRaster(hBand, m_BackgroundValue, 0);
+    m_BandsToBurn[band] = band + 1;
   }
 
-  // add the geoTransform to the dataset
-  itk::VariableLengthVector<double> geoTransform(6);
-
-  // Reporting origin and spacing of the buffered region
-  // the spacing is unchanged, the origin is relative to the buffered region
-  OutputIndexType  bufferIndexOrigin = bufferedRegion.GetIndex();
-  OutputOriginType bufferOrigin;
-  this->GetOutput()->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
-  geoTransform[0] = bufferOrigin[0] - 0.5 * this->GetOutput()->GetSignedSpacing()[0];
-  geoTransform[3] = bufferOrigin[1] - 0.5 * this->GetOutput()->GetSignedSpacing()[1];
-  geoTransform[1] = this->GetOutput()->GetSignedSpacing()[0];
-  geoTransform[5] = this->GetOutput()->GetSignedSpacing()[1];
-
-  // FIXME: Here component 1 and 4 should be replaced by the orientation parameters
-  geoTransform[2] = 0.;
-  geoTransform[4] = 0.;
-  GDALSetGeoTransform(dataset, const_cast<double*>(geoTransform.GetDataPointer()));
-
-  // Burn the geometries into the dataset
-  if (dataset != nullptr)
-  {
-    std::vector<std::string> options;
+  // The geometries are reprojected to the output projection, as
+  // GDALRasterizeLayers() does when the layer has a spatial reference
+  OGRSpatialReference outputSRS;
+  const bool          hasOutputSRS = !m_OutputProjectionRef.empty() && outputSRS.SetFromUserInput(m_OutputProjectionRef.c_str()) == OGRERR_NONE;
+#if GDAL_VERSION_NUM >= 3000000
+  outputSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#endif
 
-    std::vector<double> foreground(nbBands * m_SrcDataSetLayers.size(), m_ForegroundValue);
+  for (unsigned int idx = 0; idx < this->GetNumberOfInputs(); ++idx)
+  {
+    OGRDataSourcePointerType ogrDS    = dynamic_cast<OGRDataSourceType*>(this->itk::ProcessObject::GetInput(idx));
+    const unsigned int       nbLayers = ogrDS->GetLayersCount();
 
-    if (m_BurnAttributeMode)
-    {
-      options.push_back("ATTRIBUTE=" + m_BurnAttribute);
-    }
-    if (m_AllTouchedMode)
+    for (unsigned int layerIndex = 0; layerIndex < nbLayers; ++layerIndex)
     {
-      options.push_back("ALL_TOUCHED=TRUE");
+      OGRLayerType layer = ogrDS->GetLayer(layerIndex);
+
+      int burnField = -1;
+      if (m_BurnAttributeMode)
+      {
+        burnField = layer.GetLayerDefn().GetFieldIndex(m_BurnAttribute.c_str());
+        if (burnField < 0)
+        {
+          itkWarningMacro(<< "Failed to find field " << m_BurnAttribute << " on layer " << layer.GetName() << ", skipping.");
+          continue;
+        }
+      }
+
+      std::unique_ptr<OGRCoordinateTransformation> transform;
+      const OGRSpatialReference*                   layerSRS = layer.GetSpatialRef();
+      if (hasOutputSRS && layerSRS != nullptr && !layerSRS->IsSame(&outputSRS))
+      {
+        OGRSpatialReference sourceSRS(*layerSRS);
+#if GDAL_VERSION_NUM >= 3000000
+        sourceSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+        transform.reset(OGRCreateCoordinateTransformation(&sourceSRS, &outputSRS));
+        if (!transform)
+        {
+          itkExceptionMacro(<< "Unable to reproject layer " << layer.GetName() << " to the output projection");
+        }
+      }
+
+      std::vector<double> burnValues(nbBands, static_cast<double>(m_ForegroundValue));
+      for (OGRLayerType::const_iterator it = layer.cbegin(); it != layer.cend(); ++it)
+      {
+        const OGRGeometry* geometry = it->GetGeometry();
+        if (geometry == nullptr)
+        {
+          continue;
+        }
+
+        OGRGeometry* clone = geometry->clone();
+        if (transform && clone->transform(transform.get()) != OGRERR_NONE)
+        {
+          OGRGeometryFactory::destroyGeometry(clone);
+          continue;
+        }
+
+        if (burnField >= 0)
+        {
+          std::fill(burnValues.begin(), burnValues.end(), it->ogr().GetFieldAsDouble(burnField));
+        }
+        m_RasterizationIndex.AddGeometry(clone, burnValues);
+      }
     }
-
-    GDALRasterizeLayers(dataset, nbBands, &m_BandsToBurn[0], m_SrcDataSetLayers.size(), &(m_SrcDataSetLayers[0]), nullptr, nullptr, &foreground[0],
-                        ogr::StringListConverter(options).to_ogr(), nullptr, nullptr);
-    // release the dataset
-    GDALClose(dataset);
   }
+
+  m_RasterizationIndex.BuildIndex();
+
+  otbMsgDevMacro(<< "Indexed " << m_RasterizationIndex.GetNumberOfGeometries() << " geometries to rasterize");
+}
+
+template <class TOutputImage>
+void OGRDataSourceToLabelImageFilter<TOutputImage>::BeforeThreadedGenerateData()
+{
+  // register drivers
+  GDALAllRegister();
+}
+
+template <class TOutputImage>
+void OGRDataSourceToLabelImageFilter<TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                         itk::ThreadIdType itkNotUsed(threadId))
+{
+  // Fill the region with the background value and burn the geometries
+  // intersecting it
+  m_RasterizationIndex.Rasterize(this->GetOutput(), outputRegionForThread, m_BandsToBurn, static_cast<double>(m_BackgroundValue), m_AllTouchedMode);
 }
 
 template <class TOutputImage>
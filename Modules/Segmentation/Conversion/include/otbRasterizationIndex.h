@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRasterizationIndex_h
+#define otbRasterizationIndex_h
+
+#include "gdal.h"
+#include "ogr_geometry.h"
+#include "cpl_quad_tree.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "OTBConversionExport.h"
+
+namespace otb
+{
+
+/** \class RasterizationIndex
+ *  \brief Geometries to burn into a raster, indexed by their envelopes
+ *
+ *  The geometries are stored once with their burn values, in burning
+ *  order, and a quadtree is built over their envelopes. Rasterizing a
+ *  block of pixels only considers the geometries whose envelope
+ *  intersects the block, so that each streaming tile costs in
+ *  proportion of the geometries it contains instead of scanning all of
+ *  them.
+ *
+ *  The geometries are burnt with GDALRasterizeGeometries(), in the
+ *  order they were added: overlapping features are burnt in the same
+ *  order as GDALRasterizeLayers() would. Rasterize() does not modify
+ *  the index and can be called concurrently on disjoint blocks of the
+ *  same buffer.
+ *
+ * \ingroup OTBConversion
+ */
+class OTBConversion_EXPORT RasterizationIndex
+{
+public:
+  RasterizationIndex();
+  ~RasterizationIndex();
+
+  /** Remove all the geometries */
+  void Clear();
+
+  /** Add a geometry, burnt after the ones already added, with one burn
+   * value for each band to burn. The index takes the ownership of the
+   * geometry. */
+  void AddGeometry(OGRGeometry* geometry, const std::vector<double>& burnValues);
+
+  /** Build the spatial index, once all the geometries are added */
+  void BuildIndex();
+
+  /** Get the number of geometries */
+  std::size_t GetNumberOfGeometries() const
+  {
+    return m_Geometries.size();
+  }
+
+  /** Rasterize the geometries into a region of the buffer of an image,
+   * after filling it with the background value. The geotransform of
+   * the block is derived from the origin and the signed spacing of the
+   * image. */
+  template <class TImage>
+  void Rasterize(TImage* image, const typename TImage::RegionType& region, const std::vector<int>& bandsToBurn, double backgroundValue, bool allTouched) const;
+
+  /** Rasterize the geometries into a block of pixels wrapped in a GDAL
+   * MEM dataset, after filling it with the background value. */
+  void Rasterize(void* buffer, GDALDataType dataType, int width, int height, int nbBands, std::size_t pixelOffset, std::size_t lineOffset,
+                 std::size_t bandOffset, const double geoTransform[6], const std::vector<int>& bandsToBurn, double backgroundValue, bool allTouched) const;
+
+private:
+  RasterizationIndex(const RasterizationIndex&) = delete;
+  void operator=(const RasterizationIndex&) = delete;
+
+  /** Get the geometries whose envelope intersects an area, in burning order */
+  std::vector<std::size_t> Search(double minX, double minY, double maxX, double maxY) const;
+
+  std::vector<OGRGeometry*> m_Geometries;
+  std::vector<OGREnvelope>  m_Envelopes;
+  std::vector<double>       m_BurnValues;
+  std::size_t               m_NumberOfBurnValues;
+  CPLQuadTree*              m_QuadTree;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbRasterizationIndex.hxx"
+#endif
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRasterizationIndex_hxx
+#define otbRasterizationIndex_hxx
+
+#include "otbRasterizationIndex.h"
+#include "otbGdalDataTypeBridge.h"
+
+namespace otb
+{
+
+template <class TImage>
+void RasterizationIndex::Rasterize(TImage* image, const typename TImage::RegionType& region, const std::vector<int>& bandsToBurn, double backgroundValue,
+                                   bool allTouched) const
+{
+  typedef typename TImage::InternalPixelType InternalPixelType;
+
+  const unsigned int nbBands     = image->GetNumberOfComponentsPerPixel();
+  const std::size_t  pixelOffset = sizeof(InternalPixelType) * nbBands;
+  const std::size_t  lineOffset  = pixelOffset * image->GetBufferedRegion().GetSize()[0];
+
+  InternalPixelType* buffer = image->GetBufferPointer() + image->ComputeOffset(region.GetIndex()) * nbBands;
+
+  // The origin of the block is relative to its first pixel, the
+  // spacing is unchanged
+  typename TImage::PointType blockOrigin;
+  image->TransformIndexToPhysicalPoint(region.GetIndex(), blockOrigin);
+  const typename TImage::SpacingType spacing = image->GetSignedSpacing();
+
+  // FIXME: Here component 2 and 4 should be replaced by the orientation parameters
+  const double geoTransform[6] = {blockOrigin[0] - 0.5 * spacing[0], spacing[0], 0., blockOrigin[1] - 0.5 * spacing[1], 0., spacing[1]};
+
+  this->Rasterize(buffer, GdalDataTypeBridge::GetGDALDataType<InternalPixelType>(), region.GetSize()[0], region.GetSize()[1], nbBands, pixelOffset, lineOffset,
+                  sizeof(InternalPixelType), geoTransform, bandsToBurn, backgroundValue, allTouched);
+}
+
+} // end namespace otb
+
+#endif
@@ -26,6 +26,7 @@
 #include "otbMacro.h"
 
 #include "otbVectorData.h"
+#include "otbRasterizationIndex.h"
 
 #include "gdal.h"
 #include "ogr_api.h"
@@ -45,6 +46,10 @@ namespace otb
  *    - Setting the Origin/Size/Spacing of the output image
  *    - Using an existing image as support via SetOutputParametersFromImage(ImageBase)
  *
+ *  The geometries are converted and indexed by their envelopes once
+ *  (see RasterizationIndex), then each thread burns its own part of
+ *  the requested region with the geometries intersecting it only.
+ *
  *  OGRRegisterAll() method must have been called before applying filter.
  *
  *
@@ -138,17 +143,13 @@ public:
   void SetOutputParametersFromImage(const ImagePointerType image);
 
 protected:
-  void GenerateData() override;
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
   VectorDataToLabelImageFilter();
   ~VectorDataToLabelImageFilter() override
   {
-    // Destroy the geometries stored
-    for (unsigned int idx = 0; idx < m_SrcDataSetGeometries.size(); ++idx)
-    {
-      OGR_G_DestroyGeometry(m_SrcDataSetGeometries[idx]);
-    }
-
     if (m_OGRDataSourcePointer != nullptr)
     {
       GDALClose(m_OGRDataSourcePointer);
@@ -165,11 +166,10 @@ private:
 
   GDALDataset* m_OGRDataSourcePointer;
 
-  // Vector Of OGRGeometyH
-  std::vector<OGRGeometryH> m_SrcDataSetGeometries;
+  // Geometries to burn, with their burn values
+  RasterizationIndex m_RasterizationIndex;
 
   std::vector<double> m_BurnValues;
-  std::vector<double> m_FullBurnValues;
   std::vector<int>    m_BandsToBurn;
 
   // Field used to extract the burn value
@@ -131,6 +131,9 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateOutputInfo
   itk::MetaDataDictionary& dict = outputPtr->GetMetaDataDictionary();
   itk::EncapsulateMetaData<std::string>(dict, MetaDataKey::ProjectionRefKey, static_cast<std::string>(this->GetOutputProjectionRef()));
 
+  // Drop the geometries of a previous update
+  m_RasterizationIndex.Clear();
+
   // Generate the OGRLayers from the input VectorDatas
   // iteration begin from 1 cause the 0th input is a image
   for (unsigned int idx = 0; idx < this->GetNumberOfInputs(); ++idx)
@@ -191,19 +194,18 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateOutputInfo
           }
 
           hGeom = OGR_G_Clone(OGR_F_GetGeometryRef(hFeat));
-          m_SrcDataSetGeometries.push_back(hGeom);
 
           if (burnField == -1)
           {
             // TODO : if no burnAttribute available, warning or raise an exception??
-            m_FullBurnValues.push_back(m_DefaultBurnValue++);
+            m_RasterizationIndex.AddGeometry(reinterpret_cast<OGRGeometry*>(hGeom), std::vector<double>(1, m_DefaultBurnValue++));
             itkWarningMacro(<< "Failed to find attribute " << m_BurnAttribute << " in layer "
                             << OGR_FD_GetName(OGR_L_GetLayerDefn((OGRLayerH)(ogrLayerVector[idx2])))
                             << " .Setting burn value to default =  " << m_DefaultBurnValue);
           }
           else
           {
-            m_FullBurnValues.push_back(OGR_F_GetFieldAsDouble(hFeat, burnField));
+            m_RasterizationIndex.AddGeometry(reinterpret_cast<OGRGeometry*>(hGeom), std::vector<double>(1, OGR_F_GetFieldAsDouble(hFeat, burnField)));
           }
 
           OGR_F_Destroy(hFeat);
@@ -217,77 +219,25 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateOutputInfo
       }
     }
   }
+
+  // Index the geometries once for all the requested regions
+  m_RasterizationIndex.BuildIndex();
 }
 
 template <class TVectorData, class TOutputImage>
-void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateData()
+void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::BeforeThreadedGenerateData()
 {
-  // Call Superclass GenerateData
-  this->AllocateOutputs();
-
-  // Get the buffered region
-  OutputImageRegionType bufferedRegion = this->GetOutput()->GetBufferedRegion();
-
-  // Fill the buffer with the background value
-  this->GetOutput()->FillBuffer(m_BackgroundValue);
-
-  // nb bands
-  unsigned int nbBands = this->GetOutput()->GetNumberOfComponentsPerPixel();
-
   // register drivers
   GDALAllRegister();
+}
 
-  std::ostringstream stream;
-  stream << "MEM:::"
-         << "DATAPOINTER=" << (uintptr_t)(this->GetOutput()->GetBufferPointer()) << ","
-         << "PIXELS=" << bufferedRegion.GetSize()[0] << ","
-         << "LINES=" << bufferedRegion.GetSize()[1] << ","
-         << "BANDS=" << nbBands << ","
-         << "DATATYPE=" << GDALGetDataTypeName(GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>()) << ","
-         << "PIXELOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands << ","
-         << "LINEOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands * bufferedRegion.GetSize()[0] << ","
-         << "BANDOFFSET=" << sizeof(OutputImageInternalPixelType);
-
-  GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
-
-  // Add the projection ref to the dataset
-  GDALSetProjection(dataset, this->GetOutput()->GetProjectionRef().c_str());
-
-  // add the geoTransform to the dataset
-  itk::VariableLengthVector<double> geoTransform(6);
-
-  // Reporting origin and spacing of the buffered region
-  // the spacing is unchanged, the origin is relative to the buffered region
-  OutputIndexType  bufferIndexOrigin = bufferedRegion.GetIndex();
-  OutputOriginType bufferOrigin;
-  this->GetOutput()->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
-  geoTransform[0] = bufferOrigin[0] - 0.5 * this->GetOutput()->GetSignedSpacing()[0];
-  geoTransform[3] = bufferOrigin[1] - 0.5 * this->GetOutput()->GetSignedSpacing()[1];
-  geoTransform[1] = this->GetOutput()->GetSignedSpacing()[0];
-  geoTransform[5] = this->GetOutput()->GetSignedSpacing()[1];
-
-  // FIXME: Here component 1 and 4 should be replaced by the orientation parameters
-  geoTransform[2] = 0.;
-  geoTransform[4] = 0.;
-  GDALSetGeoTransform(dataset, const_cast<double*>(geoTransform.GetDataPointer()));
-
-  char** options = nullptr;
-  if (m_AllTouchedMode)
-  {
-    options = CSLSetNameValue(options, "ALL_TOUCHED", "TRUE");
-  }
-
-  // Burn the geometries into the dataset
-  if (dataset != nullptr)
-  {
-    GDALRasterizeGeometries(dataset, m_BandsToBurn.size(), &(m_BandsToBurn[0]), m_SrcDataSetGeometries.size(), &(m_SrcDataSetGeometries[0]), nullptr, nullptr,
-                            &(m_FullBurnValues[0]), options, GDALDummyProgress, nullptr);
-
-    CSLDestroy(options);
-
-    // release the dataset
-    GDALClose(dataset);
-  }
+template <class TVectorData, class TOutputImage>
+void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                   itk::ThreadIdType itkNotUsed(threadId))
+{
+  // Fill the region with the background value and burn the geometries
+  // intersecting it
+  m_RasterizationIndex.Rasterize(this->GetOutput(), outputRegionForThread, m_BandsToBurn, static_cast<double>(m_BackgroundValue), m_AllTouchedMode);
 }
 
 template <class TVectorData, class TOutputImage>
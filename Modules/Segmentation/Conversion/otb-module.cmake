@@ -23,6 +23,7 @@ different segment representations (labelImage, labelMap, OGR Layer, QGIS table).
 Rasterization and vectorization are important features of this module.")
 
 otb_module(OTBConversion
+ENABLE_SHARED
   DEPENDS
     OTBVectorDataBase
     OTBVectorDataManipulation
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbRasterizationIndex.h"
+
+#include "gdal_alg.h"
+#include "cpl_string.h"
+#include "itkMacro.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+
+namespace otb
+{
+
+RasterizationIndex::RasterizationIndex() : m_NumberOfBurnValues(0), m_QuadTree(nullptr)
+{
+}
+
+RasterizationIndex::~RasterizationIndex()
+{
+  this->Clear();
+}
+
+void RasterizationIndex::Clear()
+{
+  if (m_QuadTree != nullptr)
+  {
+    CPLQuadTreeDestroy(m_QuadTree);
+    m_QuadTree = nullptr;
+  }
+  for (OGRGeometry* geometry : m_Geometries)
+  {
+    OGRGeometryFactory::destroyGeometry(geometry);
+  }
+  m_Geometries.clear();
+  m_Envelopes.clear();
+  m_BurnValues.clear();
+  m_NumberOfBurnValues = 0;
+}
+
+void RasterizationIndex::AddGeometry(OGRGeometry* geometry, const std::vector<double>& burnValues)
+{
+  if (m_Geometries.empty())
+  {
+    m_NumberOfBurnValues = burnValues.size();
+  }
+  else if (burnValues.size() != m_NumberOfBurnValues)
+  {
+    OGRGeometryFactory::destroyGeometry(geometry);
+    itkGenericExceptionMacro(<< "Expected " << m_NumberOfBurnValues << " burn values, got " << burnValues.size());
+  }
+
+  // The quadtree points into the envelopes, it is rebuilt by BuildIndex()
+  if (m_QuadTree != nullptr)
+  {
+    CPLQuadTreeDestroy(m_QuadTree);
+    m_QuadTree = nullptr;
+  }
+
+  OGREnvelope envelope;
+  geometry->getEnvelope(&envelope);
+
+  m_Geometries.push_back(geometry);
+  m_Envelopes.push_back(envelope);
+  m_BurnValues.insert(m_BurnValues.end(), burnValues.begin(), burnValues.end());
+}
+
+void RasterizationIndex::BuildIndex()
+{
+  if (m_QuadTree != nullptr)
+  {
+    CPLQuadTreeDestroy(m_QuadTree);
+    m_QuadTree = nullptr;
+  }
+  if (m_Envelopes.empty())
+  {
+    return;
+  }
+
+  OGREnvelope globalEnvelope;
+  for (const OGREnvelope& envelope : m_Envelopes)
+  {
+    globalEnvelope.Merge(envelope);
+  }
+
+  CPLRectObj globalBounds;
+  globalBounds.minx = globalEnvelope.MinX;
+  globalBounds.miny = globalEnvelope.MinY;
+  globalBounds.maxx = globalEnvelope.MaxX;
+  globalBounds.maxy = globalEnvelope.MaxY;
+
+  // The bounds are given at insertion, no callback is needed
+  m_QuadTree = CPLQuadTreeCreate(&globalBounds, nullptr);
+  CPLQuadTreeSetMaxDepth(m_QuadTree, CPLQuadTreeGetAdvisedMaxDepth(static_cast<int>(m_Envelopes.size())));
+
+  for (OGREnvelope& envelope : m_Envelopes)
+  {
+    CPLRectObj bounds;
+    bounds.minx = envelope.MinX;
+    bounds.miny = envelope.MinY;
+    bounds.maxx = envelope.MaxX;
+    bounds.maxy = envelope.MaxY;
+    CPLQuadTreeInsertWithBounds(m_QuadTree, &envelope, &bounds);
+  }
+}
+
+std::vector<std::size_t> RasterizationIndex::Search(double minX, double minY, double maxX, double maxY) const
+{
+  std::vector<std::size_t> indices;
+  if (m_QuadTree == nullptr)
+  {
+    return indices;
+  }
+
+  CPLRectObj area;
+  area.minx = minX;
+  area.miny = minY;
+  area.maxx = maxX;
+  area.maxy = maxY;
+
+  int    count    = 0;
+  void** features = CPLQuadTreeSearch(m_QuadTree, &area, &count);
+
+  indices.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    indices.push_back(static_cast<const OGREnvelope*>(features[i]) - m_Envelopes.data());
+  }
+  CPLFree(features);
+
+  // Keep the burning order of the geometries
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+void RasterizationIndex::Rasterize(void* buffer, GDALDataType dataType, int width, int height, int nbBands, std::size_t pixelOffset, std::size_t lineOffset,
+                                   std::size_t bandOffset, const double geoTransform[6], const std::vector<int>& bandsToBurn, double backgroundValue,
+                                   bool allTouched) const
+{
+  std::ostringstream stream;
+  stream << "MEM:::"
+         << "DATAPOINTER=" << reinterpret_cast<std::uintptr_t>(buffer) << ","
+         << "PIXELS=" << width << ","
+         << "LINES=" << height << ","
+         << "BANDS=" << nbBands << ","
+         << "DATATYPE=" << GDALGetDataTypeName(dataType) << ","
+         << "PIXELOFFSET=" << pixelOffset << ","
+         << "LINEOFFSET=" << lineOffset << ","
+         << "BANDOFFSET=" << bandOffset;
+
+  GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
+  if (dataset == nullptr)
+  {
+    itkGenericExceptionMacro(<< "Unable to wrap the output buffer in a GDAL MEM dataset: " << CPLGetLastErrorMsg());
+  }
+
+  double blockGeoTransform[6];
+  std::copy(geoTransform, geoTransform + 6, blockGeoTransform);
+  GDALSetGeoTransform(dataset, blockGeoTransform);
+
+  for (int band = 0; band < nbBands; ++band)
+  {
+    GDALFillRaster(GDALGetRasterBand(dataset, band + 1), backgroundValue, 0);
+  }
+
+  // Select the geometries overlapping the block, with a margin of one
+  // pixel so that the touched pixels of the border are never missed
+  const double marginX = std::abs(geoTransform[1]);
+  const double marginY = std::abs(geoTransform[5]);
+  const double x0      = geoTransform[0];
+  const double x1      = geoTransform[0] + width * geoTransform[1];
+  const double y0      = geoTransform[3];
+  const double y1      = geoTransform[3] + height * geoTransform[5];
+
+  const std::vector<std::size_t> indices =
+      this->Search(std::min(x0, x1) - marginX, std::min(y0, y1) - marginY, std::max(x0, x1) + marginX, std::max(y0, y1) + marginY);
+
+  CPLErr error = CE_None;
+  if (!indices.empty())
+  {
+    if (bandsToBurn.size() != m_NumberOfBurnValues)
+    {
+      GDALClose(dataset);
+      itkGenericExceptionMacro(<< "Expected " << m_NumberOfBurnValues << " bands to burn, got " << bandsToBurn.size());
+    }
+
+    std::vector<OGRGeometryH> geometries;
+    std::vector<double>       burnValues;
+    geometries.reserve(indices.size());
+    burnValues.reserve(indices.size() * m_NumberOfBurnValues);
+    for (std::size_t index : indices)
+    {
+      geometries.push_back(reinterpret_cast<OGRGeometryH>(m_Geometries[index]));
+      burnValues.insert(burnValues.end(), m_BurnValues.begin() + index * m_NumberOfBurnValues, m_BurnValues.begin() + (index + 1) * m_NumberOfBurnValues);
+    }
+
+    std::vector<int> bands(bandsToBurn);
+    char**           options = nullptr;
+    if (allTouched)
+    {
+      options = CSLSetNameValue(options, "ALL_TOUCHED", "TRUE");
+    }
+
+    error = GDALRasterizeGeometries(dataset, static_cast<int>(bands.size()), bands.data(), static_cast<int>(geometries.size()), geometries.data(), nullptr,
+                                    nullptr, burnValues.data(), options, GDALDummyProgress, nullptr);
+    CSLDestroy(options);
+  }
+
+  GDALClose(dataset);
+
+  if (error != CE_None)
+  {
+    itkGenericExceptionMacro(<< "Failed to rasterize the geometries: " << CPLGetLastErrorMsg());
+  }
+}
+
+} // end namespace otb
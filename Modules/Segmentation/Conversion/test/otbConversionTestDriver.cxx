@@ -31,5 +31,7 @@ void RegisterTests()
   REGISTER_TEST(otbVectorDataRasterizeFilter);
   REGISTER_TEST(otbLabelImageRegionPruningFilter);
   REGISTER_TEST(otbLabelImageRegionMergingFilter);
+  REGISTER_TEST(otbLabelImageRegionMergingFilterSynthetic);
   REGISTER_TEST(otbLabelMapToVectorDataFilter);
+  REGISTER_TEST(otbRasterizationIndexTest);
 }
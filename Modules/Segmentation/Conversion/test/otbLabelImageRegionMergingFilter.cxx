@@ -24,6 +24,8 @@
 #include "otbMeanShiftSmoothingImageFilter.h"
 #include "otbLabelImageRegionMergingFilter.h"
 
+#include <cmath>
+
 int otbLabelImageRegionMergingFilter(int argc, char* argv[])
 {
   if (argc != 10)
@@ -96,3 +98,77 @@ int otbLabelImageRegionMergingFilter(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbLabelImageRegionMergingFilterSynthetic(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<unsigned int, 2> LabelImageType;
+  typedef otb::VectorImage<float, 2>  SpectralImageType;
+  typedef otb::LabelImageRegionMergingFilter<LabelImageType, SpectralImageType> MergeFilterType;
+
+  // One region per column. With a range bandwidth of 4, regions are merged
+  // when their modes differ by less than 2:
+  //  - columns 0 to 2 merge at once by transitivity, as do columns 3 and 4
+  //  - column 6 (4 columns wide) absorbs column 10, and the updated mode then
+  //    allows column 11 to merge at the next iteration
+  const unsigned int width                 = 12;
+  const unsigned int height                = 3;
+  const float        values[width]         = {0., 1., 2., 10., 11., 30., 3., 3., 3., 3., 1.5, 3.5};
+  const unsigned int labels[width]         = {1, 2, 3, 4, 5, 6, 7, 7, 7, 7, 8, 9};
+  const unsigned int expectedLabels[width] = {1, 1, 1, 2, 2, 3, 4, 4, 4, 4, 4, 4};
+  const double       expectedModes[width]  = {1., 1., 1., 10.5, 10.5, 30., 17. / 6, 17. / 6, 17. / 6, 17. / 6, 17. / 6, 17. / 6};
+
+  LabelImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, width);
+  region.SetSize(1, height);
+
+  LabelImageType::Pointer labelImage = LabelImageType::New();
+  labelImage->SetRegions(region);
+  labelImage->Allocate();
+
+  SpectralImageType::Pointer spectralImage = SpectralImageType::New();
+  spectralImage->SetRegions(region);
+  spectralImage->SetNumberOfComponentsPerPixel(1);
+  spectralImage->Allocate();
+
+  SpectralImageType::PixelType spectralPixel(1);
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    for (unsigned int x = 0; x < width; ++x)
+    {
+      LabelImageType::IndexType index;
+      index[0] = x;
+      index[1] = y;
+      labelImage->SetPixel(index, labels[x]);
+      spectralPixel[0] = values[x];
+      spectralImage->SetPixel(index, spectralPixel);
+    }
+  }
+
+  MergeFilterType::Pointer mergeFilter = MergeFilterType::New();
+  mergeFilter->SetInputLabelImage(labelImage);
+  mergeFilter->SetInputSpectralImage(spectralImage);
+  mergeFilter->SetRangeBandwidth(4.);
+  mergeFilter->Update();
+
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    for (unsigned int x = 0; x < width; ++x)
+    {
+      LabelImageType::IndexType index;
+      index[0]                  = x;
+      index[1]                  = y;
+      const unsigned int        label = mergeFilter->GetOutput()->GetPixel(index);
+      const double              mode  = mergeFilter->GetClusteredOutput()->GetPixel(index)[0];
+      if (label != expectedLabels[x] || std::abs(mode - expectedModes[x]) > 1e-5)
+      {
+        std::cerr << "Wrong merging at " << index << ": got label " << label << " and mode " << mode << ", expected label " << expectedLabels[x]
+                  << " and mode " << expectedModes[x] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
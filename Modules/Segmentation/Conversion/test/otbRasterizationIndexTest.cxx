@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "gdal.h"
+#include "ogr_geometry.h"
+
+#include "otbImage.h"
+#include "otbRasterizationIndex.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+namespace
+{
+OGRGeometry* CreateRectangle(double minX, double minY, double maxX, double maxY)
+{
+  OGRLinearRing ring;
+  ring.addPoint(minX, minY);
+  ring.addPoint(maxX, minY);
+  ring.addPoint(maxX, maxY);
+  ring.addPoint(minX, maxY);
+  ring.closeRings();
+
+  OGRPolygon* polygon = new OGRPolygon;
+  polygon->addRing(&ring);
+  return polygon;
+}
+}
+
+int otbRasterizationIndexTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<unsigned short> ImageType;
+
+  GDALAllRegister();
+
+  // Rectangles with their corners on pixel corners, the later ones
+  // overlapping the earlier ones
+  otb::RasterizationIndex index;
+  index.AddGeometry(CreateRectangle(2, 3, 20, 17), std::vector<double>(1, 1));
+  index.AddGeometry(CreateRectangle(10, 8, 31, 25), std::vector<double>(1, 2));
+  index.AddGeometry(CreateRectangle(25, 1, 38, 6), std::vector<double>(1, 3));
+  index.AddGeometry(CreateRectangle(100, 100, 110, 110), std::vector<double>(1, 4));
+  index.BuildIndex();
+
+  ImageType::RegionType region;
+  region.SetSize(0, 40);
+  region.SetSize(1, 30);
+
+  ImageType::PointType origin;
+  origin.Fill(0.5);
+
+  std::vector<ImageType::Pointer> images;
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    ImageType::Pointer image = ImageType::New();
+    image->SetRegions(region);
+    image->SetOrigin(origin);
+    image->Allocate();
+    image->FillBuffer(99);
+    images.push_back(image);
+  }
+
+  const std::vector<int> bands(1, 1);
+
+  // Rasterize the whole image at once, and tile by tile
+  index.Rasterize(images[0].GetPointer(), region, bands, 0., false);
+  for (unsigned int y = 0; y < region.GetSize(1); y += 7)
+  {
+    for (unsigned int x = 0; x < region.GetSize(0); x += 9)
+    {
+      ImageType::RegionType tile;
+      tile.SetIndex(0, x);
+      tile.SetIndex(1, y);
+      tile.SetSize(0, std::min<unsigned int>(9, region.GetSize(0) - x));
+      tile.SetSize(1, std::min<unsigned int>(7, region.GetSize(1) - y));
+      index.Rasterize(images[1].GetPointer(), tile, bands, 0., false);
+    }
+  }
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> itRef(images[0], region);
+  itk::ImageRegionConstIterator<ImageType>          itTiles(images[1], region);
+  for (itRef.GoToBegin(), itTiles.GoToBegin(); !itRef.IsAtEnd(); ++itRef, ++itTiles)
+  {
+    const ImageType::IndexType idx = itRef.GetIndex();
+
+    unsigned short expected = 0;
+    if (idx[0] >= 2 && idx[0] < 20 && idx[1] >= 3 && idx[1] < 17)
+    {
+      expected = 1;
+    }
+    if (idx[0] >= 10 && idx[0] < 31 && idx[1] >= 8 && idx[1] < 25)
+    {
+      expected = 2;
+    }
+    if (idx[0] >= 25 && idx[0] < 38 && idx[1] >= 1 && idx[1] < 6)
+    {
+      expected = 3;
+    }
+
+    if (itRef.Get() != expected)
+    {
+      std::cerr << "Wrong value at " << idx << ": " << itRef.Get() << " instead of " << expected << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (itTiles.Get() != expected)
+    {
+      std::cerr << "Wrong value at " << idx << " when rasterizing by tiles: " << itTiles.Get() << " instead of " << expected << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
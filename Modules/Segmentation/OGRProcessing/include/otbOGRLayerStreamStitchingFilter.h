@@ -27,6 +27,8 @@
 #include "itkProgressReporter.h"
 
 #include <algorithm>
+#include <map>
+#include <vector>
 
 namespace otb
 {
@@ -38,6 +40,14 @@ namespace otb
  *  - P1 and P2 are on different side of the streaming line
  *  - P1 and P2 intersect each other.
  *  - P2 has the largest intersection with P1 among all other polygons Pi intersecting P1.
+ *
+ *  With BorderLabelStitching enabled, polygons are instead rasterized on the rows (or
+ *  columns) of pixels on each side of the streaming line, and the length of the border
+ *  shared by two polygons is given by the number of adjacent pixels they cover across
+ *  the line. The pairs are then fused as above, from the longest shared border, each
+ *  polygon at most once per streaming line. This avoids testing the intersection of
+ *  every pair of polygons along the line.
+ *
  *  The \c SetStreamSize() method allows retrieving the number of streams in row and column,
  *  and their pixel coordinates.
  *  The input image is used to transform pixel coordinates of the streaming lines into
@@ -99,6 +109,12 @@ public:
   /** Get stream size*/
   itkGetMacro(StreamSize, SizeType);
 
+  /** Set/Get whether polygons are stitched from the pixels on each side of the
+   * streaming lines (see class documentation). Default is false. */
+  itkSetMacro(BorderLabelStitching, bool);
+  itkGetMacro(BorderLabelStitching, bool);
+  itkBooleanMacro(BorderLabelStitching);
+
   /** Generate Data method. This method must be called explicitly (not through the \c Update method). */
   void GenerateData() override;
 
@@ -134,6 +150,21 @@ protected:
    Main computation method. if line is true process row part, else process column part.
    */
   void ProcessStreamingLine(bool line, itk::ProgressReporter& progress);
+
+  /**
+   Computation method of the border label stitching. if line is true process row part, else process column part.
+   */
+  void ProcessStreamingLineWithBorderLabels(bool line, itk::ProgressReporter& progress);
+
+  /** Rasterize the polygons intersecting a border region of pixels. Polygons not
+   * found yet are appended to features, and each pixel of labels receives the
+   * index + 1 of the polygon covering it in features (0 if none). */
+  void ComputeBorderLabels(const RegionType& border, std::vector<OGRFeatureType>& features, std::map<long, unsigned int>& featureIndices,
+                           std::vector<GUInt32>& labels);
+
+  /** Copy the label field of a polygon to a fusioned polygon */
+  void CopyLabelField(OGRFeatureType& source, OGRFeatureType& fusion);
+
   /** get length in case of  OGRGeometryCollection.
    * This function recodes the get_lenght method available since gdal 1.8.0
    * in the case of OGRGeometryCollection. The aim is to allow accessing polygon stiching
@@ -148,6 +179,7 @@ private:
   SizeType     m_StreamSize{0,0};
   unsigned int m_Radius;
   OGRLayerType m_OGRLayer;
+  bool         m_BorderLabelStitching;
 };
 
 
@@ -24,15 +24,21 @@
 #include "otbOGRLayerStreamStitchingFilter.h"
 #include "itkContinuousIndex.h"
 
+#include <cmath>
+#include <cstdint>
 #include <iomanip>
+#include <sstream>
 #include "ogrsf_frmts.h"
+#include "gdal_alg.h"
+#include <map>
 #include <set>
+#include <utility>
 
 namespace otb
 {
 
 template <class TImage>
-OGRLayerStreamStitchingFilter<TImage>::OGRLayerStreamStitchingFilter() : m_Radius(2), m_OGRLayer(nullptr, false)
+OGRLayerStreamStitchingFilter<TImage>::OGRLayerStreamStitchingFilter() : m_Radius(2), m_OGRLayer(nullptr, false), m_BorderLabelStitching(false)
 {
   m_StreamSize.Fill(0);
 }
@@ -304,21 +310,9 @@ void OGRLayerStreamStitchingFilter<TInputImage>::ProcessStreamingLine(bool line,
           OGRFeatureType         fusionFeature(m_OGRLayer.GetLayerDefn());
           fusionFeature.SetGeometry(fusionPolygon.get());
 
-          ogr::Field field = upper.feat[0];
           try
           {
-            switch (field.GetType())
-            {
-            case OFTInteger64:
-            {
-              fusionFeature[0].SetValue(field.GetValue<GIntBig>());
-              break;
-            }
-            default:
-            {
-              fusionFeature[0].SetValue(field.GetValue<int>());
-            }
-            }
+            this->CopyLabelField(upper.feat, fusionFeature);
             m_OGRLayer.CreateFeature(fusionFeature);
             m_OGRLayer.DeleteFeature(lower.feat.GetFID());
             m_OGRLayer.DeleteFeature(upper.feat.GetFID());
@@ -346,6 +340,243 @@ void OGRLayerStreamStitchingFilter<TInputImage>::ProcessStreamingLine(bool line,
     }
   } // end for y
 }
+template <class TInputImage>
+void OGRLayerStreamStitchingFilter<TInputImage>::CopyLabelField(OGRFeatureType& source, OGRFeatureType& fusion)
+{
+  ogr::Field field = source[0];
+  switch (field.GetType())
+  {
+  case OFTInteger64:
+  {
+    fusion[0].SetValue(field.GetValue<GIntBig>());
+    break;
+  }
+  default:
+  {
+    fusion[0].SetValue(field.GetValue<int>());
+  }
+  }
+}
+
+template <class TInputImage>
+void OGRLayerStreamStitchingFilter<TInputImage>::ComputeBorderLabels(const RegionType& border, std::vector<OGRFeatureType>& features,
+                                                                     std::map<long, unsigned int>& featureIndices, std::vector<GUInt32>& labels)
+{
+  typename InputImageType::ConstPointer inputImage = this->GetInput();
+  const SpacingType                     spacing    = inputImage->GetSignedSpacing();
+
+  // Select the polygons intersecting the border pixels
+  IndexType lastIndex = border.GetIndex();
+  lastIndex[0] += border.GetSize()[0] - 1;
+  lastIndex[1] += border.GetSize()[1] - 1;
+  OriginType firstPoint;
+  inputImage->TransformIndexToPhysicalPoint(border.GetIndex(), firstPoint);
+  OriginType lastPoint;
+  inputImage->TransformIndexToPhysicalPoint(lastIndex, lastPoint);
+
+  const double halfX = 0.5 * std::abs(spacing[0]);
+  const double halfY = 0.5 * std::abs(spacing[1]);
+  m_OGRLayer.SetSpatialFilterRect(std::min(firstPoint[0], lastPoint[0]) - halfX, std::min(firstPoint[1], lastPoint[1]) - halfY,
+                                  std::max(firstPoint[0], lastPoint[0]) + halfX, std::max(firstPoint[1], lastPoint[1]) + halfY);
+
+  std::vector<OGRGeometryH> geometries;
+  std::vector<double>       burnValues;
+  for (OGRLayerType::const_iterator featIt = m_OGRLayer.begin(); featIt != m_OGRLayer.end(); ++featIt)
+  {
+    OGRGeometry const* geometry = (*featIt).GetGeometry();
+    if (geometry == nullptr || !geometry->IsValid())
+    {
+      continue;
+    }
+
+    // A polygon may cross the streaming line: it has the same index on both sides
+    std::map<long, unsigned int>::const_iterator found = featureIndices.find((*featIt).GetFID());
+    unsigned int                                 index;
+    if (found == featureIndices.end())
+    {
+      index = features.size();
+      featureIndices[(*featIt).GetFID()] = index;
+      features.push_back(*featIt);
+    }
+    else
+    {
+      index = found->second;
+    }
+    geometries.push_back(reinterpret_cast<OGRGeometryH>(const_cast<OGRGeometry*>(geometry)));
+    burnValues.push_back(static_cast<double>(index + 1));
+  }
+
+  labels.assign(border.GetNumberOfPixels(), 0);
+  if (geometries.empty())
+  {
+    return;
+  }
+
+  std::ostringstream stream;
+  stream << "MEM:::"
+         << "DATAPOINTER=" << (uintptr_t)(&labels[0]) << ","
+         << "PIXELS=" << border.GetSize()[0] << ","
+         << "LINES=" << border.GetSize()[1] << ","
+         << "BANDS=1,"
+         << "DATATYPE=UInt32";
+
+  GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
+  if (dataset == nullptr)
+  {
+    itkExceptionMacro(<< "Unable to create the dataset to rasterize the polygons along the streaming lines.");
+  }
+
+  double geoTransform[6] = {firstPoint[0] - 0.5 * spacing[0], spacing[0], 0., firstPoint[1] - 0.5 * spacing[1], 0., spacing[1]};
+  GDALSetGeoTransform(dataset, geoTransform);
+
+  // Without ALL_TOUCHED, a pixel is burnt by the polygon containing its
+  // centre, which is unique for polygons vectorized from a label image
+  int    band = 1;
+  CPLErr err  = GDALRasterizeGeometries(dataset, 1, &band, geometries.size(), &geometries[0], nullptr, nullptr, &burnValues[0], nullptr, GDALDummyProgress,
+                                      nullptr);
+  GDALClose(dataset);
+
+  if (err == CE_Failure)
+  {
+    itkExceptionMacro(<< "Unable to rasterize the polygons along the streaming lines: " << CPLGetLastErrorMsg());
+  }
+}
+
+template <class TInputImage>
+void OGRLayerStreamStitchingFilter<TInputImage>::ProcessStreamingLineWithBorderLabels(bool line, itk::ProgressReporter& progress)
+{
+  typename InputImageType::ConstPointer inputImage = this->GetInput();
+
+  // compute the number of stream division in row and column
+  RegionType   largestRegion = inputImage->GetLargestPossibleRegion();
+  SizeType     imageSize     = largestRegion.GetSize();
+  unsigned int nbRowStream   = static_cast<unsigned int>(imageSize[1] / m_StreamSize[1] + 1);
+  unsigned int nbColStream   = static_cast<unsigned int>(imageSize[0] / m_StreamSize[0] + 1);
+
+  typedef typename IndexType::IndexValueType IndexValueType;
+
+  for (unsigned int x = 1; x <= nbColStream; x++)
+  {
+    OGRErr errStart = m_OGRLayer.ogr().StartTransaction();
+
+    if (errStart != OGRERR_NONE)
+    {
+      itkExceptionMacro(<< "Unable to start transaction for OGR layer " << m_OGRLayer.ogr().GetName() << ".");
+    }
+
+    for (unsigned int y = 1; y <= nbRowStream; y++)
+    {
+      // Compute the pixels on the upper/left side of the stream line
+      IndexType borderIndex;
+      SizeType  borderSize;
+      if (!line)
+      {
+        // Treat vertical stream line
+        borderIndex[0] = static_cast<IndexValueType>(m_StreamSize[0] * x) - 1;
+        borderIndex[1] = static_cast<IndexValueType>(m_StreamSize[1] * (y - 1));
+        borderSize[0]  = 1;
+        borderSize[1]  = m_StreamSize[1];
+      }
+      else
+      {
+        // Treat horizontal stream line
+        borderIndex[0] = static_cast<IndexValueType>(m_StreamSize[0] * (x - 1));
+        borderIndex[1] = static_cast<IndexValueType>(m_StreamSize[1] * y) - 1;
+        borderSize[0]  = m_StreamSize[0];
+        borderSize[1]  = 1;
+      }
+      RegionType upperBorder(borderIndex, borderSize);
+
+      // And the pixels on the lower/right side
+      borderIndex[line ? 1 : 0] += 1;
+      RegionType lowerBorder(borderIndex, borderSize);
+
+      // Stream lines on the image edges have nothing to stitch
+      if (!upperBorder.Crop(largestRegion) || !lowerBorder.Crop(largestRegion))
+      {
+        progress.CompletedPixel();
+        continue;
+      }
+
+      std::vector<OGRFeatureType>  features;
+      std::map<long, unsigned int> featureIndices;
+      std::vector<GUInt32>         upperLabels;
+      std::vector<GUInt32>         lowerLabels;
+      this->ComputeBorderLabels(upperBorder, features, featureIndices, upperLabels);
+      this->ComputeBorderLabels(lowerBorder, features, featureIndices, lowerLabels);
+
+      // Measure the border shared by each pair of polygons covering
+      // adjacent pixels across the stream line
+      const double                                            pixelLength = std::abs(inputImage->GetSignedSpacing()[line ? 0 : 1]);
+      std::map<std::pair<unsigned int, unsigned int>, double> sharedBorders;
+      for (unsigned int i = 0; i < upperLabels.size(); ++i)
+      {
+        if (upperLabels[i] != 0 && lowerLabels[i] != 0 && upperLabels[i] != lowerLabels[i])
+        {
+          sharedBorders[std::make_pair(upperLabels[i] - 1, lowerLabels[i] - 1)] += pixelLength;
+        }
+      }
+
+      std::vector<FusionStruct> fusionList;
+      fusionList.reserve(sharedBorders.size());
+      for (const auto& sharedBorder : sharedBorders)
+      {
+        FusionStruct fusion;
+        fusion.indStream1 = sharedBorder.first.first;
+        fusion.indStream2 = sharedBorder.first.second;
+        fusion.overlap    = sharedBorder.second;
+        fusionList.push_back(fusion);
+      }
+
+      // Fuse the pairs sharing the longest borders first, each polygon at
+      // most once, as ProcessStreamingLine() does
+      std::stable_sort(fusionList.begin(), fusionList.end(), SortFeature);
+      std::vector<bool> fusioned(features.size(), false);
+      for (const auto& fusion : fusionList)
+      {
+        if (fusioned[fusion.indStream1] || fusioned[fusion.indStream2])
+        {
+          continue;
+        }
+        fusioned[fusion.indStream1] = true;
+        fusioned[fusion.indStream2] = true;
+
+        OGRFeatureType&        upper         = features[fusion.indStream1];
+        OGRFeatureType&        lower         = features[fusion.indStream2];
+        ogr::UniqueGeometryPtr fusionPolygon = ogr::Union(*upper.GetGeometry(), *lower.GetGeometry());
+        OGRFeatureType         fusionFeature(m_OGRLayer.GetLayerDefn());
+        fusionFeature.SetGeometry(fusionPolygon.get());
+
+        try
+        {
+          this->CopyLabelField(upper, fusionFeature);
+          m_OGRLayer.CreateFeature(fusionFeature);
+          m_OGRLayer.DeleteFeature(lower.GetFID());
+          m_OGRLayer.DeleteFeature(upper.GetFID());
+        }
+        catch (itk::ExceptionObject& err)
+        {
+          otbWarningMacro(<< "An exception was caught during fusion: " << err);
+        }
+      }
+
+      // Update progress
+      progress.CompletedPixel();
+    }
+
+    if (m_OGRLayer.ogr().TestCapability("Transactions"))
+    {
+      OGRErr errCommitX = m_OGRLayer.ogr().CommitTransaction();
+      if (errCommitX != OGRERR_NONE)
+      {
+        itkExceptionMacro(<< "Unable to commit transaction for OGR layer " << m_OGRLayer.ogr().GetName() << ".");
+      }
+    }
+  }
+
+  m_OGRLayer.SetSpatialFilter(nullptr);
+}
+
 template <class TImage>
 void OGRLayerStreamStitchingFilter<TImage>::GenerateData(void)
 {
@@ -364,10 +595,20 @@ void OGRLayerStreamStitchingFilter<TImage>::GenerateData(void)
   unsigned int nbColStream = static_cast<unsigned int>(imageSize[0] / m_StreamSize[0] + 1);
 
   itk::ProgressReporter progress(this, 0, 2 * nbRowStream * nbColStream, 100, 0);
-  // Process column
-  this->ProcessStreamingLine(false, progress);
-  // Process row
-  this->ProcessStreamingLine(true, progress);
+  if (m_BorderLabelStitching)
+  {
+    // Process column
+    this->ProcessStreamingLineWithBorderLabels(false, progress);
+    // Process row
+    this->ProcessStreamingLineWithBorderLabels(true, progress);
+  }
+  else
+  {
+    // Process column
+    this->ProcessStreamingLine(false, progress);
+    // Process row
+    this->ProcessStreamingLine(true, progress);
+  }
 
   this->InvokeEvent(itk::EndEvent());
 }
@@ -26,10 +26,10 @@
 
 int otbOGRLayerStreamStitchingFilter(int argc, char* argv[])
 {
-  if (argc != 5)
+  if (argc != 5 && argc != 6)
   {
     std::cerr << "Usage: " << argv[0];
-    std::cerr << " inputImage inputOGR outputOGR streamingSize" << std::endl;
+    std::cerr << " inputImage inputOGR outputOGR streamingSize [borderLabelStitching]" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -37,6 +37,7 @@ int otbOGRLayerStreamStitchingFilter(int argc, char* argv[])
   const char*  inOGRfname  = argv[2];
   const char*  tmpOGRfname = argv[3];
   unsigned int size        = atoi(argv[4]);
+  bool         borderLabel = (argc == 6) && atoi(argv[5]) != 0;
 
   /** Typedefs */
   const unsigned int Dimension = 2;
@@ -83,6 +84,7 @@ int otbOGRLayerStreamStitchingFilter(int argc, char* argv[])
   filter->SetInput(reader->GetOutput());
   filter->SetOGRLayer(ogrDS->GetLayer(layerName));
   filter->SetStreamSize(streamSize);
+  filter->SetBorderLabelStitching(borderLabel);
   filter->GenerateData();
 
   // REPACK the layer to remove features marked as deleted in the Shapefile.
@@ -23,6 +23,7 @@
 
 
 #include <algorithm>
+#include <cassert>
 
 #include "itkCenteredRigid2DTransform.h"
 
@@ -31,6 +32,7 @@
 #include "otbGlActor.h"
 #include "otbImageFileReader.h"
 #include "otbImageSettings.h"
+#include "otbImageTileLoader.h"
 #include "otbMultiChannelExtractROI.h"
 #include "otbVectorRescaleIntensityImageFilter.h"
 #include "otbVectorImage.h"
@@ -179,6 +181,9 @@ public:
 
   itkGetObjectMacro( ImageSettings, ImageSettings );
 
+  // Background loader and CPU cache of the tiles
+  itkGetObjectMacro( TileLoader, ImageTileLoader );
+
   //
   // otb::GlActor overloads.
   //
@@ -213,11 +218,11 @@ protected:
 
     ~Tile();
 
-    void Link( ReaderType::OutputImageType * );
+    void Link( const ImageTileLoader::TileDataPointer & );
 
-    ReaderType::OutputImageType::Pointer const &
-    Image() const noexcept
-      { return m_Image; }
+    ImageTileLoader::TileDataPointer const &
+    Data() const noexcept
+      { return m_Data; }
 
     void Acquire() noexcept;
     void Release();
@@ -237,7 +242,7 @@ protected:
     RescaleFilterType::Pointer m_RescaleFilter;
 
   private:
-    VectorImageType::Pointer m_Image;
+    ImageTileLoader::TileDataPointer m_Data;
 
   };
 
@@ -249,7 +254,7 @@ private:
   void operator=(const Self&);
 
   // Load tile to GPU
-  void LoadTile(Tile& tile);
+  void LoadTile(Tile& tile, const ImageTileLoader::TileDataPointer & data);
 
   // Unload tile from GPU
   void UnloadTile(Tile& tile);
@@ -271,6 +276,10 @@ private:
 
   void UpdateResolution();
 
+  // Append the keys of the tiles covering region at the given
+  // resolution, region being cropped to largest
+  void ComputeTileKeys(RegionType region, const RegionType & largest, unsigned int resolution, std::vector< ImageTileLoader::TileKey > & keys) const;
+
   unsigned int m_TileSize;
 
   std::string m_FileName;
@@ -296,6 +305,8 @@ private:
 
   ImageSettings::Pointer m_ImageSettings;
 
+  ImageTileLoader::Pointer m_TileLoader;
+
   RSTransformType::Pointer m_ViewportToImageTransform;
   RSTransformType::Pointer m_ImageToViewportTransform;
 
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otb_ImageTileLoader_h
+#define otb_ImageTileLoader_h
+
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include "otbVectorImage.h"
+
+#include "OTBIceExport.h"
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+
+namespace otb
+{
+
+/** \class ImageTileLoader
+ * \brief Loads the tiles of an image in background threads, and keeps
+ * them in a bounded CPU cache.
+ *
+ * A tile is identified by its region in a resolution of the image and
+ * by its red, green and blue channels. Loading a tile reads the region
+ * of the three channels from the overview of the requested resolution,
+ * and converts it to a BGRA float buffer ready to be uploaded as a
+ * texture. Each worker thread owns its own readers, so that tiles are
+ * read in parallel.
+ *
+ * Request() replaces the tiles waiting to be loaded by a new list, in
+ * decreasing priority. Loaded tiles are kept in the cache, and the
+ * least recently used tiles are dropped when their buffers take more
+ * than MaxCacheSize bytes (the available RAM given by
+ * ConfigurationManager::GetMaxRAMHint() by default). Tiles still used
+ * by the caller stay valid after they are dropped from the cache.
+ *
+ * This class does not depend on OpenGL.
+ *
+ * \ingroup OTBIce
+ */
+class OTBIce_EXPORT ImageTileLoader : public itk::Object
+{
+public:
+  typedef ImageTileLoader Self;
+  typedef itk::Object Superclass;
+  typedef itk::SmartPointer< Self > Pointer;
+  typedef itk::SmartPointer< const Self > ConstPointer;
+
+  typedef VectorImage< float > VectorImageType;
+  typedef VectorImageType::RegionType RegionType;
+  typedef VectorImageType::IndexType IndexType;
+  typedef VectorImageType::PixelType PixelType;
+
+  /** Identifier of a tile */
+  struct TileKey
+  {
+    RegionType m_Region;
+    unsigned int m_Resolution;
+    unsigned int m_RedIdx;
+    unsigned int m_GreenIdx;
+    unsigned int m_BlueIdx;
+
+    bool operator < ( const TileKey & other ) const;
+    bool operator == ( const TileKey & other ) const;
+  };
+
+  /** Content of a loaded tile */
+  struct TileData
+  {
+    TileKey m_Key;
+    /** Pixels of the tile in BGRA order, alpha being 255 */
+    std::vector< float > m_Buffer;
+
+    /** Red, green and blue values of a pixel, its index being relative
+     * to the tile */
+    PixelType GetPixel( const IndexType & index ) const;
+
+    /** Copy the red, green and blue channels into a new image, whose
+     * largest region starts at index 0 */
+    VectorImageType::Pointer CreateImage() const;
+
+    /** Size of the buffer in bytes */
+    std::size_t GetMemorySize() const;
+  };
+
+  typedef std::shared_ptr< const TileData > TileDataPointer;
+
+  itkNewMacro( Self );
+
+  itkTypeMacro( ImageTileLoader, itk::Object );
+
+  /** Set the image to load the tiles from. The cache and the pending
+   * requests are cleared. */
+  void SetFileName( const std::string & filename );
+
+  const std::string & GetFileName() const;
+
+  /** Maximum size of the cached tile buffers, in bytes. The most
+   * recently used tile is always kept, even if it is larger. */
+  void SetMaxCacheSize( std::size_t bytes );
+
+  std::size_t GetMaxCacheSize() const;
+
+  /** Number of worker threads (default is 2). The workers are
+   * restarted when it changes. */
+  void SetNumberOfThreads( unsigned int nbThreads );
+
+  unsigned int GetNumberOfThreads() const;
+
+  /** Largest region of the given resolution of the image */
+  RegionType GetLargestRegion( unsigned int resolution );
+
+  /** Replace the tiles waiting to be loaded. Tiles already cached or
+   * being loaded are skipped. */
+  void Request( const std::vector< TileKey > & keys );
+
+  /** Return the tile if it is in the cache, and mark it as the most
+   * recently used one. Returns nullptr otherwise. */
+  TileDataPointer GetTile( const TileKey & key );
+
+  /** Block until the given tiles are cached, or failed to load, and
+   * return them. Missing tiles are requested first, before the tiles
+   * already waiting. Failed tiles are returned as nullptr. */
+  std::vector< TileDataPointer > WaitForTiles( const std::vector< TileKey > & keys );
+
+  /** Block until no tile is waiting or being loaded */
+  void Wait();
+
+  /** Number of tiles in the cache */
+  std::size_t GetNumberOfCachedTiles() const;
+
+  /** Size of the cached tile buffers, in bytes */
+  std::size_t GetCacheSize() const;
+
+  /** Number of tiles waiting or being loaded */
+  std::size_t GetNumberOfPendingTiles() const;
+
+  /** Read a tile in the calling thread, without caching it */
+  TileDataPointer LoadTile( const TileKey & key ) const;
+
+protected:
+  ImageTileLoader();
+
+  ~ImageTileLoader() override;
+
+  void PrintSelf( std::ostream & os, itk::Indent indent ) const override;
+
+private:
+  // prevent implementation
+  ImageTileLoader( const Self & );
+  void operator = ( const Self & );
+
+  typedef std::list< TileDataPointer > LRUListType;
+  typedef std::map< TileKey, LRUListType::iterator > CacheMapType;
+
+  void StartWorkers();
+
+  void StopWorkers();
+
+  void Run();
+
+  /** Add a tile to the cache, dropping the least recently used ones */
+  void Insert( const TileDataPointer & tile );
+
+  /** Drop the least recently used tiles until the cache fits in
+   * MaxCacheSize, m_Mutex being locked */
+  void Shrink();
+
+  /** Whether the tile is cached, being loaded or failed, m_Mutex being
+   * locked */
+  bool IsKnown( const TileKey & key ) const;
+
+  std::string GetResolutionFileName( unsigned int resolution ) const;
+
+  std::string m_FileName;
+  std::size_t m_MaxCacheSize;
+  std::size_t m_CacheSize;
+  unsigned int m_NumberOfThreads;
+
+  /** Incremented when the file changes, so that the workers drop their
+   * readers and the tiles of the previous file */
+  unsigned int m_Generation;
+
+  mutable std::mutex m_Mutex;
+  std::condition_variable m_TaskAvailable;
+  std::condition_variable m_TileDone;
+  std::deque< TileKey > m_Pending;
+  std::set< TileKey > m_Loading;
+  std::set< TileKey > m_Failed;
+  LRUListType m_LRU;
+  CacheMapType m_Cache;
+  std::map< unsigned int, RegionType > m_LargestRegions;
+  std::vector< std::thread > m_Workers;
+  bool m_Stop;
+}; // End class ImageTileLoader
+
+} // End namespace otb
+
+#endif
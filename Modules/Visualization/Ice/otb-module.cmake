@@ -37,6 +37,9 @@ ENABLE_SHARED
     
   OPTIONAL_DEPENDS
     
+  TEST_DEPENDS
+    OTBTestKernel
+
   DESCRIPTION
     "${DOCUMENTATION}"
 )
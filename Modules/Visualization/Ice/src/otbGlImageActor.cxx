@@ -36,6 +36,8 @@
 #include "otbListSampleToHistogramListGenerator.h"
 #include "otbCast.h"
 
+#include <cmath>
+#include <set>
 #include <stdexcept>
 
 namespace otb
@@ -114,7 +116,7 @@ GlImageActor::Tile
   // std::cout << "Deleted texture #" << m_TextureId << std::endl;
 
   m_TextureId = GL_ZERO;
-  m_Image = VectorImageType::Pointer();
+  m_Data = ImageTileLoader::TileDataPointer();
   m_RescaleFilter = RescaleFilterType::Pointer();
   m_Loaded = false;
 }
@@ -122,28 +124,14 @@ GlImageActor::Tile
 
 void
 GlImageActor::Tile
-::Link( GlImageActor::ReaderType::OutputImageType * i )
+::Link( const ImageTileLoader::TileDataPointer & data )
 {
-  assert( i );
+  assert( data );
 
   assert( !m_Loaded );
-  assert( m_Image.IsNull() );
+  assert( !m_Data );
 
-  auto extract = ExtractROIFilterType::New();
-
-  assert( extract );
-
-  extract->SetInput( i );
-
-  extract->SetExtractionRegion( m_ImageRegion );
-
-  extract->SetChannel( m_RedIdx );
-  extract->SetChannel( m_GreenIdx );
-  extract->SetChannel( m_BlueIdx );
-
-  extract->Update();
-
-  m_Image = extract->GetOutput();
+  m_Data = data;
 }
 
 
@@ -161,6 +149,7 @@ GlImageActor::GlImageActor()
     m_Spacing(),
     m_NumberOfComponents(0),
     m_ImageSettings( ImageSettings::New() ),
+    m_TileLoader( ImageTileLoader::New() ),
     m_ViewportToImageTransform(),
     m_ImageToViewportTransform(),
     m_ViewportForwardRotationTransform(RigidTransformType::New()),
@@ -226,12 +215,14 @@ std::string GlImageActor::GetWkt() const
 
 const ImageMetadata * GlImageActor::GetImd() const
 {
-  return &(m_FileReader->GetOutput()->m_Imd);
+  const VectorImageType* output = m_FileReader->GetOutput();
+  return &(output->GetImageMetadata());
 }
 
 bool GlImageActor::GetImd( ImageMetadata & imd ) const
 {
-  imd = m_FileReader->GetOutput()->GetImageMetadata();
+  const VectorImageType* output = m_FileReader->GetOutput();
+  imd = output->GetImageMetadata();
   return true;
 }
 
@@ -249,6 +240,8 @@ void GlImageActor::Initialize(const std::string & filename)
   m_FileReader->SetFileName(m_FileName);
   m_FileReader->GetOutput()->UpdateOutputInformation();
 
+  m_TileLoader->SetFileName(m_FileName);
+
   m_LargestRegion = m_FileReader->GetOutput()->GetLargestPossibleRegion();
 
   if(m_FileReader->GetOutput()->GetNumberOfComponentsPerPixel() < 3)
@@ -343,48 +336,134 @@ void GlImageActor::UpdateData()
 
   // Now we have the requested part of image, we need to find the
   // corresponding tiles
+  std::vector< ImageTileLoader::TileKey > visibleKeys;
+
+  ComputeTileKeys( requested, largest, m_CurrentResolution, visibleKeys );
+
+  // Prefetch the tiles around the viewport, then the tiles of the
+  // neighbouring resolutions, in background
+  std::vector< ImageTileLoader::TileKey > prefetchKeys;
+
+  RegionType around( requested );
+  around.PadByRadius( m_TileSize );
+
+  ComputeTileKeys( around, largest, m_CurrentResolution, prefetchKeys );
+
+  for( int delta : { -1, 1 } )
+    {
+    const int resolution = static_cast< int >( m_CurrentResolution ) + delta;
+
+    if( resolution < 0 || resolution >= static_cast< int >( m_AvailableResolutions.size() ) )
+      continue;
+
+    // Resolution r is subsampled by 2^r
+    const double factor = std::ldexp( 1.0, -delta );
+
+    RegionType scaled;
+    for( unsigned int dim = 0; dim < 2; ++dim )
+      {
+      scaled.SetIndex( dim, static_cast< IndexType::IndexValueType >( std::floor( requested.GetIndex( dim ) * factor ) ) );
+      scaled.SetSize( dim, static_cast< SizeType::SizeValueType >( std::ceil( requested.GetSize( dim ) * factor ) ) );
+      }
+
+    ComputeTileKeys( scaled, m_TileLoader->GetLargestRegion( resolution ), resolution, prefetchKeys );
+    }
+
+  const std::set< ImageTileLoader::TileKey > visibleSet( visibleKeys.begin(), visibleKeys.end() );
+
+  prefetchKeys.erase(
+    std::remove_if(
+      prefetchKeys.begin(), prefetchKeys.end(),
+      [ &visibleSet ]( const ImageTileLoader::TileKey & key ) { return visibleSet.count( key ) > 0; } ),
+    prefetchKeys.end() );
+
+  // Do not prefetch more tiles than the cache can hold along with the
+  // visible ones
+  const std::size_t cacheSize =
+    m_TileLoader->GetMaxCacheSize() / ( 4 * sizeof( float ) * m_TileSize * m_TileSize );
+
+  prefetchKeys.resize(
+    std::min( prefetchKeys.size(),
+              cacheSize > visibleKeys.size() ? cacheSize - visibleKeys.size() : 0 ) );
+
+  m_TileLoader->Request( prefetchKeys );
+
+  // Visible tiles which are not on the GPU yet
+  std::vector< Tile > newTiles;
+  std::vector< ImageTileLoader::TileKey > newKeys;
+
+  for( const ImageTileLoader::TileKey & key : visibleKeys )
+    {
+    Tile newTile;
+    newTile.m_TextureId = 0;
+
+    newTile.m_ImageRegion = key.m_Region;
+
+    newTile.m_RedIdx = key.m_RedIdx;
+    newTile.m_GreenIdx = key.m_GreenIdx;
+    newTile.m_BlueIdx = key.m_BlueIdx;
+    newTile.m_Resolution = key.m_Resolution;
+    newTile.m_TileSize = m_TileSize;
+
+    if(!TileAlreadyLoaded(newTile))
+      {
+      ImageRegionToViewportQuad(newTile.m_ImageRegion,newTile.m_UL,newTile.m_UR,newTile.m_LL,newTile.m_LR,false);
+
+      newTiles.push_back( newTile );
+      newKeys.push_back( key );
+      }
+    }
+
+  // Only wait for the visible tiles missing from the cache, which are
+  // read in parallel before the prefetched ones
+  std::vector< ImageTileLoader::TileDataPointer > newData( m_TileLoader->WaitForTiles( newKeys ) );
+
+  for( std::size_t i = 0; i < newTiles.size(); ++i )
+    {
+    if( newData[ i ] )
+      {
+      LoadTile( newTiles[ i ], newData[ i ] );
+      }
+    }
+}
+
+void GlImageActor::ComputeTileKeys(RegionType region, const RegionType & largest, unsigned int resolution, std::vector< ImageTileLoader::TileKey > & keys) const
+{
+  if( !region.Crop( largest ) )
+    return;
 
   // First compute needed tiles
-  unsigned int nbTilesX = std::ceil(static_cast<double>(requested.GetIndex()[0] + requested.GetSize()[0])/m_TileSize) -std::floor(static_cast<double>(requested.GetIndex()[0])/m_TileSize);
-  unsigned int nbTilesY = std::ceil(static_cast<double>(requested.GetIndex()[1] + requested.GetSize()[1])/m_TileSize) -std::floor(static_cast<double>(requested.GetIndex()[1])/m_TileSize);
-  //unsigned int nbTilesY = std::ceil(static_cast<double>(requested.GetSize()[1])/m_TileSize);
-  unsigned int tileStartX = m_TileSize*(requested.GetIndex()[0]/m_TileSize);
-  unsigned int tileStartY = m_TileSize*(requested.GetIndex()[1]/m_TileSize);
+  unsigned int nbTilesX = std::ceil(static_cast<double>(region.GetIndex()[0] + region.GetSize()[0])/m_TileSize) -std::floor(static_cast<double>(region.GetIndex()[0])/m_TileSize);
+  unsigned int nbTilesY = std::ceil(static_cast<double>(region.GetIndex()[1] + region.GetSize()[1])/m_TileSize) -std::floor(static_cast<double>(region.GetIndex()[1])/m_TileSize);
+  unsigned int tileStartX = m_TileSize*(region.GetIndex()[0]/m_TileSize);
+  unsigned int tileStartY = m_TileSize*(region.GetIndex()[1]/m_TileSize);
 
   SizeType tileSize;
   tileSize.Fill(m_TileSize);
 
-   for(unsigned int i = 0; i < nbTilesX; ++i)
+  for(unsigned int i = 0; i < nbTilesX; ++i)
     {
     for(unsigned int j = 0; j<nbTilesY; ++j)
       {
-      Tile newTile;
-      newTile.m_TextureId = 0;
+      ImageTileLoader::TileKey key;
 
       IndexType tileIndex;
       tileIndex[0] = static_cast<unsigned int>(tileStartX+i*m_TileSize);
       tileIndex[1] = static_cast<unsigned int>(tileStartY+j*m_TileSize);
 
-      newTile.m_ImageRegion.SetSize(tileSize);
-      newTile.m_ImageRegion.SetIndex(tileIndex);
-
-      newTile.m_ImageRegion.Crop( largest );
+      key.m_Region.SetSize(tileSize);
+      key.m_Region.SetIndex(tileIndex);
 
-      ImageRegionToViewportQuad(newTile.m_ImageRegion,newTile.m_UL,newTile.m_UR,newTile.m_LL,newTile.m_LR,false);
+      key.m_Region.Crop( largest );
 
-      newTile.m_RedIdx = m_RedIdx;
-      newTile.m_GreenIdx = m_GreenIdx;
-      newTile.m_BlueIdx = m_BlueIdx;
-      newTile.m_Resolution = m_CurrentResolution;
-      newTile.m_TileSize = m_TileSize;
+      key.m_Resolution = resolution;
+      key.m_RedIdx = m_RedIdx;
+      key.m_GreenIdx = m_GreenIdx;
+      key.m_BlueIdx = m_BlueIdx;
 
-      if(!TileAlreadyLoaded(newTile))
-        {
-        LoadTile(newTile);
-        }
+      keys.push_back( key );
       }
     }
-
 }
 
 bool GlImageActor::TileAlreadyLoaded(const Tile& tile)
@@ -434,7 +513,7 @@ void GlImageActor::Render()
       {
         it->m_RescaleFilter = RescaleFilterType::New();
         it->m_RescaleFilter->AutomaticInputMinMaxComputationOff();
-        it->m_RescaleFilter->SetInput(it->Image());
+        it->m_RescaleFilter->SetInput(it->Data()->CreateImage());
       }
 
       VectorImageType::PixelType mins(3),maxs(3),omins(3),omaxs(3);
@@ -481,7 +560,8 @@ void GlImageActor::Render()
 
 
       itk::ImageRegionConstIterator<UCharVectorImageType> imIt(it->m_RescaleFilter->GetOutput(),it->m_RescaleFilter->GetOutput()->GetLargestPossibleRegion());
-      itk::ImageRegionConstIterator<VectorImageType> inIt(it->Image(),it->Image()->GetLargestPossibleRegion());
+      const VectorImageType * inImage = it->m_RescaleFilter->GetInput();
+      itk::ImageRegionConstIterator<VectorImageType> inIt(inImage,inImage->GetLargestPossibleRegion());
 
       auto buffer =
         std::make_unique< GLubyte[] >(
@@ -585,50 +665,22 @@ void GlImageActor::Render()
     }
 }
 
-void GlImageActor::LoadTile(Tile& tile)
+void GlImageActor::LoadTile(Tile& tile, const ImageTileLoader::TileDataPointer & data)
 {
-  assert( !m_FileReader.IsNull() );
-
-  tile.Link( m_FileReader->GetOutput() );
-
-  assert( tile.Image() );
+  // Reading and conversion of the tile have already been done by the
+  // tile loader: only upload its buffer here
+  tile.Link( data );
 
   if(!m_Shader.IsNull())
   {
-    itk::ImageRegionConstIterator< VectorImageType > it(
-      tile.Image(),
-      tile.Image()->GetLargestPossibleRegion());
-
-    auto buffer =
-      std::make_unique< float[] >(
-      4 * tile.Image()->GetLargestPossibleRegion().GetNumberOfPixels()
-      );
-
-    assert( buffer );
-
-    unsigned int idx = 0;
-
-    for(it.GoToBegin();!it.IsAtEnd();++it)
-    {
-      buffer[idx] = static_cast<float>(it.Get()[2]);
-      ++idx;
-      buffer[idx] = static_cast<float>(it.Get()[1]);
-      ++idx;
-      buffer[idx] = static_cast<float>(it.Get()[0]);
-      ++idx;
-      buffer[idx] = 255.;
-      ++idx;
-    }
-
-
     tile.Acquire();
 
     glTexImage2D(
       GL_TEXTURE_2D, 0, GL_RGB32F,
-      tile.Image()->GetLargestPossibleRegion().GetSize()[ 0 ],
-      tile.Image()->GetLargestPossibleRegion().GetSize()[ 1 ],
+      data->m_Key.m_Region.GetSize()[ 0 ],
+      data->m_Key.m_Region.GetSize()[ 1 ],
       0, GL_BGRA, GL_FLOAT,
-      buffer.get()
+      data->m_Buffer.data()
       );
 
     tile.m_Loaded = true;
@@ -920,7 +972,7 @@ GlImageActor
       idx[ 0 ] = ovrIndex[ 0 ] - it->m_ImageRegion.GetIndex()[ 0 ];
       idx[ 1 ] = ovrIndex[ 1 ] - it->m_ImageRegion.GetIndex()[ 1 ];
 
-      pixel = it->Image()->GetPixel( idx );
+      pixel = it->Data()->GetPixel( idx );
 
       return true;
       }
@@ -1107,15 +1159,17 @@ void GlImageActor::UpdateTransforms()
     m_ViewportToImageTransform = RSTransformType::New();
     m_ImageToViewportTransform = RSTransformType::New();
 
+    const VectorImageType* output = m_FileReader->GetOutput();
+
     m_ViewportToImageTransform->SetInputProjectionRef(settings->GetWkt());
     m_ViewportToImageTransform->SetInputImageMetadata(settings->GetImageMetadata());
     m_ViewportToImageTransform->SetOutputProjectionRef(m_FileReader->GetOutput()->GetProjectionRef());
-    m_ViewportToImageTransform->SetOutputImageMetadata(&(m_FileReader->GetOutput()->GetImageMetadata()));
+    m_ViewportToImageTransform->SetOutputImageMetadata(&(output->GetImageMetadata()));
 
     m_ImageToViewportTransform->SetOutputProjectionRef(settings->GetWkt());
     m_ImageToViewportTransform->SetOutputImageMetadata(settings->GetImageMetadata());
     m_ImageToViewportTransform->SetInputProjectionRef(m_FileReader->GetOutput()->GetProjectionRef());
-    m_ImageToViewportTransform->SetInputImageMetadata(&(m_FileReader->GetOutput()->GetImageMetadata()));
+    m_ImageToViewportTransform->SetInputImageMetadata(&(output->GetImageMetadata()));
 
     hasChanged = true;
     }
@@ -1218,23 +1272,27 @@ void GlImageActor::AutoColorAdjustment(
     // Retrieve all tiles
     for(TileVectorType::iterator it = m_LoadedTiles.begin();it!=m_LoadedTiles.end();++it)
       {
-      itk::ImageRegionConstIterator< VectorImageType > imIt(
-        it->Image(),
-        it->Image()->GetLargestPossibleRegion()
-        );
+      const std::vector< float > & buffer = it->Data()->m_Buffer;
+
+      // Tile buffers are in BGRA order
+      PixelType pixel( 3 );
 
-      for(imIt.GoToBegin();!imIt.IsAtEnd();++imIt)
+      for(std::size_t idx = 0; idx + 3 < buffer.size(); idx += 4)
         {
+        pixel[ 0 ] = buffer[ idx + 2 ];
+        pixel[ 1 ] = buffer[ idx + 1 ];
+        pixel[ 2 ] = buffer[ idx ];
+
         bool nonan = true;
-  
-        for(unsigned int i = 0; i < imIt.Get().Size();++i)
+
+        for(unsigned int i = 0; i < pixel.Size();++i)
           {
-          nonan = nonan && !vnl_math_isnan(imIt.Get()[i]);
+          nonan = nonan && !vnl_math_isnan(pixel[i]);
           }
 
         if(nonan)
           {
-          listSample->PushBack(imIt.Get());
+          listSample->PushBack(pixel);
           }
         }
       }
@@ -0,0 +1,575 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageTileLoader.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+#include "otbConfigurationManager.h"
+#include "otbImageFileReader.h"
+#include "otbMacro.h"
+#include "otbMultiChannelExtractROI.h"
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
+
+namespace otb
+{
+
+namespace
+{
+
+typedef ImageFileReader< ImageTileLoader::VectorImageType > ReaderType;
+typedef MultiChannelExtractROI< float, float > ExtractROIFilterType;
+
+ImageTileLoader::TileDataPointer
+ReadTile( ReaderType * reader, const ImageTileLoader::TileKey & key )
+{
+  auto extract = ExtractROIFilterType::New();
+
+  extract->SetInput( reader->GetOutput() );
+
+  extract->SetExtractionRegion( key.m_Region );
+
+  extract->SetChannel( key.m_RedIdx );
+  extract->SetChannel( key.m_GreenIdx );
+  extract->SetChannel( key.m_BlueIdx );
+
+  extract->Update();
+
+  const ImageTileLoader::VectorImageType * image = extract->GetOutput();
+
+  auto tile = std::make_shared< ImageTileLoader::TileData >();
+
+  tile->m_Key = key;
+  tile->m_Buffer.resize( 4 * image->GetLargestPossibleRegion().GetNumberOfPixels() );
+
+  itk::ImageRegionConstIterator< ImageTileLoader::VectorImageType > it(
+    image,
+    image->GetLargestPossibleRegion() );
+
+  std::size_t idx = 0;
+
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    tile->m_Buffer[ idx++ ] = static_cast< float >( it.Get()[ 2 ] );
+    tile->m_Buffer[ idx++ ] = static_cast< float >( it.Get()[ 1 ] );
+    tile->m_Buffer[ idx++ ] = static_cast< float >( it.Get()[ 0 ] );
+    tile->m_Buffer[ idx++ ] = 255.f;
+    }
+
+  return tile;
+}
+
+} // End anonymous namespace
+
+
+bool
+ImageTileLoader::TileKey
+::operator < ( const TileKey & other ) const
+{
+  return
+    std::make_tuple( m_Resolution, m_RedIdx, m_GreenIdx, m_BlueIdx,
+                     m_Region.GetIndex()[ 0 ], m_Region.GetIndex()[ 1 ],
+                     m_Region.GetSize()[ 0 ], m_Region.GetSize()[ 1 ] )
+    <
+    std::make_tuple( other.m_Resolution, other.m_RedIdx, other.m_GreenIdx, other.m_BlueIdx,
+                     other.m_Region.GetIndex()[ 0 ], other.m_Region.GetIndex()[ 1 ],
+                     other.m_Region.GetSize()[ 0 ], other.m_Region.GetSize()[ 1 ] );
+}
+
+bool
+ImageTileLoader::TileKey
+::operator == ( const TileKey & other ) const
+{
+  return m_Region == other.m_Region
+    && m_Resolution == other.m_Resolution
+    && m_RedIdx == other.m_RedIdx
+    && m_GreenIdx == other.m_GreenIdx
+    && m_BlueIdx == other.m_BlueIdx;
+}
+
+
+ImageTileLoader::PixelType
+ImageTileLoader::TileData
+::GetPixel( const IndexType & index ) const
+{
+  const std::size_t offset =
+    4 * ( index[ 1 ] * m_Key.m_Region.GetSize()[ 0 ] + index[ 0 ] );
+
+  assert( offset + 3 < m_Buffer.size() );
+
+  PixelType pixel( 3 );
+
+  pixel[ 0 ] = m_Buffer[ offset + 2 ];
+  pixel[ 1 ] = m_Buffer[ offset + 1 ];
+  pixel[ 2 ] = m_Buffer[ offset ];
+
+  return pixel;
+}
+
+ImageTileLoader::VectorImageType::Pointer
+ImageTileLoader::TileData
+::CreateImage() const
+{
+  RegionType region;
+  region.SetSize( m_Key.m_Region.GetSize() );
+
+  auto image = VectorImageType::New();
+
+  image->SetRegions( region );
+  image->SetNumberOfComponentsPerPixel( 3 );
+  image->Allocate();
+
+  itk::ImageRegionIterator< VectorImageType > it( image, region );
+
+  std::size_t idx = 0;
+  PixelType pixel( 3 );
+
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it, idx += 4 )
+    {
+    pixel[ 0 ] = m_Buffer[ idx + 2 ];
+    pixel[ 1 ] = m_Buffer[ idx + 1 ];
+    pixel[ 2 ] = m_Buffer[ idx ];
+
+    it.Set( pixel );
+    }
+
+  return image;
+}
+
+std::size_t
+ImageTileLoader::TileData
+::GetMemorySize() const
+{
+  return m_Buffer.size() * sizeof( float );
+}
+
+
+ImageTileLoader::ImageTileLoader()
+  : m_FileName(),
+    m_MaxCacheSize( ConfigurationManager::GetMaxRAMHint() * 1024 * 1024 ),
+    m_CacheSize( 0 ),
+    m_NumberOfThreads( 2 ),
+    m_Generation( 0 ),
+    m_Stop( false )
+{
+}
+
+ImageTileLoader::~ImageTileLoader()
+{
+  StopWorkers();
+}
+
+void ImageTileLoader::PrintSelf( std::ostream & os, itk::Indent indent ) const
+{
+  Superclass::PrintSelf( os, indent );
+
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "MaxCacheSize: " << m_MaxCacheSize << std::endl;
+  os << indent << "CacheSize: " << m_CacheSize << std::endl;
+  os << indent << "NumberOfThreads: " << m_NumberOfThreads << std::endl;
+  os << indent << "Cached tiles: " << m_Cache.size() << std::endl;
+  os << indent << "Pending tiles: " << m_Pending.size() + m_Loading.size() << std::endl;
+}
+
+void ImageTileLoader::SetFileName( const std::string & filename )
+{
+  {
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  m_FileName = filename;
+  ++m_Generation;
+
+  m_Pending.clear();
+  m_Loading.clear();
+  m_Failed.clear();
+  m_LRU.clear();
+  m_Cache.clear();
+  m_CacheSize = 0;
+  m_LargestRegions.clear();
+  }
+
+  m_TileDone.notify_all();
+
+  this->Modified();
+}
+
+const std::string & ImageTileLoader::GetFileName() const
+{
+  return m_FileName;
+}
+
+void ImageTileLoader::SetMaxCacheSize( std::size_t bytes )
+{
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  m_MaxCacheSize = bytes;
+
+  Shrink();
+}
+
+std::size_t ImageTileLoader::GetMaxCacheSize() const
+{
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  return m_MaxCacheSize;
+}
+
+void ImageTileLoader::SetNumberOfThreads( unsigned int nbThreads )
+{
+  nbThreads = std::max( nbThreads, 1u );
+
+  if( nbThreads == m_NumberOfThreads )
+    return;
+
+  const bool running = !m_Workers.empty();
+
+  StopWorkers();
+
+  m_NumberOfThreads = nbThreads;
+
+  if( running )
+    StartWorkers();
+}
+
+unsigned int ImageTileLoader::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+ImageTileLoader::RegionType
+ImageTileLoader::GetLargestRegion( unsigned int resolution )
+{
+  std::string filename;
+  unsigned int generation;
+
+  {
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  auto it = m_LargestRegions.find( resolution );
+
+  if( it != m_LargestRegions.end() )
+    return it->second;
+
+  filename = GetResolutionFileName( resolution );
+  generation = m_Generation;
+  }
+
+  // Opening the file may take a while: workers must not wait for it
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( filename );
+  reader->UpdateOutputInformation();
+
+  const RegionType region = reader->GetOutput()->GetLargestPossibleRegion();
+
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  // The region of a previous file is not kept
+  if( generation == m_Generation )
+    m_LargestRegions.emplace( resolution, region );
+
+  return region;
+}
+
+void ImageTileLoader::Request( const std::vector< TileKey > & keys )
+{
+  if( m_Workers.empty() )
+    StartWorkers();
+
+  {
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  m_Pending.clear();
+
+  for( const TileKey & key : keys )
+    if( !IsKnown( key ) )
+      m_Pending.push_back( key );
+  }
+
+  m_TaskAvailable.notify_all();
+  m_TileDone.notify_all();
+}
+
+ImageTileLoader::TileDataPointer
+ImageTileLoader::GetTile( const TileKey & key )
+{
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  auto it = m_Cache.find( key );
+
+  if( it == m_Cache.end() )
+    return TileDataPointer();
+
+  // Mark as most recently used
+  m_LRU.splice( m_LRU.begin(), m_LRU, it->second );
+
+  return *it->second;
+}
+
+std::vector< ImageTileLoader::TileDataPointer >
+ImageTileLoader::WaitForTiles( const std::vector< TileKey > & keys )
+{
+  if( m_Workers.empty() )
+    StartWorkers();
+
+  std::unique_lock< std::mutex > lock( m_Mutex );
+
+  // Missing tiles go first, in the given order
+  for( auto it = keys.rbegin(); it != keys.rend(); ++it )
+    if( !IsKnown( *it ) )
+      m_Pending.push_front( *it );
+
+  m_TaskAvailable.notify_all();
+
+  m_TileDone.wait(
+    lock,
+    [ this, &keys ]()
+    {
+      for( const TileKey & key : keys )
+        if( m_Loading.count( key ) ||
+            std::find( m_Pending.begin(), m_Pending.end(), key ) != m_Pending.end() )
+          return false;
+      return true;
+    } );
+
+  std::vector< TileDataPointer > tiles;
+  tiles.reserve( keys.size() );
+
+  for( const TileKey & key : keys )
+    {
+    auto it = m_Cache.find( key );
+
+    if( it == m_Cache.end() )
+      tiles.push_back( TileDataPointer() );
+    else
+      {
+      m_LRU.splice( m_LRU.begin(), m_LRU, it->second );
+      tiles.push_back( *it->second );
+      }
+    }
+
+  return tiles;
+}
+
+void ImageTileLoader::Wait()
+{
+  std::unique_lock< std::mutex > lock( m_Mutex );
+
+  m_TileDone.wait( lock, [ this ]() { return m_Pending.empty() && m_Loading.empty(); } );
+}
+
+std::size_t ImageTileLoader::GetNumberOfCachedTiles() const
+{
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  return m_Cache.size();
+}
+
+std::size_t ImageTileLoader::GetCacheSize() const
+{
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  return m_CacheSize;
+}
+
+std::size_t ImageTileLoader::GetNumberOfPendingTiles() const
+{
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  return m_Pending.size() + m_Loading.size();
+}
+
+ImageTileLoader::TileDataPointer
+ImageTileLoader::LoadTile( const TileKey & key ) const
+{
+  ReaderType::Pointer reader = ReaderType::New();
+
+  {
+  std::lock_guard< std::mutex > lock( m_Mutex );
+
+  reader->SetFileName( GetResolutionFileName( key.m_Resolution ) );
+  }
+
+  return ReadTile( reader, key );
+}
+
+void ImageTileLoader::StartWorkers()
+{
+  assert( m_Workers.empty() );
+
+  for( unsigned int i = 0; i < m_NumberOfThreads; ++i )
+    m_Workers.emplace_back( &Self::Run, this );
+}
+
+void ImageTileLoader::StopWorkers()
+{
+  {
+  std::lock_guard< std::mutex > lock( m_Mutex );
+  m_Stop = true;
+  }
+
+  m_TaskAvailable.notify_all();
+
+  for( std::thread & worker : m_Workers )
+    worker.join();
+
+  m_Workers.clear();
+
+  std::lock_guard< std::mutex > lock( m_Mutex );
+  m_Stop = false;
+}
+
+void ImageTileLoader::Run()
+{
+  // Readers of this worker, by resolution
+  std::map< unsigned int, ReaderType::Pointer > readers;
+  unsigned int generation = 0;
+
+  while( true )
+    {
+    TileKey key;
+    std::string filename;
+
+    {
+    std::unique_lock< std::mutex > lock( m_Mutex );
+
+    m_TaskAvailable.wait( lock, [ this ]() { return m_Stop || !m_Pending.empty(); } );
+
+    if( m_Stop )
+      return;
+
+    key = m_Pending.front();
+    m_Pending.pop_front();
+
+    if( IsKnown( key ) )
+      {
+      m_TileDone.notify_all();
+      continue;
+      }
+
+    m_Loading.insert( key );
+
+    if( generation != m_Generation )
+      {
+      readers.clear();
+      generation = m_Generation;
+      }
+
+    filename = GetResolutionFileName( key.m_Resolution );
+    }
+
+    TileDataPointer tile;
+
+    try
+      {
+      ReaderType::Pointer & reader = readers[ key.m_Resolution ];
+
+      if( reader.IsNull() )
+        {
+        reader = ReaderType::New();
+        reader->SetFileName( filename );
+        }
+
+      tile = ReadTile( reader, key );
+      }
+    catch( itk::ExceptionObject & err )
+      {
+      otbLogMacro( Warning, << "Failed to load tile " << key.m_Region << " of " << filename << ": " << err.GetDescription() );
+      }
+    catch( std::exception & err )
+      {
+      otbLogMacro( Warning, << "Failed to load tile " << key.m_Region << " of " << filename << ": " << err.what() );
+      }
+
+    {
+    std::lock_guard< std::mutex > lock( m_Mutex );
+
+    // Tiles of a previous file are dropped
+    if( generation == m_Generation )
+      {
+      m_Loading.erase( key );
+
+      if( tile )
+        Insert( tile );
+      else
+        m_Failed.insert( key );
+      }
+    }
+
+    m_TileDone.notify_all();
+    }
+}
+
+void ImageTileLoader::Insert( const TileDataPointer & tile )
+{
+  auto it = m_Cache.find( tile->m_Key );
+
+  if( it != m_Cache.end() )
+    {
+    m_CacheSize -= ( *it->second )->GetMemorySize();
+    m_LRU.erase( it->second );
+    m_Cache.erase( it );
+    }
+
+  m_LRU.push_front( tile );
+  m_Cache.emplace( tile->m_Key, m_LRU.begin() );
+  m_CacheSize += tile->GetMemorySize();
+
+  Shrink();
+}
+
+void ImageTileLoader::Shrink()
+{
+  while( m_CacheSize > m_MaxCacheSize && m_LRU.size() > 1 )
+    {
+    m_CacheSize -= m_LRU.back()->GetMemorySize();
+    m_Cache.erase( m_LRU.back()->m_Key );
+    m_LRU.pop_back();
+    }
+}
+
+bool ImageTileLoader::IsKnown( const TileKey & key ) const
+{
+  return m_Cache.count( key ) || m_Loading.count( key ) || m_Failed.count( key );
+}
+
+std::string ImageTileLoader::GetResolutionFileName( unsigned int resolution ) const
+{
+  std::ostringstream extFilename;
+
+  extFilename << m_FileName;
+
+  if ( m_FileName.find( '?' ) == std::string::npos )
+    {
+    extFilename << '?';
+    }
+
+  extFilename << "&resol=" << resolution;
+
+  return extFilename.str();
+}
+
+} // End namespace otb
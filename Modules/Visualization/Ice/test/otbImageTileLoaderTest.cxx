@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "otbImageTileLoader.h"
+
+typedef otb::ImageTileLoader LoaderType;
+
+namespace
+{
+
+const itk::SizeValueType TileSize = 32;
+
+/** Keys of the TileSize x TileSize tiles of the first resolution, red, green and blue
+ * being the three first bands */
+std::vector<LoaderType::TileKey> TileKeys(LoaderType* loader)
+{
+  const LoaderType::RegionType largest = loader->GetLargestRegion(0);
+
+  std::vector<LoaderType::TileKey> keys;
+  for (itk::IndexValueType y = 0; y < static_cast<itk::IndexValueType>(largest.GetSize(1)); y += TileSize)
+  {
+    for (itk::IndexValueType x = 0; x < static_cast<itk::IndexValueType>(largest.GetSize(0)); x += TileSize)
+    {
+      LoaderType::TileKey key;
+      key.m_Region.SetIndex(0, largest.GetIndex(0) + x);
+      key.m_Region.SetIndex(1, largest.GetIndex(1) + y);
+      key.m_Region.SetSize(0, TileSize);
+      key.m_Region.SetSize(1, TileSize);
+      key.m_Region.Crop(largest);
+      key.m_Resolution = 0;
+      key.m_RedIdx     = 1;
+      key.m_GreenIdx   = 2;
+      key.m_BlueIdx    = 3;
+      keys.push_back(key);
+    }
+  }
+  return keys;
+}
+
+} // End anonymous namespace
+
+/** Check the cache bound and LRU order, the priority given by
+ * WaitForTiles(), the content of the tiles and the drop of the tiles of
+ * a previous file */
+int otbImageTileLoaderTest(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " input" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Loaded tiles are those read in the calling thread
+  {
+    LoaderType::Pointer loader = LoaderType::New();
+    loader->SetFileName(argv[1]);
+
+    const std::vector<LoaderType::TileKey> keys = TileKeys(loader);
+    if (keys.size() < 16)
+    {
+      std::cerr << "The input image is too small: " << keys.size() << " tiles" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const std::vector<LoaderType::TileKey>   first(keys.begin(), keys.begin() + 4);
+    std::vector<LoaderType::TileDataPointer> tiles = loader->WaitForTiles(first);
+    for (std::size_t i = 0; i < first.size(); ++i)
+    {
+      LoaderType::TileDataPointer expected = loader->LoadTile(first[i]);
+      if (!tiles[i] || !expected || tiles[i]->m_Buffer != expected->m_Buffer)
+      {
+        std::cerr << "Tile " << first[i].m_Region << " differs from the one read by LoadTile()" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The cache holds the most recently used tiles within its size
+  {
+    LoaderType::Pointer loader = LoaderType::New();
+    loader->SetFileName(argv[1]);
+
+    const std::vector<LoaderType::TileKey> keys     = TileKeys(loader);
+    const std::size_t                      tileSize = TileSize * TileSize * 4 * sizeof(float);
+    loader->SetMaxCacheSize(3 * tileSize);
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      loader->WaitForTiles({keys[i]});
+    }
+    // Tile 0 becomes the most recently used one, so tile 1 is dropped
+    loader->GetTile(keys[0]);
+    loader->WaitForTiles({keys[3]});
+
+    if (loader->GetNumberOfCachedTiles() != 3 || loader->GetCacheSize() > 3 * tileSize)
+    {
+      std::cerr << loader->GetNumberOfCachedTiles() << " tiles cached in " << loader->GetCacheSize() << " bytes instead of 3 tiles" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!loader->GetTile(keys[0]) || loader->GetTile(keys[1]) || !loader->GetTile(keys[2]) || !loader->GetTile(keys[3]))
+    {
+      std::cerr << "The least recently used tile was not the one dropped" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Tiles waited for are loaded before the requested ones
+  {
+    LoaderType::Pointer loader = LoaderType::New();
+    loader->SetFileName(argv[1]);
+    loader->SetNumberOfThreads(1);
+
+    const std::vector<LoaderType::TileKey> keys = TileKeys(loader);
+    const std::vector<LoaderType::TileKey> prefetch(keys.begin(), keys.end() - 1);
+
+    loader->Request(prefetch);
+    std::vector<LoaderType::TileDataPointer> tiles = loader->WaitForTiles({keys.back()});
+
+    if (!tiles[0])
+    {
+      std::cerr << "The tile waited for was not loaded" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (loader->GetNumberOfPendingTiles() == 0)
+    {
+      std::cerr << "The tile waited for was loaded after all the requested ones" << std::endl;
+      return EXIT_FAILURE;
+    }
+    loader->Wait();
+  }
+
+  // Tiles of a previous file are not cached
+  {
+    LoaderType::Pointer loader = LoaderType::New();
+    loader->SetFileName(argv[1]);
+
+    const std::vector<LoaderType::TileKey> keys = TileKeys(loader);
+
+    loader->Request(keys);
+    loader->SetFileName(argv[1]);
+    loader->Wait();
+
+    if (loader->GetNumberOfCachedTiles() != 0 || loader->GetNumberOfPendingTiles() != 0)
+    {
+      std::cerr << loader->GetNumberOfCachedTiles() << " tiles of the previous file were cached" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
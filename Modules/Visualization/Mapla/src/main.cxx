@@ -70,7 +70,7 @@ int main(int argc, char* argv[])
 {
   QApplication qtApp(argc, argv);
 
-  otb::ConfigurationManager::InitOpenMPThreads();
+  otb::ConfigurationManager::InitThreads();
 
 //
 // 0. Splash-screen.
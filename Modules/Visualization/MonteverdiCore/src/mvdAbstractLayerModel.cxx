@@ -77,7 +77,7 @@ SpatialReferenceType GetSpatialReferenceType(const std::string& filename)
   reader->SetFileName(filename);
   reader->UpdateOutputInformation();
 
-  DefaultImageType* image = reader->GetOutput();
+  const DefaultImageType* image = reader->GetOutput();
   assert(image != NULL);
 
   return GetSpatialReferenceType(image->GetProjectionRef(), image->GetImageMetadata().HasSensorGeometry());
@@ -122,7 +122,7 @@ void VectorImageModel::SetFilename(const QString& filename, int w, int h)
 
   // Setup GenericRSTransform
   m_ToWgs84 = otb::GenericRSTransform<>::New();
-  m_ToWgs84->SetInputImageMetadata(&(m_ImageFileReader->GetOutput()->GetImageMetadata()));
+  m_ToWgs84->SetInputImageMetadata(&GetImageMetadata());
   m_ToWgs84->SetOutputProjectionRef(otb::SpatialReference::FromWGS84().ToWkt());
   m_ToWgs84->InstantiateTransform();
 
@@ -156,7 +156,8 @@ void VectorImageModel::SetFilename(const QString& filename, int w, int h)
 
 const otb::ImageMetadata & VectorImageModel::GetImageMetadata() const
 {
-  return m_ImageFileReader->GetOutput()->GetImageMetadata();
+  const SourceImageType* image = m_ImageFileReader->GetOutput();
+  return image->GetImageMetadata();
 }
 
 
@@ -598,7 +599,8 @@ bool VectorImageModel::virtual_HasSensorModel() const
 {
   assert(!m_Image.IsNull());
 
-  return m_Image->GetImageMetadata().HasSensorGeometry();
+  const SourceImageType* image = m_Image;
+  return image->GetImageMetadata().HasSensorGeometry();
 }
 
 /*****************************************************************************/
@@ -712,7 +714,7 @@ void VectorImageModel::OnPhysicalCursorPositionChanged(const QPoint&, const Poin
     {
       geoVector.push_back(ToStdString(tr("Geographic(exact)")));
     }
-    else if (ToImage()->GetImageMetadata().HasSensorGeometry())
+    else if (HasSensorModel())
     {
       geoVector.push_back(ToStdString(tr("Geographic(sensor model)")));
     }
@@ -724,7 +726,7 @@ void VectorImageModel::OnPhysicalCursorPositionChanged(const QPoint&, const Poin
     if (ToImage()->GetLargestPossibleRegion().IsInside(currentLodIndex) || 1)
     {
       // TODO : Is there a better method to detect no geoinfo available ?
-      if (!ToImage()->GetProjectionRef().empty() || ToImage()->GetImageMetadata().HasSensorGeometry())
+      if (!ToImage()->GetProjectionRef().empty() || HasSensorModel())
       {
         assert(!m_ToWgs84.IsNull());
 
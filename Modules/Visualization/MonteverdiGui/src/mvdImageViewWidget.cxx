@@ -1573,7 +1573,7 @@ void ImageViewWidget::OnSetProjectionRequired()
     assert(m_Manipulator != NULL);
 
     m_Manipulator->SetWkt(image->GetProjectionRef());
-    m_Manipulator->SetImd(&(image->m_Imd));
+    m_Manipulator->SetImd(&(image->GetImageMetadata()));
 
     m_Manipulator->SetOrigin(imageModel->GetOrigin());
     m_Manipulator->SetSpacing(imageModel->GetSpacing());
@@ -1919,7 +1919,7 @@ void ImageViewWidget::OnUpdateProjectionRequired()
     // Update the Manipulator reference projection.
     // Then all view manipulation will use this projection reference.
     m_Manipulator->SetWkt(image->GetProjectionRef());
-    m_Manipulator->SetImd(&(image->m_Imd));
+    m_Manipulator->SetImd(&(image->GetImageMetadata()));
     m_Manipulator->SetNativeSpacing(imageModel->GetNativeSpacing());
   }
   else
@@ -81,7 +81,7 @@ int main(int argc, char* argv[])
     otb::MPIConfig::Instance()->Init(argc, argv);
 #endif
 
-  otb::ConfigurationManager::InitOpenMPThreads();
+  otb::ConfigurationManager::InitThreads();
 
   typedef otb::Wrapper::CommandLineLauncher LauncherType;
   LauncherType::Pointer                     launcher = LauncherType::New();
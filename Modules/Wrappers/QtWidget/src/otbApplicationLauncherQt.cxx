@@ -48,7 +48,7 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////*/
   QtApplication qtApp(argc, argv);
 
-  otb::ConfigurationManager::InitOpenMPThreads();
+  otb::ConfigurationManager::InitThreads();
 
   if (argc < 2)
   {
@@ -955,6 +955,7 @@ public:
 };
 
 %include "PyCommand.i"
+%include "otbPythonStreamingFilter.i"
 
 %extend itkMetaDataDictionary
 {
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if SWIGPYTHON
+
+%{
+#include "otbPythonStreamingFilter.h"
+typedef otb::PythonStreamingFilter          PythonStreamingFilter;
+typedef otb::PythonStreamingFilter::Pointer PythonStreamingFilter_Pointer;
+%}
+
+class PythonStreamingFilter : public itkProcessObject
+{
+public:
+  static PythonStreamingFilter_Pointer New();
+  virtual char const * GetNameOfClass() const;
+
+  void SetInputImage(ImageBaseType * image);
+  ImageBaseType * GetOutputImage();
+
+  void SetCallable(PyObject *obj);
+  PyObject * GetCallable();
+
+  void SetNumberOfOutputBands(unsigned int bands);
+  unsigned int GetNumberOfOutputBands() const;
+  void SetRadius(unsigned int radius);
+  unsigned int GetRadius() const;
+protected:
+  PythonStreamingFilter();
+};
+DECLARE_REF_COUNT_CLASS( PythonStreamingFilter )
+
+#if OTB_SWIGNUMPY
+%extend PythonStreamingFilter
+{
+  %pythoncode
+  {
+    def SetNumpyCallback(self, func):
+      """
+      Call func(input, output, offset) on each streamed region, where
+      input and output are NumPy views (rows, columns, bands) of the
+      float32 buffers of the input region and of the output region,
+      and offset is the (row, column) position of the output region in
+      the input region. The views must not be kept after the call.
+      """
+      import numpy as np
+      def _call(inBuffer, inShape, outBuffer, outShape, offset):
+        inArray = np.frombuffer(inBuffer, dtype=np.float32).reshape(inShape)
+        outArray = np.frombuffer(outBuffer, dtype=np.float32).reshape(outShape)
+        func(inArray, outArray, offset)
+      self.SetCallable(_call)
+  }
+}
+
+%pythoncode
+{
+def StreamingNumpyFilter(image, func, bands=0, radius=0):
+  """
+  Insert a Python function in a streamed pipeline: the returned filter
+  calls func(input, output, offset) on each requested region of image
+  (see PythonStreamingFilter.SetNumpyCallback), and its output image is
+  given to the next application with SetParameterInputImage():
+
+    filt = otbApplication.StreamingNumpyFilter(app1.GetParameterOutputImage("out"), func)
+    app2.SetParameterInputImage("in", filt.GetOutputImage())
+    app2.ExecuteAndWriteOutput()
+
+  The filter must be kept alive until the pipeline is executed.
+  """
+  filt = PythonStreamingFilter_New()
+  filt.SetNumberOfOutputBands(bands)
+  filt.SetRadius(radius)
+  filt.SetNumpyCallback(func)
+  filt.SetInputImage(image)
+  return filt
+}
+#endif /* OTB_SWIGNUMPY */
+
+#endif
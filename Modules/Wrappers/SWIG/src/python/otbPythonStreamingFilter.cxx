@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbPythonStreamingFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
+
+namespace
+{
+// Wrapper to automatics obtain and release GIL
+// RAII idiom
+class PyGILStateEnsure
+{
+public:
+  PyGILStateEnsure() : m_GIL(PyGILState_Ensure())
+  {
+  }
+  ~PyGILStateEnsure()
+  {
+    PyGILState_Release(m_GIL);
+  }
+
+private:
+  PyGILState_STATE m_GIL;
+};
+
+// Memoryview on the buffer of a region of an image
+PyObject* NewRegionView(otb::Wrapper::FloatVectorImageType* image, int flags)
+{
+  const Py_ssize_t size = image->GetBufferedRegion().GetNumberOfPixels() * image->GetNumberOfComponentsPerPixel() * sizeof(float);
+  return PyMemoryView_FromMemory(reinterpret_cast<char*>(image->GetBufferPointer()), size, flags);
+}
+
+// (rows, columns, bands) of the buffer of an image
+PyObject* NewShape(const otb::Wrapper::FloatVectorImageType* image)
+{
+  const otb::Wrapper::FloatVectorImageType::SizeType size = image->GetBufferedRegion().GetSize();
+  return Py_BuildValue("(kkI)", static_cast<unsigned long>(size[1]), static_cast<unsigned long>(size[0]), image->GetNumberOfComponentsPerPixel());
+}
+} // end anonymous namespace
+
+namespace otb
+{
+
+PythonStreamingFilter::PythonStreamingFilter()
+  : m_Callable(nullptr), m_InputCaster(Wrapper::InputImageParameter::New()), m_NumberOfOutputBands(0), m_Radius(0)
+{
+}
+
+PythonStreamingFilter::~PythonStreamingFilter()
+{
+  if (m_Callable)
+  {
+    PyGILStateEnsure gil;
+    Py_DECREF(m_Callable);
+  }
+  m_Callable = nullptr;
+}
+
+void PythonStreamingFilter::SetInputImage(Wrapper::ImageBaseType* image)
+{
+  m_InputCaster->SetImage(image);
+  this->SetInput(m_InputCaster->GetFloatVectorImage());
+}
+
+Wrapper::ImageBaseType* PythonStreamingFilter::GetOutputImage()
+{
+  return this->GetOutput();
+}
+
+void PythonStreamingFilter::SetCallable(PyObject* obj)
+{
+  if (obj != m_Callable)
+  {
+    PyGILStateEnsure gil;
+    if (m_Callable)
+    {
+      Py_DECREF(m_Callable);
+    }
+    m_Callable = obj;
+    if (m_Callable)
+    {
+      Py_INCREF(m_Callable);
+    }
+    this->Modified();
+  }
+}
+
+PyObject* PythonStreamingFilter::GetCallable()
+{
+  return m_Callable;
+}
+
+void PythonStreamingFilter::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  if (m_NumberOfOutputBands > 0)
+  {
+    this->GetOutput()->SetNumberOfComponentsPerPixel(m_NumberOfOutputBands);
+  }
+}
+
+void PythonStreamingFilter::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  ImageType* input  = const_cast<ImageType*>(this->GetInput());
+  RegionType region = this->GetOutput()->GetRequestedRegion();
+  region.PadByRadius(m_Radius);
+  region.Crop(input->GetLargestPossibleRegion());
+  input->SetRequestedRegion(region);
+}
+
+void PythonStreamingFilter::GenerateData()
+{
+  ImageType*       output = this->GetOutput();
+  const ImageType* input  = this->GetInput();
+
+  this->AllocateOutputs();
+
+  itk::ProgressReporter progress(this, 0, 1);
+
+  // The input buffer can be larger than the requested region
+  ImageType::Pointer inputRegion = const_cast<ImageType*>(input);
+  const RegionType   requested   = input->GetRequestedRegion();
+  if (input->GetBufferedRegion() != requested)
+  {
+    inputRegion = ImageType::New();
+    inputRegion->CopyInformation(input);
+    inputRegion->SetRegions(requested);
+    inputRegion->Allocate();
+    itk::ImageRegionConstIterator<ImageType> inIt(input, requested);
+    itk::ImageRegionIterator<ImageType>      outIt(inputRegion, requested);
+    for (inIt.GoToBegin(), outIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++outIt)
+    {
+      outIt.Set(inIt.Get());
+    }
+  }
+
+  // make sure that the callable is in fact callable
+  PyGILStateEnsure gil;
+  if (!PyCallable_Check(m_Callable))
+  {
+    itkExceptionMacro(<< "The callable is not a callable Python object, or it has not been set.");
+  }
+
+  const RegionType outputRegion = output->GetRequestedRegion();
+  const long       offsetRow    = outputRegion.GetIndex(1) - requested.GetIndex(1);
+  const long       offsetCol    = outputRegion.GetIndex(0) - requested.GetIndex(0);
+
+  PyObject* args   = Py_BuildValue("(NNNN(ll))", NewRegionView(inputRegion, PyBUF_READ), NewShape(inputRegion), NewRegionView(output, PyBUF_WRITE),
+                                 NewShape(output), offsetRow, offsetCol);
+  PyObject* result = args ? PyObject_CallObject(m_Callable, args) : nullptr;
+  Py_XDECREF(args);
+
+  if (result)
+  {
+    Py_DECREF(result);
+  }
+  else
+  {
+    // there was a Python error.  Clear the error by printing to stdout
+    PyErr_Print();
+    // make sure the invoking Python code knows there was a problem
+    // by raising an exception
+    itkExceptionMacro(<< "There was an error executing the callable on region " << outputRegion);
+  }
+
+  progress.CompletedPixel();
+}
+
+} // namespace otb
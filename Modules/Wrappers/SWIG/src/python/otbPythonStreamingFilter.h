@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPythonStreamingFilter_h
+#define otbPythonStreamingFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbWrapperTypes.h"
+#include "otbWrapperInputImageParameter.h"
+
+// The python header defines _POSIX_C_SOURCE without a preceding #undef
+#undef _POSIX_C_SOURCE
+// The python header defines _XOPEN_SOURCE without a preceding #undef
+#undef _XOPEN_SOURCE
+
+#include <Python.h>
+
+namespace otb
+{
+
+/** \class PythonStreamingFilter
+ *  \brief Filter calling a Python callable on each streamed region.
+ *
+ * The filter is inserted between two in-memory connected applications.
+ * Each time a region of its output is requested, the Python callable is
+ * called with the buffers of the input region and of the output region,
+ * without copy, so that Python code can take part in a streamed
+ * pipeline without holding the whole image.
+ *
+ * The callable receives the input buffer (read-only memoryview) and its
+ * shape (rows, columns, bands), the output buffer (writable memoryview)
+ * and its shape, and the (row, column) offset of the output region in
+ * the input region. The input region is the output region padded by the
+ * radius, and cropped to the image. The buffers are only valid during
+ * the call. Pixels are stored as float.
+ *
+ * The Python module wraps the buffers in NumPy arrays, see
+ * PythonStreamingFilter.SetNumpyCallback().
+ *
+ * \ingroup OTBSWIG
+ */
+class PythonStreamingFilter : public itk::ImageToImageFilter<Wrapper::FloatVectorImageType, Wrapper::FloatVectorImageType>
+{
+public:
+  /** Standard class typedefs. */
+  typedef PythonStreamingFilter                                                                   Self;
+  typedef itk::ImageToImageFilter<Wrapper::FloatVectorImageType, Wrapper::FloatVectorImageType> Superclass;
+  typedef itk::SmartPointer<Self>                                                                 Pointer;
+  typedef itk::SmartPointer<const Self>                                                           ConstPointer;
+
+  itkTypeMacro(PythonStreamingFilter, ImageToImageFilter);
+
+  itkNewMacro(Self);
+
+  typedef Wrapper::FloatVectorImageType ImageType;
+  typedef ImageType::RegionType         RegionType;
+
+  /** Set the input image, of any pixel type: it is cast to float */
+  void SetInputImage(Wrapper::ImageBaseType* image);
+
+  /** Get the output image, to connect to an application */
+  Wrapper::ImageBaseType* GetOutputImage();
+
+  /** Assign the Python callable. A reference is taken, so that the
+   * calling code doesn't have to keep the callable around. */
+  void SetCallable(PyObject* obj);
+
+  PyObject* GetCallable();
+
+  /** Number of bands of the output, 0 to keep the number of bands of
+   * the input (default) */
+  itkSetMacro(NumberOfOutputBands, unsigned int);
+  itkGetConstMacro(NumberOfOutputBands, unsigned int);
+
+  /** Margin around the output region given to the callable */
+  itkSetMacro(Radius, unsigned int);
+  itkGetConstMacro(Radius, unsigned int);
+
+protected:
+  PythonStreamingFilter();
+  ~PythonStreamingFilter() override;
+
+  void GenerateOutputInformation() override;
+  void GenerateInputRequestedRegion() override;
+  void GenerateData() override;
+
+private:
+  PythonStreamingFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  PyObject* m_Callable;
+
+  /** Casts the input image to float */
+  Wrapper::InputImageParameter::Pointer m_InputCaster;
+
+  unsigned int m_NumberOfOutputBands;
+  unsigned int m_Radius;
+};
+
+} // namespace otb
+
+#endif
@@ -0,0 +1,62 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) 2005-2022 Centre National d'Etudes Spatiales (CNES)
+#
+# This file is part of Orfeo Toolbox
+#
+#     https://www.orfeo-toolbox.org/
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# -*- coding: utf-8 -*-
+
+#
+#  Example on the use of a Python function in a streamed pipeline
+#
+
+import numpy as np
+
+def test(otb, argv):
+  app1 = otb.Registry.CreateApplication("ExtractROI")
+  app1.SetParameterString("in", argv[1])
+  app1.Execute()
+
+  # Each streamed region is processed by numpy, with a margin of 1 pixel
+  shapes = []
+  def double(inp, out, offset):
+    rows, cols = out.shape[:2]
+    shapes.append((rows, cols))
+    out[...] = 2 * inp[offset[0]:offset[0] + rows, offset[1]:offset[1] + cols, :]
+
+  filt = otb.StreamingNumpyFilter(app1.GetParameterOutputImage("out"), double, radius=1)
+
+  app2 = otb.Registry.CreateApplication("ExtractROI")
+  app2.SetParameterInputImage("in", filt.GetOutputImage())
+  app2.SetParameterString("out", argv[2])
+  app2.SetParameterInt("ram", 1)
+  app2.ExecuteAndWriteOutput()
+
+  if len(shapes) < 2:
+    raise Exception("The image was not streamed: " + str(len(shapes)) + " region(s)")
+
+  reference = app1.GetVectorImageAsNumpyArray("out", 'float')
+  if sum(r * c for r, c in shapes) != reference.shape[0] * reference.shape[1]:
+    raise Exception("The streamed regions do not cover the image: " + str(shapes))
+
+  reader = otb.Registry.CreateApplication("ExtractROI")
+  reader.SetParameterString("in", argv[2])
+  reader.Execute()
+  result = reader.GetVectorImageAsNumpyArray("out", 'float')
+  if not np.array_equal(result, 2 * reference):
+    raise Exception("The streamed result differs from the whole image result")